@@ -898,6 +898,8 @@ int main(int argc, char *argv[])
 	args->shutdown = 1;
 	odph_thread_join(thread_tbl, num_workers);
 
+	odp_pktio_extra_stats_print(pktio);
+
 	if (check_ci_pass_count(args)) {
 		ODPH_ERR("Error: Packet count verification failed\n");
 		exit(EXIT_FAILURE);
@@ -247,6 +247,34 @@ int odp_timer_sample_ticks(odp_timer_pool_t timer_pool[], uint64_t tick[], uint6
 int odp_timer_pool_info(odp_timer_pool_t timer_pool,
 			odp_timer_pool_info_t *info);
 
+/**
+ * Read timer pool statistics
+ *
+ * Reads statistics counters of the timer pool. Counters are collected always when supported
+ * (see odp_timer_capability_t::stats), starting from timer pool creation or the last
+ * odp_timer_pool_stats_reset() call. Counters are updated by timer processing concurrently with
+ * the read, so values of different counters may not be exactly in sync with each other.
+ *
+ * @param      timer_pool  Timer pool
+ * @param[out] stats       Pointer to statistics counters output
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ */
+int odp_timer_pool_stats(odp_timer_pool_t timer_pool, odp_timer_pool_stats_t *stats);
+
+/**
+ * Reset timer pool statistics
+ *
+ * Resets all timer pool statistics counters to zero.
+ *
+ * @param timer_pool  Timer pool
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ */
+int odp_timer_pool_stats_reset(odp_timer_pool_t timer_pool);
+
 /**
  * Allocate a single shot timer
  *
@@ -345,6 +373,54 @@ int odp_timer_start(odp_timer_t timer, const odp_timer_start_t *start_param);
  */
 int odp_timer_restart(odp_timer_t timer, const odp_timer_start_t *start_param);
 
+/**
+ * Start multiple single shot timers
+ *
+ * Otherwise like odp_timer_start(), but starts multiple timers. Timer timer[i] is started with
+ * parameters start_param[i]. Timers are started in array order and the operation stops at the
+ * first timer that cannot be started. Application may call the function again starting from that
+ * timer to find out the reason of the failure. Implementation may amortize per call costs (e.g.
+ * current time read and memory synchronization) over all the timers.
+ *
+ * @param timer               Timers to be started
+ * @param start_param         Timer start parameters, one per timer
+ * @param num                 Number of timers
+ *
+ * @return Number of timers started successfully (1 ... num)
+ * @retval ODP_TIMER_TOO_NEAR First timer was not started. Its expiration time passed already, or
+ *                            is too near to the current time.
+ * @retval ODP_TIMER_TOO_FAR  First timer was not started. Its expiration time is too far from the
+ *                            current time.
+ * @retval ODP_TIMER_BUSY     First timer was not started. Resources temporarily busy.
+ * @retval ODP_TIMER_FAIL     First timer was not started due to other failure.
+ */
+int odp_timer_start_multi(const odp_timer_t timer[], const odp_timer_start_t start_param[],
+			  int num);
+
+/**
+ * Restart multiple single shot timers
+ *
+ * Otherwise like odp_timer_restart(), but restarts multiple timers. Timer timer[i] is restarted
+ * with parameters start_param[i]. Timers are restarted in array order and the operation stops at
+ * the first timer that cannot be restarted.
+ *
+ * @param timer               Timers to be restarted
+ * @param start_param         Timer start parameters, one per timer. Value of 'tmo_ev' parameter
+ *                            is ignored.
+ * @param num                 Number of timers
+ *
+ * @return Number of timers restarted successfully (1 ... num)
+ * @retval ODP_TIMER_TOO_NEAR First timer was not restarted. Its new expiration time passed
+ *                            already, or is too near to the current time.
+ * @retval ODP_TIMER_TOO_FAR  First timer was not restarted. Its new expiration time is too far
+ *                            from the current time.
+ * @retval ODP_TIMER_BUSY     First timer was not restarted. Resources temporarily busy.
+ * @retval ODP_TIMER_FAIL     First timer was not restarted. The timer expired already, or other
+ *                            failure.
+ */
+int odp_timer_restart_multi(const odp_timer_t timer[], const odp_timer_start_t start_param[],
+			    int num);
+
 /**
  * Initialize periodic timer parameters
  *
@@ -486,6 +562,25 @@ int odp_timer_periodic_cancel(odp_timer_t timer);
  */
 int odp_timer_cancel(odp_timer_t timer, odp_event_t *tmo_ev);
 
+/**
+ * Cancel multiple single shot timers
+ *
+ * Otherwise like odp_timer_cancel(), but cancels multiple timers. Timers are cancelled in array
+ * order and the operation stops at the first timer that cannot be cancelled. Timeout event of
+ * timer[i] is returned in tmo_ev[i].
+ *
+ * @param      timer  Timers to be cancelled
+ * @param[out] tmo_ev Array of event handles for output. Event handles are written only for
+ *                    timers that were cancelled successfully.
+ * @param      num    Number of timers
+ *
+ * @return Number of timers cancelled successfully (1 ... num)
+ * @retval ODP_TIMER_TOO_NEAR First timer cannot be cancelled. It has expired already, or cannot be
+ *                            cancelled due to close expiration time.
+ * @retval ODP_TIMER_FAIL     First timer was not cancelled due to other failure.
+ */
+int odp_timer_cancel_multi(const odp_timer_t timer[], odp_event_t tmo_ev[], int num);
+
 /**
  * Get timeout handle from an ODP_EVENT_TIMEOUT type event
  *
@@ -288,6 +288,15 @@ typedef struct {
 
 	} periodic;
 
+	/**
+	 * Timer pool statistics support
+	 *
+	 * 0: Timer pool statistics are not supported
+	 * 1: Timer pool statistics are supported
+	 * @see odp_timer_pool_stats()
+	 */
+	odp_bool_t stats;
+
 } odp_timer_capability_t;
 
 /**
@@ -819,6 +828,53 @@ typedef struct {
 
 } odp_timer_pool_info_t;
 
+/** Number of buckets in timer pool statistics histograms */
+#define ODP_TIMER_POOL_STATS_HIST_SIZE 32
+
+/**
+ * Timer pool statistics counters
+ *
+ * A timer pool scan checks expiration of timers and delivers timeout events of expired timers.
+ * When implementation splits the check of all timers of the pool into multiple parts (e.g.
+ * processed by different threads), each part is counted as a scan.
+ *
+ * Histograms use base 2 logarithmic buckets. Bucket 0 counts values 0 and 1, and bucket 'i'
+ * (i > 0) counts values from 2^i to 2^(i+1) - 1. The last bucket counts also all values
+ * larger than that.
+ */
+typedef struct odp_timer_pool_stats_t {
+	/** Number of timer pool scans */
+	uint64_t scans;
+
+	/** Number of missed scans. Incremented when timer pool processing falls behind and
+	 *  one or more scans are skipped (e.g. timer resolution is too high for the system). */
+	uint64_t missed_scans;
+
+	/** Number of expired timers (timeout events delivered) */
+	uint64_t expired;
+
+	/** Maximum scan duration in nanoseconds */
+	uint64_t scan_ns_max;
+
+	/** Maximum expiration lateness in nanoseconds. Lateness is the difference between
+	 *  the time a timer was expired and its expiration time. */
+	uint64_t late_ns_max;
+
+	/** Histograms */
+	struct {
+		/** Scan duration in nanoseconds */
+		uint64_t scan_ns[ODP_TIMER_POOL_STATS_HIST_SIZE];
+
+		/** Number of expired timers per scan */
+		uint64_t expired[ODP_TIMER_POOL_STATS_HIST_SIZE];
+
+		/** Expiration lateness in nanoseconds */
+		uint64_t late_ns[ODP_TIMER_POOL_STATS_HIST_SIZE];
+
+	} hist;
+
+} odp_timer_pool_stats_t;
+
 /**
  * @}
  */
@@ -1,6 +1,6 @@
 /* SPDX-License-Identifier: BSD-3-Clause
  * Copyright (c) 2015-2018 Linaro Limited
- * Copyright (c) 2024 Nokia
+ * Copyright (c) 2024-2026 Nokia
  */
 
 #include <odp_posix_extensions.h>
@@ -11,10 +11,21 @@
 #include <odp/api/abi/time_cpu.h>
 
 #include <odp_debug_internal.h>
+#include <odp_libconfig_internal.h>
 
-#include <time.h>
+#include <cpuid.h>
 #include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+/* Maximum difference between nominal and measured TSC frequency (1/N) */
+#define FREQ_CHECK_DIV 100
+
+/* Measurement time for checking nominal TSC frequency */
+#define FREQ_CHECK_NSEC (ODP_TIME_SEC_IN_NS / 500)
 
 static int nwait(uint64_t nsec)
 {
@@ -58,49 +69,170 @@ static uint64_t median(uint64_t values[], int num)
 		return values[num / 2];
 }
 
-/* Measure TSC frequency. */
-uint64_t _odp_time_cpu_global_freq(void)
+/* Measure TSC frequency over one wait period */
+static uint64_t measure_freq(uint64_t wait_nsec)
 {
 	struct timespec ts1, ts2;
 	uint64_t t1, t2, ts_nsec, cycles;
+
+	if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts1))
+		return 0;
+
+	t1 = _odp_time_cpu_global();
+
+	if (nwait(wait_nsec))
+		return 0;
+
+	if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts2))
+		return 0;
+
+	t2 = _odp_time_cpu_global();
+
+	ts_nsec  = (ts2.tv_sec - ts1.tv_sec) * ODP_TIME_SEC_IN_NS;
+	ts_nsec += ts2.tv_nsec - ts1.tv_nsec;
+
+	cycles = t2 - t1;
+
+	return (cycles * ODP_TIME_SEC_IN_NS) / ts_nsec;
+}
+
+/* Calibrate TSC frequency against CLOCK_MONOTONIC_RAW */
+static uint64_t calibrate_freq(void)
+{
 	int i;
 	const int rounds = 6; /* first round is warmup */
-	int warm_up = 1;
 	uint64_t hz[rounds];
 
 	for (i = 0; i < rounds; i++) {
 		uint64_t wait_nsec = ODP_TIME_SEC_IN_NS / 50;
 
-		if (warm_up)
+		if (i == 0)
 			wait_nsec = ODP_TIME_SEC_IN_NS / 1000;
 
-		if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts1))
+		hz[i] = measure_freq(wait_nsec);
+		if (hz[i] == 0)
 			goto err_out;
+	}
 
-		t1 = _odp_time_cpu_global();
+	return median(&hz[1], rounds - 1);
 
-		if (nwait(wait_nsec))
-			goto err_out;
+err_out:
+	_ODP_ERR("clock_gettime() failed (%s)\n", strerror(errno));
+	return 0;
+}
 
-		if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts2))
-			goto err_out;
+/* Nominal TSC frequency from CPUID leaf 0x15 (TSC/crystal ratio), with crystal
+ * frequency from leaf 0x16 (base frequency) when leaf 0x15 does not report it. */
+static uint64_t cpuid_freq(void)
+{
+	uint32_t eax, ebx, ecx, edx;
+	uint32_t max_leaf = __get_cpuid_max(0, NULL);
+	uint64_t crystal_hz;
 
-		t2 = _odp_time_cpu_global();
+	if (max_leaf < 0x15)
+		return 0;
 
-		ts_nsec  = (ts2.tv_sec - ts1.tv_sec) * ODP_TIME_SEC_IN_NS;
-		ts_nsec += ts2.tv_nsec - ts1.tv_nsec;
+	__cpuid_count(0x15, 0, eax, ebx, ecx, edx);
 
-		cycles = t2 - t1;
+	/* eax: denominator, ebx: numerator, ecx: crystal frequency */
+	if (eax == 0 || ebx == 0)
+		return 0;
 
-		hz[i] = (cycles * ODP_TIME_SEC_IN_NS) / ts_nsec;
+	crystal_hz = ecx;
 
-		if (warm_up)
-			warm_up = 0;
+	if (crystal_hz == 0 && max_leaf >= 0x16) {
+		uint32_t base_mhz;
+
+		__cpuid_count(0x16, 0, base_mhz, ebx, ecx, edx);
+		__cpuid_count(0x15, 0, eax, ebx, ecx, edx);
+
+		crystal_hz = ((uint64_t)base_mhz * 1000000 * eax) / ebx;
 	}
 
-	return median(&hz[1], rounds - 1);
+	return (crystal_hz * ebx) / eax;
+}
 
-err_out:
-	_ODP_ERR("clock_gettime() failed (%s)\n", strerror(errno));
-	return 0;
+/* TSC frequency from hypervisor timing leaf (e.g. KVM, VMware) */
+static uint64_t cpuid_hv_freq(void)
+{
+	uint32_t eax, ebx, ecx, edx;
+
+	__cpuid(1, eax, ebx, ecx, edx);
+
+	/* Hypervisor present bit */
+	if (!(ecx & (1u << 31)))
+		return 0;
+
+	__cpuid(0x40000000, eax, ebx, ecx, edx);
+	if (eax < 0x40000010)
+		return 0;
+
+	/* eax: TSC frequency in kHz */
+	__cpuid(0x40000010, eax, ebx, ecx, edx);
+
+	return (uint64_t)eax * 1000;
+}
+
+/* TSC frequency reported by kernel (not available on all kernels) */
+static uint64_t sysfs_freq(void)
+{
+	const char *path = "/sys/devices/system/cpu/cpu0/tsc_freq_khz";
+	char str[64];
+	uint64_t khz = 0;
+	FILE *file;
+
+	file = fopen(path, "r");
+	if (file == NULL)
+		return 0;
+
+	if (fgets(str, sizeof(str), file) != NULL)
+		khz = strtoull(str, NULL, 10);
+
+	fclose(file);
+
+	return khz * 1000;
+}
+
+/* TSC frequency. Nominal frequency is used when available and it matches a short
+ * measurement, otherwise frequency is calibrated. */
+uint64_t _odp_time_cpu_global_freq(void)
+{
+	const char *str = "system.tsc_freq_calibrate";
+	const char *src = "sysfs";
+	uint64_t hz, hz_meas;
+	int calibrate;
+
+	if (!_odp_libconfig_lookup_int(str, &calibrate)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return 0;
+	}
+
+	if (calibrate)
+		return calibrate_freq();
+
+	hz = sysfs_freq();
+	if (hz == 0) {
+		src = "CPUID";
+		hz = cpuid_freq();
+	}
+	if (hz == 0) {
+		src = "hypervisor CPUID";
+		hz = cpuid_hv_freq();
+	}
+	if (hz == 0)
+		return calibrate_freq();
+
+	/* Quick sanity check against the actual counter rate */
+	hz_meas = measure_freq(FREQ_CHECK_NSEC);
+	if (hz_meas == 0 || hz_meas > hz + hz / FREQ_CHECK_DIV ||
+	    hz_meas < hz - hz / FREQ_CHECK_DIV) {
+		_ODP_WARN("Nominal TSC freq from %s (%" PRIu64 " hz) does not match measured "
+			  "(%" PRIu64 " hz), calibrating\n", src, hz, hz_meas);
+		return calibrate_freq();
+	}
+
+	_ODP_DBG("TSC freq from %s: %" PRIu64 " hz (measured %" PRIu64 " hz)\n", src, hz,
+		 hz_meas);
+
+	return hz;
 }
@@ -0,0 +1,126 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/*
+ * Big reader lock
+ *
+ * Reader-writer lock for read-mostly data. Each ODP thread has its own reader
+ * indicator on a separate cache line, so readers do not write to any shared
+ * cache line and read lock/unlock scale with the number of threads. A writer
+ * sets the writer flag and then waits until all reader indicators are clear.
+ * Write lock cost is proportional to ODP_THREAD_COUNT_MAX, and the lock
+ * itself takes ODP_THREAD_COUNT_MAX cache lines of memory, so this lock is
+ * meant only for a few global, rarely updated data structures.
+ *
+ * Non-ODP threads (e.g. service threads) share a single reader counter.
+ * Lock is not recursive.
+ */
+
+#ifndef ODP_BRLOCK_INTERNAL_H_
+#define ODP_BRLOCK_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/align.h>
+#include <odp/api/atomic.h>
+#include <odp/api/hints.h>
+#include <odp/api/sync.h>
+#include <odp/api/thread_types.h>
+
+#include <odp/api/plat/atomic_inlines.h>
+#include <odp/api/plat/cpu_inlines.h>
+#include <odp/api/plat/sync_inlines.h>
+#include <odp/api/plat/thread_inline_types.h>
+
+#include <stdint.h>
+
+typedef struct ODP_ALIGNED_CACHE {
+	odp_atomic_u32_t cnt;
+
+} _odp_brlock_reader_t;
+
+typedef struct {
+	/* Writer flag */
+	odp_atomic_u32_t writer;
+
+	/* Reader indicators: one per ODP thread, the last one is shared by
+	 * non-ODP threads */
+	_odp_brlock_reader_t reader[ODP_THREAD_COUNT_MAX + 1];
+
+} _odp_brlock_t;
+
+static inline void _odp_brlock_init(_odp_brlock_t *lock)
+{
+	odp_atomic_init_u32(&lock->writer, 0);
+
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX + 1; i++)
+		odp_atomic_init_u32(&lock->reader[i].cnt, 0);
+}
+
+static inline _odp_brlock_reader_t *_odp_brlock_reader(_odp_brlock_t *lock)
+{
+	if (odp_unlikely(_odp_this_thread == NULL))
+		return &lock->reader[ODP_THREAD_COUNT_MAX];
+
+	return &lock->reader[_odp_this_thread->thr];
+}
+
+static inline void _odp_brlock_read_lock(_odp_brlock_t *lock)
+{
+	_odp_brlock_reader_t *reader = _odp_brlock_reader(lock);
+
+	while (1) {
+		odp_atomic_inc_u32(&reader->cnt);
+
+		/* Reader indicator store must be visible before writer flag load */
+		odp_mb_full();
+
+		if (odp_likely(odp_atomic_load_acq_u32(&lock->writer) == 0))
+			return;
+
+		/* Writer active: step back and wait for it to finish */
+		odp_atomic_dec_u32(&reader->cnt);
+
+		while (odp_atomic_load_u32(&lock->writer))
+			odp_cpu_pause();
+	}
+}
+
+static inline void _odp_brlock_read_unlock(_odp_brlock_t *lock)
+{
+	_odp_brlock_reader_t *reader = _odp_brlock_reader(lock);
+
+	odp_atomic_sub_rel_u32(&reader->cnt, 1);
+}
+
+static inline void _odp_brlock_write_lock(_odp_brlock_t *lock)
+{
+	uint32_t unlocked = 0;
+
+	while (!odp_atomic_cas_acq_u32(&lock->writer, &unlocked, 1)) {
+		unlocked = 0;
+		odp_cpu_pause();
+	}
+
+	/* Writer flag store must be visible before reader indicator loads */
+	odp_mb_full();
+
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX + 1; i++) {
+		while (odp_atomic_load_acq_u32(&lock->reader[i].cnt))
+			odp_cpu_pause();
+	}
+}
+
+static inline void _odp_brlock_write_unlock(_odp_brlock_t *lock)
+{
+	odp_atomic_store_rel_u32(&lock->writer, 0);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -16,6 +16,7 @@
 extern "C" {
 #endif
 
+#include <odp/api/atomic.h>
 #include <odp/api/spinlock.h>
 #include <odp/api/classification.h>
 #include <odp/api/debug.h>
@@ -27,6 +28,7 @@ extern "C" {
 #include <odp_queue_if.h>
 
 #include <protocols/ip.h>
+#include <protocols/thash.h>
 
 /* Maximum Class Of Service Entry */
 #define CLS_COS_MAX_ENTRY		64
@@ -40,16 +42,26 @@ extern "C" {
 #define CLS_PMR_PER_COS_MAX		8
 /* Max PMR Term size */
 #define MAX_PMR_TERM_SIZE		16
-/* Max queue per Class of service */
-#define CLS_COS_QUEUE_MAX		32
+/* Max queue per Class of service. This is also the size of the RSS redirection table, which
+ * maps hash values to hash queues. */
+#define CLS_COS_QUEUE_MAX		256
 /* Max number of implementation created queues */
 #define CLS_QUEUE_GROUP_MAX		(CLS_COS_MAX_ENTRY * CLS_COS_QUEUE_MAX)
+/* Max number of flow cache entries per pktio */
+#define CLS_FLOW_CACHE_MAX		(16 * 1024)
+/* Max number of PMR matches (CoS tree depth) stored in a flow cache entry */
+#define CLS_FLOW_CACHE_PATH_MAX		4
 
 /* CoS index is stored in odp_packet_hdr_t */
 ODP_STATIC_ASSERT(CLS_COS_MAX_ENTRY <= UINT8_MAX, "cos field in packet header is too small");
 ODP_STATIC_ASSERT(sizeof(((odp_packet_hdr_t *)0)->cos) == sizeof(uint8_t),
 		  "Unexpected cos field size in packet header");
 
+typedef struct {
+	odp_atomic_u64_t discards;
+	odp_atomic_u64_t packets;
+} cls_stats_t;
+
 typedef union {
 	/* All proto fields */
 	uint32_t all;
@@ -142,14 +154,19 @@ typedef struct ODP_ALIGNED_CACHE cos_s {
 		odp_bool_t use_aggr;
 		odp_bool_t use_std_enq;
 	} vector;
+	struct {
+		odp_bool_t enable;
+		odp_threshold_type_t type;
+		uint64_t min;
+		uint64_t max;
+	} red;				/* RED on pool usage */
 	size_t headroom;		/* Headroom for this CoS */
 	odp_spinlock_t lock;		/* cos lock */
 	odp_queue_param_t queue_param;
 	char name[ODP_COS_NAME_LEN];	/* name */
-	struct {
-		odp_atomic_u64_t discards;
-		odp_atomic_u64_t packets;
-	} stats, queue_stats[CLS_COS_QUEUE_MAX];
+	cls_stats_t stats;
+	/* Per queue statistics, classifier.max_hash_queues entries */
+	cls_stats_t *queue_stats;
 } cos_t;
 
 /* Pattern Matching Rule */
@@ -157,6 +174,7 @@ typedef struct ODP_ALIGNED_CACHE pmr_s {
 	uint32_t valid;			/* Validity Flag */
 	uint32_t num_pmr;		/* num of PMR Term Values*/
 	uint16_t mark;
+	uint8_t no_flow_cache;		/* Has terms outside of flow key */
 	pmr_term_value_t  pmr_term_value[CLS_PMRTERM_MAX];
 			/* List of associated PMR Terms */
 	odp_spinlock_t lock;		/* pmr lock*/
@@ -167,6 +185,30 @@ typedef struct ODP_ALIGNED_CACHE {
 	odp_queue_t queue[CLS_QUEUE_GROUP_MAX];
 } _cls_queue_grp_tbl_t;
 
+/* Flow cache key. Contains all packet fields that cacheable PMR terms match on. */
+typedef struct {
+	uint32_t src_addr[4];
+	uint32_t dst_addr[4];
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint16_t ethtype[2];		/* Outermost and innermost ethertype */
+	uint16_t vlan_tci[2];		/* Outermost and innermost VLAN TCI */
+	uint8_t proto;
+	uint8_t flags;
+	uint16_t pad;
+} cls_flow_key_t;
+
+/* Flow cache entry. Written under a sequence counter, which is odd while an update is in
+ * progress. */
+typedef struct ODP_ALIGNED_CACHE {
+	odp_atomic_u32_t seq;
+	uint32_t gen;			/* Classifier generation of the result */
+	cls_flow_key_t key;
+	uint16_t mark;
+	uint8_t num_path;
+	uint8_t path[CLS_FLOW_CACHE_PATH_MAX];	/* Matched CoS indexes */
+} cls_flow_entry_t;
+
 /**
 Linux Generic Classifier
 
@@ -178,6 +220,9 @@ typedef struct classifier {
 	cos_t *default_cos;		/* Associated Default CoS */
 	size_t headroom;		/* Pktio Headroom */
 	size_t skip;			/* Pktio Skip Offset */
+	cls_flow_entry_t *flow_cache;	/* Flow cache of this pktio */
+	odp_atomic_u64_t flow_cache_hits;
+	odp_atomic_u64_t flow_cache_misses;
 } classifier_t;
 
 /**
@@ -203,6 +248,26 @@ typedef struct cls_global_t {
 	_cls_queue_grp_tbl_t queue_grp_tbl;
 	odp_shm_t shm;
 
+	/* Max number of hash queues per CoS */
+	uint32_t max_hash_queues;
+
+	/* Per queue statistics of all CoSes */
+	odp_shm_t queue_stats_shm;
+
+	/* RSS hash key and lookup table */
+	rss_key rss_key;
+	thash_tbl_t thash;
+
+	struct {
+		odp_shm_t shm;
+		cls_flow_entry_t *entry;
+		uint32_t size;		/* Number of entries per pktio */
+		/* Incremented on every classifier configuration change */
+		odp_atomic_u32_t gen;
+		/* Number of PMRs that disable the cache */
+		odp_atomic_u32_t num_no_cache_pmr;
+	} flow_cache;
+
 } cls_global_t;
 
 #ifdef __cplusplus
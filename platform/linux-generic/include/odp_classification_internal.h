@@ -43,6 +43,20 @@ static inline cos_t *_odp_cos_entry_from_idx(uint32_t ndx)
 	return &_odp_cls_global->cos_tbl.cos_entry[ndx];
 }
 
+/* Toeplitz hash of packet header fields in network byte order */
+static inline uint32_t _odp_cls_rss_hash(const uint8_t *data, uint32_t len)
+{
+	return thash_tbl_calc(&_odp_cls_global->thash, data, len);
+}
+
+/* Select one of 'num' queues with a hash value. Low bits of the hash index a redirection table,
+ * which is filled with queue indexes in round robin order (as NICs do by default). */
+static inline uint32_t _odp_cls_rss_queue(uint32_t hash, uint32_t num)
+{
+	/* CLS_COS_QUEUE_MAX is a power of 2 */
+	return (hash & (CLS_COS_QUEUE_MAX - 1)) % num;
+}
+
 static inline int _odp_cos_queue_idx(const cos_t *cos, odp_queue_t queue)
 {
 	uint32_t i, tbl_idx;
@@ -257,6 +271,17 @@ This function should be called during pktio initialization.
 **/
 int _odp_pktio_classifier_init(pktio_entry_t *pktio);
 
+/**
+Packet IO classifier extra statistics
+
+Flow cache counters of the pktio. These are appended to the pktio driver extra
+statistics. Return the number of classifier counters (zero when flow cache is
+disabled).
+**/
+int _odp_cls_extra_stat_info(pktio_entry_t *pktio, odp_pktio_extra_stat_info_t info[], int num);
+int _odp_cls_extra_stats(pktio_entry_t *pktio, uint64_t stats[], int num);
+int _odp_cls_extra_stat_counter(pktio_entry_t *pktio, uint32_t id, uint64_t *stat);
+
 #ifdef __cplusplus
 }
 #endif
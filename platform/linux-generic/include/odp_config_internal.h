@@ -10,6 +10,8 @@
 extern "C" {
 #endif
 
+#include <odp/autoheader_internal.h>
+
 /*
  * Maximum number of supported CPU identifiers. The maximum supported CPU ID is
  * CONFIG_NUM_CPU_IDS - 1. Note that the maximum number of ODP threads is
@@ -46,9 +48,11 @@ extern "C" {
 /*
  * Maximum number of scheduled ODP queues
  *
- * Must be a power of two.
+ * Must be a power of two. Selected with --with-max-sched-queues configure option
+ * (default 1024). Queue ring memory is reserved for every queue, so lower
+ * queue_basic.max_queue_size in the config file when this is large.
  */
-#define CONFIG_MAX_SCHED_QUEUES 1024
+#define CONFIG_MAX_SCHED_QUEUES _ODP_CONFIG_MAX_SCHED_QUEUES
 
 /*
  * Maximum number of queues
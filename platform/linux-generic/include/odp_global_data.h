@@ -10,6 +10,8 @@
 extern "C" {
 #endif
 
+#include <odp/api/align.h>
+#include <odp/api/atomic.h>
 #include <odp/api/cpumask.h>
 #include <odp/api/init.h>
 #include <odp/api/random.h>
@@ -41,9 +43,16 @@ typedef struct {
 	char     model_str[CONFIG_NUM_CPU_IDS][MODEL_STR_SIZE];
 } system_info_t;
 
+/* Maximum number of huge page sizes with a known hugetlbfs mount point */
+#define HUGE_PAGE_SIZES_MAX 8
+
 typedef struct {
 	uint64_t default_huge_page_size;
 	char     *default_huge_page_dir;
+	/* Mounted huge page sizes (ascending order) and their directories */
+	int       num_sizes;
+	uint64_t  size[HUGE_PAGE_SIZES_MAX];
+	char     *dir[HUGE_PAGE_SIZES_MAX];
 } hugepage_info_t;
 
 /* Read-only global data. Members should not be modified after global init
@@ -55,6 +64,12 @@ typedef struct odp_global_data_ro_t {
 	uint64_t shm_max_memory;
 	uint64_t shm_max_size;
 	int shm_single_va;
+	/* parallel memory init: number of threads and minimum memory size */
+	int mem_init_threads;
+	uint64_t mem_init_min_size;
+	/* ChaCha20 DRBG for random data: enable and reseed interval in bytes */
+	int random_drbg;
+	uint64_t random_drbg_reseed;
 	pid_t main_pid;
 	pid_t fdserver_pid;
 	char uid[UID_MAXLEN];
@@ -86,12 +101,21 @@ typedef struct odp_global_data_ro_t {
 
 } odp_global_data_ro_t;
 
+/* Per thread wait node of queued locks (see odp_queued_lock_internal.h) */
+typedef struct ODP_ALIGNED_CACHE {
+	odp_atomic_u32_t wait;
+	/* Next waiter: 0 when none, otherwise thread index + 1 */
+	odp_atomic_u32_t next;
+
+} _odp_qlock_node_t;
+
 /* Modifiable global data. Memory region is shared and synchronized amongst all
  * worker processes. */
 typedef struct odp_global_data_rw_t {
 	odp_bool_t dpdk_initialized;
 	odp_bool_t inline_timers;
 	odp_bool_t schedule_configured;
+	_odp_qlock_node_t qlock_node[ODP_THREAD_COUNT_MAX];
 
 } odp_global_data_rw_t;
 
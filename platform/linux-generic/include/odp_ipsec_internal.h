@@ -96,8 +96,13 @@ int _odp_ipsec_status_send(odp_queue_t queue,
 /* The maximum supported AR window size */
 #define IPSEC_AR_WIN_SIZE_MAX	4096
 
-/* For a 64-bit bucket size */
-#define IPSEC_AR_WIN_BUCKET_BITS	6
+/*
+ * A bucket is a 64-bit word, which is updated with CAS. Upper 32 bits store
+ * the (lower bits of the) bucket number and lower 32 bits the window bits of
+ * the bucket. Bucket number identifies buckets that are left over from an
+ * earlier window position.
+ */
+#define IPSEC_AR_WIN_BUCKET_BITS	5
 #define IPSEC_AR_WIN_BUCKET_SIZE	(1 << IPSEC_AR_WIN_BUCKET_BITS)
 #define IPSEC_AR_WIN_BITLOC_MASK	(IPSEC_AR_WIN_BUCKET_SIZE - 1)
 
@@ -126,14 +131,11 @@ struct ipsec_sa_s {
 
 		union {
 			struct {
-				/* AR window lock */
-				odp_spinlock_t lock;
-
 				/* AR window top sequence number */
 				odp_atomic_u64_t wintop_seq;
 
 				/* AR window bucket array */
-				uint64_t bucket_arr[IPSEC_AR_WIN_BUCKET_MAX];
+				odp_atomic_u64_t bucket_arr[IPSEC_AR_WIN_BUCKET_MAX];
 			} in;
 
 			struct {
@@ -256,6 +258,9 @@ struct ipsec_sa_s {
 
 	uint32_t next_sa;
 
+	/* Index + 1 of the next SA in the SPI lookup hash chain, 0 at the end */
+	odp_atomic_u32_t spi_hash_next;
+
 	/* Data stored solely for odp_ipsec_sa_info() */
 	struct {
 		odp_cipher_alg_t cipher_alg;
@@ -381,12 +386,13 @@ int _odp_ipsec_sa_replay_update(ipsec_sa_t *ipsec_sa, uint64_t seq,
 uint16_t _odp_ipsec_sa_alloc_ipv4_id(ipsec_sa_t *ipsec_sa);
 
 /**
- * Try inline IPsec processing of provided packet.
+ * Try inline IPsec processing of a burst of packets.
  *
- * @retval 0 if packet was processed and will be queue using IPsec inline
- *           processing
+ * Packets are updated in place. Processed packets are marked in 'done' and
+ * have their destination queue set. Other packets (e.g. SA lookup failed) are
+ * left for normal packet input processing.
  */
-int _odp_ipsec_try_inline(odp_packet_t *pkt);
+void _odp_ipsec_try_inline_multi(odp_packet_t pkt[], uint8_t done[], int num);
 
 /**
  * Populate number of packets and bytes of data successfully processed by the SA
@@ -11,11 +11,18 @@ extern "C" {
 
 #include <stdint.h>
 
-void *_odp_ishmphy_reserve_single_va(uint64_t len, int fd);
+void *_odp_ishmphy_reserve_single_va(uint64_t len, int fd, uint64_t page_size);
 int   _odp_ishmphy_free_single_va(void);
 void *_odp_ishmphy_map(int fd, uint64_t size, uint64_t offset, int flags);
 int   _odp_ishmphy_unmap(void *start, uint64_t len, int flags);
 
+/* Check if a new mapping of 'len' bytes should be prefaulted in parallel */
+int   _odp_ishmphy_use_prefault(uint64_t len);
+
+/* Fault in (and lock, when requested) pages of a mapping done with _ODP_ISHM_PREFAULT flag.
+ * Uses temporary helper threads, so must not be called while holding shm locks. */
+int   _odp_ishmphy_prefault(void *addr, uint64_t len, uint64_t page_size, int flags);
+
 #ifdef __cplusplus
 }
 #endif
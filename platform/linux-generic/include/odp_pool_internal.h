@@ -31,8 +31,8 @@ extern "C" {
 typedef struct ODP_ALIGNED_CACHE pool_cache_t {
 	/* Number of buffers in cache */
 	odp_atomic_u32_t cache_num;
-	/* Cached buffers */
-	_odp_event_hdr_t *event_hdr[CONFIG_POOL_CACHE_MAX_SIZE];
+	/* Cached buffers. Array size is selected at pool create time. */
+	_odp_event_hdr_t *event_hdr[];
 
 } pool_cache_t;
 
@@ -82,6 +82,9 @@ typedef struct pool_t {
 	uint8_t         *max_addr;
 	uint32_t         ext_head_offset;
 	uint32_t         skipped_blocks;
+	/* Per thread local caches, local_cache_stride bytes per thread */
+	uint8_t         *local_cache;
+	uint32_t         local_cache_stride;
 	odp_pool_param_t params;
 	odp_pool_ext_param_t ext_param;
 
@@ -97,8 +100,6 @@ typedef struct pool_t {
 		odp_atomic_u64_t cache_free_ops;
 	} stats;
 
-	pool_cache_t     local_cache[ODP_THREAD_COUNT_MAX];
-
 	/* --- Control path data --- */
 
 	odp_shm_t        shm;
@@ -22,6 +22,7 @@ extern "C" {
 #include <odp/api/ticketlock.h>
 #include <odp_config_internal.h>
 #include <odp_macros_internal.h>
+#include <odp_queued_lock_internal.h>
 #include <ring/odp_ring_mpmc_ptr_internal.h>
 #include <ring/odp_ring_st_ptr_internal.h>
 #include <ring/odp_ring_spsc_ptr_internal.h>
@@ -60,7 +61,7 @@ typedef struct ODP_ALIGNED_CACHE queue_entry_s {
 	/* MPMC ring (2 cache lines). */
 	ring_mpmc_ptr_t      ring_mpmc;
 
-	odp_ticketlock_t     lock;
+	_odp_lock_t          lock;
 	union {
 		ring_st_ptr_t   ring_st;
 		ring_spsc_ptr_t ring_spsc;
@@ -95,6 +96,7 @@ typedef struct queue_global_t {
 	struct {
 		uint32_t max_queue_size;
 		uint32_t default_queue_size;
+		_odp_lock_type_t lock_type;
 	} config;
 
 } queue_global_t;
@@ -128,6 +130,10 @@ void _odp_queue_spsc_event_aggr_init(queue_entry_t *aggr_queue);
 
 /* Functions for schedulers */
 void _odp_sched_queue_set_status(uint32_t queue_index, int status);
+/* Remove a scheduled queue from scheduling, and add it back. Scheduler holds events of
+ * the queue while it is parked. Enqueue to a parked queue also adds it back. */
+void _odp_sched_queue_park(uint32_t queue_index);
+void _odp_sched_queue_unpark(uint32_t queue_index);
 int _odp_sched_queue_deq(uint32_t queue_index, odp_event_t ev[], int num,
 			 int update_status);
 int _odp_sched_queue_empty(uint32_t queue_index);
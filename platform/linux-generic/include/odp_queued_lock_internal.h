@@ -0,0 +1,174 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/*
+ * Queued spinlock and configurable internal lock
+ *
+ * Queued lock is an MCS style lock where lock waiters form a queue and each
+ * waiter spins on its own per thread wait node. Only the thread at the head of
+ * the queue polls the lock word, which keeps cache line traffic constant
+ * regardless of the number of waiters. Lock word is a single 32-bit flag, so
+ * uncontended lock and unlock are a CAS and a store like with odp_spinlock_t.
+ *
+ * Wait nodes are stored in global shared memory and identified by ODP thread
+ * index. A thread waits for only one lock at a time, so one node per thread
+ * is enough. Non-ODP threads (e.g. service threads) do not have a node and
+ * spin on the lock word directly.
+ */
+
+#ifndef ODP_QUEUED_LOCK_INTERNAL_H_
+#define ODP_QUEUED_LOCK_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/atomic.h>
+#include <odp/api/hints.h>
+#include <odp/api/spinlock.h>
+#include <odp/api/ticketlock.h>
+
+#include <odp/api/plat/atomic_inlines.h>
+#include <odp/api/plat/cpu_inlines.h>
+#include <odp/api/plat/spinlock_inlines.h>
+#include <odp/api/plat/thread_inline_types.h>
+#include <odp/api/plat/ticketlock_inlines.h>
+
+#include <odp_global_data.h>
+
+#include <stdint.h>
+
+typedef struct {
+	/* Lock owner flag */
+	odp_atomic_u32_t locked;
+
+	/* Wait queue tail: 0 when empty, otherwise thread index + 1 */
+	odp_atomic_u32_t tail;
+
+} _odp_qlock_t;
+
+/* Internal lock types selectable from config file */
+typedef enum {
+	_ODP_LOCK_SPIN = 0,
+	_ODP_LOCK_TICKET,
+	_ODP_LOCK_QUEUED,
+
+} _odp_lock_type_t;
+
+#define _ODP_LOCK_TYPE_MAX _ODP_LOCK_QUEUED
+
+typedef union {
+	odp_spinlock_t   spin;
+	odp_ticketlock_t ticket;
+	_odp_qlock_t     queued;
+
+} _odp_lock_t;
+
+static inline void _odp_qlock_init(_odp_qlock_t *lock)
+{
+	odp_atomic_init_u32(&lock->locked, 0);
+	odp_atomic_init_u32(&lock->tail, 0);
+}
+
+static inline int _odp_qlock_trylock(_odp_qlock_t *lock)
+{
+	uint32_t unlocked = 0;
+
+	return odp_atomic_load_u32(&lock->locked) == 0 &&
+	       odp_atomic_cas_acq_u32(&lock->locked, &unlocked, 1);
+}
+
+static inline void _odp_qlock_spin(_odp_qlock_t *lock)
+{
+	while (!_odp_qlock_trylock(lock))
+		odp_cpu_pause();
+}
+
+static inline void _odp_qlock_lock(_odp_qlock_t *lock)
+{
+	_odp_qlock_node_t *node_tbl, *node;
+	uint32_t me, prev, next;
+
+	/* Fast path: free and nobody queuing */
+	if (odp_likely(odp_atomic_load_u32(&lock->tail) == 0 && _odp_qlock_trylock(lock)))
+		return;
+
+	if (odp_unlikely(_odp_this_thread == NULL)) {
+		_odp_qlock_spin(lock);
+		return;
+	}
+
+	node_tbl = odp_global_rw->qlock_node;
+	me = _odp_this_thread->thr + 1;
+	node = &node_tbl[me - 1];
+
+	odp_atomic_store_u32(&node->next, 0);
+	odp_atomic_store_u32(&node->wait, 1);
+
+	/* Join the queue. Release makes node init visible to the previous waiter. */
+	prev = __atomic_exchange_n(&lock->tail.v, me, __ATOMIC_ACQ_REL);
+
+	if (prev) {
+		odp_atomic_store_rel_u32(&node_tbl[prev - 1].next, me);
+
+		/* Wait until previous waiter has taken the lock */
+		while (odp_atomic_load_acq_u32(&node->wait))
+			odp_cpu_pause();
+	}
+
+	/* Head of the queue: wait for the owner to release the lock */
+	_odp_qlock_spin(lock);
+
+	/* Leave the queue. If there are no other waiters, tail is cleared. */
+	prev = me;
+	if (odp_atomic_cas_rel_u32(&lock->tail, &prev, 0))
+		return;
+
+	/* Wait for the next waiter to link itself, and make it the new head */
+	while ((next = odp_atomic_load_acq_u32(&node->next)) == 0)
+		odp_cpu_pause();
+
+	odp_atomic_store_rel_u32(&node_tbl[next - 1].wait, 0);
+}
+
+static inline void _odp_qlock_unlock(_odp_qlock_t *lock)
+{
+	odp_atomic_store_rel_u32(&lock->locked, 0);
+}
+
+static inline void _odp_lock_init(_odp_lock_t *lock, _odp_lock_type_t type)
+{
+	if (type == _ODP_LOCK_QUEUED)
+		_odp_qlock_init(&lock->queued);
+	else if (type == _ODP_LOCK_TICKET)
+		odp_ticketlock_init(&lock->ticket);
+	else
+		odp_spinlock_init(&lock->spin);
+}
+
+static inline void _odp_lock(_odp_lock_t *lock, _odp_lock_type_t type)
+{
+	if (type == _ODP_LOCK_QUEUED)
+		_odp_qlock_lock(&lock->queued);
+	else if (type == _ODP_LOCK_TICKET)
+		odp_ticketlock_lock(&lock->ticket);
+	else
+		odp_spinlock_lock(&lock->spin);
+}
+
+static inline void _odp_unlock(_odp_lock_t *lock, _odp_lock_type_t type)
+{
+	if (type == _ODP_LOCK_QUEUED)
+		_odp_qlock_unlock(&lock->queued);
+	else if (type == _ODP_LOCK_TICKET)
+		odp_ticketlock_unlock(&lock->ticket);
+	else
+		odp_spinlock_unlock(&lock->spin);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,27 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#ifndef ODP_RANDOM_DRBG_INTERNAL_H_
+#define ODP_RANDOM_DRBG_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+int32_t _odp_random_drbg_data(uint8_t *buf, uint32_t len);
+int _odp_random_drbg_init_local(void);
+int _odp_random_drbg_term_local(void);
+
+/* Generate ChaCha20 block with 256-bit key, 32-bit block counter and zero nonce */
+void _odp_chacha20_block(const uint32_t key[8], uint32_t counter, uint8_t out[64]);
+
+/* Set calling thread DRBG key without OS entropy and disable reseeding. For testing only. */
+void _odp_random_drbg_seed(const uint8_t seed[32]);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ODP_RANDOM_DRBG_INTERNAL_H_ */
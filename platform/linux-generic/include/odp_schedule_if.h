@@ -39,6 +39,14 @@ typedef struct schedule_config_t {
 
 } schedule_config_t;
 
+/* Implementation internal ordered sequencing points. Each point is an ordered
+ * lock of the source queue, which is not visible to the application. */
+typedef enum {
+	SCHED_ORDER_SEQ_IPSEC_IN = 0,
+	SCHED_ORDER_SEQ_IPSEC_OUT,
+	SCHED_ORDER_SEQ_NUM
+} schedule_order_seq_t;
+
 typedef void (*schedule_pktio_start_fn_t)(int pktio_index,
 					 int num_in_queue,
 					 int in_queue_idx[],
@@ -61,6 +69,8 @@ typedef int (*schedule_term_local_fn_t)(void);
 typedef void (*schedule_order_lock_fn_t)(void);
 typedef void (*schedule_order_unlock_fn_t)(void);
 typedef void (*schedule_order_unlock_lock_fn_t)(void);
+typedef void (*schedule_order_seq_lock_fn_t)(schedule_order_seq_t seq);
+typedef void (*schedule_order_seq_unlock_fn_t)(schedule_order_seq_t seq);
 typedef uint32_t (*schedule_max_ordered_locks_fn_t)(void);
 typedef void (*schedule_get_config_fn_t)(schedule_config_t *config);
 typedef const _odp_schedule_api_fn_t *(*schedule_sched_api_fn_t)(void);
@@ -81,6 +91,14 @@ typedef struct schedule_fn_t {
 	schedule_order_lock_fn_t    order_lock;
 	schedule_order_unlock_fn_t  order_unlock;
 	schedule_order_unlock_lock_fn_t order_unlock_lock;
+
+	/* Wait until the sequencing point is reached in the order of the current
+	 * ordered context. Holding the point again within the same context is a
+	 * no-op. After order_seq_unlock() the next context may pass the point and
+	 * later calls within the current context do not wait anymore. Both are
+	 * no-ops outside of ordered context. */
+	schedule_order_seq_lock_fn_t order_seq_lock;
+	schedule_order_seq_unlock_fn_t order_seq_unlock;
 	schedule_max_ordered_locks_fn_t max_ordered_locks;
 	schedule_get_config_fn_t        get_config;
 	schedule_sched_api_fn_t		sched_api;
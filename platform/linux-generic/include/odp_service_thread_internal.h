@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#ifndef ODP_SERVICE_THREAD_INTERNAL_H_
+#define ODP_SERVICE_THREAD_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <pthread.h>
+
+/* Maximum number of CPUs in a service thread CPU list */
+#define _ODP_SERVICE_THREAD_MAX_CPUS 64
+
+/*
+ * Start a service thread
+ *
+ * Service threads are implementation internal background threads, started as plain pthreads.
+ * A thread that uses ODP APIs depending on thread local state (e.g. pool caches) must first
+ * register itself with odp_init_local() as an ODP_THREAD_CONTROL thread and call
+ * odp_term_local() before exit. The thread is pinned to 'cpu' when 'cpu' is not negative.
+ * 'name' is optional and limited to 15 characters by the OS.
+ *
+ * Returns 0 on success, <0 on failure.
+ */
+int _odp_service_thread_start(pthread_t *thread, const char *name, int cpu,
+			      void *(*start_fn)(void *), void *arg);
+
+/*
+ * Wait for a service thread to exit
+ *
+ * Returns 0 on success, <0 on failure.
+ */
+int _odp_service_thread_join(pthread_t thread);
+
+/*
+ * Run a function in parallel
+ *
+ * Calls fn(arg, idx, num) once for each 'idx' in 0 ... num - 1. Index zero is run by the calling
+ * thread and the others by temporary service threads, which are spread over control CPUs. If a
+ * service thread cannot be started, its part is run by the calling thread. Returns when all
+ * parts have been completed.
+ */
+void _odp_service_thread_parallel(int num, void (*fn)(void *arg, int idx, int num), void *arg);
+
+/*
+ * Read service thread CPU list from config file
+ *
+ * Reads an integer array config option 'path' into 'cpu' (max 'max_num' elements) and checks
+ * that each listed CPU is available to the process.
+ *
+ * Returns number of CPUs read (0 when the list is empty), or <0 on failure.
+ */
+int _odp_service_thread_cpus(const char *path, int cpu[], int max_num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -19,6 +19,7 @@ extern "C" {
 #define _ODP_ISHM_SINGLE_VA		1
 #define _ODP_ISHM_LOCK			2
 #define _ODP_ISHM_EXPORT		4 /* create export descr file in /tmp */
+#define _ODP_ISHM_PREFAULT		8 /* map only: do not populate or lock pages */
 
 /**
  * Shared memory block info
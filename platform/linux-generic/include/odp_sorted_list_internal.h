@@ -1,6 +1,7 @@
 /* SPDX-License-Identifier: BSD-3-Clause
  * Copyright (c) 2015 EZchip Semiconductor Ltd.
  * Copyright (c) 2015-2018 Linaro Limited
+ * Copyright (c) 2026 Nokia
  */
 
 #ifndef _ODP_INT_SORTED_LIST_H_
@@ -18,7 +19,17 @@ typedef uint32_t _odp_int_sorted_list_t;
 #define _ODP_INT_SORTED_POOL_INVALID  0
 #define _ODP_INT_SORTED_LIST_INVALID  0
 
-_odp_int_sorted_pool_t _odp_sorted_pool_create(uint32_t max_sorted_lists);
+/* Sorted pool implementation types. Linked lists have O(n) insert and O(1)
+ * remove, while binary heaps have O(log n) insert and remove. Both support
+ * the same API, including find and delete by user_data.
+ */
+typedef enum {
+	_ODP_INT_SORTED_POOL_LIST = 0,
+	_ODP_INT_SORTED_POOL_HEAP
+} _odp_int_sorted_pool_type_t;
+
+_odp_int_sorted_pool_t _odp_sorted_pool_create(uint32_t max_sorted_lists,
+					       _odp_int_sorted_pool_type_t type);
 
 _odp_int_sorted_list_t
 _odp_sorted_list_create(_odp_int_sorted_pool_t sorted_pool,
@@ -47,7 +58,8 @@ int _odp_sorted_list_find(_odp_int_sorted_pool_t sorted_pool,
 			  uint64_t              *sort_key_ptr);
 
 /* Deletes a <sort_key, user_data> pair from the given sorted list. Returns 0
- * if the pair is found, otherwise returns -1.
+ * if the pair is found, otherwise returns -1. If multiple entries have the
+ * same user_data, it is undefined which one of those is deleted.
  */
 int _odp_sorted_list_delete(_odp_int_sorted_pool_t sorted_pool,
 			    _odp_int_sorted_list_t sorted_list,
@@ -27,6 +27,7 @@ extern "C" {
 #include <odp_debug_internal.h>
 #include <odp_buffer_internal.h>
 #include <odp_queue_if.h>
+#include <odp_queued_lock_internal.h>
 #include <odp_packet_internal.h>
 
 #include <pthread.h>
@@ -326,7 +327,8 @@ typedef struct {
 	uint32_t          peak_cnt;
 	uint32_t          head_idx;
 	uint32_t          tail_idx;
-	odp_ticketlock_t  lock;
+	_odp_lock_t       lock;
+	_odp_lock_type_t  lock_type;
 	input_work_item_t work_ring[INPUT_WORK_RING_SIZE];
 } input_work_queue_t;
 
@@ -1,11 +1,16 @@
 /* SPDX-License-Identifier: BSD-3-Clause
  * Copyright (c) 2017-2018 Linaro Limited
+ * Copyright (c) 2026 Nokia
  */
 
 /**
  * @file
  *
  * ODP Toeplitz hash function
+ *
+ * Hash input is in network byte order and bits are processed from the most
+ * significant bit of the first byte, as NICs do. This produces the same hash
+ * values as NIC RSS when the same key is used.
  */
 
 #ifndef ODPH_THASH_H_
@@ -15,89 +20,114 @@
 extern "C" {
 #endif
 
-#include <odp/api/align.h>
-#include <odp/api/byteorder.h>
-#include <odp/api/debug.h>
-
-#include <protocols/ip.h>
-
 #include <stdint.h>
 
+/** Hash key length in bytes */
+#define THASH_KEY_LEN 40
+
+/** Maximum hash input length in bytes: IPv6 addresses and L4 ports */
+#define THASH_INPUT_MAX 36
+
+/** Default key (used by many NICs) */
+#define THASH_DEFAULT_KEY { \
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2, \
+	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0, \
+	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4, \
+	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c, \
+	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa}
+
+/** Symmetric key. The key repeats every 16 bits, so swapping source and
+ *  destination addresses and ports does not change the hash value. */
+#define THASH_SYMMETRIC_KEY { \
+	0x6d, 0x5a, 0x6d, 0x5a, 0x6d, 0x5a, 0x6d, 0x5a, \
+	0x6d, 0x5a, 0x6d, 0x5a, 0x6d, 0x5a, 0x6d, 0x5a, \
+	0x6d, 0x5a, 0x6d, 0x5a, 0x6d, 0x5a, 0x6d, 0x5a, \
+	0x6d, 0x5a, 0x6d, 0x5a, 0x6d, 0x5a, 0x6d, 0x5a, \
+	0x6d, 0x5a, 0x6d, 0x5a, 0x6d, 0x5a, 0x6d, 0x5a}
+
 /** rss data type */
 typedef union {
-	uint8_t u8[40];
-	uint32_t u32[10];
+	uint8_t u8[THASH_KEY_LEN];
+	uint32_t u32[THASH_KEY_LEN / 4];
 } rss_key;
 
-/** IPv4 tuple
- *
- */
-typedef struct thash_ipv4_tuple {
-	uint32_t src_addr;
-	uint32_t dst_addr;
-	union {
-		struct {
-			uint16_t sport;
-			uint16_t dport;
-		};
-		uint32_t sctp_tag;
-	};
-} thash_ipv4_tuple_t;
-
-/** IPv6 tuple */
-typedef struct thash_ipv6_tuple {
-	_odp_ipv6_addr_t src_addr;
-	_odp_ipv6_addr_t dst_addr;
-	union {
-		struct {
-			uint16_t sport;
-			uint16_t dport;
-		};
-		uint32_t sctp_tag;
-	};
-} thash_ipv6_tuple_t;
-
-/** Thash tuple union */
-typedef union {
-	thash_ipv4_tuple_t v4;
-	thash_ipv6_tuple_t v6;
-} thash_tuple_t;
+/** Lookup table for byte-wise hash calculation. Entry [i][v] is the hash of
+ *  byte value 'v' at input offset 'i'. */
+typedef struct {
+	uint32_t tbl[THASH_INPUT_MAX][256];
+} thash_tbl_t;
 
-static inline
-void thash_load_ipv6_addr(const _odp_ipv6hdr_t *ipv6,
-			  thash_tuple_t *tuple)
+/** 32 key bits starting from bit offset 'bit' */
+static inline uint32_t thash_key_window(const rss_key *key, uint32_t bit)
 {
+	uint32_t byte = bit / 8;
+	uint64_t val = 0;
 	int i;
 
-	for (i = 0; i < 4; i++) {
-		*(tuple->v6.src_addr.u32 + i) =
-		odp_be_to_cpu_32(*(ipv6->src_addr.u32 + i));
-
-		*(tuple->v6.dst_addr.u32 + i) =
-		odp_be_to_cpu_32(*(ipv6->dst_addr.u32 + i));
+	for (i = 0; i < 5; i++) {
+		val <<= 8;
+		if (byte + i < THASH_KEY_LEN)
+			val |= key->u8[byte + i];
 	}
+
+	return (uint32_t)(val >> (8 - (bit % 8)));
 }
 
-static inline
-uint32_t thash_softrss(uint32_t *tuple, uint8_t len,
-		       const rss_key key)
+/** Reference bit-wise implementation */
+static inline uint32_t thash_calc(const rss_key *key, const uint8_t *data, uint32_t len)
 {
 	uint32_t i, j, ret = 0;
 
-	for (j = 0; j < len; j++) {
-		for (i = 0; i < 32; i++) {
-			if (tuple[j] & (1U << (31 - i))) {
-				ret ^= odp_cpu_to_be_32(((const uint32_t *)
-				key.u32)[j]) << i | (uint32_t)((uint64_t)
-				(odp_cpu_to_be_32(((const uint32_t *)key.u32)
-				[j + 1])) >> (32 - i));
-			}
+	for (i = 0; i < len; i++) {
+		for (j = 0; j < 8; j++) {
+			if (data[i] & (0x80 >> j))
+				ret ^= thash_key_window(key, i * 8 + j);
 		}
 	}
 
 	return ret;
 }
 
+static inline void thash_tbl_init(thash_tbl_t *t, const rss_key *key)
+{
+	uint32_t win[8];
+	uint32_t i, j, v;
+
+	for (i = 0; i < THASH_INPUT_MAX; i++) {
+		for (j = 0; j < 8; j++)
+			win[j] = thash_key_window(key, i * 8 + j);
+
+		for (v = 0; v < 256; v++) {
+			uint32_t hash = 0;
+
+			for (j = 0; j < 8; j++) {
+				if (v & (0x80 >> j))
+					hash ^= win[j];
+			}
+
+			t->tbl[i][v] = hash;
+		}
+	}
+}
+
+/** Table based implementation. Input length must not exceed THASH_INPUT_MAX. */
+static inline uint32_t thash_tbl_calc(const thash_tbl_t *t, const uint8_t *data, uint32_t len)
+{
+	uint32_t hash0 = 0, hash1 = 0;
+	uint32_t i;
+
+	/* Two independent dependency chains */
+	for (i = 0; i + 1 < len; i += 2) {
+		hash0 ^= t->tbl[i][data[i]];
+		hash1 ^= t->tbl[i + 1][data[i + 1]];
+	}
+
+	if (i < len)
+		hash0 ^= t->tbl[i][data[i]];
+
+	return hash0 ^ hash1;
+}
+
 /**
  * @}
  */
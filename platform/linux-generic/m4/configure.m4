@@ -54,6 +54,7 @@ AS_VAR_APPEND([PLAT_CFG_TEXT], ["
 	pcap:                   ${have_pcap}
 	pcapng:                 ${have_pcapng}
 	wfe_locks:              ${use_wfe_locks}
+	max_sched_queues:       ${max_sched_queues}
 	ml_support:             ${ml_support}
 	default_config_path:    ${default_config_path}"])
 
@@ -83,6 +84,7 @@ AC_CONFIG_FILES([platform/linux-generic/Makefile
 		 platform/linux-generic/test/validation/api/shmem/Makefile
 		 platform/linux-generic/test/validation/api/pktio/Makefile
 		 platform/linux-generic/test/validation/api/ml/Makefile
+		 platform/linux-generic/test/validation/api/random/Makefile
 		 platform/linux-generic/test/performance/Makefile
 		 platform/linux-generic/test/performance/dmafwd/Makefile
 		 platform/linux-generic/test/pktio_ipc/Makefile])
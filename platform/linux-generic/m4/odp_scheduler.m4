@@ -12,4 +12,16 @@ AC_ARG_ENABLE([scheduler-default],
 	      [], [enable_scheduler_default=basic])
 AC_DEFINE_UNQUOTED([_ODP_SCHEDULE_DEFAULT], ["$enable_scheduler_default"],
 		   [Define to name default scheduler])
+
+AC_ARG_WITH([max-sched-queues],
+	    [AS_HELP_STRING([--with-max-sched-queues=NUM],
+			    [maximum number of scheduled queues, must be a power of two]
+			    [[default=1024] (linux-generic)])],
+	    [max_sched_queues=$withval], [max_sched_queues=1024])
+AS_CASE([$max_sched_queues],
+	[''|*[[!0-9]]*], [AC_MSG_ERROR([bad value for --with-max-sched-queues: $max_sched_queues])])
+AS_IF([test $max_sched_queues -lt 64 -o $(( max_sched_queues & (max_sched_queues - 1) )) -ne 0],
+      [AC_MSG_ERROR([--with-max-sched-queues must be a power of two and at least 64])])
+AC_DEFINE_UNQUOTED([_ODP_CONFIG_MAX_SCHED_QUEUES], [$max_sched_queues],
+		   [Define to maximum number of scheduled queues])
 ]) # ODP_SCHEDULER
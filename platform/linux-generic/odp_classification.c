@@ -5,20 +5,26 @@
 
 #include <odp/api/classification.h>
 #include <odp/api/align.h>
+#include <odp/api/atomic.h>
 #include <odp/api/debug.h>
+#include <odp/api/hash.h>
 #include <odp/api/hints.h>
 #include <odp/api/packet_io.h>
 #include <odp/api/pool.h>
 #include <odp/api/queue.h>
 #include <odp/api/shared_memory.h>
 #include <odp/api/spinlock.h>
+#include <odp/api/sync.h>
+#include <odp/api/thread.h>
 
 #include <odp_init_internal.h>
 #include <odp_debug_internal.h>
+#include <odp_libconfig_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_packet_internal.h>
 #include <odp_packet_io_internal.h>
 #include <odp_parse_internal.h>
+#include <odp_pool_internal.h>
 #include <odp_classification_datamodel.h>
 #include <odp_classification_internal.h>
 #include <odp_string_internal.h>
@@ -28,6 +34,7 @@
 #include <protocols/udp.h>
 #include <protocols/tcp.h>
 #include <protocols/thash.h>
+#include <ring/odp_ring_mpmc_rst_ptr_internal.h>
 #include <string.h>
 #include <errno.h>
 #include <stdbool.h>
@@ -48,13 +55,11 @@ static _cls_queue_grp_tbl_t *queue_grp_tbl;
 cls_global_t *_odp_cls_global;
 
 static const rss_key default_rss = {
-	.u8 = {
-	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
-	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
-	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
-	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
-	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
-	}
+	.u8 = THASH_DEFAULT_KEY
+};
+
+static const rss_key symmetric_rss = {
+	.u8 = THASH_SYMMETRIC_KEY
 };
 
 static inline uint32_t _odp_cos_to_ndx(odp_cos_t cos)
@@ -89,6 +94,120 @@ pmr_t *get_pmr_entry_internal(odp_pmr_t pmr)
 	return &pmr_tbl->pmr[_odp_pmr_to_ndx(pmr)];
 }
 
+/* Invalidate all flow cache entries */
+static inline void flow_cache_invalidate(void)
+{
+	odp_atomic_inc_u32(&_odp_cls_global->flow_cache.gen);
+}
+
+static int read_config_file(cls_global_t *global)
+{
+	const char *str;
+	int val = 0;
+
+	_ODP_PRINT("Classifier config:\n");
+
+	str = "classifier.flow_cache_size";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > CLS_FLOW_CACHE_MAX) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	global->flow_cache.size = val ? _ODP_ROUNDUP_POWER2_U32(val) : 0;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "classifier.max_hash_queues";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 1 || val > CLS_COS_QUEUE_MAX) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	global->max_hash_queues = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "classifier.rss_symmetric";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > 1) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	global->rss_key = val ? symmetric_rss : default_rss;
+	_ODP_PRINT("  %s: %i\n\n", str, val);
+
+	return 0;
+}
+
+static int flow_cache_init(cls_global_t *global)
+{
+	odp_shm_t shm;
+	uint64_t size;
+
+	global->flow_cache.shm = ODP_SHM_INVALID;
+	global->flow_cache.entry = NULL;
+	odp_atomic_init_u32(&global->flow_cache.gen, 0);
+	odp_atomic_init_u32(&global->flow_cache.num_no_cache_pmr, 0);
+
+	if (global->flow_cache.size == 0)
+		return 0;
+
+	size = (uint64_t)CONFIG_PKTIO_ENTRIES * global->flow_cache.size *
+		sizeof(cls_flow_entry_t);
+
+	shm = odp_shm_reserve("_odp_cls_flow_cache", size, ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Flow cache shm reserve failed\n");
+		return -1;
+	}
+
+	global->flow_cache.shm = shm;
+	global->flow_cache.entry = odp_shm_addr(shm);
+	memset(global->flow_cache.entry, 0, size);
+
+	return 0;
+}
+
+static int queue_stats_init(cls_global_t *global)
+{
+	odp_shm_t shm;
+	cls_stats_t *stats;
+	uint64_t size;
+	int i;
+
+	/* Statistics are allocated only for the configured number of hash queues, instead of the
+	 * CLS_COS_QUEUE_MAX maximum. */
+	size = (uint64_t)CLS_COS_MAX_ENTRY * global->max_hash_queues * sizeof(cls_stats_t);
+
+	shm = odp_shm_reserve("_odp_cls_queue_stats", size, ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Queue stats shm reserve failed\n");
+		return -1;
+	}
+
+	global->queue_stats_shm = shm;
+	stats = odp_shm_addr(shm);
+	memset(stats, 0, size);
+
+	for (i = 0; i < CLS_COS_MAX_ENTRY; i++)
+		global->cos_tbl.cos_entry[i].queue_stats = &stats[i * global->max_hash_queues];
+
+	return 0;
+}
+
 int _odp_classification_init_global(void)
 {
 	odp_shm_t shm;
@@ -106,6 +225,19 @@ int _odp_classification_init_global(void)
 	cos_tbl       = &_odp_cls_global->cos_tbl;
 	pmr_tbl       = &_odp_cls_global->pmr_tbl;
 	queue_grp_tbl = &_odp_cls_global->queue_grp_tbl;
+	_odp_cls_global->flow_cache.shm = ODP_SHM_INVALID;
+	_odp_cls_global->queue_stats_shm = ODP_SHM_INVALID;
+
+	if (read_config_file(_odp_cls_global) || flow_cache_init(_odp_cls_global) ||
+	    queue_stats_init(_odp_cls_global)) {
+		if (_odp_cls_global->flow_cache.shm != ODP_SHM_INVALID)
+			odp_shm_free(_odp_cls_global->flow_cache.shm);
+		odp_shm_free(shm);
+		_odp_cls_global = NULL;
+		return -1;
+	}
+
+	thash_tbl_init(&_odp_cls_global->thash, &_odp_cls_global->rss_key);
 
 	for (i = 0; i < CLS_COS_MAX_ENTRY; i++) {
 		/* init locks */
@@ -126,6 +258,18 @@ int _odp_classification_init_global(void)
 
 int _odp_classification_term_global(void)
 {
+	if (_odp_cls_global && _odp_cls_global->queue_stats_shm != ODP_SHM_INVALID &&
+	    odp_shm_free(_odp_cls_global->queue_stats_shm)) {
+		_ODP_ERR("shm free failed\n");
+		return -1;
+	}
+
+	if (_odp_cls_global && _odp_cls_global->flow_cache.shm != ODP_SHM_INVALID &&
+	    odp_shm_free(_odp_cls_global->flow_cache.shm)) {
+		_ODP_ERR("shm free failed\n");
+		return -1;
+	}
+
 	if (_odp_cls_global && odp_shm_free(_odp_cls_global->shm)) {
 		_ODP_ERR("shm free failed\n");
 		return -1;
@@ -181,11 +325,13 @@ int odp_cls_capability(odp_cls_capability_t *capability)
 	capability->supported_terms.bit.ipsec_spi = 1;
 	capability->supported_terms.bit.custom_frame = 1;
 	capability->supported_terms.bit.custom_l3 = 1;
-	capability->random_early_detection = ODP_SUPPORT_NO;
+	capability->random_early_detection = ODP_SUPPORT_YES;
 	capability->back_pressure = ODP_SUPPORT_NO;
 	capability->threshold_red.all_bits = 0;
+	capability->threshold_red.percent = 1;
+	capability->threshold_red.packet = 1;
 	capability->threshold_bp.all_bits = 0;
-	capability->max_hash_queues = CLS_COS_QUEUE_MAX;
+	capability->max_hash_queues = _odp_cls_global->max_hash_queues;
 	capability->hash_protocols.proto.ipv4_udp = 1;
 	capability->hash_protocols.proto.ipv4_tcp = 1;
 	capability->hash_protocols.proto.ipv4 = 1;
@@ -230,6 +376,30 @@ static inline void _cls_queue_unwind(uint32_t tbl_index, uint32_t j)
 		odp_queue_destroy(queue_grp_tbl->queue[tbl_index + --j]);
 }
 
+static int red_param_check(const odp_red_param_t *red)
+{
+	const odp_threshold_t *th = &red->threshold;
+
+	if (th->type == ODP_THRESHOLD_PERCENT) {
+		if (th->percent.max > 10000 || th->percent.min > th->percent.max) {
+			_ODP_ERR("Bad RED percent threshold: min %u, max %u\n",
+				 th->percent.min, th->percent.max);
+			return -1;
+		}
+	} else if (th->type == ODP_THRESHOLD_PACKET) {
+		if (th->packet.min > th->packet.max) {
+			_ODP_ERR("Bad RED packet threshold: min %" PRIu64 ", max %" PRIu64 "\n",
+				 th->packet.min, th->packet.max);
+			return -1;
+		}
+	} else {
+		_ODP_ERR("RED threshold type not supported: %i\n", th->type);
+		return -1;
+	}
+
+	return 0;
+}
+
 odp_cos_t odp_cls_cos_create(const char *name, const odp_cls_cos_param_t *param_in)
 {
 	uint32_t i, j;
@@ -250,7 +420,7 @@ odp_cos_t odp_cls_cos_create(const char *name, const odp_cls_cos_param_t *param_
 	}
 
 	/* num_queue should not be zero */
-	if (param.num_queue > CLS_COS_QUEUE_MAX || param.num_queue < 1)
+	if (param.num_queue > _odp_cls_global->max_hash_queues || param.num_queue < 1)
 		return ODP_COS_INVALID;
 
 	event_aggr_enabled = (param.num_queue == 1 && param.queue != ODP_QUEUE_INVALID &&
@@ -289,6 +459,9 @@ odp_cos_t odp_cls_cos_create(const char *name, const odp_cls_cos_param_t *param_
 	if (param.aggr_enq_profile.type != ODP_AEP_TYPE_NONE)
 		return ODP_COS_INVALID;
 
+	if (param.red.enable && red_param_check(&param.red))
+		return ODP_COS_INVALID;
+
 	for (i = 0; i < CLS_COS_MAX_ENTRY; i++) {
 		cos = &cos_tbl->cos_entry[i];
 		LOCK(&cos->lock);
@@ -358,6 +531,20 @@ odp_cos_t odp_cls_cos_create(const char *name, const odp_cls_cos_param_t *param_
 			cos->vector.use_std_enq = !param.vector.enable;
 			cos->vector.use_aggr = event_aggr_enabled && param.num_queue > 1;
 
+			cos->red.enable = param.red.enable;
+			if (param.red.enable) {
+				const odp_threshold_t *th = &param.red.threshold;
+
+				cos->red.type = th->type;
+				if (th->type == ODP_THRESHOLD_PERCENT) {
+					cos->red.min = th->percent.min;
+					cos->red.max = th->percent.max;
+				} else {
+					cos->red.min = th->packet.min;
+					cos->red.max = th->packet.max;
+				}
+			}
+
 			cos->stats_enable = param.stats_enable;
 			UNLOCK(&cos->lock);
 			return _odp_cos_from_ndx(i);
@@ -397,9 +584,7 @@ static inline odp_queue_t get_dest_queue(const cos_t *cos, odp_packet_hdr_t *pkt
 {
 	uint32_t hash = packet_rss_hash(pkt_hdr, cos->hash_proto, base), tbl_index;
 
-	/* CLS_COS_QUEUE_MAX is a power of 2 */
-	hash = hash & (CLS_COS_QUEUE_MAX - 1);
-	tbl_index = (cos->index * CLS_COS_QUEUE_MAX) + (hash % cos->num_queue);
+	tbl_index = (cos->index * CLS_COS_QUEUE_MAX) + _odp_cls_rss_queue(hash, cos->num_queue);
 
 	return queue_grp_tbl->queue[tbl_index];
 }
@@ -497,6 +682,7 @@ int odp_cos_destroy(odp_cos_t cos_id)
 		_cls_queue_unwind(cos->index * CLS_COS_QUEUE_MAX, cos->num_queue);
 
 	cos->valid = 0;
+	flow_cache_invalidate();
 	return 0;
 }
 
@@ -620,6 +806,7 @@ int odp_pktio_default_cos_set(odp_pktio_t pktio_in, odp_cos_t default_cos)
 	}
 
 	entry->cls.default_cos = cos;
+	flow_cache_invalidate();
 	return 0;
 }
 
@@ -667,6 +854,30 @@ int odp_pktio_headroom_set(odp_pktio_t pktio_in, uint32_t headroom)
 	return 0;
 }
 
+/* Flow cache key contains all packet fields that these terms match on */
+static inline int pmr_term_flow_cacheable(odp_cls_pmr_term_t term)
+{
+	switch (term) {
+	case ODP_PMR_ETHTYPE_0:
+	case ODP_PMR_ETHTYPE_X:
+	case ODP_PMR_VLAN_ID_0:
+	case ODP_PMR_VLAN_ID_X:
+	case ODP_PMR_VLAN_PCP_0:
+	case ODP_PMR_IPPROTO:
+	case ODP_PMR_UDP_DPORT:
+	case ODP_PMR_TCP_DPORT:
+	case ODP_PMR_UDP_SPORT:
+	case ODP_PMR_TCP_SPORT:
+	case ODP_PMR_SIP_ADDR:
+	case ODP_PMR_DIP_ADDR:
+	case ODP_PMR_SIP6_ADDR:
+	case ODP_PMR_DIP6_ADDR:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
 static int pmr_create_term(pmr_term_value_t *value,
 			   const odp_pmr_param_t *param)
 {
@@ -788,7 +999,10 @@ int odp_cls_pmr_destroy(odp_pmr_t pmr_id)
 
 no_rule:
 	pmr->valid = 0;
+	if (pmr->no_flow_cache)
+		odp_atomic_dec_u32(&_odp_cls_global->flow_cache.num_no_cache_pmr);
 	UNLOCK(&src_cos->lock);
+	flow_cache_invalidate();
 	return 0;
 }
 
@@ -838,22 +1052,30 @@ static odp_pmr_t cls_pmr_create(const odp_pmr_param_t *terms, int num_terms, uin
 		return id;
 
 	pmr->num_pmr = num_terms;
+	pmr->no_flow_cache = 0;
 	for (i = 0; i < num_terms; i++) {
 		if (pmr_create_term(&pmr->pmr_term_value[i], &terms[i])) {
 			pmr->valid = 0;
 			UNLOCK(&pmr->lock);
 			return ODP_PMR_INVALID;
 		}
+
+		if (!pmr_term_flow_cacheable(terms[i].term))
+			pmr->no_flow_cache = 1;
 	}
 
 	pmr->mark = mark;
 
+	if (pmr->no_flow_cache)
+		odp_atomic_inc_u32(&_odp_cls_global->flow_cache.num_no_cache_pmr);
+
 	loc = odp_atomic_fetch_inc_u32(&cos_src->num_rule);
 	cos_src->pmr[loc] = pmr;
 	cos_src->linked_cos[loc] = cos_dst;
 	pmr->src_cos = cos_src;
 
 	UNLOCK(&pmr->lock);
+	flow_cache_invalidate();
 	return id;
 }
 
@@ -1620,10 +1842,14 @@ static inline void pmr_debug_print(pmr_t *pmr, cos_t *cos)
 /*
  * Match a PMR chain with a Packet and return matching CoS
  * This function performs a depth-first search in the CoS tree.
+ * Indexes of the matched CoSes are stored into 'path' (when not NULL). 'num_path' is set
+ * above CLS_FLOW_CACHE_PATH_MAX when the path does not fit.
  */
-static cos_t *match_pmr_cos(cos_t *cos, const uint8_t *pkt_addr, odp_packet_hdr_t *hdr)
+static inline cos_t *match_pmr_cos(cos_t *cos, const uint8_t *pkt_addr, odp_packet_hdr_t *hdr,
+				   uint8_t path[], uint32_t *num_path)
 {
 	pmr_t *pmr_match = NULL;
+	uint32_t num = 0;
 
 	while (1) {
 		uint32_t i, num_rule = odp_atomic_load_u32(&cos->num_rule);
@@ -1646,6 +1872,10 @@ static cos_t *match_pmr_cos(cos_t *cos, const uint8_t *pkt_addr, odp_packet_hdr_
 				if (cos->stats_enable)
 					odp_atomic_inc_u64(&cos->stats.packets);
 
+				if (path && num < CLS_FLOW_CACHE_PATH_MAX)
+					path[num] = cos->index;
+				num++;
+
 				break;
 			}
 		}
@@ -1663,6 +1893,9 @@ static cos_t *match_pmr_cos(cos_t *cos, const uint8_t *pkt_addr, odp_packet_hdr_
 		}
 	}
 
+	if (num_path)
+		*num_path = num;
+
 	return cos;
 }
 
@@ -1678,10 +1911,184 @@ int _odp_pktio_classifier_init(pktio_entry_t *entry)
 	cls->default_cos = NULL;
 	cls->headroom = 0;
 	cls->skip = 0;
+	cls->flow_cache = NULL;
+	odp_atomic_init_u64(&cls->flow_cache_hits, 0);
+	odp_atomic_init_u64(&cls->flow_cache_misses, 0);
+
+	if (_odp_cls_global->flow_cache.size) {
+		uint32_t size = _odp_cls_global->flow_cache.size;
+
+		cls->flow_cache = &_odp_cls_global->flow_cache.entry[odp_pktio_index(entry->handle) *
+								     size];
+		/* Entries of a previous pktio instance are not valid anymore */
+		flow_cache_invalidate();
+	}
 
 	return 0;
 }
 
+/* Fill flow cache key. Returns 0 when the packet is not cacheable. */
+static inline int flow_cache_key(const uint8_t *pkt_addr, odp_packet_hdr_t *pkt_hdr,
+				 cls_flow_key_t *key)
+{
+	const _odp_ethhdr_t *eth;
+	const _odp_vlanhdr_t *vlan;
+	const _odp_udphdr_t *udp;
+	const _odp_tcphdr_t *tcp;
+
+	if (!packet_hdr_has_eth(pkt_hdr) || pkt_hdr->p.input_flags.ipfrag ||
+	    !(pkt_hdr->p.input_flags.ipv4 || pkt_hdr->p.input_flags.ipv6) ||
+	    !(pkt_hdr->p.input_flags.tcp || pkt_hdr->p.input_flags.udp))
+		return 0;
+
+	memset(key, 0, sizeof(cls_flow_key_t));
+
+	eth = (const _odp_ethhdr_t *)(pkt_addr + pkt_hdr->p.l2_offset);
+	key->ethtype[0] = eth->type;
+
+	if (pkt_hdr->p.input_flags.vlan || pkt_hdr->p.input_flags.vlan_qinq) {
+		vlan = (const _odp_vlanhdr_t *)(eth + 1);
+		key->vlan_tci[0] = vlan->tci;
+
+		if (pkt_hdr->p.input_flags.vlan_qinq)
+			vlan++;
+
+		key->vlan_tci[1] = vlan->tci;
+		key->ethtype[1] = vlan->type;
+	}
+
+	key->flags = pkt_hdr->p.input_flags.vlan |
+		     pkt_hdr->p.input_flags.vlan_qinq << 1 |
+		     pkt_hdr->p.input_flags.ipv6 << 2 |
+		     pkt_hdr->p.input_flags.tcp << 3;
+
+	if (pkt_hdr->p.input_flags.ipv4) {
+		const _odp_ipv4hdr_t *ipv4 = (const _odp_ipv4hdr_t *)(pkt_addr +
+								       pkt_hdr->p.l3_offset);
+
+		key->src_addr[0] = ipv4->src_addr;
+		key->dst_addr[0] = ipv4->dst_addr;
+		key->proto = ipv4->proto;
+	} else {
+		const _odp_ipv6hdr_t *ipv6 = (const _odp_ipv6hdr_t *)(pkt_addr +
+								       pkt_hdr->p.l3_offset);
+
+		memcpy(key->src_addr, &ipv6->src_addr, _ODP_IPV6ADDR_LEN);
+		memcpy(key->dst_addr, &ipv6->dst_addr, _ODP_IPV6ADDR_LEN);
+		key->proto = ipv6->next_hdr;
+	}
+
+	if (pkt_hdr->p.input_flags.tcp) {
+		tcp = (const _odp_tcphdr_t *)(pkt_addr + pkt_hdr->p.l4_offset);
+		key->src_port = tcp->src_port;
+		key->dst_port = tcp->dst_port;
+	} else {
+		udp = (const _odp_udphdr_t *)(pkt_addr + pkt_hdr->p.l4_offset);
+		key->src_port = udp->src_port;
+		key->dst_port = udp->dst_port;
+	}
+
+	return 1;
+}
+
+/* Returns 1 and copies the result on a cache hit, otherwise 0 */
+static inline int flow_cache_read(cls_flow_entry_t *entry, const cls_flow_key_t *key,
+				  uint32_t gen, cls_flow_entry_t *result)
+{
+	uint32_t seq = odp_atomic_load_acq_u32(&entry->seq);
+
+	if (seq & 1)
+		return 0;
+
+	if (entry->gen != gen || memcmp(&entry->key, key, sizeof(cls_flow_key_t)))
+		return 0;
+
+	result->mark = entry->mark;
+	result->num_path = entry->num_path;
+	memcpy(result->path, entry->path, sizeof(result->path));
+
+	/* Entry data must be read before the sequence number is checked again */
+	odp_mb_acquire();
+
+	return odp_atomic_load_u32(&entry->seq) == seq;
+}
+
+static inline void flow_cache_write(cls_flow_entry_t *entry, const cls_flow_key_t *key,
+				    uint32_t gen, uint16_t mark, const uint8_t path[],
+				    uint32_t num_path)
+{
+	uint32_t seq = odp_atomic_load_u32(&entry->seq);
+
+	/* Skip update if another thread is writing the entry */
+	if ((seq & 1) || !odp_atomic_cas_acq_u32(&entry->seq, &seq, seq + 1))
+		return;
+
+	entry->gen = gen;
+	entry->key = *key;
+	entry->mark = mark;
+	entry->num_path = num_path;
+	memcpy(entry->path, path, num_path);
+
+	odp_atomic_store_rel_u32(&entry->seq, seq + 2);
+}
+
+/*
+ * Match a packet against PMRs of the default CoS through the flow cache. Packets of the same
+ * flow produce the same result as long as all PMRs match only on fields of the flow key and
+ * classifier configuration is not changed (generation counter).
+ */
+static inline cos_t *flow_cache_match_pmr_cos(classifier_t *cls, cos_t *default_cos,
+					      const uint8_t *pkt_addr,
+					      odp_packet_hdr_t *pkt_hdr)
+{
+	cls_flow_key_t key;
+	cls_flow_entry_t result;
+	cls_flow_entry_t *entry;
+	uint32_t gen, num_path, i;
+	cos_t *cos = default_cos;
+
+	if (odp_atomic_load_u32(&_odp_cls_global->flow_cache.num_no_cache_pmr) ||
+	    !flow_cache_key(pkt_addr, pkt_hdr, &key))
+		return match_pmr_cos(default_cos, pkt_addr, pkt_hdr, NULL, NULL);
+
+	gen = odp_atomic_load_u32(&_odp_cls_global->flow_cache.gen);
+	i = odp_hash_crc32c(&key, sizeof(key), 0) & (_odp_cls_global->flow_cache.size - 1);
+	entry = &cls->flow_cache[i];
+
+	if (odp_likely(flow_cache_read(entry, &key, gen, &result))) {
+		odp_atomic_inc_u64(&cls->flow_cache_hits);
+		pkt_hdr->p.input_flags.cls_mark = 0;
+
+		if (result.num_path == 0)
+			return default_cos;
+
+		for (i = 0; i < result.num_path; i++) {
+			cos = _odp_cos_entry_from_idx(result.path[i]);
+
+			if (cos->stats_enable)
+				odp_atomic_inc_u64(&cos->stats.packets);
+		}
+
+		if (result.mark) {
+			pkt_hdr->p.input_flags.cls_mark = 1;
+			pkt_hdr->cls_mark = result.mark;
+		}
+
+		return cos;
+	}
+
+	odp_atomic_inc_u64(&cls->flow_cache_misses);
+
+	cos = match_pmr_cos(default_cos, pkt_addr, pkt_hdr, result.path, &num_path);
+
+	if (num_path <= CLS_FLOW_CACHE_PATH_MAX)
+		flow_cache_write(entry, &key, gen,
+				 (num_path && pkt_hdr->p.input_flags.cls_mark) ?
+				 pkt_hdr->cls_mark : 0, result.path, num_path);
+
+	return cos;
+}
+
 /**
 Select a CoS for the given Packet based on pktio
 
@@ -1710,7 +2117,11 @@ static inline cos_t *cls_select_cos(pktio_entry_t *entry,
 
 	/* Calls all the PMRs attached at the PKTIO level*/
 	if (default_cos && default_cos->valid) {
-		cos = match_pmr_cos(default_cos, pkt_addr, pkt_hdr);
+		if (cls->flow_cache)
+			cos = flow_cache_match_pmr_cos(cls, default_cos, pkt_addr, pkt_hdr);
+		else
+			cos = match_pmr_cos(default_cos, pkt_addr, pkt_hdr, NULL, NULL);
+
 		if (cos && cos != default_cos)
 			return cos;
 	}
@@ -1725,6 +2136,47 @@ done:
 	return cos;
 }
 
+/* Per thread state of RED random number generator */
+static __thread uint32_t red_rand_state;
+
+static inline uint32_t red_rand(void)
+{
+	uint32_t x = red_rand_state;
+
+	if (odp_unlikely(x == 0))
+		x = (odp_thread_id() + 1) * 0x9e3779b9;
+
+	/* Xorshift32 */
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	red_rand_state = x;
+
+	return x;
+}
+
+/*
+ * Random early drop based on the number of packets in use from the destination pool. Packets
+ * held in thread local pool caches are counted as used.
+ */
+static inline int red_drop(const cos_t *cos, odp_pool_t pool_hdl)
+{
+	const pool_t *pool = _odp_pool_entry(pool_hdl);
+	uint64_t used = pool->num - ring_mpmc_rst_ptr_len(&pool->ring->hdr);
+
+	if (cos->red.type == ODP_THRESHOLD_PERCENT)
+		used = (used * 10000) / pool->num;
+
+	if (used >= cos->red.max)
+		return 1;
+
+	if (used <= cos->red.min)
+		return 0;
+
+	/* Drop probability increases linearly from min to max threshold */
+	return (red_rand() % (cos->red.max - cos->red.min)) < (used - cos->red.min);
+}
+
 /**
  * Classify packet
  *
@@ -1760,12 +2212,17 @@ int _odp_cls_classify_packet(pktio_entry_t *entry, const uint8_t *base,
 
 	pkt_hdr->cos = cos->index;
 
-	if (!cos->queue_group) {
+	if (!cos->queue_group)
 		pkt_hdr->dst_queue = cos->queue;
-		return 0;
-	}
+	else
+		pkt_hdr->dst_queue = get_dest_queue(cos, pkt_hdr, base);
 
-	pkt_hdr->dst_queue = get_dest_queue(cos, pkt_hdr, base);
+	if (odp_unlikely(cos->red.enable) && red_drop(cos, *pool)) {
+		if (cos->stats_enable)
+			odp_atomic_inc_u64(&cos->stats.discards);
+		_odp_cos_queue_stats_add(cos, pkt_hdr->dst_queue, 0, 1);
+		return 1;
+	}
 
 	return 0;
 }
@@ -1774,68 +2231,42 @@ static uint32_t packet_rss_hash(odp_packet_hdr_t *pkt_hdr,
 				odp_cls_hash_proto_t hash_proto,
 				const uint8_t *base)
 {
-	thash_tuple_t tuple;
-	const _odp_ipv4hdr_t *ipv4;
-	const _odp_udphdr_t *udp;
-	const _odp_tcphdr_t *tcp;
-	const _odp_ipv6hdr_t *ipv6;
-	uint32_t hash;
-	uint32_t tuple_len;
+	uint8_t data[THASH_INPUT_MAX];
+	uint32_t len = 0;
 
-	tuple_len = 0;
-	hash = 0;
 	if (pkt_hdr->p.input_flags.ipv4) {
 		if (hash_proto.ipv4) {
-			/* add ipv4 */
-			ipv4 = (const _odp_ipv4hdr_t *)(base +
-				pkt_hdr->p.l3_offset);
-			tuple.v4.src_addr = ipv4->src_addr;
-			tuple.v4.dst_addr = ipv4->dst_addr;
-			tuple_len += 2;
-		}
+			const _odp_ipv4hdr_t *ipv4 = (const _odp_ipv4hdr_t *)(base +
+									       pkt_hdr->p.l3_offset);
 
-		if (pkt_hdr->p.input_flags.tcp && hash_proto.tcp) {
-			/* add tcp */
-			tcp = (const _odp_tcphdr_t *)(base +
-			       pkt_hdr->p.l4_offset);
-			tuple.v4.sport = tcp->src_port;
-			tuple.v4.dport = tcp->dst_port;
-			tuple_len += 1;
-		} else if (pkt_hdr->p.input_flags.udp && hash_proto.udp) {
-			/* add udp */
-			udp = (const _odp_udphdr_t *)(base +
-			       pkt_hdr->p.l4_offset);
-			tuple.v4.sport = udp->src_port;
-			tuple.v4.dport = udp->dst_port;
-			tuple_len += 1;
+			memcpy(data, &ipv4->src_addr, _ODP_IPV4ADDR_LEN);
+			memcpy(&data[_ODP_IPV4ADDR_LEN], &ipv4->dst_addr, _ODP_IPV4ADDR_LEN);
+			len = 2 * _ODP_IPV4ADDR_LEN;
 		}
 	} else if (pkt_hdr->p.input_flags.ipv6) {
 		if (hash_proto.ipv6) {
-			/* add ipv6 */
-			ipv6 = (const _odp_ipv6hdr_t *)(base +
-				pkt_hdr->p.l3_offset);
-			thash_load_ipv6_addr(ipv6, &tuple);
-			tuple_len += 8;
-		}
-		if (pkt_hdr->p.input_flags.tcp && hash_proto.tcp) {
-			tcp = (const _odp_tcphdr_t *)(base +
-			       pkt_hdr->p.l4_offset);
-			tuple.v6.sport = tcp->src_port;
-			tuple.v6.dport = tcp->dst_port;
-			tuple_len += 1;
-		} else if (pkt_hdr->p.input_flags.udp && hash_proto.udp) {
-			/* add udp */
-			udp = (const _odp_udphdr_t *)(base +
-			       pkt_hdr->p.l4_offset);
-			tuple.v6.sport = udp->src_port;
-			tuple.v6.dport = udp->dst_port;
-			tuple_len += 1;
+			const _odp_ipv6hdr_t *ipv6 = (const _odp_ipv6hdr_t *)(base +
+									       pkt_hdr->p.l3_offset);
+
+			memcpy(data, &ipv6->src_addr, _ODP_IPV6ADDR_LEN);
+			memcpy(&data[_ODP_IPV6ADDR_LEN], &ipv6->dst_addr, _ODP_IPV6ADDR_LEN);
+			len = 2 * _ODP_IPV6ADDR_LEN;
 		}
+	} else {
+		return 0;
+	}
+
+	if ((pkt_hdr->p.input_flags.tcp && hash_proto.tcp) ||
+	    (pkt_hdr->p.input_flags.udp && hash_proto.udp)) {
+		/* Source and destination ports are the first four bytes of TCP and UDP headers */
+		memcpy(&data[len], base + pkt_hdr->p.l4_offset, 2 * sizeof(uint16_t));
+		len += 2 * sizeof(uint16_t);
 	}
-	if (tuple_len)
-		hash = thash_softrss((uint32_t *)&tuple,
-				     tuple_len, default_rss);
-	return hash;
+
+	if (len == 0)
+		return 0;
+
+	return _odp_cls_rss_hash(data, len);
 }
 
 uint64_t odp_cos_to_u64(odp_cos_t hdl)
@@ -1869,6 +2300,49 @@ int odp_cls_cos_stats(odp_cos_t hdl, odp_cls_cos_stats_t *stats)
 	return 0;
 }
 
+static const char * const flow_cache_stat_name[] = {"cls_flow_cache_hits",
+						      "cls_flow_cache_misses"};
+
+int _odp_cls_extra_stat_info(pktio_entry_t *entry, odp_pktio_extra_stat_info_t info[], int num)
+{
+	int i;
+
+	if (entry->cls.flow_cache == NULL)
+		return 0;
+
+	for (i = 0; i < num && i < (int)_ODP_ARRAY_SIZE(flow_cache_stat_name); i++)
+		_odp_strcpy(info[i].name, flow_cache_stat_name[i],
+			    ODP_PKTIO_STATS_EXTRA_NAME_LEN);
+
+	return _ODP_ARRAY_SIZE(flow_cache_stat_name);
+}
+
+int _odp_cls_extra_stats(pktio_entry_t *entry, uint64_t stats[], int num)
+{
+	if (entry->cls.flow_cache == NULL)
+		return 0;
+
+	if (num > 0)
+		stats[0] = odp_atomic_load_u64(&entry->cls.flow_cache_hits);
+	if (num > 1)
+		stats[1] = odp_atomic_load_u64(&entry->cls.flow_cache_misses);
+
+	return _ODP_ARRAY_SIZE(flow_cache_stat_name);
+}
+
+int _odp_cls_extra_stat_counter(pktio_entry_t *entry, uint32_t id, uint64_t *stat)
+{
+	if (entry->cls.flow_cache == NULL || id >= _ODP_ARRAY_SIZE(flow_cache_stat_name))
+		return -1;
+
+	if (id == 0)
+		*stat = odp_atomic_load_u64(&entry->cls.flow_cache_hits);
+	else
+		*stat = odp_atomic_load_u64(&entry->cls.flow_cache_misses);
+
+	return 0;
+}
+
 int odp_cls_queue_stats(odp_cos_t hdl, odp_queue_t queue,
 			odp_cls_queue_stats_t *stats)
 {
@@ -1947,6 +2421,11 @@ void cls_print_cos(cos_t *cos)
 			print_queue_ident(queue_grp_tbl->queue[tbl_index + i]);
 	}
 
+	if (cos->red.enable)
+		_ODP_PRINT("    red: %s min %" PRIu64 " max %" PRIu64 "\n",
+			   cos->red.type == ODP_THRESHOLD_PERCENT ? "percent" : "packet",
+			   cos->red.min, cos->red.max);
+
 	for (uint32_t j = 0; j < num_rule; j++) {
 		pmr_t *pmr = cos->pmr[j];
 
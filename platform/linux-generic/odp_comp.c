@@ -1,26 +1,58 @@
 /* SPDX-License-Identifier: BSD-3-Clause
  * Copyright (c) 2018 Linaro Limited
+ * Copyright (c) 2026 Nokia
  */
 
+#include <odp_posix_extensions.h>
+
+#include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 #include <odp/api/comp.h>
 #include <odp/api/event.h>
+#include <odp/api/init.h>
 #include <odp/api/packet.h>
 #include <odp/api/queue.h>
+#include <odp/api/ticketlock.h>
 
+#include <odp/api/plat/atomic_inlines.h>
+#include <odp/api/plat/cpu_inlines.h>
 #include <odp/api/plat/strong_types.h>
 
 #include <odp_debug_internal.h>
 #include <odp_global_data.h>
 #include <odp_init_internal.h>
+#include <odp_libconfig_internal.h>
+#include <odp_macros_internal.h>
 #include <odp_packet_internal.h>
+#include <odp_service_thread_internal.h>
+#include <ring/odp_ring_mpmc_u32_internal.h>
+#include <ring/odp_ring_mpsc_u32_internal.h>
 
 #include "miniz/miniz.h"
 
 #define MAX_SESSIONS  16
 #define MEM_LEVEL   8
 
+/* Maximum number of compression worker threads */
+#define MAX_WORKERS 32
+
+/* Number of offloaded operations shared by all sessions. Must be a power of two. */
+#define MAX_REQS 1024
+
+/* Number of requests a worker thread dequeues at a time */
+#define WORKER_BURST 8
+
+/* Number of empty polls before a worker thread starts sleeping between polls */
+#define WORKER_IDLE_POLLS 10000
+
+/* Worker thread sleep time when idle */
+#define WORKER_IDLE_SLEEP_NS 10000
+
+ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(MAX_REQS), "MAX_REQS not a power of two");
+
 /** Forward declaration of session structure */
 typedef struct odp_comp_generic_session odp_comp_generic_session_t;
 
@@ -41,6 +73,10 @@ int (*comp_func_t)(odp_packet_t pkt_in,
 struct odp_comp_generic_session {
 	struct odp_comp_generic_session *next;
 	odp_comp_session_param_t        params;
+	/* Number of offloaded operations not yet completed */
+	odp_atomic_u32_t                num_pending;
+	/* Worker thread serving this session */
+	uint32_t                        worker;
 	struct {
 		comp_func_t func;
 		mz_stream stream;
@@ -51,10 +87,45 @@ struct odp_comp_generic_session {
 	} comp;
 };
 
+/* Operation offloaded to a worker thread */
+typedef struct comp_req_t {
+	odp_packet_t pkt_in;
+	odp_packet_t pkt_out;
+	odp_comp_packet_op_param_t param;
+} comp_req_t;
+
+typedef struct ODP_ALIGNED_CACHE comp_worker_t {
+	/* Requests queued to this thread */
+	ring_mpsc_u32_t ring;
+	uint32_t ring_data[MAX_REQS];
+	pthread_t thread;
+	/* 0: starting, 1: running, -1: failed */
+	odp_atomic_u32_t state;
+	int cpu;
+} comp_worker_t;
+
 typedef struct odp_comp_global_s {
 	odp_spinlock_t                lock;
 	odp_shm_t global_shm;
 	odp_comp_generic_session_t *free;
+
+	struct {
+		uint8_t async_offload;
+		int num_worker;
+		int worker_cpu[MAX_WORKERS];
+	} config;
+
+	/* Worker thread offload state */
+	struct {
+		odp_ticketlock_t lock;
+		uint32_t num_sessions;
+		odp_atomic_u32_t exit;
+		ring_mpmc_u32_t free_ring;
+		uint32_t free_ring_data[MAX_REQS];
+		comp_req_t req[MAX_REQS];
+		comp_worker_t worker[MAX_WORKERS];
+	} offload;
+
 	odp_comp_generic_session_t  sessions[MAX_SESSIONS];
 } odp_comp_global_t;
 
@@ -394,6 +465,213 @@ static int term_def(odp_comp_generic_session_t *session)
 	return 0;
 }
 
+/* Initialize operation result in output packet */
+static odp_comp_generic_session_t *op_prepare(odp_packet_t pkt_in, odp_packet_t pkt_out,
+					      const odp_comp_packet_op_param_t *param)
+{
+	odp_comp_generic_session_t *session;
+	odp_comp_packet_result_t *result;
+
+	session = to_gen_session(param->session);
+	_ODP_ASSERT(session);
+	_ODP_ASSERT(pkt_in != ODP_PACKET_INVALID);
+	_ODP_ASSERT(pkt_out != ODP_PACKET_INVALID);
+
+	result = get_op_result_from_packet(pkt_out);
+	_ODP_ASSERT(result);
+
+	result->pkt_in = pkt_in;
+	result->output_data_range.offset = param->out_data_range.offset;
+	result->output_data_range.length = 0;
+
+	packet_subtype_set(pkt_out, ODP_EVENT_PACKET_COMP);
+
+	return session;
+}
+
+/* Wait until all offloaded operations of a session have completed */
+static inline void wait_pending(odp_comp_generic_session_t *session)
+{
+	while (odp_atomic_load_acq_u32(&session->num_pending))
+		odp_cpu_pause();
+}
+
+/* Queue operation to a worker thread. Returns 1 on success and 0 when out of requests. */
+static int offload_op(odp_packet_t pkt_in, odp_packet_t pkt_out,
+		      const odp_comp_packet_op_param_t *param)
+{
+	odp_comp_generic_session_t *session;
+	comp_worker_t *worker;
+	comp_req_t *req;
+	uint32_t idx;
+
+	if (odp_unlikely(ring_mpmc_u32_deq(&global->offload.free_ring,
+					   global->offload.free_ring_data,
+					   MAX_REQS - 1, &idx) == 0))
+		return 0;
+
+	session = op_prepare(pkt_in, pkt_out, param);
+	worker = &global->offload.worker[session->worker];
+
+	req = &global->offload.req[idx];
+	req->pkt_in = pkt_in;
+	req->pkt_out = pkt_out;
+	req->param = *param;
+
+	odp_atomic_inc_u32(&session->num_pending);
+
+	/* Ring has space for all requests */
+	ring_mpsc_u32_enq_multi(&worker->ring, worker->ring_data, MAX_REQS - 1, &idx, 1);
+
+	return 1;
+}
+
+static void offload_req_complete(comp_req_t *req)
+{
+	odp_comp_generic_session_t *session = to_gen_session(req->param.session);
+	odp_event_t event = odp_packet_to_event(req->pkt_out);
+
+	/* Failures are reported through result status of the output packet */
+	(void)session->comp.func(req->pkt_in, req->pkt_out, &req->param, session);
+
+	if (odp_unlikely(odp_queue_enq(session->params.compl_queue, event))) {
+		_ODP_ERR("Completion event enqueue failed %" PRIu64 "\n",
+			 odp_queue_to_u64(session->params.compl_queue));
+		odp_event_free(event);
+	}
+
+	odp_atomic_dec_u32(&session->num_pending);
+}
+
+static void *worker_run(void *arg)
+{
+	comp_worker_t *worker = arg;
+	uint32_t idx[WORKER_BURST];
+	uint32_t num, i;
+	uint32_t num_idle = 0;
+	const struct timespec ts = { .tv_sec = 0, .tv_nsec = WORKER_IDLE_SLEEP_NS };
+
+	/* Worker threads are control threads, so that they can enqueue events */
+	if (odp_init_local((odp_instance_t)odp_global_ro.main_pid, ODP_THREAD_CONTROL)) {
+		_ODP_ERR("Compression thread local init failed\n");
+		odp_atomic_store_rel_u32(&worker->state, (uint32_t)-1);
+		return NULL;
+	}
+
+	odp_atomic_store_rel_u32(&worker->state, 1);
+
+	while (1) {
+		num = ring_mpsc_u32_deq_multi(&worker->ring, worker->ring_data, MAX_REQS - 1,
+					      idx, WORKER_BURST);
+
+		if (num == 0) {
+			/* Requests are always processed before exit */
+			if (odp_atomic_load_acq_u32(&global->offload.exit))
+				break;
+
+			if (num_idle < WORKER_IDLE_POLLS) {
+				num_idle++;
+				odp_cpu_pause();
+			} else {
+				nanosleep(&ts, NULL);
+			}
+
+			continue;
+		}
+
+		num_idle = 0;
+
+		for (i = 0; i < num; i++)
+			offload_req_complete(&global->offload.req[idx[i]]);
+
+		ring_mpmc_u32_enq_multi(&global->offload.free_ring, global->offload.free_ring_data,
+					MAX_REQS - 1, idx, num);
+	}
+
+	if (odp_term_local() < 0)
+		_ODP_ERR("Compression thread local term failed\n");
+
+	return NULL;
+}
+
+static void workers_stop(int num)
+{
+	odp_atomic_store_rel_u32(&global->offload.exit, 1);
+
+	for (int i = 0; i < num; i++)
+		(void)_odp_service_thread_join(global->offload.worker[i].thread);
+}
+
+static int workers_start(void)
+{
+	comp_worker_t *worker;
+	uint32_t state;
+	char name[16];
+	int i;
+
+	odp_atomic_store_u32(&global->offload.exit, 0);
+
+	for (i = 0; i < global->config.num_worker; i++) {
+		worker = &global->offload.worker[i];
+		odp_atomic_store_u32(&worker->state, 0);
+		snprintf(name, sizeof(name), "odp-comp-%i", i);
+
+		if (_odp_service_thread_start(&worker->thread, name, worker->cpu, worker_run,
+					      worker))
+			goto fail;
+
+		do {
+			state = odp_atomic_load_acq_u32(&worker->state);
+			odp_cpu_pause();
+		} while (state == 0);
+
+		if (state != 1) {
+			(void)_odp_service_thread_join(worker->thread);
+			goto fail;
+		}
+	}
+
+	return 0;
+
+fail:
+	_ODP_ERR("Starting compression thread %i failed\n", i);
+	workers_stop(i);
+	return -1;
+}
+
+/* Worker threads run while there are sessions */
+static int offload_session_add(odp_comp_generic_session_t *session)
+{
+	int ret = 0;
+
+	odp_atomic_init_u32(&session->num_pending, 0);
+	session->worker = (session - global->sessions) % global->config.num_worker;
+
+	odp_ticketlock_lock(&global->offload.lock);
+
+	if (global->offload.num_sessions == 0)
+		ret = workers_start();
+
+	if (ret == 0)
+		global->offload.num_sessions++;
+
+	odp_ticketlock_unlock(&global->offload.lock);
+
+	return ret;
+}
+
+static void offload_session_rem(void)
+{
+	odp_ticketlock_lock(&global->offload.lock);
+
+	global->offload.num_sessions--;
+
+	if (global->offload.num_sessions == 0)
+		workers_stop(global->config.num_worker);
+
+	odp_ticketlock_unlock(&global->offload.lock);
+}
+
 odp_comp_session_t
 odp_comp_session_create(const odp_comp_session_param_t *params)
 {
@@ -424,6 +702,12 @@ odp_comp_session_create(const odp_comp_session_param_t *params)
 		goto cleanup;
 	}
 
+	if (global->config.async_offload && offload_session_add(session)) {
+		if (params->comp_algo != ODP_COMP_ALG_NULL)
+			(void)term_def(session);
+		goto cleanup;
+	}
+
 	return (odp_comp_session_t)session;
 
 cleanup:
@@ -439,6 +723,11 @@ int odp_comp_session_destroy(odp_comp_session_t session)
 
 	generic = (odp_comp_generic_session_t *)(intptr_t)session;
 
+	if (global->config.async_offload) {
+		wait_pending(generic);
+		offload_session_rem();
+	}
+
 	switch (generic->params.comp_algo) {
 	case ODP_COMP_ALG_DEFLATE:
 	case ODP_COMP_ALG_ZLIB:
@@ -518,22 +807,14 @@ static int _odp_comp_single(odp_packet_t pkt_in, odp_packet_t pkt_out,
 			    const odp_comp_packet_op_param_t *param)
 {
 	odp_comp_generic_session_t *session;
-	odp_comp_packet_result_t *result;
 	int rc;
 
-	session = to_gen_session(param->session);
-	_ODP_ASSERT(session);
-	_ODP_ASSERT(pkt_in != ODP_PACKET_INVALID);
-	_ODP_ASSERT(pkt_out != ODP_PACKET_INVALID);
-
-	result = get_op_result_from_packet(pkt_out);
-	_ODP_ASSERT(result);
+	session = op_prepare(pkt_in, pkt_out, param);
 
-	result->pkt_in = pkt_in;
-	result->output_data_range.offset = param->out_data_range.offset;
-	result->output_data_range.length = 0;
-
-	packet_subtype_set(pkt_out, ODP_EVENT_PACKET_COMP);
+	/* Operations on a session are processed in order. Complete previously offloaded
+	 * operations first. */
+	if (global->config.async_offload)
+		wait_pending(session);
 
 	rc = session->comp.func(pkt_in, pkt_out, param, session);
 	if (rc < 0)
@@ -563,6 +844,15 @@ int odp_comp_op_enq(const odp_packet_t pkt_in[], odp_packet_t pkt_out[],
 	int i;
 	int rc;
 
+	if (global->config.async_offload) {
+		for (i = 0; i < num_pkt; i++) {
+			if (offload_op(pkt_in[i], pkt_out[i], &param[i]) == 0)
+				break;
+		}
+
+		return i;
+	}
+
 	for (i = 0; i < num_pkt; i++) {
 		odp_event_t event;
 		odp_comp_generic_session_t *session;
@@ -596,6 +886,69 @@ int odp_comp_result(odp_comp_packet_result_t *result,
 	return 0;
 }
 
+static int read_config_file(odp_comp_global_t *glb)
+{
+	const char *str;
+	int val = 0;
+	int num;
+
+	_ODP_PRINT("Compression config:\n");
+
+	str = "comp.async_offload";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+	glb->config.async_offload = !!val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "comp.worker_cpus";
+	num = _odp_service_thread_cpus(str, glb->config.worker_cpu, MAX_WORKERS);
+	if (num < 0)
+		return -1;
+
+	_ODP_PRINT("  %s: [", str);
+	for (int i = 0; i < num; i++)
+		_ODP_PRINT("%s%i", i ? ", " : "", glb->config.worker_cpu[i]);
+	_ODP_PRINT("]\n\n");
+
+	/* One unpinned thread when CPUs are not listed */
+	glb->config.num_worker = num;
+	if (num == 0) {
+		glb->config.num_worker = 1;
+		glb->config.worker_cpu[0] = -1;
+	}
+
+	if (glb->config.async_offload &&
+	    odp_global_ro.init_param.mem_model == ODP_MEM_MODEL_PROCESS) {
+		_ODP_PRINT("Compression offload not supported in process mode, disabled\n\n");
+		glb->config.async_offload = 0;
+	}
+
+	return 0;
+}
+
+static void offload_init(odp_comp_global_t *glb)
+{
+	uint32_t i;
+
+	odp_ticketlock_init(&glb->offload.lock);
+	odp_atomic_init_u32(&glb->offload.exit, 0);
+	ring_mpmc_u32_init(&glb->offload.free_ring);
+
+	for (i = 0; i < MAX_REQS; i++)
+		ring_mpmc_u32_enq(&glb->offload.free_ring, glb->offload.free_ring_data,
+				  MAX_REQS - 1, i);
+
+	for (i = 0; i < (uint32_t)glb->config.num_worker; i++) {
+		comp_worker_t *worker = &glb->offload.worker[i];
+
+		ring_mpsc_u32_init(&worker->ring);
+		odp_atomic_init_u32(&worker->state, 0);
+		worker->cpu = glb->config.worker_cpu[i];
+	}
+}
+
 int _odp_comp_init_global(void)
 {
 	size_t mem_size;
@@ -615,11 +968,22 @@ int _odp_comp_init_global(void)
 			      ODP_CACHE_LINE_SIZE, 0);
 
 	global = odp_shm_addr(shm);
+	if (global == NULL) {
+		_ODP_ERR("SHM reserve failed\n");
+		return -1;
+	}
 
 	/* Clear it out */
 	memset(global, 0, mem_size);
 	global->global_shm = shm;
 
+	if (read_config_file(global)) {
+		odp_shm_free(shm);
+		return -1;
+	}
+
+	offload_init(global);
+
 	/* Initialize free list and lock */
 	for (idx = 0; idx < MAX_SESSIONS; idx++) {
 		global->sessions[idx].next = global->free;
@@ -648,6 +1012,18 @@ int _odp_comp_term_global(void)
 		rc = -1;
 	}
 
+	/* Stop worker threads of sessions that were not destroyed */
+	if (global->config.async_offload) {
+		odp_ticketlock_lock(&global->offload.lock);
+
+		if (global->offload.num_sessions) {
+			workers_stop(global->config.num_worker);
+			global->offload.num_sessions = 0;
+		}
+
+		odp_ticketlock_unlock(&global->offload.lock);
+	}
+
 	ret = odp_shm_free(global->global_shm);
 	if (ret < 0) {
 		_ODP_ERR("shm free failed for comp_pool\n");
@@ -2,6 +2,8 @@
  * Copyright (c) 2021-2026 Nokia
  */
 
+#include <odp_posix_extensions.h>
+
 #include <odp/api/dma.h>
 #include <odp/api/event.h>
 #include <odp/api/shared_memory.h>
@@ -13,7 +15,11 @@
 #include <odp/api/packet.h>
 #include <odp/api/pool.h>
 #include <odp/api/queue.h>
+#include <odp/api/init.h>
+#include <odp/api/time.h>
 
+#include <odp/api/plat/atomic_inlines.h>
+#include <odp/api/plat/cpu_inlines.h>
 #include <odp/api/plat/std_inlines.h>
 #include <odp/api/plat/strong_types.h>
 
@@ -21,18 +27,44 @@
 #include <odp_debug_internal.h>
 #include <odp_init_internal.h>
 #include <odp_event_internal.h>
+#include <odp_libconfig_internal.h>
+#include <odp_macros_internal.h>
 #include <odp_pool_internal.h>
+#include <odp_service_thread_internal.h>
 #include <odp_string_internal.h>
+#include <ring/odp_ring_mpmc_u32_internal.h>
+#include <ring/odp_ring_mpsc_u32_internal.h>
 
 #include <string.h>
 #include <inttypes.h>
+#include <time.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #define MAX_SESSIONS  CONFIG_MAX_DMA_SESSIONS
 #define MAX_TRANSFERS 256
 #define MAX_SEGS      16
 #define MAX_SEG_LEN   (128 * 1024)
 
+/* Maximum number of copy threads */
+#define MAX_COPY_THREADS 32
+
+/* Number of copy requests shared by all sessions. Must be a power of two. */
+#define MAX_COPY_REQS 1024
+
+/* Number of requests a copy thread dequeues at a time */
+#define COPY_BURST 16
+
+/* Number of empty polls before a copy thread starts sleeping between polls */
+#define COPY_IDLE_POLLS 10000
+
+/* Copy thread sleep time when idle */
+#define COPY_IDLE_SLEEP_NS 10000
+
 ODP_STATIC_ASSERT(MAX_TRANSFERS < UINT32_MAX, "Too many inflight transfers");
+ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(MAX_COPY_REQS), "MAX_COPY_REQS not a power of two");
 
 typedef struct segment_t {
 	void     *addr;
@@ -50,6 +82,8 @@ typedef struct transfer_t {
 typedef struct result_t {
 	uint32_t num_dst;
 	void *user_ptr;
+	/* Set when an offloaded transfer has been completed by a copy thread */
+	odp_atomic_u32_t done;
 	/* Space for implementation allocated packets if requested */
 	odp_packet_t pkts[MAX_SEGS];
 
@@ -61,11 +95,43 @@ typedef struct ODP_ALIGNED_CACHE dma_session_t {
 	uint8_t           active;
 	char              name[ODP_DMA_NAME_LEN];
 	odp_stash_t       stash;
+	/* Number of offloaded transfers not yet completed */
+	odp_atomic_u32_t  num_pending;
+	/* Copy thread serving this session */
+	uint32_t          copy_thr;
 	/* Last element in array reserved for sync transfers, others added to ID stash */
 	result_t          result[MAX_TRANSFERS + 1];
 
 } dma_session_t;
 
+/* Transfer offloaded to a copy thread */
+typedef struct ODP_ALIGNED_CACHE copy_req_t {
+	dma_session_t *session;
+	/* Transfer result, NULL with ODP_DMA_COMPL_NONE */
+	result_t *result;
+	odp_event_t event;
+	odp_queue_t queue;
+	odp_dma_compl_mode_t compl_mode;
+	uint32_t num_trs;
+	uint32_t tot_len;
+	uint32_t num_free;
+	transfer_t trs[2 * MAX_SEGS];
+	/* Source packets to be freed after the copy */
+	odp_packet_t free_pkt[MAX_SEGS];
+
+} copy_req_t;
+
+typedef struct ODP_ALIGNED_CACHE copy_thread_t {
+	/* Requests queued to this thread */
+	ring_mpsc_u32_t ring;
+	uint32_t ring_data[MAX_COPY_REQS];
+	pthread_t thread;
+	/* 0: starting, 1: running, -1: failed */
+	odp_atomic_u32_t state;
+	int cpu;
+
+} copy_thread_t;
+
 typedef struct dma_global_t {
 	odp_shm_t shm;
 
@@ -73,6 +139,26 @@ typedef struct dma_global_t {
 	odp_pool_capability_t pool_capa;
 	odp_pool_param_t pool_param;
 
+	struct {
+		uint32_t nt_copy_threshold;
+		uint8_t async_offload;
+		int num_copy_thr;
+		int copy_cpu[MAX_COPY_THREADS];
+
+	} config;
+
+	/* Copy thread offload state */
+	struct {
+		odp_ticketlock_t lock;
+		uint32_t num_sessions;
+		odp_atomic_u32_t exit;
+		ring_mpmc_u32_t free_ring;
+		uint32_t free_ring_data[MAX_COPY_REQS];
+		copy_req_t req[MAX_COPY_REQS];
+		copy_thread_t thr[MAX_COPY_THREADS];
+
+	} offload;
+
 	dma_session_t session[MAX_SESSIONS];
 
 } dma_global_t;
@@ -201,6 +287,16 @@ static int destroy_stash(odp_stash_t stash)
 	return ret;
 }
 
+/* Wait until all offloaded transfers of a session have completed */
+static inline void wait_pending(dma_session_t *session)
+{
+	while (odp_atomic_load_acq_u32(&session->num_pending))
+		odp_cpu_pause();
+}
+
+static int offload_session_add(dma_session_t *session);
+static void offload_session_rem(void);
+
 odp_dma_t odp_dma_create(const char *name, const odp_dma_param_t *param)
 {
 	odp_dma_capability_t dma_capa;
@@ -267,6 +363,18 @@ odp_dma_t odp_dma_create(const char *name, const odp_dma_param_t *param)
 		}
 	}
 
+	odp_atomic_init_u32(&session->num_pending, 0);
+
+	if (_odp_dma_glb->config.async_offload) {
+		if (offload_session_add(session)) {
+			if (session->stash != ODP_STASH_INVALID)
+				(void)destroy_stash(session->stash);
+
+			session->active = 0;
+			return ODP_DMA_INVALID;
+		}
+	}
+
 	session->name[0] = 0;
 
 	if (name)
@@ -287,6 +395,10 @@ int odp_dma_destroy(odp_dma_t dma)
 		return -1;
 	}
 
+	/* Offloaded transfers may still use the session and its transfer IDs */
+	if (_odp_dma_glb->config.async_offload)
+		wait_pending(session);
+
 	if (session->stash != ODP_STASH_INVALID)
 		if (destroy_stash(session->stash))
 			ret = -1;
@@ -302,6 +414,9 @@ int odp_dma_destroy(odp_dma_t dma)
 	session->active = 0;
 	odp_ticketlock_unlock(&session->lock);
 
+	if (_odp_dma_glb->config.async_offload)
+		offload_session_rem();
+
 	return ret;
 }
 
@@ -539,32 +654,40 @@ static uint32_t add_to_free_set(odp_packet_t pkt, odp_packet_t set[], uint32_t n
 	return num;
 }
 
-static void free_src_segs(const odp_dma_transfer_param_t *transfer)
+static uint32_t src_free_set(const odp_dma_transfer_param_t *transfer, odp_packet_t set[])
 {
 	const uint32_t num_src = transfer->num_src;
+	uint32_t num = 0;
 
 	if (transfer->opts.unique_src_segs) {
 		for (uint32_t i = 0; i < num_src; i++)
-			odp_packet_free(transfer->src_seg[i].packet);
-	} else {
-		odp_packet_t free_set[num_src];
-		uint32_t num = 0;
+			set[i] = transfer->src_seg[i].packet;
 
-		for (uint32_t i = 0; i < num_src; i++)
-			num = add_to_free_set(transfer->src_seg[i].packet, free_set, num);
-
-		odp_packet_free_multi(free_set, num);
+		return num_src;
 	}
+
+	for (uint32_t i = 0; i < num_src; i++)
+		num = add_to_free_set(transfer->src_seg[i].packet, set, num);
+
+	return num;
 }
 
-static int do_transfer(dma_session_t *session, const odp_dma_transfer_param_t *transfer,
-		       result_t *result)
+static void free_src_segs(const odp_dma_transfer_param_t *transfer)
+{
+	odp_packet_t free_set[transfer->num_src];
+
+	odp_packet_free_multi(free_set, src_free_set(transfer, free_set));
+}
+
+/* Resolve transfer segments into a table of contiguous copies. Returns number of table entries
+ * or <0 on failure. */
+static int prepare_transfer(dma_session_t *session, const odp_dma_transfer_param_t *transfer,
+			    result_t *result, transfer_t trs[], uint32_t *len)
 {
-	int num, i;
+	int num;
 	uint32_t tot_len;
 	int num_src, num_dst;
 	const int max_num = 2 * MAX_SEGS;
-	transfer_t trs[max_num];
 	segment_t src[MAX_SEGS];
 	segment_t dst[MAX_SEGS];
 
@@ -634,8 +757,80 @@ static int do_transfer(dma_session_t *session, const odp_dma_transfer_param_t *t
 		return -1;
 	}
 
+	*len = tot_len;
+	return num;
+}
+
+#ifdef __SSE2__
+/* Copy using non-temporal stores, which bypass caches on the destination side */
+static void memcpy_nt(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+	uint32_t head = (16 - ((uintptr_t)dst & 15)) & 15;
+
+	if (head > len)
+		head = len;
+
+	memcpy(dst, src, head);
+	dst += head;
+	src += head;
+	len -= head;
+
+	while (len >= 64) {
+		__m128i d0 = _mm_loadu_si128((const __m128i *)(uintptr_t)src);
+		__m128i d1 = _mm_loadu_si128((const __m128i *)(uintptr_t)(src + 16));
+		__m128i d2 = _mm_loadu_si128((const __m128i *)(uintptr_t)(src + 32));
+		__m128i d3 = _mm_loadu_si128((const __m128i *)(uintptr_t)(src + 48));
+
+		_mm_stream_si128((__m128i *)(uintptr_t)dst, d0);
+		_mm_stream_si128((__m128i *)(uintptr_t)(dst + 16), d1);
+		_mm_stream_si128((__m128i *)(uintptr_t)(dst + 32), d2);
+		_mm_stream_si128((__m128i *)(uintptr_t)(dst + 48), d3);
+
+		dst += 64;
+		src += 64;
+		len -= 64;
+	}
+
+	memcpy(dst, src, len);
+}
+#endif
+
+static void copy_transfer(const transfer_t trs[], int num, uint32_t tot_len)
+{
+	int i;
+
+#ifdef __SSE2__
+	const uint32_t nt_threshold = _odp_dma_glb->config.nt_copy_threshold;
+
+	if (nt_threshold && tot_len >= nt_threshold) {
+		for (i = 0; i < num; i++)
+			memcpy_nt(trs[i].dst, trs[i].src, trs[i].len);
+
+		/* Order streaming stores before completion is reported */
+		_mm_sfence();
+		return;
+	}
+#else
+	(void)tot_len;
+#endif
+
 	for (i = 0; i < num; i++)
 		memcpy(trs[i].dst, trs[i].src, trs[i].len);
+}
+
+static int do_transfer(dma_session_t *session, const odp_dma_transfer_param_t *transfer,
+		       result_t *result)
+{
+	int num;
+	uint32_t tot_len;
+	transfer_t trs[2 * MAX_SEGS];
+
+	num = prepare_transfer(session, transfer, result, trs, &tot_len);
+
+	if (odp_unlikely(num < 0))
+		return -1;
+
+	copy_transfer(trs, num, tot_len);
 
 	if (transfer->opts.seg_free)
 		free_src_segs(transfer);
@@ -643,6 +838,208 @@ static int do_transfer(dma_session_t *session, const odp_dma_transfer_param_t *t
 	return 1;
 }
 
+/* Queue transfer to a copy thread. Returns 1 on success, 0 when out of copy requests, and <0
+ * on failure. */
+static int offload_transfer(dma_session_t *session, const odp_dma_transfer_param_t *transfer,
+			    const odp_dma_compl_param_t *compl, result_t *res)
+{
+	dma_global_t *glb = _odp_dma_glb;
+	copy_thread_t *thr = &glb->offload.thr[session->copy_thr];
+	copy_req_t *req;
+	uint32_t idx;
+	int num;
+
+	if (odp_unlikely(ring_mpmc_u32_deq(&glb->offload.free_ring, glb->offload.free_ring_data,
+					   MAX_COPY_REQS - 1, &idx) == 0))
+		return 0;
+
+	req = &glb->offload.req[idx];
+
+	num = prepare_transfer(session, transfer, transfer->opts.seg_alloc ? res : NULL,
+			       req->trs, &req->tot_len);
+
+	if (odp_unlikely(num < 0)) {
+		ring_mpmc_u32_enq(&glb->offload.free_ring, glb->offload.free_ring_data,
+				  MAX_COPY_REQS - 1, idx);
+		return -1;
+	}
+
+	req->session    = session;
+	req->result     = res;
+	req->event      = compl->event;
+	req->queue      = compl->queue;
+	req->compl_mode = compl->compl_mode;
+	req->num_trs    = num;
+	req->num_free   = 0;
+
+	if (transfer->opts.seg_free)
+		req->num_free = src_free_set(transfer, req->free_pkt);
+
+	if (res)
+		odp_atomic_store_u32(&res->done, 0);
+
+	odp_atomic_inc_u32(&session->num_pending);
+
+	/* Ring has space for all requests */
+	ring_mpsc_u32_enq_multi(&thr->ring, thr->ring_data, MAX_COPY_REQS - 1, &idx, 1);
+
+	return 1;
+}
+
+static void copy_req_complete(copy_req_t *req)
+{
+	copy_transfer(req->trs, req->num_trs, req->tot_len);
+
+	if (req->num_free)
+		odp_packet_free_multi(req->free_pkt, req->num_free);
+
+	if (req->compl_mode == ODP_DMA_COMPL_POLL) {
+		odp_atomic_store_rel_u32(&req->result->done, 1);
+	} else if (req->compl_mode == ODP_DMA_COMPL_EVENT) {
+		if (odp_unlikely(odp_queue_enq(req->queue, req->event))) {
+			_ODP_ERR("Completion event enqueue failed %" PRIu64 "\n",
+				 odp_queue_to_u64(req->queue));
+			odp_event_free(req->event);
+		}
+	}
+
+	odp_atomic_dec_u32(&req->session->num_pending);
+}
+
+static void *copy_thread_run(void *arg)
+{
+	copy_thread_t *thr = arg;
+	dma_global_t *glb = _odp_dma_glb;
+	uint32_t idx[COPY_BURST];
+	uint32_t num, i;
+	uint32_t num_idle = 0;
+	const struct timespec ts = { .tv_sec = 0, .tv_nsec = COPY_IDLE_SLEEP_NS };
+
+	/* Copy threads are control threads, so that they can free packets and enqueue events */
+	if (odp_init_local((odp_instance_t)odp_global_ro.main_pid, ODP_THREAD_CONTROL)) {
+		_ODP_ERR("Copy thread local init failed\n");
+		odp_atomic_store_rel_u32(&thr->state, (uint32_t)-1);
+		return NULL;
+	}
+
+	odp_atomic_store_rel_u32(&thr->state, 1);
+
+	while (1) {
+		num = ring_mpsc_u32_deq_multi(&thr->ring, thr->ring_data, MAX_COPY_REQS - 1,
+					      idx, COPY_BURST);
+
+		if (num == 0) {
+			/* Requests are always processed before exit */
+			if (odp_atomic_load_acq_u32(&glb->offload.exit))
+				break;
+
+			if (num_idle < COPY_IDLE_POLLS) {
+				num_idle++;
+				odp_cpu_pause();
+			} else {
+				nanosleep(&ts, NULL);
+			}
+
+			continue;
+		}
+
+		num_idle = 0;
+
+		for (i = 0; i < num; i++)
+			copy_req_complete(&glb->offload.req[idx[i]]);
+
+		ring_mpmc_u32_enq_multi(&glb->offload.free_ring, glb->offload.free_ring_data,
+					MAX_COPY_REQS - 1, idx, num);
+	}
+
+	if (odp_term_local() < 0)
+		_ODP_ERR("Copy thread local term failed\n");
+
+	return NULL;
+}
+
+static void copy_threads_stop(int num)
+{
+	dma_global_t *glb = _odp_dma_glb;
+
+	odp_atomic_store_rel_u32(&glb->offload.exit, 1);
+
+	for (int i = 0; i < num; i++)
+		(void)_odp_service_thread_join(glb->offload.thr[i].thread);
+}
+
+static int copy_threads_start(void)
+{
+	dma_global_t *glb = _odp_dma_glb;
+	copy_thread_t *thr;
+	uint32_t state;
+	char name[16];
+	int i;
+
+	odp_atomic_store_u32(&glb->offload.exit, 0);
+
+	for (i = 0; i < glb->config.num_copy_thr; i++) {
+		thr = &glb->offload.thr[i];
+		odp_atomic_store_u32(&thr->state, 0);
+		snprintf(name, sizeof(name), "odp-dma-cp%i", i);
+
+		if (_odp_service_thread_start(&thr->thread, name, thr->cpu, copy_thread_run, thr))
+			goto fail;
+
+		do {
+			state = odp_atomic_load_acq_u32(&thr->state);
+			odp_cpu_pause();
+		} while (state == 0);
+
+		if (state != 1) {
+			(void)_odp_service_thread_join(thr->thread);
+			goto fail;
+		}
+	}
+
+	return 0;
+
+fail:
+	_ODP_ERR("Starting DMA copy thread %i failed\n", i);
+	copy_threads_stop(i);
+	return -1;
+}
+
+/* Copy threads run while there are sessions */
+static int offload_session_add(dma_session_t *session)
+{
+	dma_global_t *glb = _odp_dma_glb;
+	int ret = 0;
+
+	session->copy_thr = (session - glb->session) % glb->config.num_copy_thr;
+
+	odp_ticketlock_lock(&glb->offload.lock);
+
+	if (glb->offload.num_sessions == 0)
+		ret = copy_threads_start();
+
+	if (ret == 0)
+		glb->offload.num_sessions++;
+
+	odp_ticketlock_unlock(&glb->offload.lock);
+
+	return ret;
+}
+
+static void offload_session_rem(void)
+{
+	dma_global_t *glb = _odp_dma_glb;
+
+	odp_ticketlock_lock(&glb->offload.lock);
+
+	glb->offload.num_sessions--;
+
+	if (glb->offload.num_sessions == 0)
+		copy_threads_stop(glb->config.num_copy_thr);
+
+	odp_ticketlock_unlock(&glb->offload.lock);
+}
+
 int odp_dma_transfer(odp_dma_t dma, const odp_dma_transfer_param_t *transfer,
 		     odp_dma_result_t *result)
 {
@@ -667,6 +1064,11 @@ int odp_dma_transfer(odp_dma_t dma, const odp_dma_transfer_param_t *transfer,
 	if (transfer->opts.seg_alloc)
 		res = get_sync_res(session);
 
+	/* Synchronous transfers are not offloaded. Complete previously started transfers first
+	 * when transfer order is required. */
+	if (_odp_dma_glb->config.async_offload && session->dma_param.order != ODP_DMA_ORDER_NONE)
+		wait_pending(session);
+
 	ret = do_transfer(session, transfer, res);
 
 	if (odp_unlikely(ret < 1))
@@ -799,6 +1201,9 @@ int odp_dma_transfer_start(odp_dma_t dma, const odp_dma_transfer_param_t *transf
 		return -1;
 	}
 
+	if (_odp_dma_glb->config.async_offload)
+		return offload_transfer(session, transfer, compl, res);
+
 	ret = do_transfer(session, transfer, transfer->opts.seg_alloc ? res : NULL);
 
 	if (odp_unlikely(ret < 1))
@@ -858,9 +1263,12 @@ int odp_dma_transfer_done(odp_dma_t dma, odp_dma_transfer_id_t transfer_id,
 		return -1;
 	}
 
-	if (result) {
-		result_t *res = &session->result[index_from_transfer_id(id)];
+	result_t *res = &session->result[index_from_transfer_id(id)];
 
+	if (_odp_dma_glb->config.async_offload && odp_atomic_load_acq_u32(&res->done) == 0)
+		return 0;
+
+	if (result) {
 		result->success  = 1;
 		result->user_ptr = res->user_ptr;
 		result->num_dst = res->num_dst;
@@ -991,6 +1399,12 @@ void odp_dma_print(odp_dma_t dma)
 	_ODP_PRINT("--------\n");
 	_ODP_PRINT("  DMA handle      0x%" PRIx64 "\n", odp_dma_to_u64(dma));
 	_ODP_PRINT("  name            %s\n", session->name);
+
+	if (_odp_dma_glb->config.async_offload) {
+		_ODP_PRINT("  copy thread     %u\n", session->copy_thr);
+		_ODP_PRINT("  pending         %u\n", odp_atomic_load_u32(&session->num_pending));
+	}
+
 	_ODP_PRINT("\n");
 }
 
@@ -1020,6 +1434,81 @@ void odp_dma_compl_print(odp_dma_compl_t dma_compl)
 	_ODP_PRINT("\n");
 }
 
+static int read_config_file(dma_global_t *glb)
+{
+	const char *str;
+	int val = 0;
+	int num;
+
+	_ODP_PRINT("DMA config:\n");
+
+	str = "dma.async_offload";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+	glb->config.async_offload = !!val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "dma.nt_copy_threshold";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+	if (val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+	glb->config.nt_copy_threshold = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "dma.copy_thread_cpus";
+	num = _odp_service_thread_cpus(str, glb->config.copy_cpu, MAX_COPY_THREADS);
+	if (num < 0)
+		return -1;
+
+	_ODP_PRINT("  %s: [", str);
+	for (int i = 0; i < num; i++)
+		_ODP_PRINT("%s%i", i ? ", " : "", glb->config.copy_cpu[i]);
+	_ODP_PRINT("]\n\n");
+
+	/* One unpinned thread when CPUs are not listed */
+	glb->config.num_copy_thr = num;
+	if (num == 0) {
+		glb->config.num_copy_thr = 1;
+		glb->config.copy_cpu[0] = -1;
+	}
+
+	if (glb->config.async_offload &&
+	    odp_global_ro.init_param.mem_model == ODP_MEM_MODEL_PROCESS) {
+		_ODP_PRINT("DMA transfer offload not supported in process mode, disabled\n\n");
+		glb->config.async_offload = 0;
+	}
+
+	return 0;
+}
+
+static void offload_init(dma_global_t *glb)
+{
+	uint32_t i;
+
+	odp_ticketlock_init(&glb->offload.lock);
+	odp_atomic_init_u32(&glb->offload.exit, 0);
+	ring_mpmc_u32_init(&glb->offload.free_ring);
+
+	for (i = 0; i < MAX_COPY_REQS; i++)
+		ring_mpmc_u32_enq(&glb->offload.free_ring, glb->offload.free_ring_data,
+				  MAX_COPY_REQS - 1, i);
+
+	for (i = 0; i < (uint32_t)glb->config.num_copy_thr; i++) {
+		copy_thread_t *thr = &glb->offload.thr[i];
+
+		ring_mpsc_u32_init(&thr->ring);
+		odp_atomic_init_u32(&thr->state, 0);
+		thr->cpu = glb->config.copy_cpu[i];
+	}
+}
+
 int _odp_dma_init_global(void)
 {
 	odp_shm_t shm;
@@ -1051,6 +1540,12 @@ int _odp_dma_init_global(void)
 	for (i = 0; i < MAX_SESSIONS; i++)
 		odp_ticketlock_init(&_odp_dma_glb->session[i].lock);
 
+	if (read_config_file(_odp_dma_glb))
+		return -1;
+
+	if (_odp_dma_glb->config.async_offload)
+		offload_init(_odp_dma_glb);
+
 	return 0;
 }
 
@@ -1064,6 +1559,20 @@ int _odp_dma_term_global(void)
 	if (_odp_dma_glb == NULL)
 		return 0;
 
+	/* Stop copy threads of sessions that were not destroyed */
+	if (_odp_dma_glb->config.async_offload) {
+		odp_ticketlock_lock(&_odp_dma_glb->offload.lock);
+
+		if (_odp_dma_glb->offload.num_sessions) {
+			_ODP_ERR("DMA sessions not destroyed: %u\n",
+				 _odp_dma_glb->offload.num_sessions);
+			copy_threads_stop(_odp_dma_glb->config.num_copy_thr);
+			_odp_dma_glb->offload.num_sessions = 0;
+		}
+
+		odp_ticketlock_unlock(&_odp_dma_glb->offload.lock);
+	}
+
 	shm = _odp_dma_glb->shm;
 
 	if (odp_shm_free(shm)) {
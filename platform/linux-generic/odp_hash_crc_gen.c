@@ -1,5 +1,6 @@
 /* SPDX-License-Identifier: BSD-3-Clause
  * Copyright (c) 2018 Linaro Limited
+ * Copyright (c) 2026 Nokia
  */
 
 #include <stdio.h>
@@ -9,9 +10,9 @@
 
 #include <odp/api/hash.h>
 #include <odp/api/hints.h>
-#include <odp/api/rwlock.h>
 #include <odp/api/shared_memory.h>
 
+#include <odp_brlock_internal.h>
 #include <odp_debug_internal.h>
 #include <odp_init_internal.h>
 
@@ -20,7 +21,8 @@ typedef struct crc_table_t {
 	uint32_t width;
 	uint32_t poly;
 	int      reflect;
-	odp_rwlock_t rwlock;
+	/* Table is regenerated only when CRC parameters change */
+	_odp_brlock_t lock;
 	odp_shm_t shm;
 
 } crc_table_t;
@@ -44,7 +46,7 @@ int _odp_hash_init_global(void)
 	memset(crc_table, 0, sizeof(crc_table_t));
 
 	crc_table->shm = shm;
-	odp_rwlock_init(&crc_table->rwlock);
+	_odp_brlock_init(&crc_table->lock);
 
 	return 0;
 }
@@ -216,7 +218,7 @@ int odp_hash_crc_gen64(const void *data_ptr, uint32_t data_len,
 		return -1;
 	}
 
-	odp_rwlock_read_lock(&crc_table->rwlock);
+	_odp_brlock_read_lock(&crc_table->lock);
 
 	update_table = (crc_table->width != width) ||
 		       (crc_table->poly != poly) ||
@@ -224,8 +226,8 @@ int odp_hash_crc_gen64(const void *data_ptr, uint32_t data_len,
 
 	/* Generate CRC table if not yet generated. */
 	if (odp_unlikely(update_table)) {
-		odp_rwlock_read_unlock(&crc_table->rwlock);
-		odp_rwlock_write_lock(&crc_table->rwlock);
+		_odp_brlock_read_unlock(&crc_table->lock);
+		_odp_brlock_write_lock(&crc_table->lock);
 
 		crc_table_gen(poly, reflect, width);
 	}
@@ -233,9 +235,9 @@ int odp_hash_crc_gen64(const void *data_ptr, uint32_t data_len,
 	crc = crc_calc(data_ptr, data_len, init_val, reflect, width);
 
 	if (odp_unlikely(update_table))
-		odp_rwlock_write_unlock(&crc_table->rwlock);
+		_odp_brlock_write_unlock(&crc_table->lock);
 	else
-		odp_rwlock_read_unlock(&crc_table->rwlock);
+		_odp_brlock_read_unlock(&crc_table->lock);
 
 	if (crc_param->xor_out)
 		crc = crc ^ (uint32_t)crc_param->xor_out;
@@ -21,6 +21,7 @@
 #include <odp_classification_internal.h>
 #include <odp_libconfig_internal.h>
 #include <odp_schedule_if.h>
+#include <odp_random_drbg_internal.h>
 
 #include <protocols/eth.h>
 #include <protocols/ip.h>
@@ -33,6 +34,7 @@
 typedef enum {
 	IPSEC_ORDERING_NONE = 0,
 	IPSEC_ORDERING_SIMPLE,
+	IPSEC_ORDERING_SEQ,
 } ordering_mode_t;
 
 typedef struct {
@@ -123,13 +125,18 @@ static inline int continuous_copy_back(continuous_t *state)
 
 /*
  * Wait until the ordered scheduling context of this thread corresponds
- * to the head of its input queue. Do nothing if ordering is not requested
- * or if not holding an ordered context.
+ * to the head of its input queue, or with sequencing point ordering, until
+ * the preceding contexts have passed the sequencing point. Do nothing if
+ * ordering is not requested or if not holding an ordered context.
  */
-static void wait_for_order(ordering_mode_t mode)
+static void wait_for_order(ordering_mode_t mode, schedule_order_seq_t seq)
 {
 	if (mode == IPSEC_ORDERING_NONE)
 		return;
+	if (mode == IPSEC_ORDERING_SEQ) {
+		_odp_sched_fn->order_seq_lock(seq);
+		return;
+	}
 	_odp_sched_fn->order_lock();
 	/*
 	 * We rely on the unlock being no-op, so let's not even bother
@@ -141,6 +148,16 @@ static void wait_for_order(ordering_mode_t mode)
 	 */
 }
 
+/*
+ * Let the next ordered context pass the sequencing point. Called after
+ * sequence number generation or anti-replay window update of a burst.
+ */
+static inline void pass_order(ordering_mode_t mode, schedule_order_seq_t seq)
+{
+	if (mode == IPSEC_ORDERING_SEQ)
+		_odp_sched_fn->order_seq_unlock(seq);
+}
+
 /*
  * Set cabability bits for algorithms that are defined for use with IPsec
  * and for which the IPsec crypto or auth capability function returns
@@ -1083,42 +1100,6 @@ static int ipsec_in_prepare_packet(odp_packet_t *pkt, ipsec_state_t *state, ipse
 	       _odp_ipsec_sa_stats_precheck(*ipsec_sa, status) < 0;
 }
 
-static int ipsec_in_do_crypto(odp_packet_t *pkt, odp_crypto_packet_op_param_t *param,
-			      odp_ipsec_op_status_t *status)
-{
-	odp_crypto_packet_result_t result;
-	int rc;
-
-	if (odp_unlikely(odp_crypto_op(pkt, pkt, param, 1) < 0)) {
-		_ODP_DBG("Crypto failed\n");
-		goto alg_err;
-	}
-
-	rc = odp_crypto_result(&result, *pkt);
-
-	if (odp_likely(rc == 0))
-		return 0;
-
-	if (odp_unlikely(rc < -1)) {
-		_ODP_DBG("Crypto failed\n");
-		goto alg_err;
-	}
-
-	if (result.cipher_status.alg_err == ODP_CRYPTO_ALG_ERR_ICV_CHECK ||
-	    result.auth_status.alg_err == ODP_CRYPTO_ALG_ERR_ICV_CHECK)
-		goto auth_err;
-
-alg_err:
-	status->error.alg = 1;
-
-	return -1;
-
-auth_err:
-	status->error.auth = 1;
-
-	return -1;
-}
-
 static int ipsec_in_finalize_op(odp_packet_t *pkt, ipsec_state_t *state, ipsec_sa_t *ipsec_sa,
 				odp_ipsec_op_status_t *status)
 {
@@ -1305,54 +1286,6 @@ static void ipsec_in_parse_decap_packet(odp_packet_t pkt, ipsec_state_t *state,
 	op(pkt, state);
 }
 
-static ipsec_sa_t *ipsec_in_single(odp_packet_t pkt,
-				   odp_ipsec_sa_t sa,
-				   odp_packet_t *pkt_out,
-				   odp_bool_t enqueue_op,
-				   odp_ipsec_op_status_t *status,
-				   uint32_t *orig_ip_len)
-{
-	ipsec_state_t state;
-	ipsec_sa_t *ipsec_sa = NULL;
-	odp_crypto_packet_op_param_t param;
-
-	if (odp_unlikely(ipsec_in_prepare_packet(&pkt, &state, &ipsec_sa, sa, &param, status,
-						 orig_ip_len)))
-		goto exit;
-
-	if (ipsec_in_do_crypto(&pkt, &param, status))
-		goto exit;
-
-	if (ipsec_sa->antireplay) {
-		if (enqueue_op)
-			wait_for_order(ipsec_global->inbound_ordering_mode);
-
-		if (_odp_ipsec_sa_replay_update(ipsec_sa, state.in.seq_no, status) < 0)
-			goto exit;
-	}
-
-	if (odp_unlikely(ipsec_in_finalize_packet(&pkt, &state, ipsec_sa, status)))
-		goto post_lifetime_err_cnt_update;
-
-	ipsec_in_parse_decap_packet(pkt, &state, ipsec_sa);
-
-	goto exit;
-
-post_lifetime_err_cnt_update:
-	if (ipsec_config->stats_en) {
-		odp_atomic_inc_u64(&ipsec_sa->stats.post_lifetime_err_pkts);
-		odp_atomic_add_u64(&ipsec_sa->stats.post_lifetime_err_bytes, state.stats_length);
-	}
-
-exit:
-	*pkt_out = pkt;
-
-	if (ipsec_config->stats_en)
-		ipsec_sa_err_stats_update(ipsec_sa, status);
-
-	return ipsec_sa;
-}
-
 /* Generate sequence number */
 static inline
 uint64_t ipsec_seq_no(ipsec_sa_t *ipsec_sa)
@@ -1557,6 +1490,10 @@ static int ipsec_random_data(uint8_t *data, uint32_t len)
 	static __thread uint8_t buffer[IPSEC_RANDOM_BUF_SIZE];
 	static __thread uint32_t buffer_used = IPSEC_RANDOM_BUF_SIZE;
 
+	/* DRBG buffers random data internally, no need for another buffer */
+	if (odp_likely(odp_global_ro.random_drbg))
+		return _odp_random_drbg_data(data, len) == (int32_t)len ? 0 : -1;
+
 	if (odp_likely(buffer_used + len <= IPSEC_RANDOM_BUF_SIZE)) {
 		memcpy(data, &buffer[buffer_used], len);
 		buffer_used += len;
@@ -1682,7 +1619,8 @@ static int ipsec_out_esp(odp_packet_t *pkt,
 	}
 
 	if (enqueue_op)
-		wait_for_order(ipsec_global->outbound_ordering_mode);
+		wait_for_order(ipsec_global->outbound_ordering_mode,
+			       SCHED_ORDER_SEQ_IPSEC_OUT);
 	seq_no = ipsec_seq_no(ipsec_sa);
 
 	if (ipsec_out_iv(state, ipsec_sa, seq_no) < 0) {
@@ -1905,7 +1843,8 @@ static int ipsec_out_ah(odp_packet_t *pkt,
 	}
 
 	if (enqueue_op)
-		wait_for_order(ipsec_global->outbound_ordering_mode);
+		wait_for_order(ipsec_global->outbound_ordering_mode,
+			       SCHED_ORDER_SEQ_IPSEC_OUT);
 	seq_no = ipsec_seq_no(ipsec_sa);
 
 	memset(&ah, 0, sizeof(ah));
@@ -2379,37 +2318,51 @@ static inline void finish_packet_proc(odp_packet_t pkt, ipsec_op_t *op, odp_queu
 	}
 }
 
-static void ipsec_in_finalize(odp_packet_t pkt_in[], ipsec_op_t ops[], int num, odp_bool_t is_enq)
+/* Check crypto results and update anti-replay windows of a burst in order */
+static void ipsec_in_replay_update(odp_packet_t pkt_in[], ipsec_op_t ops[], int num,
+				   odp_bool_t is_enq)
 {
 	for (int i = 0; i < num; i++) {
 		ipsec_op_t *op = &ops[i];
-		odp_packet_t *pkt = &pkt_in[i];
-		odp_queue_t q = ODP_QUEUE_INVALID;
 
 		if (odp_unlikely(op->status.error.all))
-			goto finish;
+			continue;
 
-		if (odp_unlikely(ipsec_in_check_crypto_result(*pkt, &op->status)))
-			goto finish;
+		if (odp_unlikely(ipsec_in_check_crypto_result(pkt_in[i], &op->status)))
+			continue;
 
 		if (op->sa->antireplay) {
 			if (is_enq)
-				wait_for_order(ipsec_global->inbound_ordering_mode);
+				wait_for_order(ipsec_global->inbound_ordering_mode,
+					       SCHED_ORDER_SEQ_IPSEC_IN);
 
-			if (odp_unlikely(_odp_ipsec_sa_replay_update(op->sa, op->state.in.seq_no,
-								     &op->status) < 0))
-				goto finish;
+			_odp_ipsec_sa_replay_update(op->sa, op->state.in.seq_no, &op->status);
 		}
+	}
+}
 
-		if (odp_unlikely(ipsec_in_finalize_packet(pkt, &op->state, op->sa,
-							  &op->status))) {
-			update_post_lifetime_stats(op->sa, &op->state);
-			goto finish;
-		}
+static inline void ipsec_in_finalize_one(odp_packet_t *pkt, ipsec_op_t *op)
+{
+	if (odp_unlikely(op->status.error.all))
+		return;
 
-		ipsec_in_parse_decap_packet(*pkt, &op->state, op->sa);
+	if (odp_unlikely(ipsec_in_finalize_packet(pkt, &op->state, op->sa, &op->status))) {
+		update_post_lifetime_stats(op->sa, &op->state);
+		return;
+	}
+
+	ipsec_in_parse_decap_packet(*pkt, &op->state, op->sa);
+}
+
+static void ipsec_in_finalize(odp_packet_t pkt_in[], ipsec_op_t ops[], int num, odp_bool_t is_enq)
+{
+	for (int i = 0; i < num; i++) {
+		ipsec_op_t *op = &ops[i];
+		odp_packet_t *pkt = &pkt_in[i];
+		odp_queue_t q = ODP_QUEUE_INVALID;
+
+		ipsec_in_finalize_one(pkt, op);
 
-finish:
 		if (is_enq)
 			q = NULL != op->sa ? op->sa->queue : ipsec_config->inbound.default_queue;
 
@@ -2428,6 +2381,7 @@ int odp_ipsec_in(const odp_packet_t pkt_in[], int num_in, odp_packet_t pkt_out[]
 	ipsec_in_prepare(pkt_in, pkt_out, &max_out, param, ops, crypto_pkts, crypto_param,
 			 crypto_ops, &num_crypto);
 	ipsec_do_crypto_burst(crypto_pkts, crypto_param, crypto_ops, num_crypto);
+	ipsec_in_replay_update(pkt_out, ops, max_out, false);
 	ipsec_in_finalize(pkt_out, ops, max_out, false);
 	*num_out = max_out;
 
@@ -2567,6 +2521,8 @@ int odp_ipsec_in_enq(const odp_packet_t pkt_in[], int num_in, const odp_ipsec_in
 	ipsec_in_prepare(pkt_in, pkt_out, &max_out, param, ops, crypto_pkts, crypto_param,
 			 crypto_ops, &num_crypto);
 	ipsec_do_crypto_burst(crypto_pkts, crypto_param, crypto_ops, num_crypto);
+	ipsec_in_replay_update(pkt_out, ops, max_out, true);
+	pass_order(ipsec_global->inbound_ordering_mode, SCHED_ORDER_SEQ_IPSEC_IN);
 	ipsec_in_finalize(pkt_out, ops, max_out, true);
 
 	return max_out;
@@ -2581,51 +2537,72 @@ int odp_ipsec_out_enq(const odp_packet_t pkt_in[], int num_in, const odp_ipsec_o
 
 	ipsec_out_prepare(pkt_in, pkt_out, &max_out, param, ops, crypto_pkts, crypto_param,
 			  crypto_ops, &num_crypto, true);
+	pass_order(ipsec_global->outbound_ordering_mode, SCHED_ORDER_SEQ_IPSEC_OUT);
 	ipsec_do_crypto_burst(crypto_pkts, crypto_param, crypto_ops, num_crypto);
 	ipsec_out_finalize(pkt_out, ops, max_out, true);
 
 	return max_out;
 }
 
-int _odp_ipsec_try_inline(odp_packet_t *pkt)
+static void ipsec_try_inline_burst(odp_packet_t pkt[], uint8_t done[], int num)
 {
-	odp_ipsec_op_status_t status;
-	ipsec_sa_t *ipsec_sa;
-	uint32_t orig_ip_len = 0;
-	odp_ipsec_packet_result_t *result;
-	odp_packet_hdr_t *pkt_hdr;
+	odp_packet_t pkt_out[MAX_BURST], crypto_pkts[MAX_BURST];
+	odp_crypto_packet_op_param_t crypto_param[MAX_BURST];
+	ipsec_op_t ops[MAX_BURST], *crypto_ops[MAX_BURST];
+	odp_ipsec_in_param_t param;
+	int num_prep = num, num_crypto;
 
-	if (odp_global_ro.disable.ipsec)
-		return -1;
+	memset(&param, 0, sizeof(param));
 
-	memset(&status, 0, sizeof(status));
+	ipsec_in_prepare(pkt, pkt_out, &num_prep, &param, ops, crypto_pkts, crypto_param,
+			 crypto_ops, &num_crypto);
+	ipsec_do_crypto_burst(crypto_pkts, crypto_param, crypto_ops, num_crypto);
+	ipsec_in_replay_update(pkt_out, ops, num_prep, false);
 
-	ipsec_sa = ipsec_in_single(*pkt, ODP_IPSEC_SA_INVALID, pkt, false,
-				   &status, &orig_ip_len);
-	/*
-	 * Route packet back in case of lookup failure or early error before
-	 * lookup
-	 */
-	if (NULL == ipsec_sa)
-		return -1;
+	for (int i = 0; i < num; i++) {
+		ipsec_op_t *op = &ops[i];
+		odp_ipsec_packet_result_t *result;
+		odp_packet_hdr_t *pkt_hdr;
+		odp_queue_t queue;
 
-	packet_subtype_set(*pkt, ODP_EVENT_PACKET_IPSEC);
-	result = ipsec_pkt_result(*pkt);
-	memset(result, 0, sizeof(*result));
-	result->status = status;
-	result->orig_ip_len = orig_ip_len;
-	result->sa = ipsec_sa->ipsec_sa_hdl;
-	result->flag.inline_mode = 1;
+		done[i] = 0;
 
-	pkt_hdr = packet_hdr(*pkt);
-	pkt_hdr->dst_queue = ipsec_sa->queue;
-	/* Distinguish inline IPsec packets from classifier packets */
-	pkt_hdr->cos = CLS_COS_IDX_NONE;
+		if (i >= num_prep)
+			continue;
 
-	/* Last thing */
-	_odp_ipsec_sa_unuse(ipsec_sa);
+		pkt[i] = pkt_out[i];
 
-	return 0;
+		/* Route packet back in case of lookup failure or early error before lookup */
+		if (NULL == op->sa)
+			continue;
+
+		ipsec_in_finalize_one(&pkt[i], op);
+
+		/* SA is in use until finish_packet_proc() */
+		queue = op->sa->queue;
+		finish_packet_proc(pkt[i], op, ODP_QUEUE_INVALID);
+
+		result = ipsec_pkt_result(pkt[i]);
+		result->orig_ip_len = op->orig_ip_len;
+		result->flag.inline_mode = 1;
+
+		pkt_hdr = packet_hdr(pkt[i]);
+		pkt_hdr->dst_queue = queue;
+		/* Distinguish inline IPsec packets from classifier packets */
+		pkt_hdr->cos = CLS_COS_IDX_NONE;
+		done[i] = 1;
+	}
+}
+
+void _odp_ipsec_try_inline_multi(odp_packet_t pkt[], uint8_t done[], int num)
+{
+	if (odp_global_ro.disable.ipsec) {
+		memset(done, 0, num);
+		return;
+	}
+
+	for (int i = 0; i < num; i += MAX_BURST)
+		ipsec_try_inline_burst(&pkt[i], &done[i], _ODP_MIN(num - i, MAX_BURST));
 }
 
 static inline int ipsec_out_inline_check_out_hdrs(odp_packet_t pkt,
@@ -2816,6 +2793,7 @@ int odp_ipsec_out_inline(const odp_packet_t pkt_in[], int num_in,
 
 	ipsec_out_inline_prepare(pkt_in, pkt_out, max_out, param, inline_param, ops, crypto_pkts,
 				 crypto_param, crypto_ops, &num_crypto);
+	pass_order(ipsec_global->outbound_ordering_mode, SCHED_ORDER_SEQ_IPSEC_OUT);
 	ipsec_do_crypto_burst(crypto_pkts, crypto_param, crypto_ops, num_crypto);
 	ipsec_out_inline_finalize(pkt_out, inline_param, ops, max_out);
 
@@ -2894,12 +2872,20 @@ static int read_config_file(ipsec_global_t *global)
 		_ODP_ERR("Config option '%s' not found.\n", str_i);
 		return -1;
 	}
+	if (val < IPSEC_ORDERING_NONE || val > IPSEC_ORDERING_SEQ) {
+		_ODP_ERR("Bad value %s = %i\n", str_i, val);
+		return -1;
+	}
 	global->inbound_ordering_mode = val;
 
 	if (!_odp_libconfig_lookup_int(str_o, &val)) {
 		_ODP_ERR("Config option '%s' not found.\n", str_o);
 		return -1;
 	}
+	if (val < IPSEC_ORDERING_NONE || val > IPSEC_ORDERING_SEQ) {
+		_ODP_ERR("Bad value %s = %i\n", str_o, val);
+		return -1;
+	}
 	global->outbound_ordering_mode = val;
 
 	return 0;
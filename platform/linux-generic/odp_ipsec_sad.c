@@ -8,9 +8,11 @@
 #include <odp/api/ipsec.h>
 #include <odp/api/random.h>
 #include <odp/api/shared_memory.h>
+#include <odp/api/sync.h>
 
 #include <odp/api/plat/atomic_inlines.h>
 #include <odp/api/plat/cpu_inlines.h>
+#include <odp/api/plat/sync_inlines.h>
 
 #include <odp_config_internal.h>
 #include <odp_init_internal.h>
@@ -42,6 +44,19 @@
 
 #define SA_IDX_NONE UINT32_MAX
 
+/*
+ * Inbound SAs with SPI based lookup are linked into hash chains by SPI.
+ * Lookups walk the chains without locking, while SA create and destroy
+ * modify the chains under a lock. Lookup locks an SA (see ipsec_sa_lock())
+ * before checking it, so a concurrently removed SA is not returned. An SA
+ * that is destroyed and reused in another chain during a lookup may cause
+ * the lookup to miss an SA.
+ */
+#define SPI_HASH_BITS 12
+#define SPI_HASH_SIZE (1 << SPI_HASH_BITS)
+
+ODP_STATIC_ASSERT(SPI_HASH_SIZE >= CONFIG_IPSEC_MAX_NUM_SA, "SPI_HASH_SIZE too small");
+
 /*
  * We do not have global IPv4 ID counter that is accessed for every outbound
  * packet. Instead, we split IPv4 ID space to fixed size blocks that we
@@ -108,6 +123,13 @@ typedef struct ipsec_sa_table_t {
 		uint32_t head;
 		odp_spinlock_t lock;
 	} sa_freelist;
+	struct {
+		/* SA index + 1 of the first SA in the chain, 0 when empty */
+		odp_atomic_u32_t head[SPI_HASH_SIZE];
+		/* Chain modification counter, odd while a chain is being modified */
+		odp_atomic_u32_t seq[SPI_HASH_SIZE];
+		odp_spinlock_t lock;
+	} spi_hash;
 	uint32_t max_num_sa;
 	odp_shm_t shm;
 	ipsec_thread_local_t per_thread[];
@@ -231,6 +253,12 @@ int _odp_ipsec_sad_init_global(void)
 	ipsec_sa_tbl->sa_freelist.head = 0;
 	odp_spinlock_init(&ipsec_sa_tbl->sa_freelist.lock);
 
+	for (i = 0; i < SPI_HASH_SIZE; i++) {
+		odp_atomic_init_u32(&ipsec_sa_tbl->spi_hash.head[i], 0);
+		odp_atomic_init_u32(&ipsec_sa_tbl->spi_hash.seq[i], 0);
+	}
+	odp_spinlock_init(&ipsec_sa_tbl->spi_hash.lock);
+
 	return 0;
 }
 
@@ -293,6 +321,66 @@ static void ipsec_sa_release(ipsec_sa_t *ipsec_sa)
 	odp_spinlock_unlock(&ipsec_sa_tbl->sa_freelist.lock);
 }
 
+static inline uint32_t spi_hash_idx(uint32_t spi)
+{
+	return (spi * 0x9e3779b1) >> (32 - SPI_HASH_BITS);
+}
+
+/* Start chain modification. Called with the hash lock held. */
+static inline void spi_hash_write_begin(uint32_t hash)
+{
+	odp_atomic_u32_t *seq = &ipsec_sa_tbl->spi_hash.seq[hash];
+
+	odp_atomic_store_u32(seq, odp_atomic_load_u32(seq) + 1);
+
+	/* Odd counter value is visible before chain modifications */
+	odp_mb_release();
+}
+
+static inline void spi_hash_write_end(uint32_t hash)
+{
+	odp_atomic_u32_t *seq = &ipsec_sa_tbl->spi_hash.seq[hash];
+
+	odp_atomic_store_rel_u32(seq, odp_atomic_load_u32(seq) + 1);
+}
+
+static void spi_hash_add(ipsec_sa_t *ipsec_sa)
+{
+	uint32_t hash = spi_hash_idx(ipsec_sa->spi);
+	odp_atomic_u32_t *head = &ipsec_sa_tbl->spi_hash.head[hash];
+
+	odp_spinlock_lock(&ipsec_sa_tbl->spi_hash.lock);
+	spi_hash_write_begin(hash);
+	odp_atomic_store_u32(&ipsec_sa->spi_hash_next, odp_atomic_load_u32(head));
+	odp_atomic_store_rel_u32(head, ipsec_sa->ipsec_sa_idx + 1);
+	spi_hash_write_end(hash);
+	odp_spinlock_unlock(&ipsec_sa_tbl->spi_hash.lock);
+}
+
+static void spi_hash_del(ipsec_sa_t *ipsec_sa)
+{
+	uint32_t hash = spi_hash_idx(ipsec_sa->spi);
+	odp_atomic_u32_t *link = &ipsec_sa_tbl->spi_hash.head[hash];
+	uint32_t idx;
+
+	odp_spinlock_lock(&ipsec_sa_tbl->spi_hash.lock);
+	spi_hash_write_begin(hash);
+
+	while ((idx = odp_atomic_load_u32(link)) != 0) {
+		ipsec_sa_t *cur = ipsec_sa_entry(idx - 1);
+
+		if (cur == ipsec_sa) {
+			/* Removed SA keeps its next link for concurrent lookups */
+			odp_atomic_store_rel_u32(link, odp_atomic_load_u32(&cur->spi_hash_next));
+			break;
+		}
+		link = &cur->spi_hash_next;
+	}
+
+	spi_hash_write_end(hash);
+	odp_spinlock_unlock(&ipsec_sa_tbl->spi_hash.lock);
+}
+
 /* Mark reserved SA as available now */
 static void ipsec_sa_publish(ipsec_sa_t *ipsec_sa)
 {
@@ -459,9 +547,9 @@ static int ipsec_antireplay_init(ipsec_sa_t *ipsec_sa,
 	num_bkts = IPSEC_AR_WIN_NUM_BUCKETS(ipsec_sa->in.ar.win_size);
 	ipsec_sa->in.ar.num_buckets = num_bkts;
 	odp_atomic_init_u64(&ipsec_sa->hot.in.wintop_seq, 0);
-	memset(ipsec_sa->hot.in.bucket_arr, 0, sizeof(uint64_t) * num_bkts);
 
-	odp_spinlock_init(&ipsec_sa->hot.in.lock);
+	for (uint16_t i = 0; i < num_bkts; i++)
+		odp_atomic_init_u64(&ipsec_sa->hot.in.bucket_arr[i], 0);
 
 	return 0;
 }
@@ -771,6 +859,9 @@ odp_ipsec_sa_t odp_ipsec_sa_create(const odp_ipsec_sa_param_t *param)
 
 	init_sa_thread_local(ipsec_sa);
 
+	if (ipsec_sa->inbound && ipsec_sa->lookup_mode != ODP_IPSEC_LOOKUP_DISABLED)
+		spi_hash_add(ipsec_sa);
+
 	ipsec_sa_publish(ipsec_sa);
 
 	return ipsec_sa->ipsec_sa_hdl;
@@ -841,6 +932,9 @@ int odp_ipsec_sa_destroy(odp_ipsec_sa_t sa)
 		rc = -1;
 	}
 
+	if (ipsec_sa->inbound && ipsec_sa->lookup_mode != ODP_IPSEC_LOOKUP_DISABLED)
+		spi_hash_del(ipsec_sa);
+
 	ipsec_sa_release(ipsec_sa);
 
 	return rc;
@@ -868,13 +962,17 @@ int odp_ipsec_sa_mtu_update(odp_ipsec_sa_t sa, uint32_t mtu)
 	return 0;
 }
 
-ipsec_sa_t *_odp_ipsec_sa_lookup(const ipsec_sa_lookup_t *lookup)
+static ipsec_sa_t *spi_hash_find(const ipsec_sa_lookup_t *lookup, uint32_t hash)
 {
-	uint32_t i;
+	odp_atomic_u32_t *head = &ipsec_sa_tbl->spi_hash.head[hash];
+	uint32_t idx = odp_atomic_load_acq_u32(head);
 	ipsec_sa_t *best = NULL;
 
-	for (i = 0; i < ipsec_sa_tbl->max_num_sa; i++) {
-		ipsec_sa_t *ipsec_sa = ipsec_sa_entry(i);
+	/* Chain length is limited in case of concurrent modifications */
+	for (uint32_t n = 0; idx != 0 && n < ipsec_sa_tbl->max_num_sa; n++) {
+		ipsec_sa_t *ipsec_sa = ipsec_sa_entry(idx - 1);
+
+		idx = odp_atomic_load_acq_u32(&ipsec_sa->spi_hash_next);
 
 		if (ipsec_sa_lock(ipsec_sa) < 0)
 			continue;
@@ -906,6 +1004,36 @@ ipsec_sa_t *_odp_ipsec_sa_lookup(const ipsec_sa_lookup_t *lookup)
 	return best;
 }
 
+ipsec_sa_t *_odp_ipsec_sa_lookup(const ipsec_sa_lookup_t *lookup)
+{
+	uint32_t hash = spi_hash_idx(lookup->spi);
+	odp_atomic_u32_t *seq = &ipsec_sa_tbl->spi_hash.seq[hash];
+	uint32_t seq_val = odp_atomic_load_acq_u32(seq);
+	ipsec_sa_t *ipsec_sa;
+
+	/* Walk the chain without the lock, when it is not being modified */
+	if (odp_likely((seq_val & 1) == 0)) {
+		ipsec_sa = spi_hash_find(lookup, hash);
+
+		/* Chain reads complete before the counter is checked again */
+		odp_mb_acquire();
+
+		if (odp_likely(odp_atomic_load_u32(seq) == seq_val))
+			return ipsec_sa;
+
+		if (ipsec_sa)
+			_odp_ipsec_sa_unuse(ipsec_sa);
+	}
+
+	/* Chain was modified during the walk (e.g. an SA was destroyed and its entry
+	 * reused), so live SAs may have been missed. Walk again under the lock. */
+	odp_spinlock_lock(&ipsec_sa_tbl->spi_hash.lock);
+	ipsec_sa = spi_hash_find(lookup, hash);
+	odp_spinlock_unlock(&ipsec_sa_tbl->spi_hash.lock);
+
+	return ipsec_sa;
+}
+
 int _odp_ipsec_sa_stats_precheck(ipsec_sa_t *ipsec_sa,
 				 odp_ipsec_op_status_t *status)
 {
@@ -1003,55 +1131,59 @@ int _odp_ipsec_sa_replay_precheck(ipsec_sa_t *ipsec_sa, uint64_t seq,
 	return 0;
 }
 
+/*
+ * Lock-free window update. A packet marks its bit in the bucket word with CAS
+ * and then advances the window top. A bucket word left over from an earlier
+ * window position has an older bucket number and is reset by the first packet
+ * of the new bucket. A bucket is reused only after it has moved out of the
+ * window, since there is one extra bucket in addition to the window buckets.
+ */
 static inline int ipsec_wslarge_replay_update(ipsec_sa_t *ipsec_sa, uint64_t seq,
 					      odp_ipsec_op_status_t *status)
 {
-	uint64_t bucket, wintop_bucket, new_bucket;
-	uint64_t bkt_diff, bkt_cnt;
-	uint64_t bit = 0, top_seq;
-
-	odp_spinlock_lock(&ipsec_sa->hot.in.lock);
-
-	top_seq = odp_atomic_load_u64(&ipsec_sa->hot.in.wintop_seq);
-	if ((seq + ipsec_sa->in.ar.win_size) <= top_seq)
-		goto ar_err;
-
-	bucket = (seq >> IPSEC_AR_WIN_BUCKET_BITS);
-
-	/* Check if the seq is within the range */
-	if (seq > top_seq) {
-		wintop_bucket =	top_seq >> IPSEC_AR_WIN_BUCKET_BITS;
-		bkt_diff = bucket - wintop_bucket;
-
-		/* Seq is way after the range of AR window size */
-		if (bkt_diff > ipsec_sa->in.ar.num_buckets)
-			bkt_diff = ipsec_sa->in.ar.num_buckets;
-
-		for (bkt_cnt = 0; bkt_cnt < bkt_diff; bkt_cnt++) {
-			new_bucket = (bkt_cnt + wintop_bucket + 1) %
-				     ipsec_sa->in.ar.num_buckets;
-			ipsec_sa->hot.in.bucket_arr[new_bucket] = 0;
+	uint64_t bucket = seq >> IPSEC_AR_WIN_BUCKET_BITS;
+	uint32_t bkt_num = (uint32_t)bucket;
+	uint32_t bit = (uint32_t)1 << (seq & IPSEC_AR_WIN_BITLOC_MASK);
+	odp_atomic_u64_t *word;
+	uint64_t old, new, top_seq;
+
+	word = &ipsec_sa->hot.in.bucket_arr[bucket % ipsec_sa->in.ar.num_buckets];
+	old = odp_atomic_load_u64(word);
+
+	do {
+		uint32_t old_num = old >> 32;
+		uint32_t bits = (uint32_t)old;
+
+		top_seq = odp_atomic_load_u64(&ipsec_sa->hot.in.wintop_seq);
+		if ((seq + ipsec_sa->in.ar.win_size) <= top_seq)
+			goto ar_err;
+
+		if (old_num == bkt_num) {
+			/* Already seen the packet, discard it */
+			if (bits & bit)
+				goto ar_err;
+
+			bits |= bit;
+		} else if ((int32_t)(old_num - bkt_num) > 0) {
+			/* Bucket has been reused by a later window position */
+			goto ar_err;
+		} else {
+			/* First packet of the bucket in the current window position */
+			bits = bit;
 		}
 
-		/* AR window top sequence number */
-		odp_atomic_store_u64(&ipsec_sa->hot.in.wintop_seq, seq);
-	}
-
-	bucket %= ipsec_sa->in.ar.num_buckets;
-	bit = (uint64_t)1 << (seq & IPSEC_AR_WIN_BITLOC_MASK);
+		new = ((uint64_t)bkt_num << 32) | bits;
+	} while (!odp_atomic_cas_acq_rel_u64(word, &old, new));
 
-	/* Already seen the packet, discard it */
-	if (ipsec_sa->hot.in.bucket_arr[bucket] & bit)
-		goto ar_err;
-
-	/* Packet is new, mark it as seen */
-	ipsec_sa->hot.in.bucket_arr[bucket] |= bit;
-	odp_spinlock_unlock(&ipsec_sa->hot.in.lock);
+	/* Packet is new, advance AR window top sequence number */
+	while (seq > top_seq) {
+		if (odp_atomic_cas_rel_u64(&ipsec_sa->hot.in.wintop_seq, &top_seq, seq))
+			break;
+	}
 
 	return 0;
 ar_err:
 	status->error.antireplay = 1;
-	odp_spinlock_unlock(&ipsec_sa->hot.in.lock);
 	return -1;
 }
 
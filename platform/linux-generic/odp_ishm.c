@@ -49,6 +49,7 @@
 #include <odp_shm_internal.h>
 #include <odp_ishmphy_internal.h>
 #include <odp_libconfig_internal.h>
+#include <odp_service_thread_internal.h>
 #include <odp_string_internal.h>
 
 #include <stdlib.h>
@@ -174,6 +175,7 @@ typedef struct ishm_block {
 	uint64_t len;		 /* length. multiple of page size. 0 if free*/
 	ishm_fragment_t *fragment; /* used when _ODP_ISHM_SINGLE_VA is used */
 	huge_flag_t huge;	 /* page type: external means unknown here. */
+	uint64_t page_size;	 /* page size, 0 when unknown (external)    */
 	uint64_t seq;	/* sequence number, incremented on alloc and free   */
 	uint64_t refcnt;/* number of linux processes mapping this block     */
 } ishm_block_t;
@@ -190,6 +192,10 @@ typedef struct {
 	uint64_t dev_seq;	/* used when creating device names */
 	/* limit for reserving memory using huge pages */
 	uint64_t huge_page_limit;
+	/* limit for reserving memory using large huge pages */
+	uint64_t large_page_limit;
+	/* large huge page size (e.g. 1GB), 0 if not available */
+	uint64_t large_page_size;
 	uint32_t odpthread_cnt;	/* number of running ODP threads   */
 	ishm_block_t  block[ISHM_MAX_NB_BLOCKS];
 	void *single_va_start;	/* start of single VA memory */
@@ -258,6 +264,23 @@ static struct huge_page_cache *hpc;
 /* prototypes: */
 static void procsync(void);
 
+/* Return hugetlbfs mount point for a huge page size, or NULL if not mounted */
+static const char *huge_page_dir(uint64_t page_size)
+{
+	const hugepage_info_t *hugeinfo = &odp_global_ro.hugepage_info;
+	int i;
+
+	if (page_size == hugeinfo->default_huge_page_size)
+		return hugeinfo->default_huge_page_dir;
+
+	for (i = 0; i < hugeinfo->num_sizes; i++) {
+		if (hugeinfo->size[i] == page_size)
+			return hugeinfo->dir[i];
+	}
+
+	return NULL;
+}
+
 static int hp_create_file(uint64_t len, const char *filename)
 {
 	int fd;
@@ -644,8 +667,9 @@ static int create_export_file(ishm_block_t *new_block, uint64_t len, uint32_t fl
  * or /mnt/huge/odp-<pid>-<sequence_or_name> (for huge pages).
  * Return the new file descriptor, or -1 on error.
  */
-static int create_file(int block_index, huge_flag_t huge, uint64_t len,
-		       uint32_t flags, uint32_t align, odp_bool_t single_va)
+static int create_file(int block_index, huge_flag_t huge, uint64_t page_size,
+		       uint64_t len, uint32_t flags, uint32_t align,
+		       odp_bool_t single_va)
 {
 	char *name;
 	int  fd;
@@ -656,6 +680,7 @@ static int create_file(int block_index, huge_flag_t huge, uint64_t len,
 	char dir[ISHM_FILENAME_MAXLEN];
 	int ret;
 	const odp_bool_t use_huge = huge == HUGE;
+	const char *huge_dir = use_huge ? huge_page_dir(page_size) : NULL;
 
 	/* No ishm_block_t for the master single VA memory file */
 	if (single_va) {
@@ -666,12 +691,11 @@ static int create_file(int block_index, huge_flag_t huge, uint64_t len,
 	}
 
 	/* huge dir must be known to create files there!: */
-	if (use_huge && !odp_global_ro.hugepage_info.default_huge_page_dir)
+	if (use_huge && !huge_dir)
 		return -1;
 
 	if (use_huge)
-		snprintf(dir, ISHM_FILENAME_MAXLEN, "%s/%s",
-			 odp_global_ro.hugepage_info.default_huge_page_dir,
+		snprintf(dir, ISHM_FILENAME_MAXLEN, "%s/%s", huge_dir,
 			 odp_global_ro.uid);
 	else
 		snprintf(dir, ISHM_FILENAME_MAXLEN, "%s/%s",
@@ -758,7 +782,8 @@ static void delete_file(ishm_block_t *block)
  * Mutex must be assured by the caller.
  */
 static void *do_map(int block_index, uint64_t len, uint32_t align,
-		    uint64_t offset, uint32_t flags, huge_flag_t huge, int *fd)
+		    uint64_t offset, uint32_t flags, huge_flag_t huge,
+		    uint64_t page_size, int *fd)
 {
 	ishm_block_t *new_block;	  /* entry in the main block table   */
 	void *mapped_addr;
@@ -773,14 +798,19 @@ static void *do_map(int block_index, uint64_t len, uint32_t align,
 	 * unless a fd was already given
 	 */
 	if (*fd < 0) {
-		*fd = create_file(block_index, huge, len, flags, align, false);
+		*fd = create_file(block_index, huge, page_size, len, flags,
+				  align, false);
 		if (*fd < 0)
 			return NULL;
 	} else {
 		new_block->filename[0] = 0;
 	}
 
-	/* try to mmap: */
+	/* try to mmap: new files are populated in parallel when large enough. This is done
+	 * by the caller after releasing the table lock. */
+	if (!new_block->external_fd && _odp_ishmphy_use_prefault(len))
+		flags |= _ODP_ISHM_PREFAULT;
+
 	mapped_addr = _odp_ishmphy_map(*fd, len, offset, flags);
 	if (mapped_addr == NULL) {
 		if (!new_block->external_fd) {
@@ -816,6 +846,7 @@ static void *alloc_single_va(int new_index, uint64_t size, uint32_t align, uint3
 		page_sz = odp_sys_page_size();
 		new_block->huge = NORMAL;
 	}
+	new_block->page_size = page_sz;
 	new_block->filename[0] = 0;
 
 	len = (size + (page_sz - 1)) & (-page_sz);
@@ -1066,11 +1097,14 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 	ishm_block_t *new_block;	      /* entry in the main block table*/
 	uint64_t page_sz;		      /* normal page size. usually 4K*/
 	uint64_t page_hp_size;		      /* huge page size */
+	uint64_t page_lp_size;		      /* large huge page size */
 	uint32_t hp_align;
 	uint64_t len = 0;		      /* mapped length */
 	void *addr = NULL;		      /* mapping address */
 	int new_proc_entry;
+	int prefault;
 	static int  huge_error_printed;       /* to avoid millions of error...*/
+	static int  large_error_printed;
 
 	odp_spinlock_lock(&ishm_tbl->lock);
 
@@ -1081,6 +1115,11 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 	page_sz      = odp_sys_page_size();
 	/* Use normal pages if ODP_SHM_NO_HP was used */
 	page_hp_size = (user_flags & ODP_SHM_NO_HP) ? 0 : odp_sys_huge_page_size();
+	/* Large huge pages are used only for reservations over the limit */
+	page_lp_size = 0;
+	if (page_hp_size && ishm_tbl->large_page_size &&
+	    size > ishm_tbl->large_page_limit)
+		page_lp_size = ishm_tbl->large_page_size;
 
 	/* grab a new entry: */
 	for (new_index = 0; new_index < ISHM_MAX_NB_BLOCKS; new_index++) {
@@ -1120,16 +1159,18 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 		/* note that the huge page flag is meaningless here as huge
 		 * page is determined by the provided file descriptor: */
 		addr = do_map(new_index, len, align, offset, flags, EXTERNAL,
-			      &fd);
+			      0, &fd);
 		if (addr == NULL) {
 			odp_spinlock_unlock(&ishm_tbl->lock);
 			_ODP_ERR("_ishm_reserve failed.\n");
 			return -1;
 		}
 		new_block->huge = EXTERNAL;
+		new_block->page_size = 0;
 	} else {
 		new_block->external_fd = 0;
 		new_block->huge = UNKNOWN;
+		new_block->page_size = 0;
 	}
 
 	/* Otherwise, Try first huge pages when possible and needed: */
@@ -1149,27 +1190,48 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 		if (flags & _ODP_ISHM_SINGLE_VA)
 			goto use_single_va;
 
-		/* roundup to page size */
-		len = (size + (page_hp_size - 1)) & (-page_hp_size);
-
-		/* try pre-allocated pages */
-		fd = hp_get_cached(len);
-		if (fd != -1) {
-			/* do as if user provided a fd */
-			new_block->external_fd = 1;
-			addr = do_map(new_index, len, hp_align, 0, flags,
-				      CACHED, &fd);
+		/* try large huge pages first (e.g. 1GB) to reduce TLB misses */
+		if (page_lp_size) {
+			len = (size + (page_lp_size - 1)) & (-page_lp_size);
+			addr = do_map(new_index, len, hp_align, 0, flags, HUGE,
+				      page_lp_size, &fd);
 			if (addr == NULL) {
-				_ODP_ERR("Could not use cached hp %d\n", fd);
-				hp_put_cached(fd);
-				fd = -1;
+				if (!large_error_printed) {
+					_ODP_WARN("No %" PRIu64 " kB huge pages, fall back to "
+						  "%" PRIu64 " kB huge pages.\n",
+						  page_lp_size / 1024, page_hp_size / 1024);
+					large_error_printed = 1;
+				}
 			} else {
-				new_block->huge = CACHED;
+				new_block->huge = HUGE;
+				new_block->page_size = page_lp_size;
+			}
+		}
+
+		if (fd < 0) {
+			/* roundup to page size */
+			len = (size + (page_hp_size - 1)) & (-page_hp_size);
+
+			/* try pre-allocated pages */
+			fd = hp_get_cached(len);
+			if (fd != -1) {
+				/* do as if user provided a fd */
+				new_block->external_fd = 1;
+				addr = do_map(new_index, len, hp_align, 0, flags,
+					      CACHED, 0, &fd);
+				if (addr == NULL) {
+					_ODP_ERR("Could not use cached hp %d\n", fd);
+					hp_put_cached(fd);
+					fd = -1;
+				} else {
+					new_block->huge = CACHED;
+					new_block->page_size = page_hp_size;
+				}
 			}
 		}
 		if (fd == -1) {
 			addr = do_map(new_index, len, hp_align, 0, flags, HUGE,
-				      &fd);
+				      page_hp_size, &fd);
 
 			if (addr == NULL) {
 				if (!huge_error_printed) {
@@ -1179,6 +1241,7 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 				}
 			} else {
 				new_block->huge = HUGE;
+				new_block->page_size = page_hp_size;
 			}
 		}
 	}
@@ -1205,8 +1268,9 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 
 		/* roundup to page size */
 		len = (size + (page_sz - 1)) & (-page_sz);
-		addr = do_map(new_index, len, align, 0, flags, NORMAL, &fd);
+		addr = do_map(new_index, len, align, 0, flags, NORMAL, 0, &fd);
 		new_block->huge = NORMAL;
+		new_block->page_size = page_sz;
 	}
 
 use_single_va:
@@ -1252,7 +1316,20 @@ use_single_va:
 		new_index = -1;
 	}
 
+	/* Same condition as in do_map() */
+	prefault = new_index >= 0 && !new_block->external_fd &&
+		   !(flags & _ODP_ISHM_SINGLE_VA) && _odp_ishmphy_use_prefault(len);
+	page_sz = new_block->page_size;
+
 	odp_spinlock_unlock(&ishm_tbl->lock);
+
+	/* Prefault pages outside of the lock, as it creates helper threads */
+	if (prefault && _odp_ishmphy_prefault(addr, len, page_sz, flags)) {
+		_odp_ishm_free_by_index(new_index);
+		_ODP_ERR("_ishm_reserve failed.\n");
+		return -1;
+	}
+
 	return new_index;
 }
 
@@ -1275,9 +1352,9 @@ static void *reserve_single_va(uint64_t size, int *fd_out)
 	if (page_hp_size && (size > page_sz)) {
 		/* roundup to page size */
 		len = (size + (page_hp_size - 1)) & (-page_hp_size);
-		fd = create_file(-1, HUGE, len, 0, 0, true);
+		fd = create_file(-1, HUGE, page_hp_size, len, 0, 0, true);
 		if (fd >= 0) {
-			addr = _odp_ishmphy_reserve_single_va(len, fd);
+			addr = _odp_ishmphy_reserve_single_va(len, fd, page_hp_size);
 			if (!addr) {
 				close(fd);
 				unlink(ishm_tbl->single_va_filename);
@@ -1295,9 +1372,9 @@ static void *reserve_single_va(uint64_t size, int *fd_out)
 		/* roundup to page size */
 		len = (size + (page_sz - 1)) & (-page_sz);
 
-		fd = create_file(-1, NORMAL, len, 0, 0, true);
+		fd = create_file(-1, NORMAL, 0, len, 0, 0, true);
 		if (fd >= 0)
-			addr = _odp_ishmphy_reserve_single_va(len, fd);
+			addr = _odp_ishmphy_reserve_single_va(len, fd, page_sz);
 		ishm_tbl->single_va_huge = false;
 	}
 
@@ -1571,8 +1648,8 @@ int _odp_ishm_info(int block_index, _odp_ishm_info_t *info)
 	info->name	 = ishm_tbl->block[block_index].param_name;
 	info->addr	 = ishm_proctable->entry[proc_index].start;
 	info->size	 = ishm_tbl->block[block_index].user_len;
-	info->page_size  = (ishm_tbl->block[block_index].huge == HUGE) ?
-			   odp_sys_huge_page_size() : odp_sys_page_size();
+	info->page_size  = ishm_tbl->block[block_index].page_size ?
+			   ishm_tbl->block[block_index].page_size : odp_sys_page_size();
 	info->flags	 = ishm_tbl->block[block_index].flags;
 	info->user_flags = ishm_tbl->block[block_index].user_flags;
 
@@ -1674,12 +1751,15 @@ int _odp_ishm_init_global(const odp_init_t *init)
 	void *addr;
 	void *spce_addr = NULL;
 	int i;
-	int val_kb;
+	int val_kb, val;
 	uid_t uid;
 	char *hp_dir = odp_global_ro.hugepage_info.default_huge_page_dir;
 	uint64_t max_memory;
 	uint64_t internal;
 	uint64_t huge_page_limit;
+	uint64_t large_page_limit;
+	uint64_t large_page_size = 0;
+	hugepage_info_t *hugeinfo = &odp_global_ro.hugepage_info;
 
 	if (!_odp_libconfig_lookup_ext_int("shm", NULL, "single_va_size_kb",
 					   &val_kb)) {
@@ -1701,6 +1781,39 @@ int _odp_ishm_init_global(const odp_init_t *init)
 
 	_ODP_DBG("Shm huge page usage limit: %dkB\n", val_kb);
 
+	if (!_odp_libconfig_lookup_ext_int("shm", NULL, "mem_init_threads", &val)) {
+		_ODP_ERR("Unable to read memory init threads from config\n");
+		return -1;
+	}
+	if (val < 1 || val > _ODP_SERVICE_THREAD_MAX_CPUS) {
+		_ODP_ERR("Bad value shm.mem_init_threads = %i\n", val);
+		return -1;
+	}
+	odp_global_ro.mem_init_threads = val;
+
+	if (!_odp_libconfig_lookup_ext_int("shm", NULL, "mem_init_min_kb", &val_kb)) {
+		_ODP_ERR("Unable to read memory init size limit from config\n");
+		return -1;
+	}
+	odp_global_ro.mem_init_min_size = (uint64_t)val_kb * 1024;
+
+	_ODP_DBG("Shm memory init threads: %i, min size: %dkB\n", val, val_kb);
+
+	if (!_odp_libconfig_lookup_ext_int("shm", NULL, "large_huge_page_limit_kb",
+					   &val_kb)) {
+		_ODP_ERR("Unable to read large huge page usage limit from config\n");
+		return -1;
+	}
+	large_page_limit = (uint64_t)val_kb * 1024;
+
+	_ODP_DBG("Shm large huge page usage limit: %dkB\n", val_kb);
+
+	/* Largest mounted huge page size above the default size is used for
+	 * reservations over the large page limit. Zero limit disables. */
+	if (val_kb > 0 && hugeinfo->num_sizes &&
+	    hugeinfo->size[hugeinfo->num_sizes - 1] > hugeinfo->default_huge_page_size)
+		large_page_size = hugeinfo->size[hugeinfo->num_sizes - 1];
+
 	/* user requested memory size + some extra for internal use */
 	if (init && init->shm.max_memory)
 		max_memory = init->shm.max_memory + internal;
@@ -1738,6 +1851,14 @@ int _odp_ishm_init_global(const odp_init_t *init)
 		_odp_ishm_cleanup_files(hp_dir);
 	}
 
+	for (i = 0; i < hugeinfo->num_sizes; i++) {
+		if (hugeinfo->size[i] != hugeinfo->default_huge_page_size)
+			_odp_ishm_cleanup_files(hugeinfo->dir[i]);
+	}
+
+	if (large_page_size)
+		_ODP_DBG("Large huge page size: %" PRIu64 " kB\n", large_page_size / 1024);
+
 	_odp_ishm_cleanup_files(odp_global_ro.shm_dir);
 
 	/* allocate space for the internal shared mem block table: */
@@ -1752,6 +1873,8 @@ int _odp_ishm_init_global(const odp_init_t *init)
 	ishm_tbl->dev_seq = 0;
 	ishm_tbl->odpthread_cnt = 0;
 	ishm_tbl->huge_page_limit = huge_page_limit;
+	ishm_tbl->large_page_limit = large_page_limit;
+	ishm_tbl->large_page_size = large_page_size;
 	odp_spinlock_init(&ishm_tbl->lock);
 
 	/* allocate space for the internal shared mem fragment table: */
@@ -2003,9 +2126,9 @@ int _odp_ishm_status(const char *title)
 	}
 
 	_ODP_PRINT("%s\n", title);
-	_ODP_PRINT("    %-*s flag %-29s %-8s   %-8s %-3s %-3s %-3s file\n",
+	_ODP_PRINT("    %-*s flag %-29s %-8s   %-8s %-7s %-3s %-3s %-3s file\n",
 		   max_name_len, "name", "range", "user_len", "unused",
-		   "seq", "ref", "fd");
+		   "page_kB", "seq", "ref", "fd");
 
 	/* display block table: 1 line per entry +1 extra line if mapped here */
 	for (i = 0; i < ISHM_MAX_NB_BLOCKS; i++) {
@@ -2054,12 +2177,13 @@ int _odp_ishm_status(const char *title)
 		}
 
 		_ODP_PRINT("%2i  %-*s %s%c  %p-%p %-8" PRIu64 "   "
-			  "%-8" PRIu64 " %-3" PRIu64 " %-3" PRIu64 " "
+			  "%-8" PRIu64 " %-7" PRIu64 " %-3" PRIu64 " %-3" PRIu64 " "
 			  "%-3d %s\n",
 			  i, max_name_len, ishm_tbl->block[i].param_name,
 			  flags, huge, start_addr, end_addr,
 			  ishm_tbl->block[i].user_len,
 			  ishm_tbl->block[i].len - ishm_tbl->block[i].user_len,
+			  ishm_tbl->block[i].page_size / 1024,
 			  ishm_tbl->block[i].seq,
 			  ishm_tbl->block[i].refcnt,
 			  entry_fd,
@@ -2181,6 +2305,7 @@ void _odp_ishm_print(int block_index)
 	}
 
 	_ODP_PRINT(" page type:  %s\n", str);
+	_ODP_PRINT(" page size:  %" PRIu64 " kB\n", block->page_size / 1024);
 	_ODP_PRINT(" seq:        %" PRIu64 "\n", block->seq);
 	_ODP_PRINT(" refcnt:     %" PRIu64 "\n", block->refcnt);
 	_ODP_PRINT("\n");
@@ -2195,12 +2320,10 @@ int32_t odp_system_meminfo(odp_system_meminfo_t *info, odp_system_memblock_t mem
 	int proc_index;
 	int32_t i;
 	uintptr_t addr;
-	uint64_t len, lost, page_size;
+	uint64_t len, lost;
 	uint64_t lost_total = 0;
 	uint64_t len_total = 0;
 	int32_t num = 0;
-	const uint64_t huge_sz = odp_sys_huge_page_size();
-	const uint64_t normal_sz = odp_sys_page_size();
 
 	odp_spinlock_lock(&ishm_tbl->lock);
 	procsync();
@@ -2224,16 +2347,10 @@ int32_t odp_system_meminfo(odp_system_meminfo_t *info, odp_system_memblock_t mem
 			if (proc_index >= 0)
 				addr = (uintptr_t)ishm_proctable->entry[proc_index].start;
 
-			page_size = 0;
-			if (block->huge == HUGE)
-				page_size = huge_sz;
-			else if (block->huge == NORMAL)
-				page_size = normal_sz;
-
 			mb->addr = addr;
 			mb->used = len;
 			mb->overhead = lost;
-			mb->page_size = page_size;
+			mb->page_size = block->page_size;
 		}
 
 		len_total  += len;
@@ -12,6 +12,8 @@
 #include <odp/api/system_info.h>
 #include <odp/api/debug.h>
 #include <odp_debug_internal.h>
+#include <odp_global_data.h>
+#include <odp_service_thread_internal.h>
 #include <odp_shm_internal.h>
 #include <odp_ishmphy_internal.h>
 
@@ -35,6 +37,66 @@ static uint64_t common_va_len;
 #define MAP_ANONYMOUS MAP_ANON
 #endif
 
+typedef struct {
+	uint8_t *addr;
+	uint64_t len;
+	uint64_t page_size;
+
+} prefault_t;
+
+static void prefault_part(void *arg, int idx, int num)
+{
+	prefault_t *pf = arg;
+	uint64_t num_page = pf->len / pf->page_size;
+	uint64_t first = (num_page * idx) / num;
+	uint64_t last = (num_page * (idx + 1)) / num;
+	uint8_t *start = pf->addr + first * pf->page_size;
+	uint64_t len = (last - first) * pf->page_size;
+
+	if (len == 0)
+		return;
+
+#ifdef MADV_POPULATE_WRITE
+	if (madvise(start, len, MADV_POPULATE_WRITE) == 0)
+		return;
+#endif
+	/* Block may be already visible to other threads, use atomic no-op writes */
+	for (uint64_t i = 0; i < len; i += pf->page_size)
+		__atomic_fetch_or(&start[i], 0, __ATOMIC_RELAXED);
+}
+
+/* Fault in all pages of a new mapping using multiple threads. Memory is split into parts at
+ * 'page_size' boundaries, which must be the page size of the mapping (e.g. huge page size). */
+static void prefault(void *addr, uint64_t len, uint64_t page_size)
+{
+	prefault_t pf;
+
+	pf.addr = addr;
+	pf.len = len;
+	pf.page_size = page_size;
+
+	_odp_service_thread_parallel(odp_global_ro.mem_init_threads, prefault_part, &pf);
+}
+
+int _odp_ishmphy_use_prefault(uint64_t len)
+{
+	return odp_global_ro.mem_init_threads > 1 && len >= odp_global_ro.mem_init_min_size;
+}
+
+int _odp_ishmphy_prefault(void *addr, uint64_t len, uint64_t page_size, int flags)
+{
+	prefault(addr, len, page_size);
+
+	/* if locking is requested, lock it...*/
+	if (flags & _ODP_ISHM_LOCK) {
+		if (mlock(addr, len)) {
+			_ODP_ERR("mlock failed: %s\n", strerror(errno));
+			return -1;
+		}
+	}
+	return 0;
+}
+
 /* Reserve single VA memory
  * This function is called at odp_init_global() time to pre-reserve some memory
  * which is inherited by all odpthreads (i.e. descendant processes and threads).
@@ -42,17 +104,21 @@ static uint64_t common_va_len;
  * _ODP_ISHM_SINGLE_VA flag.
  * returns the address of the mapping or NULL on error.
  */
-void *_odp_ishmphy_reserve_single_va(uint64_t len, int fd)
+void *_odp_ishmphy_reserve_single_va(uint64_t len, int fd, uint64_t page_size)
 {
 	void *addr;
+	const int parallel = _odp_ishmphy_use_prefault(len);
 
 	addr = mmap(NULL, len, PROT_READ | PROT_WRITE,
-		    MAP_SHARED | MAP_POPULATE, fd, 0);
+		    MAP_SHARED | (parallel ? 0 : MAP_POPULATE), fd, 0);
 	if (addr == MAP_FAILED) {
 		_ODP_ERR("mmap failed: %s\n", strerror(errno));
 		return NULL;
 	}
 
+	if (parallel)
+		prefault(addr, len, page_size);
+
 	if (mprotect(addr, len, PROT_READ | PROT_WRITE))
 		_ODP_ERR("mprotect failed: %s\n", strerror(errno));
 
@@ -94,6 +160,10 @@ void *_odp_ishmphy_map(int fd, uint64_t size, uint64_t offset, int flags)
 
 	_ODP_ASSERT(!(flags & _ODP_ISHM_SINGLE_VA));
 
+	/* Pages are faulted in (and locked) later with _odp_ishmphy_prefault() */
+	if (flags & _ODP_ISHM_PREFAULT)
+		mmap_flags = 0;
+
 	/* do a new mapping in the VA space: */
 	mapped_addr = mmap(NULL, size, PROT_READ | PROT_WRITE,
 			   MAP_SHARED | mmap_flags, fd, offset);
@@ -107,7 +177,7 @@ void *_odp_ishmphy_map(int fd, uint64_t size, uint64_t offset, int flags)
 		return NULL;
 
 	/* if locking is requested, lock it...*/
-	if (flags & _ODP_ISHM_LOCK) {
+	if ((flags & _ODP_ISHM_LOCK) && !(flags & _ODP_ISHM_PREFAULT)) {
 		if (mlock(mapped_addr, size)) {
 			_ODP_ERR("mlock failed: %s\n", strerror(errno));
 			if (munmap(mapped_addr, size))
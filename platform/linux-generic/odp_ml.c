@@ -45,6 +45,8 @@
 #define ML_MAX_MODELS_CREATED CONFIG_ML_MAX_MODELS
 #define ML_MAX_MODELS_LOADED CONFIG_ML_MAX_MODELS
 #define ML_MAX_ENGINES 1
+/* Maximum combined batch size of a batched inference */
+#define ML_MAX_BATCH_SIZE 1024
 
 /* Error codes */
 enum {
@@ -109,6 +111,8 @@ typedef struct ml_model_t {
 	OrtSession		*session;
 	OrtSessionOptions	*session_opts;
 	uint32_t		max_compl_id;
+	/* All inputs and outputs have dynamic outermost dimension */
+	odp_bool_t		batchable;
 
 	odp_ml_model_info_t	info;
 	odp_ml_input_info_t	input_info[CONFIG_ML_MAX_INPUTS];
@@ -133,6 +137,9 @@ typedef struct ml_global_t {
 	OrtEnv			*env;
 	ort_run_opts_t		ort_run_opts;
 
+	/* Maximum combined batch size of runs batched together, 0 when disabled */
+	uint32_t		max_batch_size;
+
 	ml_model_t		models[ML_MAX_MODELS_CREATED];
 
 } ml_global_t;
@@ -852,6 +859,24 @@ static int check_io_shape(ml_model_t *mdl)
 		}
 	}
 
+	/* Runs can be combined along the batch dimension only when it is the outermost
+	 * dimension of all inputs and outputs */
+	mdl->batchable = true;
+
+	for (uint32_t i = 0; i < mdl->info.num_inputs; i++) {
+		shape = &mdl->input_info[i].shape;
+
+		if (shape->type != ODP_ML_SHAPE_BATCH || shape->dim[0] != ODP_ML_DIM_DYNAMIC)
+			mdl->batchable = false;
+	}
+
+	for (uint32_t i = 0; i < mdl->info.num_outputs; i++) {
+		shape = &mdl->output_info[i].shape;
+
+		if (shape->type != ODP_ML_SHAPE_BATCH || shape->dim[0] != ODP_ML_DIM_DYNAMIC)
+			mdl->batchable = false;
+	}
+
 	return 0;
 }
 
@@ -1215,6 +1240,8 @@ void odp_ml_model_print(odp_ml_model_t model)
 	_ODP_PRINT("  Model version: %" PRIu64 "\n", info->model_version);
 	_ODP_PRINT("  Model interface version: %" PRIu64 "\n", info->interface_version);
 	_ODP_PRINT("  Index: %u\n", info->index);
+	_ODP_PRINT("  Batching: %s\n", mdl->batchable && _odp_ml_glb->max_batch_size > 1 ?
+		   "enabled" : "disabled");
 	_ODP_PRINT("  Number of inputs: %u\n", info->num_inputs);
 
 	for (uint32_t i = 0; i < info->num_inputs; i++) {
@@ -1259,6 +1286,7 @@ void odp_ml_print(void)
 	_ODP_PRINT("  max_models_loaded: %u\n", ML_MAX_MODELS_LOADED);
 	_ODP_PRINT("  model_max_inputs: %u\n", CONFIG_ML_MAX_INPUTS);
 	_ODP_PRINT("  model_max_outputs: %u\n", CONFIG_ML_MAX_OUTPUTS);
+	_ODP_PRINT("  max_batch_size: %u\n", _odp_ml_glb->max_batch_size);
 
 	_ODP_PRINT("  load:\n");
 	_ODP_PRINT("    completion mode: ");
@@ -2019,14 +2047,11 @@ error:
 	return ret;
 }
 
-static int input_data_to_tensor(const odp_ml_input_info_t *input_info, uint32_t num_seg,
-				const odp_ml_data_seg_t *input_seg, uint32_t *seg_idx,
-				uint32_t batch_size, OrtValue **input_tensor)
+/* Create an input tensor and get pointer to its data */
+static int create_input_tensor(const odp_ml_input_info_t *input_info, uint32_t batch_size,
+			       OrtValue **input_tensor, void **data)
 {
-	int is_tensor;
-	uint64_t input_size;
 	OrtAllocator *allocator;
-	void *data = NULL;
 	OrtStatus *status = NULL;
 	int64_t shape[ODP_ML_MAX_DIMS] = {0};
 	const OrtApi *ort_api = _odp_ml_glb->ort_api;
@@ -2053,14 +2078,31 @@ static int input_data_to_tensor(const odp_ml_input_info_t *input_info, uint32_t
 		return -1;
 	}
 
-	input_size = input_info->data_type_size * get_num_elem(batch_size, &input_info->shape);
-
-	status = ort_api->GetTensorMutableData(*input_tensor, &data);
-	if (check_ortstatus(status) || !data) {
+	*data = NULL;
+	status = ort_api->GetTensorMutableData(*input_tensor, data);
+	if (check_ortstatus(status) || !*data) {
 		_ODP_ERR("GetTensorMutableData() failed\n");
 		return -1;
 	}
 
+	return 0;
+}
+
+static int input_data_to_tensor(const odp_ml_input_info_t *input_info, uint32_t num_seg,
+				const odp_ml_data_seg_t *input_seg, uint32_t *seg_idx,
+				uint32_t batch_size, OrtValue **input_tensor)
+{
+	int is_tensor;
+	uint64_t input_size;
+	void *data = NULL;
+	OrtStatus *status = NULL;
+	const OrtApi *ort_api = _odp_ml_glb->ort_api;
+
+	if (create_input_tensor(input_info, batch_size, input_tensor, &data))
+		return -1;
+
+	input_size = input_info->data_type_size * get_num_elem(batch_size, &input_info->shape);
+
 	for (uint64_t i = 0; i < input_size; ) {
 		if (*seg_idx >= num_seg) {
 			_ODP_ERR("Insufficient input data\n");
@@ -2385,6 +2427,250 @@ error:
 	return retval;
 }
 
+/* Copy input data of one model input from run data segments, starting from segment *seg_idx */
+static int input_segs_to_buf(const odp_ml_data_t *data, uint32_t *seg_idx, uint8_t *dst,
+			     uint64_t size)
+{
+	uint64_t offset = 0;
+
+	while (offset < size) {
+		if (*seg_idx >= data->num_input_seg) {
+			_ODP_ERR("Insufficient input data\n");
+			return -1;
+		}
+
+		const odp_ml_data_seg_t *seg = &data->input_seg[*seg_idx];
+
+		if (offset + seg->size > size) {
+			_ODP_ERR("Excess input data in segment %" PRIu32 "\n", *seg_idx);
+			return -1;
+		}
+
+		memcpy(dst + offset, seg->addr, seg->size);
+		offset += seg->size;
+		(*seg_idx)++;
+	}
+
+	return 0;
+}
+
+/* Copy output data of one model output to run data segments, starting from segment *seg_idx */
+static int buf_to_output_segs(const odp_ml_data_t *data, uint32_t *seg_idx, const uint8_t *src,
+			      uint64_t size)
+{
+	uint64_t offset = 0;
+
+	while (offset < size) {
+		if (*seg_idx >= data->num_output_seg) {
+			_ODP_ERR("Insufficient output space\n");
+			return -1;
+		}
+
+		const odp_ml_data_seg_t *seg = &data->output_seg[*seg_idx];
+		uint64_t cpy_size = size - offset > seg->size ? seg->size : size - offset;
+
+		memcpy(seg->addr, src + offset, cpy_size);
+		offset += cpy_size;
+		(*seg_idx)++;
+	}
+
+	return 0;
+}
+
+/* Run inference once for multiple runs combined along the (outermost) batch dimension. Input data
+ * of the runs is concatenated into a single tensor per model input, and output tensors are
+ * scattered back to the output segments of each run. Returns 1 when all runs were performed,
+ * 0 when the model is busy, and <0 on failure. */
+static int run_batch(odp_ml_model_t model, const odp_ml_data_t data[],
+		     const odp_ml_run_param_t param[], int num, uint32_t batch_size)
+{
+	int ret = -1;
+	OrtStatus *status = NULL;
+	uint8_t *buf;
+	void *ptr;
+	uint64_t offset, size, sample_size;
+	uint32_t tensor_size;
+
+	uint32_t in_seg_idx[ML_MAX_BATCH_SIZE]		= {0};
+	uint32_t out_seg_idx[ML_MAX_BATCH_SIZE]		= {0};
+	OrtValue *input_tensor[CONFIG_ML_MAX_INPUTS]	= {0};
+	OrtValue *output_tensors[CONFIG_ML_MAX_OUTPUTS]	= {0};
+	const char *input_names[CONFIG_ML_MAX_INPUTS]	= {0};
+	const char *output_names[CONFIG_ML_MAX_OUTPUTS]	= {0};
+
+	const OrtApi *ort_api			= _odp_ml_glb->ort_api;
+	ml_model_t *mdl				= ml_model_from_handle(model);
+	const odp_ml_model_info_t *ml_info	= &mdl->info;
+	const odp_ml_input_info_t *input_info	= mdl->input_info;
+	const odp_ml_output_info_t *output_info = mdl->output_info;
+
+	odp_ticketlock_lock(&mdl->lock);
+	if (odp_unlikely(mdl->state == ML_STATE_INFERENCING)) {
+		odp_ticketlock_unlock(&mdl->lock);
+		return 0;
+	}
+	if (odp_unlikely(mdl->state != ML_STATE_LOADED)) {
+		_ODP_ERR("Wrong model state: not created or not loaded\n");
+		odp_ticketlock_unlock(&mdl->lock);
+		return -1;
+	}
+	mdl->state = ML_STATE_INFERENCING;
+	odp_ticketlock_unlock(&mdl->lock);
+
+	if (ODP_DEBUG) {
+		for (int j = 0; j < num; j++)
+			if (verify_run_params(model, &data[j], &param[j]))
+				goto error;
+	}
+
+	/* Concatenate input data of all runs */
+	for (uint32_t i = 0; i < ml_info->num_inputs; i++) {
+		if (create_input_tensor(&input_info[i], batch_size, &input_tensor[i], &ptr))
+			goto error;
+
+		buf = ptr;
+		sample_size = input_info[i].data_type_size * get_num_elem(1, &input_info[i].shape);
+		offset = 0;
+
+		for (int j = 0; j < num; j++) {
+			size = sample_size * param[j].batch_size;
+
+			if (input_segs_to_buf(&data[j], &in_seg_idx[j], buf + offset, size))
+				goto error;
+
+			offset += size;
+		}
+
+		input_names[i] = input_info[i].name;
+	}
+
+	for (uint32_t i = 0; i < ml_info->num_outputs; i++)
+		output_names[i] = output_info[i].name;
+
+	status = ort_api->Run(mdl->session,
+			      NULL,
+			      (const char * const *)input_names,
+			      (const OrtValue * const*)input_tensor,
+			      ml_info->num_inputs,
+			      (const char * const *)output_names,
+			      ml_info->num_outputs,
+			      output_tensors);
+
+	if (check_ortstatus(status)) {
+		_ODP_ERR("Run batched inference failed\n");
+		goto error;
+	}
+
+	/* Scatter outputs to runs */
+	for (uint32_t i = 0; i < ml_info->num_outputs; i++) {
+		sample_size = output_info[i].data_type_size *
+			      get_num_elem(1, &output_info[i].shape);
+
+		if (get_tensor_data_size(output_tensors[i], &tensor_size,
+					 output_info[i].data_type_size))
+			goto error;
+
+		if (tensor_size != sample_size * batch_size) {
+			_ODP_ERR("Unexpected output[%u] size %u\n", i, tensor_size);
+			goto error;
+		}
+
+		ptr = NULL;
+		status = ort_api->GetTensorMutableData(output_tensors[i], &ptr);
+		if (check_ortstatus(status) || !ptr)
+			goto error;
+
+		buf = ptr;
+		offset = 0;
+
+		for (int j = 0; j < num; j++) {
+			size = sample_size * param[j].batch_size;
+
+			if (buf_to_output_segs(&data[j], &out_seg_idx[j], buf + offset, size))
+				goto error;
+
+			offset += size;
+		}
+	}
+
+	for (int j = 0; j < num; j++)
+		if (param[j].result)
+			memset(param[j].result, 0, sizeof(odp_ml_run_result_t));
+
+	ret = 1;
+
+error:
+	for (uint32_t i = 0; i < ml_info->num_outputs; i++)
+		if (output_tensors[i])
+			ort_api->ReleaseValue(output_tensors[i]);
+
+	for (uint32_t i = 0; i < ml_info->num_inputs; i++)
+		if (input_tensor[i])
+			ort_api->ReleaseValue(input_tensor[i]);
+
+	odp_ticketlock_lock(&mdl->lock);
+	mdl->state = ML_STATE_LOADED;
+	odp_ticketlock_unlock(&mdl->lock);
+
+	return ret;
+}
+
+static inline odp_bool_t use_batching(odp_ml_model_t model, const odp_ml_run_param_t param[],
+				      int num)
+{
+	return _odp_ml_glb->max_batch_size > 1 && param && num > 1 &&
+	       model != ODP_ML_MODEL_INVALID && ml_model_from_handle(model)->batchable;
+}
+
+/* Perform runs in batches. Consecutive runs are combined while their total batch size stays
+ * within the configured limit. When a batched inference fails, the runs are performed one by one
+ * to report errors per run. */
+static int run_multi_batched(odp_ml_model_t model, const odp_ml_data_t data[],
+			     const odp_ml_run_param_t param[], int num)
+{
+	const uint32_t max_batch_size = _odp_ml_glb->max_batch_size;
+	int i = 0;
+	int ret = -1;
+
+	while (i < num) {
+		uint32_t batch_size = param[i].batch_size;
+		int n = 1;
+
+		while (batch_size && i + n < num && param[i + n].batch_size &&
+		       batch_size + param[i + n].batch_size <= max_batch_size) {
+			batch_size += param[i + n].batch_size;
+			n++;
+		}
+
+		if (n > 1) {
+			ret = run_batch(model, &data[i], &param[i], n, batch_size);
+
+			if (ret == 1) {
+				i += n;
+				continue;
+			}
+
+			if (ret == 0)
+				break;
+		}
+
+		for (int j = 0; j < n; j++) {
+			ret = odp_ml_run(model, &data[i], &param[i]);
+
+			if (odp_unlikely(ret != 1))
+				goto out;
+
+			i++;
+		}
+	}
+
+out:
+	if (odp_unlikely(i == 0))
+		return ret;
+
+	return i;
+}
+
 int odp_ml_run_multi(odp_ml_model_t model, const odp_ml_data_t data[],
 		     const odp_ml_run_param_t param[], int num)
 {
@@ -2396,6 +2682,9 @@ int odp_ml_run_multi(odp_ml_model_t model, const odp_ml_data_t data[],
 		return -1;
 	}
 
+	if (use_batching(model, param, num))
+		return run_multi_batched(model, data, param, num);
+
 	for (i = 0; i < num; i++) {
 		if (param)
 			ret = odp_ml_run(model, &data[i], &param[i]);
@@ -2412,6 +2701,35 @@ int odp_ml_run_multi(odp_ml_model_t model, const odp_ml_data_t data[],
 	return i;
 }
 
+/* Report completion of a run started with odp_ml_run_start() */
+static int run_compl(ml_model_t *mdl, const odp_ml_compl_param_t *compl_param)
+{
+	/* Send a completion event to the given queue */
+	if (compl_param->mode == ODP_ML_COMPL_MODE_EVENT) {
+		odp_ml_run_result_t *result;
+		odp_buffer_t buf = (odp_buffer_t)(uintptr_t)compl_param->event;
+
+		_odp_buffer_subtype_set(buf, ODP_EVENT_ML_COMPL_RUN);
+
+		result = odp_buffer_addr(buf);
+		result->error_code = 0;
+		result->user_ptr = compl_param->user_ptr;
+
+		if (odp_unlikely(odp_queue_enq(compl_param->queue, compl_param->event))) {
+			_ODP_ERR("Completion event enqueue failed %" PRIu64 "\n",
+				 odp_queue_to_u64(compl_param->queue));
+			return -1;
+		}
+
+		return 1;
+	}
+
+	/* compl_param->mode == ODP_ML_COMPL_MODE_POLL */
+	mdl->result[compl_param->compl_id].user_ptr = compl_param->user_ptr;
+
+	return 1;
+}
+
 int odp_ml_run_start(odp_ml_model_t model, const odp_ml_data_t *data,
 		     const odp_ml_compl_param_t *compl_param,
 		     const odp_ml_run_param_t *run_param)
@@ -2440,30 +2758,7 @@ int odp_ml_run_start(odp_ml_model_t model, const odp_ml_data_t *data,
 	if (odp_unlikely(ret < 1))
 		return ret;
 
-	/* Send a completion event to the given queue */
-	if (compl_param->mode == ODP_ML_COMPL_MODE_EVENT) {
-		odp_ml_run_result_t *result;
-		odp_buffer_t buf = (odp_buffer_t)(uintptr_t)compl_param->event;
-
-		_odp_buffer_subtype_set(buf, ODP_EVENT_ML_COMPL_RUN);
-
-		result = odp_buffer_addr(buf);
-		result->error_code = 0;
-		result->user_ptr = compl_param->user_ptr;
-
-		if (odp_unlikely(odp_queue_enq(compl_param->queue, compl_param->event))) {
-			_ODP_ERR("Completion event enqueue failed %" PRIu64 "\n",
-				 odp_queue_to_u64(compl_param->queue));
-			return -1;
-		}
-
-		return 1;
-	}
-
-	/* compl_param->mode == ODP_ML_COMPL_MODE_POLL */
-	mdl->result[compl_param->compl_id].user_ptr = compl_param->user_ptr;
-
-	return 1;
+	return run_compl(mdl, compl_param);
 }
 
 int odp_ml_run_start_multi(odp_ml_model_t model, const odp_ml_data_t data[],
@@ -2478,6 +2773,30 @@ int odp_ml_run_start_multi(odp_ml_model_t model, const odp_ml_data_t data[],
 		return -1;
 	}
 
+	if (use_batching(model, run_param, num)) {
+		ml_model_t *mdl = ml_model_from_handle(model);
+
+		for (i = 0; i < num; i++) {
+			if (odp_unlikely(check_compl_param(&compl_param[i], mdl->max_compl_id,
+							   false))) {
+				_ODP_ERR("Bad ML job completion parameter\n");
+				return -1;
+			}
+		}
+
+		ret = run_multi_batched(model, data, run_param, num);
+
+		/* Runs have been performed already, so all of them are reported as started.
+		 * A completion event that cannot be enqueued is freed, instead of being
+		 * left to the caller with a run that has already been performed. */
+		for (i = 0; i < ret; i++) {
+			if (odp_unlikely(run_compl(mdl, &compl_param[i]) != 1))
+				odp_event_free(compl_param[i].event);
+		}
+
+		return ret;
+	}
+
 	for (i = 0; i < num; i++) {
 		if (run_param)
 			ret = odp_ml_run_start(model, &data[i], &compl_param[i], &run_param[i]);
@@ -2540,9 +2859,11 @@ static int execution_mode_from_str(const char *mode_str, ExecutionMode *mode)
 	return 0;
 }
 
-static int read_config_file(ort_run_opts_t *opts)
+static int read_config_file(ml_global_t *glb)
 {
+	ort_run_opts_t *opts = &glb->ort_run_opts;
 	const char *conf_str;
+	int val = 0;
 	char mode_str[ML_MAX_CONFIG_STR_LEN];
 	char opt_level_str[ML_MAX_CONFIG_STR_LEN];
 
@@ -2602,6 +2923,19 @@ static int read_config_file(ort_run_opts_t *opts)
 	}
 	_ODP_PRINT("  %s: %s\n", conf_str, opts->opt_model_filepath);
 
+	conf_str =  "ml.max_batch_size";
+	if (!_odp_libconfig_lookup_int(conf_str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", conf_str);
+		return -1;
+	}
+
+	if (val < 0 || val > ML_MAX_BATCH_SIZE) {
+		_ODP_ERR("Bad value %s = %i (max %i)\n", conf_str, val, ML_MAX_BATCH_SIZE);
+		return -1;
+	}
+	glb->max_batch_size = val;
+	_ODP_PRINT("  %s: %i\n", conf_str, val);
+
 	return 0;
 }
 
@@ -2636,7 +2970,7 @@ int _odp_ml_init_global(void)
 
 	odp_pool_param_init(&_odp_ml_glb->pool_param);
 
-	if (read_config_file(&_odp_ml_glb->ort_run_opts))
+	if (read_config_file(_odp_ml_glb))
 		goto error;
 
 	ort_api = OrtGetApiBase()->GetApi(ORT_API_VERSION);
@@ -1851,6 +1851,12 @@ int odp_pktio_extra_stat_info(odp_pktio_t pktio,
 	if (entry->ops->extra_stat_info)
 		ret = entry->ops->extra_stat_info(entry, info, num);
 
+	if (ret >= 0) {
+		int num_cls = num > ret ? num - ret : 0;
+
+		ret += _odp_cls_extra_stat_info(entry, num_cls ? &info[ret] : NULL, num_cls);
+	}
+
 	unlock_entry(entry);
 
 	return ret;
@@ -1878,6 +1884,12 @@ int odp_pktio_extra_stats(odp_pktio_t pktio, uint64_t stats[], int num)
 	if (entry->ops->extra_stats)
 		ret = entry->ops->extra_stats(entry, stats, num);
 
+	if (ret >= 0) {
+		int num_cls = num > ret ? num - ret : 0;
+
+		ret += _odp_cls_extra_stats(entry, num_cls ? &stats[ret] : NULL, num_cls);
+	}
+
 	unlock_entry(entry);
 
 	return ret;
@@ -1905,6 +1917,17 @@ int odp_pktio_extra_stat_counter(odp_pktio_t pktio, uint32_t id, uint64_t *stat)
 	if (entry->ops->extra_stat_counter)
 		ret = entry->ops->extra_stat_counter(entry, id, stat);
 
+	if (ret < 0) {
+		/* Classifier counters follow driver counters */
+		int num_drv = 0;
+
+		if (entry->ops->extra_stat_info)
+			num_drv = entry->ops->extra_stat_info(entry, NULL, 0);
+
+		if (num_drv >= 0 && id >= (uint32_t)num_drv)
+			ret = _odp_cls_extra_stat_counter(entry, id - num_drv, stat);
+	}
+
 	unlock_entry(entry);
 
 	return ret;
@@ -26,6 +26,7 @@
 #include <ring/odp_ring_mpmc_rst_ptr_internal.h>
 #include <odp_global_data.h>
 #include <odp_libconfig_internal.h>
+#include <odp_service_thread_internal.h>
 #include <odp_shm_internal.h>
 #include <odp_timer_internal.h>
 #include <odp_event_vector_internal.h>
@@ -65,7 +66,6 @@ ODP_STATIC_ASSERT(CONFIG_INTERNAL_POOLS < CONFIG_POOLS,
 
 /* Thread local variables */
 typedef struct pool_local_t {
-	pool_cache_t *cache[CONFIG_POOLS];
 	int thr_id;
 
 } pool_local_t;
@@ -89,9 +89,19 @@ const _odp_pool_inline_offset_t _odp_pool_inline ODP_ALIGNED_CACHE = {
 
 #include <odp/visibility_end.h>
 
+static inline pool_cache_t *thread_cache(pool_t *pool, int thr_id)
+{
+	return (pool_cache_t *)(void *)(pool->local_cache +
+					(uint32_t)thr_id * pool->local_cache_stride);
+}
+
+static inline pool_cache_t *local_cache(pool_t *pool)
+{
+	return thread_cache(pool, local.thr_id);
+}
+
 static inline void cache_init(pool_cache_t *cache)
 {
-	memset(cache, 0, sizeof(pool_cache_t));
 	odp_atomic_init_u32(&cache->cache_num, 0);
 }
 
@@ -232,7 +242,7 @@ static inline int cache_available(pool_t *pool, odp_pool_stats_t *stats)
 	}
 
 	for (; i < idx_limit; i++) {
-		uint32_t cur = odp_atomic_load_u32(&pool->local_cache[i].cache_num);
+		uint32_t cur = odp_atomic_load_u32(&thread_cache(pool, i)->cache_num);
 
 		if (per_thread && i >= first && i <= last)
 			stats->thread.cache_available[out_idx++] = cur;
@@ -252,7 +262,7 @@ static inline uint64_t cache_total_available(pool_t *pool)
 	const int max_threads = odp_thread_count_max();
 
 	for (int i = 0; i < max_threads; i++)
-		cached += odp_atomic_load_u32(&pool->local_cache[i].cache_num);
+		cached += odp_atomic_load_u32(&thread_cache(pool, i)->cache_num);
 
 	return cached;
 }
@@ -450,19 +460,10 @@ int _odp_pool_term_global(void)
 
 int _odp_pool_init_local(void)
 {
-	pool_t *pool;
-	int i;
-	int thr_id = odp_thread_id();
-
 	memset(&local, 0, sizeof(pool_local_t));
 
-	for (i = 0; i < CONFIG_POOLS; i++) {
-		pool           = _odp_pool_entry_from_idx(i);
-		local.cache[i] = &pool->local_cache[thr_id];
-		cache_init(local.cache[i]);
-	}
-
-	local.thr_id = thr_id;
+	/* Local caches are initialized on pool create and flushed on thread term */
+	local.thr_id = odp_thread_id();
 	return 0;
 }
 
@@ -473,17 +474,22 @@ int _odp_pool_term_local(void)
 	for (i = 0; i < CONFIG_POOLS; i++) {
 		pool_t *pool = _odp_pool_entry_from_idx(i);
 
-		cache_flush(local.cache[i], pool);
+		if (pool->ring)
+			cache_flush(local_cache(pool), pool);
 	}
 
 	return 0;
 }
 
-static pool_t *reserve_pool(uint32_t shmflags, uint8_t pool_ext, uint32_t num)
+static void set_pool_cache_size(pool_t *pool, uint32_t cache_size);
+
+static pool_t *reserve_pool(uint32_t shmflags, uint8_t pool_ext, uint32_t num,
+			    uint32_t cache_size)
 {
 	int i;
 	odp_shm_t shm;
-	uint32_t mem_size;
+	uint64_t mem_size, cache_offset;
+	uint32_t max_threads = odp_thread_count_max();
 	pool_t *pool;
 	char ring_name[ODP_SHM_NAME_LEN];
 
@@ -498,12 +504,23 @@ static pool_t *reserve_pool(uint32_t shmflags, uint8_t pool_ext, uint32_t num)
 			memset(&pool->memset_mark, 0,
 			       sizeof(pool_t) - offsetof(pool_t, memset_mark));
 			sprintf(ring_name, "_odp_pool_ring_%d", i);
+			set_pool_cache_size(pool, cache_size);
 
 			/* Reserve memory for the ring, and for lookup table in case of pool ext */
 			mem_size = sizeof(pool_ring_t);
 			if (pool_ext)
 				mem_size += num * sizeof(_odp_event_hdr_t *);
 
+			/* Local caches of all threads follow the ring. A cache stores at
+			 * most cache_size events, or burst_size events when caching is
+			 * disabled. */
+			cache_offset = _ODP_ROUNDUP_CACHE_LINE(mem_size);
+			pool->local_cache_stride =
+				_ODP_ROUNDUP_CACHE_LINE(sizeof(pool_cache_t) +
+							_ODP_MAX(pool->cache_size, pool->burst_size) *
+							sizeof(_odp_event_hdr_t *));
+			mem_size = cache_offset + (uint64_t)max_threads * pool->local_cache_stride;
+
 			shm = odp_shm_reserve(ring_name, mem_size, ODP_CACHE_LINE_SIZE, shmflags);
 
 			if (odp_unlikely(shm == ODP_SHM_INVALID)) {
@@ -517,6 +534,10 @@ static pool_t *reserve_pool(uint32_t shmflags, uint8_t pool_ext, uint32_t num)
 			pool->ring_shm = shm;
 			pool->ring = odp_shm_addr(shm);
 			pool->pool_ext = pool_ext;
+			pool->local_cache = (uint8_t *)pool->ring + cache_offset;
+
+			for (uint32_t thr = 0; thr < max_threads; thr++)
+				cache_init(thread_cache(pool, thr));
 
 			return pool;
 		}
@@ -607,61 +628,58 @@ static void init_event_hdr(pool_t *pool, _odp_event_hdr_t *event_hdr, uint32_t e
 	}
 }
 
-static void init_buffers(pool_t *pool)
+typedef struct {
+	pool_t *pool;
+	uint64_t page_size;
+	/* First block and event index of each part */
+	uint64_t first_block[_ODP_SERVICE_THREAD_MAX_CPUS];
+	uint32_t first_event[_ODP_SERVICE_THREAD_MAX_CPUS + 1];
+
+} init_buffers_t;
+
+/* Packet buffers which cross huge page boundaries are skipped. Some NICs
+ * cannot handle buffers which cross page boundaries. */
+static inline int skip_block(pool_t *pool, uint64_t page_size, uint64_t block_idx)
 {
+	uint64_t addr = (uint64_t)(uintptr_t)&pool->base_addr[block_idx * pool->block_size];
+	uint64_t first_page, last_page;
+
+	if (pool->type != ODP_POOL_PACKET || page_size < FIRST_HP_SIZE)
+		return 0;
+
+	first_page = addr & ~(page_size - 1);
+	last_page = (addr + pool->block_size - 1) & ~(page_size - 1);
+
+	return last_page != first_page;
+}
+
+static void init_buffers_part(void *arg, int idx, int num ODP_UNUSED)
+{
+	init_buffers_t *init = arg;
+	pool_t *pool = init->pool;
 	_odp_event_hdr_t *event_hdr;
 	odp_buffer_hdr_t *buf_hdr;
 	odp_packet_hdr_t *pkt_hdr;
-	odp_shm_info_t shm_info;
 	void *addr;
 	void *uarea = NULL;
 	uint8_t *data = NULL;
 	uint8_t *data_ptr = NULL;
 	uint32_t offset;
-	ring_mpmc_rst_ptr_t *ring;
-	_odp_event_hdr_t **ring_data;
-	uint32_t mask;
-	odp_pool_type_t type;
-	uint64_t page_size;
-	int skipped_blocks = 0;
-
-	if (odp_shm_info(pool->shm, &shm_info))
-		_ODP_ABORT("Shm info failed\n");
+	odp_pool_type_t type = pool->type;
+	uint64_t i = init->first_block[idx];
+	uint32_t event = init->first_event[idx];
 
-	page_size = shm_info.page_size;
-	ring = &pool->ring->hdr;
-	ring_data = pool->ring->event_hdr;
-	mask = pool->ring_mask;
-	type = pool->type;
-
-	for (uint64_t i = 0; i < pool->num + skipped_blocks ; i++) {
-		addr = &pool->base_addr[i * pool->block_size];
-
-		/* Skip packet buffers which cross huge page boundaries. Some
-		 * NICs cannot handle buffers which cross page boundaries. */
-		if (type == ODP_POOL_PACKET && page_size >= FIRST_HP_SIZE) {
-			uint64_t first_page;
-			uint64_t last_page;
-
-			first_page = ((uint64_t)(uintptr_t)addr &
-					~(page_size - 1));
-			last_page = (((uint64_t)(uintptr_t)addr +
-					pool->block_size - 1) &
-					~(page_size - 1));
-			if (last_page != first_page) {
-				skipped_blocks++;
-				continue;
-			}
-		}
+	for (; event < init->first_event[idx + 1]; i++) {
+		if (skip_block(pool, init->page_size, i))
+			continue;
 
-		addr = (uint8_t *)addr + pool->block_offset;
+		addr = &pool->base_addr[i * pool->block_size + pool->block_offset];
 		event_hdr = addr;
 		buf_hdr = addr;
 		pkt_hdr = addr;
 
 		if (pool->uarea_size)
-			uarea = &pool->uarea_base_addr[(i - skipped_blocks) *
-						       pool->uarea_size];
+			uarea = &pool->uarea_base_addr[event * pool->uarea_size];
 
 		/* Only buffers and packets have data pointer */
 		if (type == ODP_POOL_BUFFER || type == ODP_POOL_PACKET) {
@@ -680,17 +698,76 @@ static void init_buffers(pool_t *pool)
 		}
 
 		init_event_hdr(pool, event_hdr, i, data_ptr, uarea);
+		event++;
+	}
+}
+
+static void init_buffers(pool_t *pool)
+{
+	init_buffers_t init;
+	odp_shm_info_t shm_info;
+	ring_mpmc_rst_ptr_t *ring;
+	_odp_event_hdr_t **ring_data;
+	_odp_event_hdr_t *event_hdr;
+	uint32_t mask;
+	uint32_t event = 0;
+	uint64_t i;
+	int num_part = 1;
+	int part = 0;
+	int skipped_blocks = 0;
 
-		/* Store buffer into the global pool */
+	if (odp_shm_info(pool->shm, &shm_info))
+		_ODP_ABORT("Shm info failed\n");
+
+	ring = &pool->ring->hdr;
+	ring_data = pool->ring->event_hdr;
+	mask = pool->ring_mask;
+
+	/* Event headers of large pools are initialized in parallel */
+	if (odp_global_ro.mem_init_threads > 1 &&
+	    pool->shm_size >= odp_global_ro.mem_init_min_size)
+		num_part = odp_global_ro.mem_init_threads;
+
+	if ((uint32_t)num_part > pool->num)
+		num_part = pool->num ? pool->num : 1;
+
+	init.pool = pool;
+	init.page_size = shm_info.page_size;
+	init.first_block[0] = 0;
+
+	for (part = 0; part <= num_part; part++)
+		init.first_event[part] = ((uint64_t)pool->num * part) / num_part;
+
+	/* Split events into parts and store them into the global pool. Event
+	 * headers are written only after this. */
+	part = 0;
+	for (i = 0; event < pool->num; i++) {
+		if (skip_block(pool, init.page_size, i)) {
+			skipped_blocks++;
+			continue;
+		}
+
+		while (part < num_part && init.first_event[part] == event)
+			init.first_block[part++] = i;
+
+		event_hdr = (_odp_event_hdr_t *)(uintptr_t)&pool->base_addr[i * pool->block_size +
+									     pool->block_offset];
 		ring_mpmc_rst_ptr_enq(ring, (void **)ring_data, mask, event_hdr);
+		event++;
 	}
 	pool->skipped_blocks = skipped_blocks;
 
+	if (num_part > 1)
+		_odp_service_thread_parallel(num_part, init_buffers_part, &init);
+	else
+		init_buffers_part(&init, 0, 1);
+
 	if (pool->uarea_size && pool->params.uarea_init.init_fn) {
-		for (uint32_t i = 0; i < pool->num; i++) {
-			uarea = &pool->uarea_base_addr[i * pool->uarea_size];
+		for (uint32_t j = 0; j < pool->num; j++) {
+			void *uarea = &pool->uarea_base_addr[j * pool->uarea_size];
+
 			pool->params.uarea_init.init_fn(uarea, pool->param_uarea_size,
-							pool->params.uarea_init.args, i);
+							pool->params.uarea_init.args, j);
 		}
 	}
 }
@@ -925,7 +1002,7 @@ odp_pool_t _odp_pool_create(const char *name, const odp_pool_param_t *params,
 		return ODP_POOL_INVALID;
 	}
 
-	pool = reserve_pool(shmflags, 0, num);
+	pool = reserve_pool(shmflags, 0, num, cache_size);
 
 	if (pool == NULL) {
 		_ODP_ERR("No more free pools\n");
@@ -1008,8 +1085,6 @@ odp_pool_t _odp_pool_create(const char *name, const odp_pool_param_t *params,
 	pool->block_size     = block_size;
 	pool->shm_size       = (num + num_extra) * (uint64_t)block_size;
 
-	set_pool_cache_size(pool, cache_size);
-
 	shm = odp_shm_reserve(shm_name, pool->shm_size, ODP_PAGE_SIZE,
 			      shmflags);
 
@@ -1309,7 +1384,7 @@ int odp_pool_destroy(odp_pool_t pool_hdl)
 
 	/* Make sure local caches are empty */
 	for (i = 0; i < max_threads; i++)
-		cache_flush(&pool->local_cache[i], pool);
+		cache_flush(thread_cache(pool, i), pool);
 
 	if (pool->pool_ext == 0)
 		odp_shm_free(pool->shm);
@@ -1385,7 +1460,7 @@ int odp_pool_info(odp_pool_t pool_hdl, odp_pool_info_t *info)
 
 odp_event_t _odp_event_alloc(pool_t *pool)
 {
-	pool_cache_t *cache = local.cache[pool->pool_idx];
+	pool_cache_t *cache = local_cache(pool);
 	_odp_event_hdr_t *hdr;
 	uint32_t cached;
 
@@ -1420,8 +1495,7 @@ odp_event_t _odp_event_alloc(pool_t *pool)
 
 int _odp_event_alloc_multi(pool_t *pool, _odp_event_hdr_t *event_hdr[], int max_num)
 {
-	uint32_t pool_idx = pool->pool_idx;
-	pool_cache_t *cache = local.cache[pool_idx];
+	pool_cache_t *cache = local_cache(pool);
 	ring_mpmc_rst_ptr_t *ring;
 	_odp_event_hdr_t **ring_data;
 	_odp_event_hdr_t *hdr;
@@ -1486,8 +1560,7 @@ int _odp_event_alloc_multi(pool_t *pool, _odp_event_hdr_t *event_hdr[], int max_
 static inline void event_free_to_pool(pool_t *pool,
 				      _odp_event_hdr_t *event_hdr[], int num)
 {
-	uint32_t pool_idx = pool->pool_idx;
-	pool_cache_t *cache = local.cache[pool_idx];
+	pool_cache_t *cache = local_cache(pool);
 	ring_mpmc_rst_ptr_t *ring;
 	_odp_event_hdr_t **ring_data;
 	uint32_t cache_num, mask;
@@ -1540,7 +1613,7 @@ void _odp_event_free(odp_event_t event)
 {
 	_odp_event_hdr_t *event_hdr = _odp_event_hdr(event);
 	pool_t *pool = _odp_pool_entry(event_hdr->pool);
-	pool_cache_t *cache = local.cache[pool->pool_idx];
+	pool_cache_t *cache = local_cache(pool);
 	const uint32_t cache_size = pool->cache_size;
 	uint32_t cache_num;
 
@@ -1782,6 +1855,12 @@ static const char *get_short_type_str(odp_pool_type_t type)
 	}
 }
 
+/* Memory used for local caches of all threads */
+static uint64_t local_cache_mem_size(pool_t *pool)
+{
+	return (uint64_t)odp_thread_count_max() * pool->local_cache_stride;
+}
+
 void odp_pool_print(odp_pool_t pool_hdl)
 {
 	pool_t *pool;
@@ -1811,6 +1890,7 @@ void odp_pool_print(odp_pool_t pool_hdl)
 	_ODP_PRINT("  uarea base addr %p\n", (void *)pool->uarea_base_addr);
 	_ODP_PRINT("  cache size      %u\n", pool->cache_size);
 	_ODP_PRINT("  burst size      %u\n", pool->burst_size);
+	_ODP_PRINT("  cache mem size  %" PRIu64 "\n", local_cache_mem_size(pool));
 	_ODP_PRINT("  mem src         %s\n",
 		   pool->mem_src_ops ? pool->mem_src_ops->name : "(none)");
 	_ODP_PRINT("  event valid.    %d\n", _ODP_EVENT_VALIDATION);
@@ -1819,16 +1899,23 @@ void odp_pool_print(odp_pool_t pool_hdl)
 
 void odp_pool_print_all(void)
 {
-	uint64_t available;
+	uint64_t available, cache_mem;
+	uint64_t cache_mem_tot = 0, cache_mem_max = 0;
 	uint32_t i, index, tot, cache_size, seg_len;
 	uint32_t buf_len = 0;
 	uint8_t type, ext;
 	const int col_width = 24;
 	const char *name, *type_c;
+	/* Local cache memory per pool, if caches were sized for the maximum cache size
+	 * and thread count */
+	const uint64_t static_cache_mem = (uint64_t)ODP_THREAD_COUNT_MAX *
+		_ODP_ROUNDUP_CACHE_LINE(sizeof(pool_cache_t) +
+					CONFIG_POOL_CACHE_MAX_SIZE * sizeof(_odp_event_hdr_t *));
 
 	_ODP_PRINT("\nList of all pools\n");
 	_ODP_PRINT("-----------------\n");
-	_ODP_PRINT(" idx %-*s type   free    tot  cache  buf_len  ext\n", col_width, "name");
+	_ODP_PRINT(" idx %-*s type   free    tot  cache  buf_len  ext  cache_kB\n", col_width,
+		   "name");
 
 	for (i = 0; i < CONFIG_POOLS; i++) {
 		pool_t *pool = _odp_pool_entry_from_idx(i);
@@ -1848,18 +1935,26 @@ void odp_pool_print_all(void)
 		tot        = pool->num;
 		type       = pool->type;
 		seg_len    = pool->seg_len;
+		cache_mem  = local_cache_mem_size(pool);
 
 		UNLOCK(&pool->lock);
 
+		cache_mem_tot += cache_mem;
+		cache_mem_max += static_cache_mem;
+
 		if (type == ODP_POOL_BUFFER || type == ODP_POOL_PACKET)
 			buf_len = seg_len;
 
 		type_c = get_short_type_str(pool->type_2);
 
 		_ODP_PRINT("%4u %-*s    %s %6" PRIu64 " %6" PRIu32 " %6" PRIu32 " %8" PRIu32 "    "
-			  "%" PRIu8 "\n", index, col_width, name, type_c, available, tot,
-			  cache_size, buf_len, ext);
+			  "%" PRIu8 " %9" PRIu64 "\n", index, col_width, name, type_c, available, tot,
+			  cache_size, buf_len, ext, cache_mem / 1024);
 	}
+
+	_ODP_PRINT("\nLocal cache memory: %" PRIu64 " kB (%" PRIu64 " kB saved vs. %u threads and "
+		   "max cache size)\n", cache_mem_tot / 1024, (cache_mem_max - cache_mem_tot) / 1024,
+		   ODP_THREAD_COUNT_MAX);
 	_ODP_PRINT("\n");
 }
 
@@ -2199,7 +2294,7 @@ odp_pool_t odp_pool_ext_create(const char *name, const odp_pool_ext_param_t *par
 	if (odp_global_ro.shm_single_va)
 		shm_flags |= ODP_SHM_SINGLE_VA;
 
-	pool = reserve_pool(shm_flags, 1, num_buf);
+	pool = reserve_pool(shm_flags, 1, num_buf, param->cache_size);
 
 	if (pool == NULL) {
 		_ODP_ERR("No more free pools\n");
@@ -2208,7 +2303,6 @@ odp_pool_t odp_pool_ext_create(const char *name, const odp_pool_ext_param_t *par
 
 	pool->ext_param = *param;
 	set_pool_name(pool, name);
-	set_pool_cache_size(pool, param->cache_size);
 
 	if (reserve_uarea(pool, param->pkt.uarea_size, num_buf, shm_flags)) {
 		_ODP_ERR("User area SHM reserve failed\n");
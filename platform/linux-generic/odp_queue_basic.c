@@ -38,9 +38,10 @@
 #include <stdalign.h>
 #include <string.h>
 
-#define LOCK(queue_ptr)      odp_ticketlock_lock(&((queue_ptr)->lock))
-#define UNLOCK(queue_ptr)    odp_ticketlock_unlock(&((queue_ptr)->lock))
-#define LOCK_INIT(queue_ptr) odp_ticketlock_init(&((queue_ptr)->lock))
+#define LOCK(queue_ptr)      _odp_lock(&((queue_ptr)->lock), _odp_queue_glb->config.lock_type)
+#define UNLOCK(queue_ptr)    _odp_unlock(&((queue_ptr)->lock), _odp_queue_glb->config.lock_type)
+#define LOCK_INIT(queue_ptr) _odp_lock_init(&((queue_ptr)->lock), \
+					    _odp_queue_glb->config.lock_type)
 
 #define MIN_QUEUE_SIZE 32
 #define MAX_QUEUE_SIZE (1 * 1024 * 1024)
@@ -119,7 +120,21 @@ static int read_config_file(queue_global_t *_odp_queue_glb)
 	}
 
 	_odp_queue_glb->config.default_queue_size = val_u32;
-	_ODP_PRINT("  %s: %u\n\n", str, val_u32);
+	_ODP_PRINT("  %s: %u\n", str, val_u32);
+
+	str = "queue_basic.lock_type";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > _ODP_LOCK_TYPE_MAX) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	_odp_queue_glb->config.lock_type = val;
+	_ODP_PRINT("  %s: %i\n\n", str, val);
 
 	return 0;
 }
@@ -559,6 +574,37 @@ void _odp_sched_queue_set_status(uint32_t queue_index, int status)
 	UNLOCK(queue);
 }
 
+void _odp_sched_queue_park(uint32_t queue_index)
+{
+	queue_entry_t *queue = qentry_from_index(queue_index);
+
+	LOCK(queue);
+
+	if (queue->status == QUEUE_STATUS_SCHED)
+		queue->status = QUEUE_STATUS_NOTSCHED;
+
+	UNLOCK(queue);
+}
+
+void _odp_sched_queue_unpark(uint32_t queue_index)
+{
+	queue_entry_t *queue = qentry_from_index(queue_index);
+	int sched = 0;
+
+	LOCK(queue);
+
+	if (queue->status == QUEUE_STATUS_NOTSCHED) {
+		queue->status = QUEUE_STATUS_SCHED;
+		sched = 1;
+	}
+
+	UNLOCK(queue);
+
+	/* Add queue back to scheduling */
+	if (sched && _odp_sched_fn->sched_queue(queue_index))
+		_ODP_ABORT("schedule_queue failed\n");
+}
+
 static int queue_destroy(odp_queue_t handle)
 {
 	int empty;
@@ -7,14 +7,16 @@
 #include <odp/api/random.h>
 
 #include <odp/autoheader_internal.h>
+#include <odp_debug_internal.h>
+#include <odp_global_data.h>
 #include <odp_init_internal.h>
+#include <odp_libconfig_internal.h>
+#include <odp_random_drbg_internal.h>
 #include <odp_random_std_internal.h>
 #include <odp_random_openssl_internal.h>
 #include <odp_random.h>
 
 #if defined(__aarch64__) && defined(__ARM_FEATURE_RNG)
-#include <odp_global_data.h>
-
 #include <asm/hwcap.h>
 #include <sys/auxv.h>
 
@@ -27,7 +29,7 @@ odp_random_kind_t odp_random_max_kind(void)
 {
 	odp_random_kind_t kind, max_kind = ODP_RANDOM_BASIC;
 
-	if (_ODP_OPENSSL_RAND)
+	if (_ODP_OPENSSL_RAND || odp_global_ro.random_drbg)
 		max_kind = ODP_RANDOM_CRYPTO;
 
 	kind = _odp_random_max_kind();
@@ -41,10 +43,15 @@ int32_t odp_random_data(uint8_t *buf, uint32_t len, odp_random_kind_t kind)
 {
 	switch (kind) {
 	case ODP_RANDOM_BASIC:
-		if (_ODP_OPENSSL_RAND)
+		if (_ODP_OPENSSL_RAND) {
+			if (odp_global_ro.random_drbg)
+				return _odp_random_drbg_data(buf, len);
 			return _odp_random_openssl_data(buf, len);
+		}
 		return _odp_random_std_data(buf, len);
 	case ODP_RANDOM_CRYPTO:
+		if (odp_global_ro.random_drbg)
+			return _odp_random_drbg_data(buf, len);
 		if (_ODP_OPENSSL_RAND)
 			return _odp_random_openssl_data(buf, len);
 		return _odp_random_crypto_data(buf, len);
@@ -60,12 +67,46 @@ int32_t odp_random_test_data(uint8_t *buf, uint32_t len, uint64_t *seed)
 	return _odp_random_std_test_data(buf, len, seed);
 }
 
+static int read_config_file(void)
+{
+	const char *str;
+	int val = 0;
+
+	_ODP_PRINT("Random config:\n");
+
+	str = "random.drbg";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+	if (val != 0 && val != 1) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+	odp_global_ro.random_drbg = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "random.drbg_reseed_kb";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+	if (val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+	odp_global_ro.random_drbg_reseed = (uint64_t)val * 1024;
+	_ODP_PRINT("  %s: %i\n\n", str, val);
+
+	return 0;
+}
+
 int _odp_random_init_global(void)
 {
 #if defined(__aarch64__) && defined(__ARM_FEATURE_RNG)
 	odp_global_ro.flags.has_arm_rng = (getauxval(AT_HWCAP2) & HWCAP2_RNG) ? 1 : 0;
 #endif
-	return 0;
+	return read_config_file();
 }
 
 int _odp_random_term_global(void)
@@ -75,6 +116,9 @@ int _odp_random_term_global(void)
 
 int _odp_random_init_local(void)
 {
+	if (odp_global_ro.random_drbg && _odp_random_drbg_init_local())
+		return -1;
+
 	if (_ODP_OPENSSL_RAND)
 		return _odp_random_openssl_init_local();
 	return _odp_random_std_init_local();
@@ -82,6 +126,9 @@ int _odp_random_init_local(void)
 
 int _odp_random_term_local(void)
 {
+	if (odp_global_ro.random_drbg)
+		_odp_random_drbg_term_local();
+
 	if (_ODP_OPENSSL_RAND)
 		return _odp_random_openssl_term_local();
 	return _odp_random_std_term_local();
@@ -0,0 +1,224 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/*
+ * Per thread ChaCha20 [1] based deterministic random bit generator
+ *
+ * Each thread runs its own ChaCha20 keystream generator, so random data calls
+ * do not need locks or system calls. Key is replaced after every buffer fill
+ * with the first 32 bytes of the generated keystream ("fast key erasure" [2]),
+ * and used output is cleared from the buffer. Key is seeded from the OS
+ * (getrandom()) in thread init (or on first use) and reseeded from the OS after
+ * every odp_global_ro.random_drbg_reseed bytes of output.
+ *
+ * [1] ChaCha20 and Poly1305 for IETF Protocols. RFC 8439, June 2018.
+ * [2] Fast-key-erasure random-number generators. D. J. Bernstein, July 2017.
+ *     https://blog.cr.yp.to/20170723-random.html
+ */
+
+#include <odp_posix_extensions.h>
+
+#include <odp/api/hints.h>
+
+#include <odp_debug_internal.h>
+#include <odp_global_data.h>
+#include <odp_random_drbg_internal.h>
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/random.h>
+
+#define CHACHA_BLOCK_SIZE 64
+#define CHACHA_KEY_WORDS  8
+#define CHACHA_KEY_SIZE   (CHACHA_KEY_WORDS * 4)
+
+/* Number of ChaCha20 blocks generated per buffer fill */
+#define DRBG_BLOCKS   8
+#define DRBG_BUF_SIZE (DRBG_BLOCKS * CHACHA_BLOCK_SIZE - CHACHA_KEY_SIZE)
+
+typedef struct {
+	uint32_t key[CHACHA_KEY_WORDS];
+	uint8_t buf[DRBG_BUF_SIZE];
+	/* Number of unused bytes at the end of the buffer */
+	uint32_t num;
+	/* Output bytes left until next reseed. Zero also when not seeded yet. */
+	uint64_t reseed_left;
+
+} drbg_t;
+
+static __thread drbg_t drbg;
+
+#define ROTL32(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+
+#define QUARTER_ROUND(a, b, c, d) \
+	do { \
+		a += b; d ^= a; d = ROTL32(d, 16); \
+		c += d; b ^= c; b = ROTL32(b, 12); \
+		a += b; d ^= a; d = ROTL32(d, 8);  \
+		c += d; b ^= c; b = ROTL32(b, 7);  \
+	} while (0)
+
+static inline void store_le32(uint8_t *p, uint32_t v)
+{
+	p[0] = v;
+	p[1] = v >> 8;
+	p[2] = v >> 16;
+	p[3] = v >> 24;
+}
+
+static inline uint32_t load_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 |
+	       (uint32_t)p[3] << 24;
+}
+
+void _odp_chacha20_block(const uint32_t key[CHACHA_KEY_WORDS], uint32_t counter,
+			 uint8_t out[CHACHA_BLOCK_SIZE])
+{
+	uint32_t in[16], x[16];
+
+	/* "expand 32-byte k" */
+	in[0] = 0x61707865;
+	in[1] = 0x3320646e;
+	in[2] = 0x79622d32;
+	in[3] = 0x6b206574;
+	for (int i = 0; i < CHACHA_KEY_WORDS; i++)
+		in[4 + i] = key[i];
+	/* Key changes on every fill, so a zero nonce is fine */
+	in[12] = counter;
+	in[13] = 0;
+	in[14] = 0;
+	in[15] = 0;
+
+	memcpy(x, in, sizeof(x));
+
+	for (int i = 0; i < 10; i++) {
+		QUARTER_ROUND(x[0], x[4], x[8],  x[12]);
+		QUARTER_ROUND(x[1], x[5], x[9],  x[13]);
+		QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+		QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+		QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+		QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+		QUARTER_ROUND(x[2], x[7], x[8],  x[13]);
+		QUARTER_ROUND(x[3], x[4], x[9],  x[14]);
+	}
+
+	for (int i = 0; i < 16; i++)
+		store_le32(&out[4 * i], x[i] + in[i]);
+}
+
+static int os_random(uint8_t *buf, uint32_t len)
+{
+	while (len) {
+		ssize_t ret = getrandom(buf, len, 0);
+
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+
+			_ODP_ERR("getrandom() failed: %s\n", strerror(errno));
+			return -1;
+		}
+
+		buf += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+static int reseed(void)
+{
+	uint8_t seed[CHACHA_KEY_SIZE];
+
+	if (os_random(seed, sizeof(seed)))
+		return -1;
+
+	for (int i = 0; i < CHACHA_KEY_WORDS; i++)
+		drbg.key[i] ^= load_le32(&seed[4 * i]);
+
+	memset(seed, 0, sizeof(seed));
+
+	/* Discard output generated with the old key */
+	drbg.num = 0;
+	drbg.reseed_left = odp_global_ro.random_drbg_reseed;
+	if (drbg.reseed_left == 0)
+		drbg.reseed_left = UINT64_MAX;
+
+	return 0;
+}
+
+static void fill(void)
+{
+	uint8_t block[CHACHA_BLOCK_SIZE];
+
+	/* All blocks are generated with the current key. First block contains the new key
+	 * and start of the output. */
+	_odp_chacha20_block(drbg.key, 0, block);
+
+	for (uint32_t i = 1; i < DRBG_BLOCKS; i++)
+		_odp_chacha20_block(drbg.key, i, &drbg.buf[i * CHACHA_BLOCK_SIZE - CHACHA_KEY_SIZE]);
+
+	memcpy(drbg.buf, &block[CHACHA_KEY_SIZE], CHACHA_BLOCK_SIZE - CHACHA_KEY_SIZE);
+
+	for (int i = 0; i < CHACHA_KEY_WORDS; i++)
+		drbg.key[i] = load_le32(&block[4 * i]);
+
+	memset(block, 0, sizeof(block));
+	drbg.num = DRBG_BUF_SIZE;
+}
+
+int32_t _odp_random_drbg_data(uint8_t *buf, uint32_t len)
+{
+	uint32_t left = len;
+
+	if (odp_unlikely(drbg.reseed_left == 0) && reseed())
+		return -1;
+
+	while (left) {
+		uint32_t n, pos;
+
+		if (odp_unlikely(drbg.num == 0))
+			fill();
+
+		n = left < drbg.num ? left : drbg.num;
+		pos = DRBG_BUF_SIZE - drbg.num;
+
+		memcpy(buf, &drbg.buf[pos], n);
+		memset(&drbg.buf[pos], 0, n);
+
+		drbg.num -= n;
+		buf += n;
+		left -= n;
+	}
+
+	drbg.reseed_left = drbg.reseed_left > len ? drbg.reseed_left - len : 0;
+
+	return len;
+}
+
+void _odp_random_drbg_seed(const uint8_t seed[CHACHA_KEY_SIZE])
+{
+	for (int i = 0; i < CHACHA_KEY_WORDS; i++)
+		drbg.key[i] = load_le32(&seed[4 * i]);
+
+	memset(drbg.buf, 0, sizeof(drbg.buf));
+	drbg.num = 0;
+	drbg.reseed_left = UINT64_MAX;
+}
+
+int _odp_random_drbg_init_local(void)
+{
+	memset(&drbg, 0, sizeof(drbg));
+
+	return reseed();
+}
+
+int _odp_random_drbg_term_local(void)
+{
+	memset(&drbg, 0, sizeof(drbg));
+
+	return 0;
+}
@@ -22,6 +22,8 @@
 #include <odp/api/sync.h>
 #include <odp/api/packet_io.h>
 #include <ring/odp_ring_mpmc_rst_u32_internal.h>
+#include <ring/odp_ring_mpmc_u32_internal.h>
+#include <ring/odp_ring_spsc_ptr_internal.h>
 #include <odp_timer_internal.h>
 #include <odp_queue_basic_internal.h>
 #include <odp_libconfig_internal.h>
@@ -29,6 +31,7 @@
 #include <odp/api/plat/schedule_inline_types.h>
 #include <odp_global_data.h>
 #include <odp_event_internal.h>
+#include <odp_packet_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_string_internal.h>
 
@@ -39,14 +42,20 @@
 /* No synchronization context */
 #define NO_SYNC_CONTEXT ODP_SCHED_SYNC_PARALLEL
 
-/* Number of priority levels  */
-#define NUM_PRIO 8
+/* Maximum number of priority levels */
+#define MAX_PRIO 32
 
-/* Group mask (prio_grp_mask) size in bits */
+/* Number of priority level elements in burst size configuration arrays */
+#define NUM_BURST_PRIO 8
+
+/* Group mask word size in bits */
 #define GRP_MASK_BITS 64
 
-/* Number of scheduling groups. Maximum value is GRP_MASK_BITS. */
-#define NUM_SCHED_GRPS GRP_MASK_BITS
+/* Maximum number of scheduling groups. Group index needs to fit into 8 bits. */
+#define MAX_SCHED_GRPS 256
+
+/* Number of words in a group mask */
+#define GRP_MASK_WORDS (MAX_SCHED_GRPS / GRP_MASK_BITS)
 
 /* Spread balancing frequency. Balance every BALANCE_ROUNDS_M1 + 1 scheduling rounds. */
 #define BALANCE_ROUNDS_M1 0xfffff
@@ -92,8 +101,8 @@ ODP_STATIC_ASSERT((QUEUE_LOAD * CONFIG_MAX_SCHED_QUEUES) < UINT32_MAX, "Load_val
 /* Maximum pktin index. Needs to fit into 8 bits. */
 #define MAX_PKTIN_INDEX 255
 
-/* Maximum priority queue ring size. A ring must be large enough to store all
- * queues in the worst case (all queues are scheduled, have the same priority
+/* Maximum priority queue ring size. By default, a ring is large enough to store
+ * all queues in the worst case (all queues are scheduled, have the same priority
  * and no spreading). */
 #define MAX_RING_SIZE CONFIG_MAX_SCHED_QUEUES
 
@@ -112,6 +121,11 @@ ODP_STATIC_ASSERT(ODP_THREAD_COUNT_MAX < (64 * 1024),
 /* Mask of queues per priority */
 typedef uint8_t prio_q_mask_t;
 
+/* Mask of schedule groups */
+typedef struct {
+	uint64_t u64[GRP_MASK_WORDS];
+} grp_mask_t;
+
 ODP_STATIC_ASSERT((8 * sizeof(prio_q_mask_t)) >= MAX_SPREAD,
 		  "prio_q_mask_t_is_too_small");
 
@@ -125,6 +139,27 @@ ODP_STATIC_ASSERT((8 * sizeof(prio_q_mask_t)) >= MAX_SPREAD,
 /* Ordered stash size */
 #define MAX_ORDERED_STASH 512
 
+/* Maximum number of reorder buffer slots */
+#define MAX_REORDER_SLOTS 4096
+
+/* Maximum distance of a deposited ordered context from the oldest unreleased
+ * context of the source queue */
+#define REORDER_WINDOW 256
+
+ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(MAX_REORDER_SLOTS), "Reorder_slots_not_power_of_two");
+ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(REORDER_WINDOW), "Reorder_window_not_power_of_two");
+
+/* Maximum number of flow bins per atomic queue */
+#define MAX_FLOW_BINS 256
+
+/* Maximum number of events per flow bin */
+#define MAX_FLOW_BIN_SIZE 4096
+
+/* Maximum number of events dequeued from an atomic queue for distribution into flow bins */
+#define FLOW_DEQ_SIZE CONFIG_BURST_SIZE
+
+ODP_STATIC_ASSERT(MAX_FLOW_BINS <= BUF_HDR_MAX_FLOW_ID + 1, "Too_many_flow_bins");
+
 /* Storage for stashed enqueue operation arguments */
 typedef struct {
 	_odp_event_hdr_t *event_hdr[QUEUE_MULTI_MAX];
@@ -132,15 +167,90 @@ typedef struct {
 	int num;
 } ordered_stash_t;
 
+/* Number of ordered locks per queue. Implementation internal sequencing
+ * points (schedule_order_seq_t) follow the application ordered locks. */
+#define NUM_ORD_LOCKS (CONFIG_QUEUE_MAX_ORD_LOCKS + SCHED_ORDER_SEQ_NUM)
+
 /* Ordered lock states */
 typedef union {
-	uint8_t u8[CONFIG_QUEUE_MAX_ORD_LOCKS];
+	uint8_t u8[NUM_ORD_LOCKS];
 	uint32_t all;
 } lock_called_t;
 
+/* Sequencing point states in lock_called_t */
+#define ORD_SEQ_HELD   1
+#define ORD_SEQ_PASSED 2
+
 ODP_STATIC_ASSERT(sizeof(lock_called_t) == sizeof(uint32_t),
 		  "Lock_called_values_do_not_fit_in_uint32");
 
+/* Reorder buffer slot. Stores the stashed enqueue operations of an ordered
+ * context, which was released before it was the oldest context of its queue. */
+typedef struct ODP_ALIGNED_CACHE {
+	uint64_t ctx;
+	int stash_num;
+	lock_called_t lock_called;
+	ordered_stash_t stash[];
+} reorder_slot_t;
+
+/* Reorder buffer index word: deposited context in the upper bits and slot index + 1 in the
+ * lower bits. Window positions are reused for every REORDER_WINDOW contexts, the context tags
+ * the entry so that a late releaser cannot claim a slot deposited for a later context. */
+#define ROB_IDX_BITS 16
+#define ROB_IDX_MASK ((1ull << ROB_IDX_BITS) - 1)
+#define ROB_IDX_VAL(ctx, idx) (((ctx) << ROB_IDX_BITS) | ((uint64_t)(idx) + 1))
+
+ODP_STATIC_ASSERT(MAX_REORDER_SLOTS < ROB_IDX_MASK, "Reorder_slot_index_does_not_fit");
+
+/* Reorder buffer shared by all ordered queues */
+typedef struct {
+	/* Free slot indexes */
+	ring_mpmc_u32_t free_ring;
+	uint32_t free_ring_data[MAX_REORDER_SLOTS];
+
+	/* Index word per queue (max_queues) and context (REORDER_WINDOW), or 0 when context
+	 * has not been deposited */
+	odp_atomic_u64_t idx[];
+
+} reorder_buf_t;
+
+/* Flow bin of an atomic queue. Events of a bin are processed by one thread at a time. */
+typedef struct ODP_ALIGNED_CACHE {
+	/* Number of events in the bin, including events being processed by the bin owner */
+	odp_atomic_u32_t num_ev;
+
+	/* Events of the bin. The thread holding the queue is the single producer and
+	 * the thread owning the bin is the single consumer. */
+	ring_spsc_ptr_t ring;
+	uintptr_t ring_data[];
+
+} flow_bin_t;
+
+/* Flow bins of an atomic queue. Bin data follows the header. */
+typedef struct ODP_ALIGNED_CACHE {
+	/* Ready bins: bins with events, which are not owned by any thread */
+	ring_mpmc_u32_t ready;
+
+	/* Number of bins with events */
+	odp_atomic_u32_t num_active;
+
+	/* Set when the queue has been removed from scheduling while bins have events */
+	odp_atomic_u32_t parked;
+
+	/* Queue index */
+	uint32_t queue_index;
+
+	/* Events dequeued from the queue, but not yet distributed into bins. Accessed
+	 * only by the thread holding the queue. */
+	uint16_t num_pending;
+	uint16_t pending_idx;
+	_odp_event_hdr_t *pending[FLOW_DEQ_SIZE];
+
+	/* Ready ring data: bin indexes */
+	uint32_t ready_data[MAX_FLOW_BINS];
+
+} flow_queue_t;
+
 /* Shuffled values from 0 to 127 */
 static uint8_t sched_random_u8[] = {
 	0x5B, 0x56, 0x21, 0x28, 0x77, 0x2C, 0x7E, 0x10,
@@ -163,15 +273,20 @@ static uint8_t sched_random_u8[] = {
 
 ODP_STATIC_ASSERT(sizeof(sched_random_u8) == RANDOM_TBL_SIZE, "Bad_random_table_size");
 
-/* Scheduler local data */
+/* Scheduler local data. Fields accessed on every schedule call are packed into
+ * the first two cache lines. Stashed events and group/spread tables follow. */
 typedef struct ODP_ALIGNED_CACHE {
 	uint32_t sched_round;
 	uint16_t thr;
 	uint8_t  pause;
 	uint8_t  sync_ctx;
 	uint8_t  balance_on;
+	uint8_t  grp_idx;
 	uint16_t balance_start;
 	uint16_t spread_round;
+	uint16_t num_grp;
+	uint32_t grp_epoch;
+	grp_mask_t grp_mask;
 
 	struct {
 		uint16_t    num_ev;
@@ -180,36 +295,42 @@ typedef struct ODP_ALIGNED_CACHE {
 		odp_queue_t queue;
 		ring_mpmc_rst_u32_t   *ring;
 		uint32_t    *ring_data;
-		odp_event_t ev[STASH_SIZE];
 	} stash;
 
-	uint64_t grp_mask;
-	uint32_t grp_epoch;
-	uint16_t num_grp;
-	uint8_t grp_idx;
-	uint8_t grp[NUM_SCHED_GRPS];
-	uint8_t spread_tbl[SPREAD_TBL_SIZE];
-
 	struct {
+		uint64_t ctx; /**< Ordered context id */
+		/** Storage for stashed enqueue operations, NULL when not used */
+		ordered_stash_t *stash;
 		/* Source queue index */
 		uint32_t src_queue;
-		uint64_t ctx; /**< Ordered context id */
 		int stash_num; /**< Number of stashed enqueue operations */
-		uint8_t in_order; /**< Order status */
 		lock_called_t lock_called; /**< States of ordered locks */
-		/** Storage for stashed enqueue operations */
-		ordered_stash_t stash[MAX_ORDERED_STASH];
+		uint8_t in_order; /**< Order status */
 	} ordered;
 
+	struct {
+		/* Flow bins of the source queue, NULL when not owning a bin */
+		flow_queue_t *queue;
+		flow_bin_t *bin;
+		uint32_t bin_idx;
+		uint32_t num_ev;
+	} flow;
+
+	/* Stashed events */
+	odp_event_t stash_ev[STASH_SIZE] ODP_ALIGNED_CACHE;
+
+	uint8_t grp[MAX_SCHED_GRPS];
+	uint8_t spread_tbl[SPREAD_TBL_SIZE];
+
 } sched_local_t;
 
-/* Priority queue */
+/* Priority queue. Ring data size is selected at init time. */
 typedef struct ODP_ALIGNED_CACHE {
 	/* Ring header */
 	ring_mpmc_rst_u32_t ring;
 
 	/* Ring data: queue indexes */
-	uint32_t queue_index[MAX_RING_SIZE];
+	uint32_t queue_index[];
 
 } prio_queue_t;
 
@@ -222,28 +343,58 @@ typedef struct ODP_ALIGNED_CACHE {
 	odp_atomic_u64_t next_ctx;
 
 	/* Array of ordered locks */
-	odp_atomic_u64_t lock[CONFIG_QUEUE_MAX_ORD_LOCKS];
+	odp_atomic_u64_t lock[NUM_ORD_LOCKS];
 
 } order_context_t;
 
 typedef struct {
 	struct {
-		uint8_t burst_default[NUM_SCHED_SYNC][NUM_PRIO];
-		uint8_t burst_max[NUM_SCHED_SYNC][NUM_PRIO];
+		uint8_t burst_default[NUM_SCHED_SYNC][MAX_PRIO];
+		uint8_t burst_max[NUM_SCHED_SYNC][MAX_PRIO];
 		uint16_t order_stash_size;
+		uint16_t order_reorder_slots;
+		uint16_t flow_bins;
+		uint16_t flow_bin_size;
+		uint16_t num_groups;
+		uint8_t num_prio;
 		uint8_t num_spread;
 		uint8_t prefer_ratio;
+		uint32_t queues_per_prio;
 	} config;
 	uint32_t         ring_mask;
+	uint32_t         grp_mask_words;
 	uint16_t         max_spread;
 	uint8_t          load_balance;
 	odp_atomic_u32_t grp_epoch;
 	odp_shm_t        shm;
-	odp_ticketlock_t mask_lock[NUM_SCHED_GRPS];
-	prio_q_mask_t    prio_q_mask[NUM_SCHED_GRPS][NUM_PRIO];
+
+	/* Reorder buffer, NULL when not used */
+	reorder_buf_t    *rob;
+	uint8_t          *rob_slot;
+	uint32_t         rob_slot_size;
+	odp_shm_t        rob_shm;
+
+	/* Ordered stash storage of all threads, NULL when not used */
+	ordered_stash_t  *ord_stash;
+	odp_shm_t        ord_stash_shm;
+
+	/* Flow bins of atomic queues, NULL when not used */
+	uint8_t          *flow_base;
+	ring_mpmc_u32_t  flow_free;
+	uint32_t         *flow_free_data;
+	uint32_t         flow_free_mask;
+	uint32_t         flow_q_size;
+	uint32_t         flow_bin_size;
+	uint32_t         flow_bin_mask;
+	uint32_t         flow_ring_mask;
+	uint32_t         max_flow_id;
+	odp_shm_t        flow_shm;
+
+	odp_ticketlock_t mask_lock[MAX_SCHED_GRPS];
+	prio_q_mask_t    prio_q_mask[MAX_SCHED_GRPS][MAX_PRIO];
 
 	/* Groups on a priority level that have queues created */
-	odp_atomic_u64_t prio_grp_mask[NUM_PRIO];
+	odp_atomic_u64_t prio_grp_mask[MAX_PRIO][GRP_MASK_WORDS];
 
 	struct {
 		uint8_t grp;
@@ -255,14 +406,19 @@ typedef struct {
 		uint8_t poll_pktin;
 		uint8_t pktio_index;
 		uint8_t pktin_index;
+		uint8_t flow;
+		/* Flow bin storage index, when 'flow' is set */
+		uint32_t flow_idx;
 	} queue[CONFIG_MAX_SCHED_QUEUES];
 
-	/* Scheduler priority queues */
-	prio_queue_t prio_q[NUM_SCHED_GRPS][NUM_PRIO][MAX_SPREAD];
-	uint32_t prio_q_count[NUM_SCHED_GRPS][NUM_PRIO][MAX_SPREAD];
+	/* Scheduler priority queues: num_groups * num_prio * num_spread rings */
+	uint8_t *prio_q_base;
+	uint32_t prio_q_size;
+	odp_shm_t prio_q_shm;
+	uint32_t prio_q_count[MAX_SCHED_GRPS][MAX_PRIO][MAX_SPREAD];
 
 	/* Number of queues per group and priority  */
-	uint32_t prio_grp_count[NUM_PRIO][NUM_SCHED_GRPS];
+	uint32_t prio_grp_count[MAX_PRIO][MAX_SCHED_GRPS];
 
 	odp_thrmask_t  mask_all;
 	odp_ticketlock_t grp_lock;
@@ -272,9 +428,9 @@ typedef struct {
 		odp_thrmask_t  mask;
 		uint16_t       spread_thrs[MAX_SPREAD];
 		uint8_t        allocated;
-		uint8_t        level[NUM_PRIO];
+		uint8_t        level[MAX_PRIO];
 		uint32_t       num_prio;
-	} sched_grp[NUM_SCHED_GRPS];
+	} sched_grp[MAX_SCHED_GRPS];
 
 	struct {
 		int num_pktin;
@@ -298,8 +454,10 @@ typedef struct {
 } sched_global_t;
 
 /* Check that queue[] variables are large enough */
-ODP_STATIC_ASSERT(NUM_SCHED_GRPS  <= GRP_MASK_BITS, "Groups do not fit into group mask");
-ODP_STATIC_ASSERT(NUM_PRIO        <= 256, "Prio_does_not_fit_8_bits");
+ODP_STATIC_ASSERT(MAX_SCHED_GRPS  <= 256, "Group_does_not_fit_8_bits");
+ODP_STATIC_ASSERT((MAX_SCHED_GRPS % GRP_MASK_BITS) == 0, "Groups_do_not_fill_group_mask");
+ODP_STATIC_ASSERT(MAX_PRIO        <= 256, "Prio_does_not_fit_8_bits");
+ODP_STATIC_ASSERT(MAX_PRIO        >= NUM_BURST_PRIO, "Too_few_priorities");
 ODP_STATIC_ASSERT(MAX_SPREAD      <= 256, "Spread_does_not_fit_8_bits");
 ODP_STATIC_ASSERT(CONFIG_QUEUE_MAX_ORD_LOCKS <= 256,
 		  "Ordered_lock_count_does_not_fit_8_bits");
@@ -319,49 +477,68 @@ static inline void schedule_ord_stash_release_no_stash(odp_queue_t dst_queue);
 
 static void prio_grp_mask_init(void)
 {
-	int i;
+	int i, j;
 
-	for (i = 0; i < NUM_PRIO; i++)
-		odp_atomic_init_u64(&sched->prio_grp_mask[i], 0);
+	for (i = 0; i < MAX_PRIO; i++)
+		for (j = 0; j < GRP_MASK_WORDS; j++)
+			odp_atomic_init_u64(&sched->prio_grp_mask[i][j], 0);
 }
 
 static inline void prio_grp_mask_set(int prio, int grp)
 {
-	uint64_t grp_mask = (uint64_t)1 << grp;
-	uint64_t mask = odp_atomic_load_u64(&sched->prio_grp_mask[prio]);
+	odp_atomic_u64_t *word = &sched->prio_grp_mask[prio][grp / GRP_MASK_BITS];
+	uint64_t grp_mask = (uint64_t)1 << (grp % GRP_MASK_BITS);
+	uint64_t mask = odp_atomic_load_u64(word);
 
-	odp_atomic_store_u64(&sched->prio_grp_mask[prio], mask | grp_mask);
+	odp_atomic_store_u64(word, mask | grp_mask);
 
 	sched->prio_grp_count[prio][grp]++;
 }
 
 static inline void prio_grp_mask_clear(int prio, int grp)
 {
-	uint64_t grp_mask = (uint64_t)1 << grp;
-	uint64_t mask = odp_atomic_load_u64(&sched->prio_grp_mask[prio]);
+	odp_atomic_u64_t *word = &sched->prio_grp_mask[prio][grp / GRP_MASK_BITS];
+	uint64_t grp_mask = (uint64_t)1 << (grp % GRP_MASK_BITS);
+	uint64_t mask = odp_atomic_load_u64(word);
 
 	sched->prio_grp_count[prio][grp]--;
 
 	if (sched->prio_grp_count[prio][grp] == 0)
-		odp_atomic_store_u64(&sched->prio_grp_mask[prio], mask &= (~grp_mask));
+		odp_atomic_store_u64(word, mask &= (~grp_mask));
 }
 
-static inline uint64_t prio_grp_mask_check(int prio, uint64_t grp_mask)
+static inline uint64_t prio_grp_mask_check(int prio, const grp_mask_t *grp_mask)
 {
-	return odp_atomic_load_u64(&sched->prio_grp_mask[prio]) & grp_mask;
+	uint64_t ret = odp_atomic_load_u64(&sched->prio_grp_mask[prio][0]) & grp_mask->u64[0];
+
+	/* With up to 64 groups, the loop is not entered */
+	for (uint32_t i = 1; i < sched->grp_mask_words; i++)
+		ret |= odp_atomic_load_u64(&sched->prio_grp_mask[prio][i]) & grp_mask->u64[i];
+
+	return ret;
 }
 
+static inline prio_queue_t *prio_queue(int grp, int prio, int spr)
+{
+	uint32_t idx = (grp * sched->config.num_prio + prio) * sched->config.num_spread + spr;
+
+	return (prio_queue_t *)(void *)(sched->prio_q_base + idx * sched->prio_q_size);
+}
+
+/* Burst size arrays have NUM_BURST_PRIO elements. Priority levels are mapped
+ * proportionally to array elements. */
 static int read_burst_size_conf(uint8_t out_tbl[], const char *conf_str,
 				int min_val, int max_val, int print)
 {
-	int burst_val[NUM_PRIO];
+	int burst_val[NUM_BURST_PRIO];
+	int num_prio = sched->config.num_prio;
 	const int max_len = 256;
 	const int n = max_len - 1;
 	char line[max_len];
 	int len = 0;
 
-	if (_odp_libconfig_lookup_array(conf_str, burst_val, NUM_PRIO) !=
-	    NUM_PRIO) {
+	if (_odp_libconfig_lookup_array(conf_str, burst_val, NUM_BURST_PRIO) !=
+	    NUM_BURST_PRIO) {
 		_ODP_ERR("Config option '%s' not found.\n", conf_str);
 		return -1;
 	}
@@ -371,7 +548,7 @@ static int read_burst_size_conf(uint8_t out_tbl[], const char *conf_str,
 	snprintf(str, sizeof(str), "%s[]:", conf_str);
 	len += snprintf(&line[len], n - len, "  %-38s", str);
 
-	for (int i = 0; i < NUM_PRIO; i++) {
+	for (int i = 0; i < NUM_BURST_PRIO; i++) {
 		int val = burst_val[i];
 
 		if (val > max_val || val < min_val) {
@@ -379,6 +556,11 @@ static int read_burst_size_conf(uint8_t out_tbl[], const char *conf_str,
 			return -1;
 		}
 		len += snprintf(&line[len], n - len, " %3i", val);
+	}
+
+	for (int i = 0; i < num_prio; i++) {
+		int val = burst_val[(i * NUM_BURST_PRIO) / num_prio];
+
 		if (val > 0)
 			out_tbl[i] = val;
 	}
@@ -455,6 +637,93 @@ static int read_config_file(sched_global_t *sched)
 	sched->config.order_stash_size = val;
 	_ODP_PRINT("  %s: %i\n", str, val);
 
+	str = "sched_basic.order_reorder_slots";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_REORDER_SLOTS || val < 0) {
+		_ODP_ERR("Bad value %s = %i [min: 0, max: %u]\n", str, val, MAX_REORDER_SLOTS);
+		return -1;
+	}
+
+	sched->config.order_reorder_slots = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.flow_bins";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_FLOW_BINS || val < 0 || !_ODP_CHECK_IS_POWER2(val)) {
+		_ODP_ERR("Bad value %s = %i [min: 0, max: %u, power of two]\n", str, val,
+			 MAX_FLOW_BINS);
+		return -1;
+	}
+
+	sched->config.flow_bins = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.flow_bin_size";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_FLOW_BIN_SIZE || val < 1 || !_ODP_CHECK_IS_POWER2(val)) {
+		_ODP_ERR("Bad value %s = %i [min: 1, max: %u, power of two]\n", str, val,
+			 MAX_FLOW_BIN_SIZE);
+		return -1;
+	}
+
+	sched->config.flow_bin_size = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.num_groups";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_SCHED_GRPS || val <= SCHED_GROUP_NAMED) {
+		_ODP_ERR("Bad value %s = %i [min: %u, max: %u]\n", str, val,
+			 SCHED_GROUP_NAMED + 1, MAX_SCHED_GRPS);
+		return -1;
+	}
+
+	sched->config.num_groups = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.num_prio";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_PRIO || val < 1) {
+		_ODP_ERR("Bad value %s = %i [min: 1, max: %u]\n", str, val, MAX_PRIO);
+		return -1;
+	}
+
+	sched->config.num_prio = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.queues_per_prio";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_RING_SIZE || val < 0) {
+		_ODP_ERR("Bad value %s = %i [min: 0, max: %u]\n", str, val, MAX_RING_SIZE);
+		return -1;
+	}
+
+	sched->config.queues_per_prio = val ? (uint32_t)val : MAX_RING_SIZE;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
 	/* Initialize default values for all queue types */
 	str = "sched_basic.burst_size_default";
 	if (read_burst_size_conf(sched->config.burst_default[ODP_SCHED_SYNC_ATOMIC], str, 1,
@@ -547,6 +816,9 @@ static int read_config_file(sched_global_t *sched)
 
 	_ODP_PRINT("  dynamic load balance: %s\n", sched->load_balance ? "ON" : "OFF");
 
+	if (sched->config.order_reorder_slots && sched->config.order_stash_size == 0)
+		_ODP_PRINT("  reorder buffer: OFF (order_stash_size is zero)\n");
+
 	_ODP_PRINT("\n");
 
 	return 0;
@@ -571,6 +843,10 @@ static void sched_local_init(void)
 	sched_local.sync_ctx    = NO_SYNC_CONTEXT;
 	sched_local.stash.queue = ODP_QUEUE_INVALID;
 
+	if (sched->ord_stash)
+		sched_local.ordered.stash = &sched->ord_stash[(uint64_t)sched_local.thr *
+							      sched->config.order_stash_size];
+
 	spread = spread_from_index(sched_local.thr);
 	prefer_ratio = sched->config.prefer_ratio;
 
@@ -586,12 +862,194 @@ static void sched_local_init(void)
 	}
 }
 
+static int reorder_buf_init(void)
+{
+	odp_shm_t shm;
+	reorder_buf_t *rob;
+	uint32_t num_slot = sched->config.order_reorder_slots;
+	uint32_t num_idx = sched->max_queues * REORDER_WINDOW;
+	uint32_t slot_size, hdr_size, i;
+
+	if (num_slot == 0 || sched->config.order_stash_size == 0)
+		return 0;
+
+	hdr_size = _ODP_ROUNDUP_CACHE_LINE(sizeof(reorder_buf_t) +
+					   num_idx * sizeof(odp_atomic_u64_t));
+	slot_size = _ODP_ROUNDUP_CACHE_LINE(sizeof(reorder_slot_t) +
+					    sched->config.order_stash_size *
+					    sizeof(ordered_stash_t));
+
+	shm = odp_shm_reserve("_odp_sched_basic_rob", hdr_size + num_slot * slot_size,
+			      ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Reorder buffer shm reserve failed.\n");
+		return -1;
+	}
+
+	rob = odp_shm_addr(shm);
+
+	for (i = 0; i < num_idx; i++)
+		odp_atomic_init_u64(&rob->idx[i], 0);
+
+	ring_mpmc_u32_init(&rob->free_ring);
+	for (i = 0; i < num_slot; i++)
+		ring_mpmc_u32_enq(&rob->free_ring, rob->free_ring_data, MAX_REORDER_SLOTS - 1, i);
+
+	sched->rob = rob;
+	sched->rob_slot = (uint8_t *)rob + hdr_size;
+	sched->rob_slot_size = slot_size;
+	sched->rob_shm = shm;
+
+	return 0;
+}
+
+/* Reserve ordered stash storage for all threads. Pages of a thread's stash are taken
+ * into use only when the thread stashes enqueue operations. */
+static int ordered_stash_init(void)
+{
+	odp_shm_t shm;
+	uint64_t size = (uint64_t)odp_thread_count_max() * sched->config.order_stash_size *
+			sizeof(ordered_stash_t);
+
+	if (size == 0)
+		return 0;
+
+	shm = odp_shm_reserve("_odp_sched_basic_ord_stash", size, ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Ordered stash shm reserve failed.\n");
+		return -1;
+	}
+
+	sched->ord_stash = odp_shm_addr(shm);
+	sched->ord_stash_shm = shm;
+
+	return 0;
+}
+
+static int prio_queue_init(void)
+{
+	odp_shm_t shm;
+	uint32_t num_rings = sched->config.num_groups * sched->config.num_prio *
+			     sched->config.num_spread;
+	uint32_t ring_size = sched->ring_mask + 1;
+	uint32_t i;
+
+	sched->prio_q_size = _ODP_ROUNDUP_CACHE_LINE(sizeof(prio_queue_t) +
+						     ring_size * sizeof(uint32_t));
+
+	shm = odp_shm_reserve("_odp_sched_basic_prio_q", (uint64_t)num_rings * sched->prio_q_size,
+			      ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Schedule init: Priority queue shm reserve failed.\n");
+		return -1;
+	}
+
+	sched->prio_q_shm = shm;
+	sched->prio_q_base = odp_shm_addr(shm);
+
+	for (i = 0; i < num_rings; i++) {
+		prio_queue_t *prio_q = (prio_queue_t *)(void *)(sched->prio_q_base +
+								i * sched->prio_q_size);
+
+		ring_mpmc_rst_u32_init(&prio_q->ring);
+	}
+
+	return 0;
+}
+
+static inline flow_queue_t *flow_queue(uint32_t queue_index)
+{
+	return (flow_queue_t *)(void *)(sched->flow_base + (uint64_t)sched->queue[queue_index].flow_idx *
+					sched->flow_q_size);
+}
+
+static inline flow_bin_t *flow_bin(flow_queue_t *fq, uint32_t bin_idx)
+{
+	return (flow_bin_t *)(void *)((uint8_t *)fq + sizeof(flow_queue_t) +
+				      bin_idx * sched->flow_bin_size);
+}
+
+/* Reserve flow bins for the number of queues the application configured. Atomic queues
+ * allocate bin storage on creation. Flows are mapped to bins by masking flow ID, so there
+ * is no use for more bins than flows. */
+static int flow_bins_init(uint32_t max_flow_id, uint32_t num_queues)
+{
+	odp_shm_t shm;
+	uint32_t num_bins = _ODP_MIN((uint32_t)sched->config.flow_bins,
+				     _ODP_ROUNDUP_POWER2_U32(max_flow_id + 1));
+	uint32_t bin_size = sched->config.flow_bin_size;
+	uint32_t free_size = _ODP_ROUNDUP_POWER2_U32(num_queues);
+	uint64_t free_offset;
+
+	sched->flow_bin_size = _ODP_ROUNDUP_CACHE_LINE(sizeof(flow_bin_t) +
+						       bin_size * sizeof(uintptr_t));
+	sched->flow_q_size = sizeof(flow_queue_t) + num_bins * sched->flow_bin_size;
+	free_offset = (uint64_t)num_queues * sched->flow_q_size;
+
+	shm = odp_shm_reserve("_odp_sched_basic_flow", free_offset + free_size * sizeof(uint32_t),
+			      ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Flow bin shm reserve failed.\n");
+		return -1;
+	}
+
+	sched->flow_base = odp_shm_addr(shm);
+	sched->flow_free_data = (uint32_t *)(void *)(sched->flow_base + free_offset);
+	sched->flow_free_mask = free_size - 1;
+	ring_mpmc_u32_init(&sched->flow_free);
+
+	for (uint32_t i = 0; i < num_queues; i++)
+		ring_mpmc_u32_enq(&sched->flow_free, sched->flow_free_data, sched->flow_free_mask, i);
+
+	sched->flow_bin_mask = num_bins - 1;
+	sched->flow_ring_mask = bin_size - 1;
+	sched->max_flow_id = max_flow_id;
+	sched->flow_shm = shm;
+
+	return 0;
+}
+
+static int flow_bins_term(void)
+{
+	if (sched->flow_base == NULL)
+		return 0;
+
+	sched->flow_base = NULL;
+
+	if (odp_shm_free(sched->flow_shm)) {
+		_ODP_ERR("Shm free failed for flow bins\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static void flow_queue_init(uint32_t queue_index)
+{
+	flow_queue_t *fq = flow_queue(queue_index);
+
+	ring_mpmc_u32_init(&fq->ready);
+	odp_atomic_init_u32(&fq->num_active, 0);
+	odp_atomic_init_u32(&fq->parked, 0);
+	fq->queue_index = queue_index;
+	fq->num_pending = 0;
+	fq->pending_idx = 0;
+
+	for (uint32_t i = 0; i <= sched->flow_bin_mask; i++) {
+		flow_bin_t *bin = flow_bin(fq, i);
+
+		odp_atomic_init_u32(&bin->num_ev, 0);
+		ring_spsc_ptr_init(&bin->ring);
+	}
+}
+
 static int schedule_init_global(void)
 {
 	odp_shm_t shm;
 	int i, j, grp;
 	int prefer_ratio;
-	uint32_t ring_size, num_rings;
+	uint32_t ring_size, num_rings, num_grps, num_prio, queues_per_prio;
+	uint64_t max_queues;
 
 	_ODP_DBG("Schedule init ... ");
 
@@ -607,7 +1065,7 @@ static int schedule_init_global(void)
 	sched = odp_shm_addr(shm);
 	memset(sched, 0, sizeof(sched_global_t));
 
-	if (read_config_file(sched)) {
+	if (read_config_file(sched) || ordered_stash_init()) {
 		odp_shm_free(shm);
 		return -1;
 	}
@@ -623,45 +1081,59 @@ static int schedule_init_global(void)
 	/* When num_spread == 1, only spread_tbl[0] is used. */
 	sched->max_spread = (sched->config.num_spread - 1) * prefer_ratio;
 
-	/* Dynamic load balance may move all queues into a single ring.
-	 * Ring size can be smaller with fixed spreading. */
+	num_grps = sched->config.num_groups;
+	num_prio = sched->config.num_prio;
+	queues_per_prio = sched->config.queues_per_prio;
+
+	/* Dynamic load balance may move all queues of a group and priority level
+	 * into a single ring. Ring size can be smaller with fixed spreading. */
 	if (sched->load_balance) {
-		ring_size = MAX_RING_SIZE;
+		ring_size = queues_per_prio;
 		num_rings = 1;
 	} else {
-		ring_size = MAX_RING_SIZE / sched->config.num_spread;
+		ring_size = queues_per_prio / sched->config.num_spread;
 		num_rings = sched->config.num_spread;
 	}
 
-	ring_size = _ODP_ROUNDUP_POWER2_U32(ring_size);
+	ring_size = _ODP_ROUNDUP_POWER2_U32(_ODP_MAX(ring_size, 2U));
 	_ODP_ASSERT(ring_size <= MAX_RING_SIZE);
 	sched->ring_mask = ring_size - 1;
+	sched->grp_mask_words = (num_grps + GRP_MASK_BITS - 1) / GRP_MASK_BITS;
 
-	sched->config_if.max_groups = NUM_SCHED_GRPS - SCHED_GROUP_NAMED;
-	sched->config_if.max_group_prios = NUM_SCHED_GRPS * NUM_PRIO;
-	sched->config_if.max_prios = NUM_PRIO;
+	sched->config_if.max_groups = num_grps - SCHED_GROUP_NAMED;
+	sched->config_if.max_group_prios = num_grps * num_prio;
+	sched->config_if.max_prios = num_prio;
 	sched->config_if.min_prio = 0;
-	sched->config_if.max_prio = NUM_PRIO - 1;
+	sched->config_if.max_prio = num_prio - 1;
 	sched->config_if.def_prio = sched->config_if.max_prio / 2;
 	/* Each ring can hold in maximum ring_size-1 queues. Due to ring size round up,
-	 * total capacity of rings may be larger than CONFIG_MAX_SCHED_QUEUES. */
-	sched->max_queues = sched->ring_mask * num_rings;
-	if (sched->max_queues > CONFIG_MAX_SCHED_QUEUES)
-		sched->max_queues = CONFIG_MAX_SCHED_QUEUES;
-
-	for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
-		odp_ticketlock_init(&sched->mask_lock[grp]);
-
-		for (i = 0; i < NUM_PRIO; i++) {
-			for (j = 0; j < MAX_SPREAD; j++) {
-				prio_queue_t *prio_q;
+	 * total capacity of rings may be larger than CONFIG_MAX_SCHED_QUEUES. When the
+	 * number of queues per priority level is limited, queues need to be divided
+	 * over groups and priority levels. */
+	max_queues = (uint64_t)sched->ring_mask * num_rings;
+	if (queues_per_prio < MAX_RING_SIZE)
+		max_queues *= num_grps * num_prio;
+	sched->max_queues = _ODP_MIN(max_queues, (uint64_t)CONFIG_MAX_SCHED_QUEUES);
+
+	if (reorder_buf_init()) {
+		if (sched->ord_stash)
+			odp_shm_free(sched->ord_stash_shm);
+		odp_shm_free(shm);
+		return -1;
+	}
 
-				prio_q = &sched->prio_q[grp][i][j];
-				ring_mpmc_rst_u32_init(&prio_q->ring);
-			}
-		}
+	if (prio_queue_init()) {
+		if (sched->ord_stash)
+			odp_shm_free(sched->ord_stash_shm);
+		if (sched->rob)
+			odp_shm_free(sched->rob_shm);
+		odp_shm_free(shm);
+		return -1;
 	}
 
+	for (grp = 0; grp < MAX_SCHED_GRPS; grp++)
+		odp_ticketlock_init(&sched->mask_lock[grp]);
+
 	odp_ticketlock_init(&sched->pktio_lock);
 	for (i = 0; i < NUM_PKTIO; i++)
 		sched->pktio[i].num_pktin = 0;
@@ -672,7 +1144,7 @@ static int schedule_init_global(void)
 
 	prio_grp_mask_init();
 
-	for (i = 0; i < NUM_SCHED_GRPS; i++) {
+	for (i = 0; i < MAX_SCHED_GRPS; i++) {
 		memset(sched->sched_grp[i].name, 0, ODP_SCHED_GROUP_NAME_LEN);
 		odp_thrmask_zero(&sched->sched_grp[i].mask);
 
@@ -707,15 +1179,15 @@ static int schedule_term_global(void)
 	int i, j, grp;
 	uint32_t ring_mask = sched->ring_mask;
 
-	for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
-		for (i = 0; i < NUM_PRIO; i++) {
-			for (j = 0; j < MAX_SPREAD; j++) {
+	for (grp = 0; grp < sched->config.num_groups; grp++) {
+		for (i = 0; i < sched->config.num_prio; i++) {
+			for (j = 0; j < sched->config.num_spread; j++) {
 				ring_mpmc_rst_u32_t *ring;
 				uint32_t *ring_data;
 				uint32_t qi;
 
-				ring = &sched->prio_q[grp][i][j].ring;
-				ring_data = sched->prio_q[grp][i][j].queue_index;
+				ring = &prio_queue(grp, i, j)->ring;
+				ring_data = prio_queue(grp, i, j)->queue_index;
 
 				while (ring_mpmc_rst_u32_deq(ring, ring_data, ring_mask, &qi)) {
 					odp_event_t events[1];
@@ -725,11 +1197,34 @@ static int schedule_term_global(void)
 
 					if (num > 0)
 						_ODP_ERR("Queue not empty\n");
+
+					if (sched->queue[qi].flow &&
+					    (flow_queue(qi)->num_pending ||
+					     odp_atomic_load_u32(&flow_queue(qi)->num_active)))
+						_ODP_ERR("Flow bins not empty\n");
 				}
 			}
 		}
 	}
 
+	if (sched->ord_stash && odp_shm_free(sched->ord_stash_shm)) {
+		_ODP_ERR("Shm free failed for ordered stash\n");
+		rc = -1;
+	}
+
+	if (sched->rob && odp_shm_free(sched->rob_shm)) {
+		_ODP_ERR("Shm free failed for reorder buffer\n");
+		rc = -1;
+	}
+
+	if (flow_bins_term())
+		rc = -1;
+
+	if (odp_shm_free(sched->prio_q_shm)) {
+		_ODP_ERR("Shm free failed for priority queues\n");
+		rc = -1;
+	}
+
 	ret = odp_shm_free(sched->shm);
 	if (ret < 0) {
 		_ODP_ERR("Shm free failed for odp_scheduler");
@@ -756,18 +1251,20 @@ static inline int grp_update_tbl(void)
 	int i;
 	int num = 0;
 	int thr = sched_local.thr;
-	uint64_t mask = 0;
+	grp_mask_t mask;
+
+	memset(&mask, 0, sizeof(grp_mask_t));
 
 	odp_ticketlock_lock(&sched->grp_lock);
 
-	for (i = 0; i < NUM_SCHED_GRPS; i++) {
+	for (i = 0; i < sched->config.num_groups; i++) {
 		if (sched->sched_grp[i].allocated == 0)
 			continue;
 
 		if (odp_thrmask_isset(&sched->sched_grp[i].mask, thr)) {
 			sched_local.grp[num] = i;
 			num++;
-			mask |= (uint64_t)1 << i;
+			mask.u64[i / GRP_MASK_BITS] |= (uint64_t)1 << (i % GRP_MASK_BITS);
 		}
 	}
 
@@ -823,10 +1320,16 @@ static inline void dec_queue_count(int grp, int prio, int spr)
 	odp_ticketlock_unlock(&sched->mask_lock[grp]);
 }
 
-static inline void update_queue_count(int grp, int prio, int old_spr, int new_spr)
+static inline int update_queue_count(int grp, int prio, int old_spr, int new_spr)
 {
 	odp_ticketlock_lock(&sched->mask_lock[grp]);
 
+	/* Ring of the new spread is full */
+	if (odp_unlikely(sched->prio_q_count[grp][prio][new_spr] >= sched->ring_mask)) {
+		odp_ticketlock_unlock(&sched->mask_lock[grp]);
+		return -1;
+	}
+
 	sched->prio_q_mask[grp][prio] |= 1 << new_spr;
 	sched->prio_q_count[grp][prio][new_spr]++;
 
@@ -836,9 +1339,11 @@ static inline void update_queue_count(int grp, int prio, int old_spr, int new_sp
 		sched->prio_q_mask[grp][prio] &= (uint8_t)(~(1 << old_spr));
 
 	odp_ticketlock_unlock(&sched->mask_lock[grp]);
+
+	return 0;
 }
 
-static uint8_t allocate_spread(int grp, int prio)
+static int allocate_spread(int grp, int prio)
 {
 	uint8_t i, num_min, spr;
 	uint32_t num;
@@ -864,6 +1369,12 @@ static uint8_t allocate_spread(int grp, int prio)
 		}
 	}
 
+	/* All rings are full */
+	if (min >= sched->ring_mask) {
+		odp_ticketlock_unlock(&sched->mask_lock[grp]);
+		return -1;
+	}
+
 	spr = min_spr[0];
 
 	/* When there are multiple minimum spreads, select one randomly */
@@ -894,8 +1405,7 @@ static int check_queue_prio(int prio, int grp)
 static int schedule_create_queue(uint32_t queue_index,
 				 const odp_schedule_param_t *sched_param)
 {
-	int i;
-	uint8_t spread;
+	int i, spread;
 	int grp  = sched_param->group;
 	int prio = prio_level_from_api(sched_param->prio);
 
@@ -904,7 +1414,13 @@ static int schedule_create_queue(uint32_t queue_index,
 		return -1;
 	}
 
-	if (grp < 0 || grp >= NUM_SCHED_GRPS) {
+	/* Per queue storage (e.g. reorder buffer index) is sized by max_queues */
+	if (queue_index >= sched->max_queues) {
+		_ODP_ERR("Too many scheduled queues: %u\n", queue_index);
+		return -1;
+	}
+
+	if (grp < 0 || grp >= sched->config.num_groups) {
 		_ODP_ERR("Bad schedule group %i\n", grp);
 		return -1;
 	}
@@ -933,12 +1449,17 @@ static int schedule_create_queue(uint32_t queue_index,
 		return -1;
 	}
 
+	spread = allocate_spread(grp, prio);
+	if (spread < 0) {
+		odp_ticketlock_unlock(&sched->grp_lock);
+		_ODP_ERR("Too many queues in group %i, priority %i\n", grp, sched_param->prio);
+		return -1;
+	}
+
 	prio_grp_mask_set(prio, grp);
 
 	odp_ticketlock_unlock(&sched->grp_lock);
 
-	spread = allocate_spread(grp, prio);
-
 	sched->queue[queue_index].grp  = grp;
 	sched->queue[queue_index].prio = prio;
 	sched->queue[queue_index].spread = spread;
@@ -947,11 +1468,20 @@ static int schedule_create_queue(uint32_t queue_index,
 	sched->queue[queue_index].poll_pktin  = 0;
 	sched->queue[queue_index].pktio_index = 0;
 	sched->queue[queue_index].pktin_index = 0;
+	sched->queue[queue_index].flow = 0;
+
+	/* Without free bin storage, atomicity is maintained per queue */
+	if (sched->flow_base && sched_param->sync == ODP_SCHED_SYNC_ATOMIC &&
+	    ring_mpmc_u32_deq(&sched->flow_free, sched->flow_free_data, sched->flow_free_mask,
+			      &sched->queue[queue_index].flow_idx)) {
+		flow_queue_init(queue_index);
+		sched->queue[queue_index].flow = 1;
+	}
 
 	odp_atomic_init_u64(&sched->order[queue_index].ctx, 0);
 	odp_atomic_init_u64(&sched->order[queue_index].next_ctx, 0);
 
-	for (i = 0; i < CONFIG_QUEUE_MAX_ORD_LOCKS; i++)
+	for (i = 0; i < NUM_ORD_LOCKS; i++)
 		odp_atomic_init_u64(&sched->order[queue_index].lock[i], 0);
 
 	return 0;
@@ -978,6 +1508,17 @@ static void schedule_destroy_queue(uint32_t queue_index)
 	sched->queue[queue_index].prio   = 0;
 	sched->queue[queue_index].spread = 0;
 
+	if (sched->queue[queue_index].flow) {
+		flow_queue_t *fq = flow_queue(queue_index);
+
+		if (fq->num_pending || odp_atomic_load_u32(&fq->num_active))
+			_ODP_ERR("Flow bins not empty\n");
+
+		ring_mpmc_u32_enq(&sched->flow_free, sched->flow_free_data, sched->flow_free_mask,
+				  sched->queue[queue_index].flow_idx);
+		sched->queue[queue_index].flow = 0;
+	}
+
 	if ((sched_sync_type(queue_index) == ODP_SCHED_SYNC_ORDERED) &&
 	    odp_atomic_load_u64(&sched->order[queue_index].ctx) !=
 	    odp_atomic_load_u64(&sched->order[queue_index].next_ctx))
@@ -989,8 +1530,9 @@ static int schedule_sched_queue(uint32_t queue_index)
 	int grp      = sched->queue[queue_index].grp;
 	int prio     = sched->queue[queue_index].prio;
 	int spread   = sched->queue[queue_index].spread;
-	ring_mpmc_rst_u32_t *ring = &sched->prio_q[grp][prio][spread].ring;
-	uint32_t *ring_data = sched->prio_q[grp][prio][spread].queue_index;
+	prio_queue_t *prio_q = prio_queue(grp, prio, spread);
+	ring_mpmc_rst_u32_t *ring = &prio_q->ring;
+	uint32_t *ring_data = prio_q->queue_index;
 
 	ring_mpmc_rst_u32_enq(ring, ring_data, sched->ring_mask, queue_index);
 	return 0;
@@ -1018,14 +1560,48 @@ static void schedule_pktio_start(int pktio_index, int num_pktin,
 	}
 }
 
+static inline void release_flow_bin(void)
+{
+	flow_queue_t *fq = sched_local.flow.queue;
+	flow_bin_t *bin = sched_local.flow.bin;
+	uint32_t num = sched_local.flow.num_ev;
+	uint32_t old;
+
+	/* Event processing completes before the bin is passed to another thread */
+	odp_mb_release();
+	old = odp_atomic_fetch_sub_u32(&bin->num_ev, num);
+
+	if (old > num) {
+		/* More events were added into the bin, pass it to the next owner */
+		ring_mpmc_u32_enq(&fq->ready, fq->ready_data, sched->flow_bin_mask,
+				  sched_local.flow.bin_idx);
+
+		/* Pairs with the barrier in flow_park() */
+		odp_mb_full();
+
+		/* Add parked queue back to scheduling */
+		if (odp_atomic_load_u32(&fq->parked))
+			_odp_sched_queue_unpark(fq->queue_index);
+	} else {
+		odp_atomic_dec_u32(&fq->num_active);
+	}
+
+	sched_local.flow.queue = NULL;
+}
+
 static inline void release_atomic(void)
 {
 	uint32_t qi  = sched_local.stash.qi;
 	ring_mpmc_rst_u32_t *ring = sched_local.stash.ring;
 	uint32_t *ring_data = sched_local.stash.ring_data;
 
-	/* Release current atomic queue */
-	ring_mpmc_rst_u32_enq(ring, ring_data, sched->ring_mask, qi);
+	if (sched_local.flow.queue) {
+		/* Release current flow bin. The queue itself is not held. */
+		release_flow_bin();
+	} else {
+		/* Release current atomic queue */
+		ring_mpmc_rst_u32_enq(ring, ring_data, sched->ring_mask, qi);
+	}
 
 	/* We don't hold sync context anymore */
 	sched_local.sync_ctx = NO_SYNC_CONTEXT;
@@ -1057,23 +1633,18 @@ static inline void wait_for_order(uint32_t queue_index)
 	}
 }
 
-/**
- * Perform stashed enqueue operations
- *
- * Should be called only when already in order.
- */
-static inline void ordered_stash_release(void)
+static inline void ordered_stash_enq(ordered_stash_t stash[], int stash_num)
 {
 	int i;
 
-	for (i = 0; i < sched_local.ordered.stash_num; i++) {
+	for (i = 0; i < stash_num; i++) {
 		odp_queue_t queue;
 		_odp_event_hdr_t **event_hdr;
 		int num, num_enq;
 
-		queue = sched_local.ordered.stash[i].queue;
-		event_hdr = sched_local.ordered.stash[i].event_hdr;
-		num = sched_local.ordered.stash[i].num;
+		queue = stash[i].queue;
+		event_hdr = stash[i].event_hdr;
+		num = stash[i].num;
 
 		num_enq = odp_queue_enq_multi(queue,
 					      (odp_event_t *)event_hdr, num);
@@ -1087,35 +1658,155 @@ static inline void ordered_stash_release(void)
 			_odp_event_free_multi(&event_hdr[num_enq], num - num_enq);
 		}
 	}
+}
+
+/**
+ * Perform stashed enqueue operations
+ *
+ * Should be called only when already in order.
+ */
+static inline void ordered_stash_release(void)
+{
+	ordered_stash_enq(sched_local.ordered.stash, sched_local.ordered.stash_num);
 	sched_local.ordered.stash_num = 0;
 }
 
-static inline void release_ordered(void)
+static inline void release_ordered_locks(uint32_t qi, uint64_t ctx, lock_called_t lock_called)
 {
-	uint32_t qi;
 	uint32_t i;
 
-	qi = sched_local.ordered.src_queue;
+	for (i = 0; i < sched->queue[qi].order_lock_count; i++) {
+		if (!lock_called.u8[i])
+			odp_atomic_store_rel_u64(&sched->order[qi].lock[i], ctx + 1);
+	}
+
+	/* Sequencing points are always passed before context release */
+	for (i = CONFIG_QUEUE_MAX_ORD_LOCKS; i < NUM_ORD_LOCKS; i++) {
+		if (!lock_called.u8[i])
+			odp_atomic_store_rel_u64(&sched->order[qi].lock[i], ctx + 1);
+	}
+}
+
+static inline odp_atomic_u64_t *reorder_idx(uint32_t qi, uint64_t ctx)
+{
+	return &sched->rob->idx[qi * REORDER_WINDOW + (ctx & (REORDER_WINDOW - 1))];
+}
 
-	wait_for_order(qi);
+static inline reorder_slot_t *reorder_slot(uint32_t idx)
+{
+	return (reorder_slot_t *)(void *)(sched->rob_slot + idx * sched->rob_slot_size);
+}
 
-	/* Release all ordered locks */
-	for (i = 0; i < sched->queue[qi].order_lock_count; i++) {
-		if (!sched_local.ordered.lock_called.u8[i])
-			odp_atomic_store_rel_u64(&sched->order[qi].lock[i],
-						 sched_local.ordered.ctx + 1);
+/**
+ * Release deposited contexts of a queue in order
+ *
+ * Called after all contexts preceding 'ctx' have been released. Performs stashed
+ * enqueue operations of consecutive deposited contexts, starting from 'ctx'.
+ */
+static void reorder_drain(uint32_t qi, uint64_t ctx)
+{
+	reorder_buf_t *rob = sched->rob;
+
+	while (1) {
+		odp_atomic_u64_t *idx = reorder_idx(qi, ctx);
+		reorder_slot_t *slot;
+		uint64_t val;
+		uint32_t slot_idx;
+
+		/* Pairs with the barrier in reorder_deposit() */
+		odp_mb_full();
+
+		val = odp_atomic_load_u64(idx);
+
+		/* Not deposited, deposited for a later context (this context has been released
+		 * already by another thread), or another thread is releasing it */
+		if (val == 0 || (val >> ROB_IDX_BITS) != (ctx & (UINT64_MAX >> ROB_IDX_BITS)) ||
+		    !odp_atomic_cas_acq_u64(idx, &val, 0))
+			return;
+
+		slot_idx = (val & ROB_IDX_MASK) - 1;
+		slot = reorder_slot(slot_idx);
+		_ODP_ASSERT(slot->ctx == ctx);
+
+		release_ordered_locks(qi, ctx, slot->lock_called);
+		ordered_stash_enq(slot->stash, slot->stash_num);
+		ring_mpmc_u32_enq(&rob->free_ring, rob->free_ring_data, MAX_REORDER_SLOTS - 1,
+				  slot_idx);
+
+		odp_atomic_add_rel_u64(&sched->order[qi].ctx, 1);
+		ctx++;
 	}
+}
 
-	sched_local.ordered.lock_called.all = 0;
-	sched_local.ordered.in_order = 0;
+/**
+ * Deposit current ordered context into the reorder buffer
+ *
+ * Stashed enqueue operations are performed later by the thread that releases the
+ * preceding context. Returns 0 on success. Returns <0 when the reorder buffer cannot
+ * be used, and the context needs to be released in order.
+ */
+static int reorder_deposit(uint32_t qi)
+{
+	reorder_buf_t *rob = sched->rob;
+	uint64_t ctx = sched_local.ordered.ctx;
+	reorder_slot_t *slot;
+	uint32_t idx;
+
+	if (ctx - odp_atomic_load_u64(&sched->order[qi].ctx) >= REORDER_WINDOW)
+		return -1;
+
+	if (ring_mpmc_u32_deq(&rob->free_ring, rob->free_ring_data, MAX_REORDER_SLOTS - 1,
+			      &idx) == 0)
+		return -1;
+
+	slot = reorder_slot(idx);
+	slot->ctx = ctx;
+	slot->lock_called = sched_local.ordered.lock_called;
+	slot->stash_num = sched_local.ordered.stash_num;
+	memcpy(slot->stash, sched_local.ordered.stash,
+	       slot->stash_num * sizeof(ordered_stash_t));
+
+	odp_atomic_store_rel_u64(reorder_idx(qi, ctx), ROB_IDX_VAL(ctx, idx));
+
+	/* Either the thread releasing the preceding context sees the deposited slot, or
+	 * this thread sees that the preceding context has been released. */
+	odp_mb_full();
+
+	if (odp_atomic_load_u64(&sched->order[qi].ctx) == ctx)
+		reorder_drain(qi, ctx);
+
+	return 0;
+}
+
+static inline void release_ordered(void)
+{
+	uint32_t qi = sched_local.ordered.src_queue;
+	uint64_t ctx = sched_local.ordered.ctx;
 
 	/* We don't hold sync context anymore */
 	sched_local.sync_ctx = NO_SYNC_CONTEXT;
 
-	ordered_stash_release();
+	/* With reorder buffer, do not wait for own turn */
+	if (sched->rob && !sched_local.ordered.in_order && !ordered_own_turn(qi) &&
+	    reorder_deposit(qi) == 0) {
+		sched_local.ordered.stash_num = 0;
+	} else {
+		wait_for_order(qi);
+
+		/* Release all ordered locks */
+		release_ordered_locks(qi, ctx, sched_local.ordered.lock_called);
+
+		ordered_stash_release();
 
-	/* Next thread can continue processing */
-	odp_atomic_add_rel_u64(&sched->order[qi].ctx, 1);
+		/* Next thread can continue processing */
+		odp_atomic_add_rel_u64(&sched->order[qi].ctx, 1);
+
+		if (sched->rob)
+			reorder_drain(qi, ctx + 1);
+	}
+
+	sched_local.ordered.lock_called.all = 0;
+	sched_local.ordered.in_order = 0;
 }
 
 static void schedule_release_ordered(void)
@@ -1290,6 +1981,17 @@ static int schedule_config(const odp_schedule_config_t *config)
 		return -1;
 	}
 
+	if (config->max_flow_id > BUF_HDR_MAX_FLOW_ID) {
+		_ODP_ERR("Bad max flow ID %u\n", config->max_flow_id);
+		return -1;
+	}
+
+	/* Atomic queues maintain atomicity per flow bin in flow aware mode */
+	if (config->max_flow_id && sched->config.flow_bins &&
+	    flow_bins_init(config->max_flow_id, config->num_queues ? config->num_queues :
+			   sched->max_queues))
+		return -1;
+
 	odp_ticketlock_lock(&sched->grp_lock);
 	sched->config_if.group_enable.all = config->sched_group.all;
 	sched->config_if.group_enable.control = config->sched_group.control;
@@ -1302,7 +2004,7 @@ static int schedule_config(const odp_schedule_config_t *config)
 	sched->config_if.def_prio = (sched->config_if.max_prio - sched->config_if.min_prio) / 2 +
 				    sched->config_if.min_prio;
 
-	for (int i = 0; i < NUM_SCHED_GRPS; i++) {
+	for (int i = 0; i < sched->config.num_groups; i++) {
 		for (uint32_t j = 0; j < sched->config_if.max_prios; ++j)
 			sched->sched_grp[i].level[j] = sched->config_if.min_prio + j;
 
@@ -1376,7 +2078,7 @@ static inline int copy_from_stash(odp_event_t *restrict out_ev, uint32_t max)
 	int i = 0;
 
 	while (sched_local.stash.num_ev && max) {
-		out_ev[i] = sched_local.stash.ev[sched_local.stash.ev_index];
+		out_ev[i] = sched_local.stash_ev[sched_local.stash.ev_index];
 		sched_local.stash.ev_index++;
 		sched_local.stash.num_ev--;
 		max--;
@@ -1485,10 +2187,25 @@ static inline int queue_is_pktin(uint32_t queue_index)
 	return sched->queue[queue_index].poll_pktin;
 }
 
+/* Pktin queue of a pktio has been stopped. Call stop_finalize when we have stopped
+ * polling all pktin queues of the pktio. */
+static void pktin_stopped(int pktio_index)
+{
+	int num_pktin;
+
+	odp_ticketlock_lock(&sched->pktio_lock);
+	sched->pktio[pktio_index].num_pktin--;
+	num_pktin = sched->pktio[pktio_index].num_pktin;
+	odp_ticketlock_unlock(&sched->pktio_lock);
+
+	if (num_pktin == 0)
+		_odp_sched_cb_pktio_stop_finalize(pktio_index);
+}
+
 static inline int poll_pktin(uint32_t qi, int direct_recv,
 			     odp_event_t ev_tbl[], int max_num)
 {
-	int pktio_index, pktin_index, num, num_pktin;
+	int pktio_index, pktin_index, num;
 	_odp_event_hdr_t **hdr_tbl;
 	int ret;
 	void *q_int;
@@ -1512,18 +2229,10 @@ static inline int poll_pktin(uint32_t qi, int direct_recv,
 	if (num == 0)
 		return 0;
 
-	/* Pktio stopped or closed. Call stop_finalize when we have stopped
-	 * polling all pktin queues of the pktio. */
+	/* Pktio stopped or closed */
 	if (odp_unlikely(num < 0)) {
-		odp_ticketlock_lock(&sched->pktio_lock);
-		sched->pktio[pktio_index].num_pktin--;
-		num_pktin = sched->pktio[pktio_index].num_pktin;
-		odp_ticketlock_unlock(&sched->pktio_lock);
-
 		_odp_sched_queue_set_status(qi, QUEUE_STATUS_NOTSCHED);
-
-		if (num_pktin == 0)
-			_odp_sched_cb_pktio_stop_finalize(pktio_index);
+		pktin_stopped(pktio_index);
 
 		return num;
 	}
@@ -1549,10 +2258,206 @@ static inline int poll_pktin(uint32_t qi, int direct_recv,
 	return ret;
 }
 
+/* Poll packet input into pending events of flow bins. Flow ID of a packet is
+ * selected based on its flow hash. */
+static inline int flow_poll_pktin(uint32_t qi, flow_queue_t *fq, int active)
+{
+	int pktio_index = sched->queue[qi].pktio_index;
+	int pktin_index = sched->queue[qi].pktin_index;
+	uint32_t num_flows = sched->max_flow_id + 1;
+	int num;
+
+	num = _odp_sched_cb_pktin_poll(pktio_index, pktin_index, fq->pending, FLOW_DEQ_SIZE);
+
+	if (odp_unlikely(num < 0)) {
+		/* Pktio stopped or closed. Continue scheduling the queue until events
+		 * of its flow bins have been processed. */
+		sched->queue[qi].poll_pktin = 0;
+
+		if (!active)
+			_odp_sched_queue_set_status(qi, QUEUE_STATUS_NOTSCHED);
+
+		pktin_stopped(pktio_index);
+
+		return active ? 0 : -1;
+	}
+
+	for (int i = 0; i < num; i++) {
+		_odp_event_hdr_t *hdr = fq->pending[i];
+		odp_packet_hdr_t *pkt_hdr = (odp_packet_hdr_t *)(uintptr_t)hdr;
+
+		if (hdr->event_type != ODP_EVENT_PACKET)
+			continue;
+
+		hdr->flow_id = 0;
+		if (pkt_hdr->p.input_flags.flow_hash)
+			hdr->flow_id = pkt_hdr->flow_hash % num_flows;
+	}
+
+	return num;
+}
+
+static inline void flow_bin_add(flow_queue_t *fq, uint32_t bin_idx, uint32_t num)
+{
+	flow_bin_t *bin = flow_bin(fq, bin_idx);
+
+	/* Bin becomes active when the first events are added */
+	if (odp_atomic_fetch_add_u32(&bin->num_ev, num) == 0) {
+		/* Previous owner has completed processing */
+		odp_mb_acquire();
+		odp_atomic_inc_u32(&fq->num_active);
+		ring_mpmc_u32_enq(&fq->ready, fq->ready_data, sched->flow_bin_mask, bin_idx);
+	}
+}
+
+/* Move pending events into flow bins. Stops on the first full bin to maintain event
+ * order within each flow. */
+static inline void flow_distribute(flow_queue_t *fq)
+{
+	uint32_t bin_mask = sched->flow_bin_mask;
+	uint32_t ring_mask = sched->flow_ring_mask;
+	uint32_t cur_idx = 0;
+	uint32_t num = 0;
+
+	while (fq->num_pending) {
+		_odp_event_hdr_t *hdr = fq->pending[fq->pending_idx];
+		uint32_t bin_idx = hdr->flow_id & bin_mask;
+		flow_bin_t *bin = flow_bin(fq, bin_idx);
+
+		/* Add events to bins in runs of the same bin */
+		if (bin_idx != cur_idx && num) {
+			flow_bin_add(fq, cur_idx, num);
+			num = 0;
+		}
+
+		cur_idx = bin_idx;
+
+		if (ring_spsc_ptr_enq(&bin->ring, bin->ring_data, ring_mask, (uintptr_t)hdr) == 0)
+			break;
+
+		num++;
+		fq->pending_idx++;
+		fq->num_pending--;
+	}
+
+	if (num)
+		flow_bin_add(fq, cur_idx, num);
+
+	if (fq->num_pending == 0)
+		fq->pending_idx = 0;
+}
+
+/* Queue has been removed from scheduling while its bins have events. The queue is added back
+ * to scheduling by an enqueue, or by a bin owner that passes a bin to the ready ring. */
+static inline void flow_park(flow_queue_t *fq)
+{
+	odp_atomic_store_u32(&fq->parked, 1);
+
+	/* Pairs with the barrier in release_flow_bin() */
+	odp_mb_full();
+
+	if (!ring_mpmc_u32_is_empty(&fq->ready))
+		_odp_sched_queue_unpark(fq->queue_index);
+}
+
+/* Schedule events of an atomic queue with flow bins. Called by the thread holding the
+ * queue. Returns number of events output from a bin, which is now owned by the thread,
+ * or 0 when no bin is ready. The queue needs to be scheduled again in both cases.
+ * Returns <0 when the queue has been removed from scheduling. Instead of polling a queue
+ * that has only bins owned by other threads, or events waiting for a full bin, the queue
+ * is parked until a bin owner passes a bin to the ready ring. */
+static inline int flow_schedule(uint32_t qi, int pktin, odp_event_t ev_tbl[], uint32_t max_deq)
+{
+	flow_queue_t *fq = flow_queue(qi);
+	flow_bin_t *bin;
+	uint32_t bin_idx, num_ev;
+	int num;
+
+	odp_atomic_store_u32(&fq->parked, 0);
+
+	if (fq->num_pending == 0) {
+		int active = odp_atomic_load_u32(&fq->num_active) != 0;
+
+		/* Only the thread holding the queue activates bins. Status of an empty queue
+		 * is updated also when bins have events. */
+		num = _odp_sched_queue_deq(qi, (odp_event_t *)fq->pending, FLOW_DEQ_SIZE, !pktin);
+
+		if (odp_unlikely(num < 0))
+			return num;
+
+		if (num == 0 && pktin)
+			num = flow_poll_pktin(qi, fq, active);
+
+		if (num < 0)
+			return -1;
+
+		if (num == 0 && !pktin) {
+			/* The queue is not held anymore */
+			if (active)
+				flow_park(fq);
+
+			return -1;
+		}
+
+		fq->num_pending = num;
+		fq->pending_idx = 0;
+	}
+
+	if (fq->num_pending)
+		flow_distribute(fq);
+
+	if (ring_mpmc_u32_deq(&fq->ready, fq->ready_data, sched->flow_bin_mask, &bin_idx) == 0) {
+		/* Events wait for full bins, which are owned by other threads */
+		if (fq->num_pending && !pktin) {
+			_odp_sched_queue_park(qi);
+			flow_park(fq);
+			return -1;
+		}
+
+		return 0;
+	}
+
+	/* Dequeue only events that have been added into the bin */
+	bin = flow_bin(fq, bin_idx);
+	num_ev = odp_atomic_load_acq_u32(&bin->num_ev);
+	num = ring_spsc_ptr_deq_multi(&bin->ring, bin->ring_data, sched->flow_ring_mask,
+				      (uintptr_t *)ev_tbl, _ODP_MIN(max_deq, num_ev));
+
+	sched_local.flow.queue   = fq;
+	sched_local.flow.bin     = bin;
+	sched_local.flow.bin_idx = bin_idx;
+	sched_local.flow.num_ev  = num;
+
+	return num;
+}
+
+static inline int output_events(odp_queue_t *out_queue, odp_event_t out_ev[], uint32_t max_num,
+				uint32_t qi, int num, int stashed)
+{
+	odp_queue_t handle = queue_from_index(qi);
+	int ret;
+
+	if (stashed) {
+		sched_local.stash.num_ev   = num;
+		sched_local.stash.ev_index = 0;
+		sched_local.stash.queue    = handle;
+		ret = copy_from_stash(out_ev, max_num);
+	} else {
+		sched_local.stash.num_ev = 0;
+		ret = num;
+	}
+
+	/* Output the source queue handle */
+	if (out_queue)
+		*out_queue = handle;
+
+	return ret;
+}
+
 static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[], uint32_t max_num,
 				    int grp, int prio, int first_spr, int balance)
 {
-	int spr, new_spr, i, ret;
+	int spr, new_spr, i;
 	uint32_t qi;
 	int num_spread = sched->config.num_spread;
 	uint32_t ring_mask = sched->ring_mask;
@@ -1571,13 +2476,13 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 	for (i = 0; i < num_spread;) {
 		int num;
 		uint8_t sync_ctx, ordered;
-		odp_queue_t handle;
+		prio_queue_t *prio_q;
 		ring_mpmc_rst_u32_t *ring;
 		uint32_t *ring_data;
 		int pktin;
 		uint32_t max_deq;
 		int stashed = 1;
-		odp_event_t *ev_tbl = sched_local.stash.ev;
+		odp_event_t *ev_tbl = sched_local.stash_ev;
 
 		if (spr >= num_spread)
 			spr = 0;
@@ -1589,8 +2494,9 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 			continue;
 		}
 
-		ring = &sched->prio_q[grp][prio][spr].ring;
-		ring_data = sched->prio_q[grp][prio][spr].queue_index;
+		prio_q = prio_queue(grp, prio, spr);
+		ring = &prio_q->ring;
+		ring_data = prio_q->queue_index;
 
 		/* Get queue index from the spread queue */
 		if (ring_mpmc_rst_u32_deq(ring, ring_data, ring_mask, &qi) == 0) {
@@ -1627,12 +2533,34 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 		if (odp_unlikely(balance)) {
 			new_spr = balance_spread(grp, prio, spr);
 
-			if (new_spr != spr) {
+			if (new_spr != spr && update_queue_count(grp, prio, spr, new_spr) == 0) {
 				sched->queue[qi].spread = new_spr;
-				ring = &sched->prio_q[grp][prio][new_spr].ring;
-				ring_data = sched->prio_q[grp][prio][new_spr].queue_index;
-				update_queue_count(grp, prio, spr, new_spr);
+				prio_q = prio_queue(grp, prio, new_spr);
+				ring = &prio_q->ring;
+				ring_data = prio_q->queue_index;
+			}
+		}
+
+		if (sched->queue[qi].flow) {
+			num = flow_schedule(qi, pktin, ev_tbl, max_deq);
+
+			if (odp_unlikely(num < 0)) {
+				/* Queue was removed from scheduling */
+				continue;
+			}
+
+			/* Events are held in flow bins. Continue scheduling the queue. */
+			ring_mpmc_rst_u32_enq(ring, ring_data, ring_mask, qi);
+
+			if (num == 0) {
+				i++;
+				spr++;
+				continue;
 			}
+
+			sched_local.sync_ctx = sync_ctx;
+
+			return output_events(out_queue, out_ev, max_num, qi, num, stashed);
 		}
 
 		num = _odp_sched_queue_deq(qi, ev_tbl, max_deq, !pktin);
@@ -1701,23 +2629,7 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 			ring_mpmc_rst_u32_enq(ring, ring_data, ring_mask, qi);
 		}
 
-		handle = queue_from_index(qi);
-
-		if (stashed) {
-			sched_local.stash.num_ev   = num;
-			sched_local.stash.ev_index = 0;
-			sched_local.stash.queue    = handle;
-			ret = copy_from_stash(out_ev, max_num);
-		} else {
-			sched_local.stash.num_ev = 0;
-			ret = num;
-		}
-
-		/* Output the source queue handle */
-		if (out_queue)
-			*out_queue = handle;
-
-		return ret;
+		return output_events(out_queue, out_ev, max_num, qi, num, stashed);
 	}
 
 	return 0;
@@ -1732,7 +2644,8 @@ static inline int do_schedule(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t
 	uint32_t sched_round;
 	uint16_t spread_round;
 	uint32_t epoch;
-	uint64_t my_groups;
+	const grp_mask_t *my_groups;
+	const int num_prio = sched->config.num_prio;
 	int balance = 0;
 
 	if (sched_local.stash.num_ev) {
@@ -1793,11 +2706,11 @@ static inline int do_schedule(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t
 	if (odp_unlikely(num_grp == 0))
 		return 0;
 
-	my_groups = sched_local.grp_mask;
+	my_groups = &sched_local.grp_mask;
 	first_id = sched_local.grp_idx;
 	sched_local.grp_idx = (first_id + 1) % num_grp;
 
-	for (prio = 0; prio < NUM_PRIO; prio++) {
+	for (prio = 0; prio < num_prio; prio++) {
 		grp_id = first_id;
 
 		if (prio_grp_mask_check(prio, my_groups) == 0) {
@@ -2003,20 +2916,9 @@ static void order_unlock(void)
 	/* Nothing to do */
 }
 
-static void schedule_order_lock(uint32_t lock_index)
+static inline void ordered_lock_wait(uint32_t queue_index, uint32_t lock_index)
 {
-	odp_atomic_u64_t *ord_lock;
-	uint32_t queue_index;
-
-	if (sched_local.sync_ctx != ODP_SCHED_SYNC_ORDERED)
-		return;
-
-	queue_index = sched_local.ordered.src_queue;
-
-	_ODP_ASSERT(lock_index <= sched->queue[queue_index].order_lock_count &&
-		    !sched_local.ordered.lock_called.u8[lock_index]);
-
-	ord_lock = &sched->order[queue_index].lock[lock_index];
+	odp_atomic_u64_t *ord_lock = &sched->order[queue_index].lock[lock_index];
 
 	/* Busy loop to synchronize ordered processing */
 	while (1) {
@@ -2032,6 +2934,21 @@ static void schedule_order_lock(uint32_t lock_index)
 	}
 }
 
+static void schedule_order_lock(uint32_t lock_index)
+{
+	uint32_t queue_index;
+
+	if (sched_local.sync_ctx != ODP_SCHED_SYNC_ORDERED)
+		return;
+
+	queue_index = sched_local.ordered.src_queue;
+
+	_ODP_ASSERT(lock_index <= sched->queue[queue_index].order_lock_count &&
+		    !sched_local.ordered.lock_called.u8[lock_index]);
+
+	ordered_lock_wait(queue_index, lock_index);
+}
+
 static void schedule_order_unlock(uint32_t lock_index)
 {
 	odp_atomic_u64_t *ord_lock;
@@ -2051,6 +2968,32 @@ static void schedule_order_unlock(uint32_t lock_index)
 	odp_atomic_store_rel_u64(ord_lock, sched_local.ordered.ctx + 1);
 }
 
+static void order_seq_lock(schedule_order_seq_t seq)
+{
+	uint32_t lock_index = CONFIG_QUEUE_MAX_ORD_LOCKS + seq;
+
+	if (sched_local.sync_ctx != ODP_SCHED_SYNC_ORDERED ||
+	    sched_local.ordered.lock_called.u8[lock_index])
+		return;
+
+	ordered_lock_wait(sched_local.ordered.src_queue, lock_index);
+}
+
+static void order_seq_unlock(schedule_order_seq_t seq)
+{
+	uint32_t lock_index = CONFIG_QUEUE_MAX_ORD_LOCKS + seq;
+	uint32_t queue_index;
+
+	if (sched_local.sync_ctx != ODP_SCHED_SYNC_ORDERED ||
+	    sched_local.ordered.lock_called.u8[lock_index] != ORD_SEQ_HELD)
+		return;
+
+	queue_index = sched_local.ordered.src_queue;
+	sched_local.ordered.lock_called.u8[lock_index] = ORD_SEQ_PASSED;
+	odp_atomic_store_rel_u64(&sched->order[queue_index].lock[lock_index],
+				 sched_local.ordered.ctx + 1);
+}
+
 static void schedule_order_unlock_lock(uint32_t unlock_index,
 				       uint32_t lock_index)
 {
@@ -2141,7 +3084,7 @@ static odp_schedule_group_t allocate_group(const char *name, const odp_thrmask_t
 		return group;
 	}
 
-	for (int i = SCHED_GROUP_NAMED; i < NUM_SCHED_GRPS; i++) {
+	for (int i = SCHED_GROUP_NAMED; i < sched->config.num_groups; i++) {
 		if (!sched->sched_grp[i].allocated) {
 			char *grp_name = sched->sched_grp[i].name;
 
@@ -2229,7 +3172,7 @@ static int schedule_group_destroy(odp_schedule_group_t group)
 	odp_thrmask_t zero;
 	int i;
 
-	if (group >= NUM_SCHED_GRPS || group < SCHED_GROUP_NAMED) {
+	if (group >= sched->config.num_groups || group < SCHED_GROUP_NAMED) {
 		_ODP_ERR("Bad group %i\n", group);
 		return -1;
 	}
@@ -2265,7 +3208,7 @@ static odp_schedule_group_t schedule_group_lookup(const char *name)
 
 	odp_ticketlock_lock(&sched->grp_lock);
 
-	for (i = SCHED_GROUP_NAMED; i < NUM_SCHED_GRPS; i++) {
+	for (i = SCHED_GROUP_NAMED; i < sched->config.num_groups; i++) {
 		if (strcmp(name, sched->sched_grp[i].name) == 0) {
 			group = (odp_schedule_group_t)i;
 			break;
@@ -2281,7 +3224,7 @@ static int schedule_group_join(odp_schedule_group_t group, const odp_thrmask_t *
 	int i, count, thr;
 	odp_thrmask_t new_mask;
 
-	if (group >= NUM_SCHED_GRPS || group < SCHED_GROUP_NAMED) {
+	if (group >= sched->config.num_groups || group < SCHED_GROUP_NAMED) {
 		_ODP_ERR("Bad group %i\n", group);
 		return -1;
 	}
@@ -2327,7 +3270,7 @@ static int schedule_group_leave(odp_schedule_group_t group, const odp_thrmask_t
 	int i, count, thr;
 	odp_thrmask_t new_mask;
 
-	if (group >= NUM_SCHED_GRPS || group < SCHED_GROUP_NAMED) {
+	if (group >= sched->config.num_groups || group < SCHED_GROUP_NAMED) {
 		_ODP_ERR("Bad group %i\n", group);
 		return -1;
 	}
@@ -2377,7 +3320,7 @@ static int schedule_group_thrmask(odp_schedule_group_t group,
 
 	odp_ticketlock_lock(&sched->grp_lock);
 
-	if (group < NUM_SCHED_GRPS && sched->sched_grp[group].allocated) {
+	if (group < sched->config.num_groups && sched->sched_grp[group].allocated) {
 		*thrmask = sched->sched_grp[group].mask;
 		ret = 0;
 	} else {
@@ -2395,7 +3338,7 @@ static int schedule_group_info(odp_schedule_group_t group,
 
 	odp_ticketlock_lock(&sched->grp_lock);
 
-	if (group < NUM_SCHED_GRPS && sched->sched_grp[group].allocated) {
+	if (group < sched->config.num_groups && sched->sched_grp[group].allocated) {
 		info->name    = sched->sched_grp[group].name;
 		info->thrmask = sched->sched_grp[group].mask;
 		info->num     = sched->sched_grp[group].num_prio;
@@ -2509,6 +3452,8 @@ static void schedule_print(void)
 	ring_mpmc_rst_u32_t *ring;
 	odp_schedule_capability_t capa;
 	int num_spread = sched->config.num_spread;
+	int num_grps = sched->config.num_groups;
+	int num_prio = sched->config.num_prio;
 	const int col_width = 24;
 	const int size = 512;
 	char str[size];
@@ -2522,6 +3467,10 @@ static void schedule_print(void)
 	_ODP_PRINT("  max priorities:    %u\n", capa.max_prios);
 	_ODP_PRINT("  num spread:        %i\n", num_spread);
 	_ODP_PRINT("  prefer ratio:      %u\n", sched->config.prefer_ratio);
+
+	if (sched->flow_base)
+		_ODP_PRINT("  flow bins:         %u (%u events per bin)\n",
+			   sched->flow_bin_mask + 1, sched->flow_ring_mask + 1);
 	_ODP_PRINT("\n");
 
 	pos  = 0;
@@ -2534,17 +3483,17 @@ static void schedule_print(void)
 
 	_ODP_PRINT("%s\n", str);
 
-	for (prio = 0; prio < NUM_PRIO; prio++) {
-		for (grp = 0; grp < NUM_SCHED_GRPS; grp++)
+	for (prio = 0; prio < num_prio; prio++) {
+		for (grp = 0; grp < num_grps; grp++)
 			if (sched->prio_q_mask[grp][prio])
 				break;
 
-		if (grp == NUM_SCHED_GRPS)
+		if (grp == num_grps)
 			continue;
 
 		_ODP_PRINT("  prio: %i\n", prio);
 
-		for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
+		for (grp = 0; grp < num_grps; grp++) {
 			if (sched->sched_grp[grp].allocated == 0)
 				continue;
 
@@ -2553,7 +3502,7 @@ static void schedule_print(void)
 
 			for (spr = 0; spr < num_spread; spr++) {
 				num_queues = sched->prio_q_count[grp][prio][spr];
-				ring = &sched->prio_q[grp][prio][spr].ring;
+				ring = &prio_queue(grp, prio, spr)->ring;
 				num_active = ring_mpmc_rst_u32_len(ring);
 				pos += _odp_snprint(&str[pos], size - pos, " %3u/%3u",
 						    num_active, num_queues);
@@ -2566,7 +3515,7 @@ static void schedule_print(void)
 	_ODP_PRINT("\n  Number of threads per schedule group:\n");
 	_ODP_PRINT("             name                     spread\n");
 
-	for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
+	for (grp = 0; grp < num_grps; grp++) {
 		if (sched->sched_grp[grp].allocated == 0)
 			continue;
 
@@ -2617,6 +3566,8 @@ schedule_fn_t _odp_schedule_basic_fn = {
 	.term_local  = schedule_term_local,
 	.order_lock = order_lock,
 	.order_unlock = order_unlock,
+	.order_seq_lock = order_seq_lock,
+	.order_seq_unlock = order_seq_unlock,
 	.max_ordered_locks = schedule_max_ordered_locks,
 	.get_config = schedule_get_config,
 	.sched_api = sched_api,
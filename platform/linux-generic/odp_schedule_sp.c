@@ -1256,6 +1256,16 @@ static void order_unlock(void)
 	/* Nothing to do */
 }
 
+static void order_seq_lock(schedule_order_seq_t seq)
+{
+	(void)seq;
+}
+
+static void order_seq_unlock(schedule_order_seq_t seq)
+{
+	(void)seq;
+}
+
 static int schedule_capability(odp_schedule_capability_t *capa)
 {
 	memset(capa, 0, sizeof(odp_schedule_capability_t));
@@ -1313,6 +1323,8 @@ const schedule_fn_t _odp_schedule_sp_fn = {
 	.term_local    = term_local,
 	.order_lock    = order_lock,
 	.order_unlock  = order_unlock,
+	.order_seq_lock = order_seq_lock,
+	.order_seq_unlock = order_seq_unlock,
 	.max_ordered_locks = max_ordered_locks,
 	.get_config    = get_config,
 	.sched_api     = sched_api,
@@ -0,0 +1,143 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#include <odp_posix_extensions.h>
+
+#include <odp/api/cpumask.h>
+
+#include <odp_debug_internal.h>
+#include <odp_global_data.h>
+#include <odp_libconfig_internal.h>
+#include <odp_service_thread_internal.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+int _odp_service_thread_start(pthread_t *thread, const char *name, int cpu,
+			      void *(*start_fn)(void *), void *arg)
+{
+	pthread_attr_t attr;
+	cpu_set_t cpu_set;
+	int ret;
+
+	if (pthread_attr_init(&attr)) {
+		_ODP_ERR("pthread_attr_init() failed\n");
+		return -1;
+	}
+
+	if (cpu >= 0) {
+		CPU_ZERO(&cpu_set);
+		CPU_SET(cpu, &cpu_set);
+
+		if (pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpu_set)) {
+			_ODP_ERR("Setting CPU affinity (%i) failed\n", cpu);
+			pthread_attr_destroy(&attr);
+			return -1;
+		}
+	}
+
+	ret = pthread_create(thread, &attr, start_fn, arg);
+	pthread_attr_destroy(&attr);
+
+	if (ret) {
+		_ODP_ERR("pthread_create() failed: %s\n", strerror(ret));
+		return -1;
+	}
+
+	/* Thread name is for debugging only, ignore errors */
+	if (name)
+		(void)pthread_setname_np(*thread, name);
+
+	return 0;
+}
+
+int _odp_service_thread_join(pthread_t thread)
+{
+	int ret = pthread_join(thread, NULL);
+
+	if (ret) {
+		_ODP_ERR("pthread_join() failed: %s\n", strerror(ret));
+		return -1;
+	}
+
+	return 0;
+}
+
+typedef struct {
+	void (*fn)(void *arg, int idx, int num);
+	void *arg;
+	int idx;
+	int num;
+
+} parallel_part_t;
+
+static void *parallel_run(void *arg)
+{
+	parallel_part_t *part = arg;
+
+	part->fn(part->arg, part->idx, part->num);
+
+	return NULL;
+}
+
+void _odp_service_thread_parallel(int num, void (*fn)(void *arg, int idx, int num), void *arg)
+{
+	parallel_part_t part[_ODP_SERVICE_THREAD_MAX_CPUS];
+	pthread_t thread[_ODP_SERVICE_THREAD_MAX_CPUS];
+	int started[_ODP_SERVICE_THREAD_MAX_CPUS];
+	const odp_cpumask_t *mask = &odp_global_ro.control_cpus;
+	int i, cpu;
+
+	if (num > _ODP_SERVICE_THREAD_MAX_CPUS)
+		num = _ODP_SERVICE_THREAD_MAX_CPUS;
+
+	if (num < 1)
+		num = 1;
+
+	/* Calling thread runs the first part, others start from the next control CPU */
+	cpu = odp_cpumask_first(mask);
+
+	for (i = 1; i < num; i++) {
+		if (cpu >= 0) {
+			cpu = odp_cpumask_next(mask, cpu);
+			if (cpu < 0)
+				cpu = odp_cpumask_first(mask);
+		}
+
+		part[i].fn  = fn;
+		part[i].arg = arg;
+		part[i].idx = i;
+		part[i].num = num;
+
+		started[i] = !_odp_service_thread_start(&thread[i], "odp-init", cpu,
+							parallel_run, &part[i]);
+	}
+
+	fn(arg, 0, num);
+
+	for (i = 1; i < num; i++) {
+		if (started[i])
+			_odp_service_thread_join(thread[i]);
+		else
+			fn(arg, i, num);
+	}
+}
+
+int _odp_service_thread_cpus(const char *path, int cpu[], int max_num)
+{
+	int num, i;
+
+	num = _odp_libconfig_lookup_array(path, cpu, max_num);
+
+	for (i = 0; i < num; i++) {
+		if (cpu[i] < 0 || cpu[i] >= (int)ODP_CPUMASK_SIZE ||
+		    !odp_cpumask_isset(&odp_global_ro.all_cpus, cpu[i])) {
+			_ODP_ERR("Config option '%s': CPU %i not available\n", path, cpu[i]);
+			return -1;
+		}
+	}
+
+	return num;
+}
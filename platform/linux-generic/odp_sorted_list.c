@@ -1,6 +1,7 @@
 /* SPDX-License-Identifier: BSD-3-Clause
  * Copyright (c) 2015 EZchip Semiconductor Ltd.
  * Copyright (c) 2015-2018 Linaro Limited
+ * Copyright (c) 2026 Nokia
  */
 
 #include <stdint.h>
@@ -9,6 +10,7 @@
 #include <stdio.h>
 #include <inttypes.h>
 #include <odp_debug_internal.h>
+#include <odp_macros_internal.h>
 #include <odp_sorted_list_internal.h>
 
 typedef struct sorted_list_item_s sorted_list_item_t;
@@ -25,6 +27,34 @@ typedef struct {
 	uint32_t            pad;
 } sorted_list_desc_t;
 
+/* Binary heap item. Items with equal sort_key are ordered by insertion
+ * sequence number, so that ties go to the oldest entry like in the linked
+ * lists. */
+typedef struct {
+	uint64_t sort_key;
+	uint64_t seq;
+	uint64_t user_data;
+	uint32_t hash_idx;
+	uint32_t pad;
+} sorted_heap_item_t;
+
+/* Heap descriptor. The hash table maps user_data to heap item index, so that
+ * find and delete do not need to walk through the whole heap. The table is at
+ * least twice the size of the heap and uses linear probing. */
+typedef struct {
+	sorted_heap_item_t *items;
+	uint32_t           *hash_tbl;
+	uint64_t            next_seq;
+	uint32_t            num_items;
+	uint32_t            max_items;
+	uint32_t            hash_mask;
+	uint32_t            pad;
+} sorted_heap_desc_t;
+
+#define HEAP_HASH_EMPTY     UINT32_MAX
+#define HEAP_MIN_ITEMS      16
+#define HEAP_MAX_INIT_ITEMS 256
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpedantic"
 typedef struct {
@@ -38,19 +68,244 @@ typedef struct {
 	uint64_t             total_removes;
 	uint32_t             max_sorted_lists;
 	uint32_t             next_list_idx;
+	_odp_int_sorted_pool_type_t type;
 	sorted_list_descs_t *list_descs;
+	sorted_heap_desc_t  *heap_descs;
 } sorted_pool_t;
 
-_odp_int_sorted_pool_t _odp_sorted_pool_create(uint32_t max_sorted_lists)
+static inline uint32_t heap_hash(sorted_heap_desc_t *heap_desc,
+				 uint64_t user_data)
+{
+	return (uint32_t)((user_data * 0x9E3779B97F4A7C15ULL) >> 32) &
+		heap_desc->hash_mask;
+}
+
+static inline int heap_item_less(const sorted_heap_item_t *a,
+				 const sorted_heap_item_t *b)
+{
+	if (a->sort_key != b->sort_key)
+		return a->sort_key < b->sort_key;
+
+	return a->seq < b->seq;
+}
+
+static inline void heap_item_set(sorted_heap_desc_t *heap_desc, uint32_t idx,
+				 const sorted_heap_item_t *item)
+{
+	heap_desc->items[idx] = *item;
+	heap_desc->hash_tbl[item->hash_idx] = idx;
+}
+
+static uint32_t heap_hash_insert(sorted_heap_desc_t *heap_desc,
+				 uint64_t user_data, uint32_t item_idx)
+{
+	uint32_t hash_idx = heap_hash(heap_desc, user_data);
+
+	while (heap_desc->hash_tbl[hash_idx] != HEAP_HASH_EMPTY)
+		hash_idx = (hash_idx + 1) & heap_desc->hash_mask;
+
+	heap_desc->hash_tbl[hash_idx] = item_idx;
+	return hash_idx;
+}
+
+static int heap_hash_find(sorted_heap_desc_t *heap_desc, uint64_t user_data)
+{
+	uint32_t hash_idx, item_idx;
+
+	if (heap_desc->num_items == 0)
+		return -1;
+
+	hash_idx = heap_hash(heap_desc, user_data);
+
+	while ((item_idx = heap_desc->hash_tbl[hash_idx]) != HEAP_HASH_EMPTY) {
+		if (heap_desc->items[item_idx].user_data == user_data)
+			return (int)item_idx;
+
+		hash_idx = (hash_idx + 1) & heap_desc->hash_mask;
+	}
+
+	return -1;
+}
+
+/* Remove a hash table entry using backward shift deletion, which keeps probe
+ * sequences intact without tombstones. */
+static void heap_hash_remove(sorted_heap_desc_t *heap_desc, uint32_t hash_idx)
+{
+	uint32_t mask = heap_desc->hash_mask;
+	uint32_t i = hash_idx;
+	uint32_t j = hash_idx;
+	uint32_t home, item_idx;
+
+	while (1) {
+		j = (j + 1) & mask;
+		item_idx = heap_desc->hash_tbl[j];
+		if (item_idx == HEAP_HASH_EMPTY)
+			break;
+
+		home = heap_hash(heap_desc, heap_desc->items[item_idx].user_data);
+
+		/* Entry at j can be moved to i, if its home slot is not
+		 * cyclically within (i, j]. */
+		if ((i <= j) ? (home <= i || home > j) : (home <= i && home > j)) {
+			heap_desc->hash_tbl[i] = item_idx;
+			heap_desc->items[item_idx].hash_idx = i;
+			i = j;
+		}
+	}
+
+	heap_desc->hash_tbl[i] = HEAP_HASH_EMPTY;
+}
+
+static int heap_resize(sorted_heap_desc_t *heap_desc, uint32_t max_items)
+{
+	sorted_heap_item_t *items;
+	uint32_t *hash_tbl;
+	uint32_t hash_size, i;
+
+	hash_size = 1;
+	while (hash_size < 2 * max_items)
+		hash_size <<= 1;
+
+	items = realloc(heap_desc->items, max_items * sizeof(sorted_heap_item_t));
+	if (!items)
+		return -1;
+
+	heap_desc->items = items;
+
+	hash_tbl = malloc(hash_size * sizeof(uint32_t));
+	if (!hash_tbl)
+		return -1;
+
+	free(heap_desc->hash_tbl);
+	memset(hash_tbl, 0xff, hash_size * sizeof(uint32_t));
+	heap_desc->hash_tbl  = hash_tbl;
+	heap_desc->hash_mask = hash_size - 1;
+	heap_desc->max_items = max_items;
+
+	for (i = 0; i < heap_desc->num_items; i++)
+		items[i].hash_idx = heap_hash_insert(heap_desc, items[i].user_data, i);
+
+	return 0;
+}
+
+static void heap_sift_up(sorted_heap_desc_t *heap_desc, uint32_t idx)
+{
+	sorted_heap_item_t item = heap_desc->items[idx];
+	uint32_t parent;
+
+	while (idx > 0) {
+		parent = (idx - 1) / 2;
+		if (!heap_item_less(&item, &heap_desc->items[parent]))
+			break;
+
+		heap_item_set(heap_desc, idx, &heap_desc->items[parent]);
+		idx = parent;
+	}
+
+	heap_item_set(heap_desc, idx, &item);
+}
+
+static void heap_sift_down(sorted_heap_desc_t *heap_desc, uint32_t idx)
+{
+	sorted_heap_item_t item = heap_desc->items[idx];
+	uint32_t num = heap_desc->num_items;
+	uint32_t child;
+
+	while ((child = 2 * idx + 1) < num) {
+		if (child + 1 < num &&
+		    heap_item_less(&heap_desc->items[child + 1],
+				   &heap_desc->items[child]))
+			child++;
+
+		if (!heap_item_less(&heap_desc->items[child], &item))
+			break;
+
+		heap_item_set(heap_desc, idx, &heap_desc->items[child]);
+		idx = child;
+	}
+
+	heap_item_set(heap_desc, idx, &item);
+}
+
+static void heap_item_delete(sorted_heap_desc_t *heap_desc, uint32_t idx)
+{
+	uint32_t last;
+
+	heap_hash_remove(heap_desc, heap_desc->items[idx].hash_idx);
+
+	last = --heap_desc->num_items;
+	if (idx == last)
+		return;
+
+	heap_item_set(heap_desc, idx, &heap_desc->items[last]);
+
+	if (idx > 0 && heap_item_less(&heap_desc->items[idx],
+				      &heap_desc->items[(idx - 1) / 2]))
+		heap_sift_up(heap_desc, idx);
+	else
+		heap_sift_down(heap_desc, idx);
+}
+
+static int heap_insert(sorted_heap_desc_t *heap_desc, uint64_t sort_key,
+		       uint64_t user_data)
+{
+	sorted_heap_item_t *item;
+	uint32_t idx, max_items;
+
+	if (heap_desc->num_items == heap_desc->max_items) {
+		max_items = _ODP_MAX(2 * heap_desc->max_items,
+				     (uint32_t)HEAP_MIN_ITEMS);
+		if (heap_resize(heap_desc, max_items))
+			return -1;
+	}
+
+	idx  = heap_desc->num_items++;
+	item = &heap_desc->items[idx];
+	item->sort_key  = sort_key;
+	item->seq       = heap_desc->next_seq++;
+	item->user_data = user_data;
+	item->hash_idx  = heap_hash_insert(heap_desc, user_data, idx);
+
+	heap_sift_up(heap_desc, idx);
+	return 0;
+}
+
+static void heap_free(sorted_heap_desc_t *heap_desc)
+{
+	free(heap_desc->items);
+	free(heap_desc->hash_tbl);
+	memset(heap_desc, 0, sizeof(sorted_heap_desc_t));
+}
+
+_odp_int_sorted_pool_t _odp_sorted_pool_create(uint32_t max_sorted_lists,
+					       _odp_int_sorted_pool_type_t type)
 {
 	sorted_list_descs_t *list_descs;
+	sorted_heap_desc_t  *heap_descs;
 	sorted_pool_t       *pool;
 	uint32_t             malloc_len;
 
 	pool = malloc(sizeof(sorted_pool_t));
+	if (!pool)
+		return _ODP_INT_SORTED_POOL_INVALID;
+
 	memset(pool, 0, sizeof(sorted_pool_t));
 	pool->max_sorted_lists = max_sorted_lists;
 	pool->next_list_idx    = 1;
+	pool->type             = type;
+
+	if (type == _ODP_INT_SORTED_POOL_HEAP) {
+		malloc_len = max_sorted_lists * sizeof(sorted_heap_desc_t);
+		heap_descs = malloc(malloc_len);
+		if (!heap_descs) {
+			free(pool);
+			return _ODP_INT_SORTED_POOL_INVALID;
+		}
+
+		memset(heap_descs, 0, malloc_len);
+		pool->heap_descs = heap_descs;
+		return (_odp_int_sorted_pool_t)(uintptr_t)pool;
+	}
 
 	malloc_len = max_sorted_lists * sizeof(sorted_list_desc_t);
 	list_descs = malloc(malloc_len);
@@ -61,13 +316,23 @@ _odp_int_sorted_pool_t _odp_sorted_pool_create(uint32_t max_sorted_lists)
 
 _odp_int_sorted_list_t
 _odp_sorted_list_create(_odp_int_sorted_pool_t sorted_pool,
-			uint32_t max_entries ODP_UNUSED)
+			uint32_t max_entries)
 {
 	sorted_pool_t *pool;
-	uint32_t       list_idx;
+	uint32_t       list_idx, max_items;
 
 	pool     = (sorted_pool_t *)(uintptr_t)sorted_pool;
 	list_idx = pool->next_list_idx++;
+
+	if (pool->type == _ODP_INT_SORTED_POOL_HEAP &&
+	    list_idx < pool->max_sorted_lists) {
+		/* Preallocate room for the expected number of entries. Heap
+		 * grows on demand, if more are inserted. */
+		max_items = _ODP_MAX(max_entries, (uint32_t)HEAP_MIN_ITEMS);
+		max_items = _ODP_MIN(max_items, (uint32_t)HEAP_MAX_INIT_ITEMS);
+		heap_resize(&pool->heap_descs[list_idx], max_items);
+	}
+
 	return (_odp_int_sorted_list_t)list_idx;
 }
 
@@ -87,6 +352,14 @@ int _odp_sorted_list_insert(_odp_int_sorted_pool_t sorted_pool,
 	    (pool->max_sorted_lists <= list_idx))
 		return -1;
 
+	if (pool->type == _ODP_INT_SORTED_POOL_HEAP) {
+		if (heap_insert(&pool->heap_descs[list_idx], sort_key, user_data))
+			return -1;
+
+		pool->total_inserts++;
+		return 0;
+	}
+
 	list_desc     = &pool->list_descs->descs[list_idx];
 	new_list_item = malloc(sizeof(sorted_list_item_t));
 	memset(new_list_item, 0, sizeof(sorted_list_item_t));
@@ -131,6 +404,19 @@ int _odp_sorted_list_find(_odp_int_sorted_pool_t sorted_pool,
 	    (pool->max_sorted_lists <= list_idx))
 		return -1;
 
+	if (pool->type == _ODP_INT_SORTED_POOL_HEAP) {
+		sorted_heap_desc_t *heap_desc = &pool->heap_descs[list_idx];
+		int idx = heap_hash_find(heap_desc, user_data);
+
+		if (idx < 0)
+			return 0;
+
+		if (sort_key_ptr)
+			*sort_key_ptr = heap_desc->items[idx].sort_key;
+
+		return 1;
+	}
+
 	list_desc = &pool->list_descs->descs[list_idx];
 
        /* Now search the sorted linked list - as described by list_desc -
@@ -167,6 +453,18 @@ int _odp_sorted_list_delete(_odp_int_sorted_pool_t sorted_pool,
 	    (pool->max_sorted_lists <= list_idx))
 		return -1;
 
+	if (pool->type == _ODP_INT_SORTED_POOL_HEAP) {
+		sorted_heap_desc_t *heap_desc = &pool->heap_descs[list_idx];
+		int idx = heap_hash_find(heap_desc, user_data);
+
+		if (idx < 0)
+			return -1;
+
+		heap_item_delete(heap_desc, idx);
+		pool->total_deletes++;
+		return 0;
+	}
+
 	list_desc = &pool->list_descs->descs[list_idx];
 
        /* Now search the sorted linked list - as described by list_desc -
@@ -213,6 +511,23 @@ int _odp_sorted_list_remove(_odp_int_sorted_pool_t sorted_pool,
 	    (pool->max_sorted_lists <= list_idx))
 		return -1;
 
+	if (pool->type == _ODP_INT_SORTED_POOL_HEAP) {
+		sorted_heap_desc_t *heap_desc = &pool->heap_descs[list_idx];
+
+		if (heap_desc->num_items == 0)
+			return -1;
+
+		if (sort_key_ptr)
+			*sort_key_ptr = heap_desc->items[0].sort_key;
+
+		if (user_data_ptr)
+			*user_data_ptr = heap_desc->items[0].user_data;
+
+		heap_item_delete(heap_desc, 0);
+		pool->total_removes++;
+		return 1;
+	}
+
 	list_desc = &pool->list_descs->descs[list_idx];
 	if ((list_desc->sorted_list_len == 0) ||
 	    (!list_desc->first_item))
@@ -246,6 +561,14 @@ int _odp_sorted_list_destroy(_odp_int_sorted_pool_t sorted_pool,
 	    (pool->max_sorted_lists <= list_idx))
 		return -1;
 
+	if (pool->type == _ODP_INT_SORTED_POOL_HEAP) {
+		if (pool->heap_descs[list_idx].num_items != 0)
+			return -2;
+
+		heap_free(&pool->heap_descs[list_idx]);
+		return 0;
+	}
+
 	list_desc = &pool->list_descs->descs[list_idx];
 	if (list_desc->sorted_list_len != 0)
 		return -2;
@@ -259,7 +582,8 @@ void _odp_sorted_list_stats_print(_odp_int_sorted_pool_t sorted_pool)
 	sorted_pool_t *pool;
 
 	pool = (sorted_pool_t *)(uintptr_t)sorted_pool;
-	_ODP_PRINT("  sorted_pool=0x%" PRIX64 "\n", sorted_pool);
+	_ODP_PRINT("  sorted_pool=0x%" PRIX64 " type=%s\n", sorted_pool,
+		   pool->type == _ODP_INT_SORTED_POOL_HEAP ? "heap" : "list");
 	_ODP_PRINT("    max_sorted_lists=%u next_list_idx=%u\n",
 		   pool->max_sorted_lists, pool->next_list_idx);
 	_ODP_PRINT("    total_inserts=%" PRIu64 " total_deletes=%" PRIu64
@@ -273,9 +597,20 @@ void _odp_sorted_pool_destroy(_odp_int_sorted_pool_t sorted_pool)
 	sorted_list_desc_t  *list_desc;
 	sorted_list_item_t  *list_item, *next_list_item;
 	sorted_pool_t       *pool;
-	uint32_t             list_idx;
+	uint32_t             list_idx, num_lists;
 
 	pool       = (sorted_pool_t *)(uintptr_t)sorted_pool;
+
+	if (pool->type == _ODP_INT_SORTED_POOL_HEAP) {
+		num_lists = _ODP_MIN(pool->next_list_idx, pool->max_sorted_lists);
+		for (list_idx = 0; list_idx < num_lists; list_idx++)
+			heap_free(&pool->heap_descs[list_idx]);
+
+		free(pool->heap_descs);
+		free(pool);
+		return;
+	}
+
 	list_descs = pool->list_descs;
 
 	for (list_idx = 0; list_idx < pool->next_list_idx; list_idx++) {
@@ -317,11 +317,34 @@ static int system_cache_line(system_info_t *sysinfo)
  */
 static int system_hp(hugepage_info_t *hugeinfo)
 {
+	uint64_t size[HUGE_PAGE_SIZES_MAX];
+	int i, num;
+
 	hugeinfo->default_huge_page_size = default_huge_page_size();
 
 	/* default_huge_page_dir may be NULL if no huge page support */
 	hugeinfo->default_huge_page_dir = get_hugepage_dir(0);
 
+	/* Discover mount points of all supported huge page sizes */
+	hugeinfo->num_sizes = 0;
+	num = odp_sys_huge_page_size_all(size, HUGE_PAGE_SIZES_MAX);
+	if (num > HUGE_PAGE_SIZES_MAX)
+		num = HUGE_PAGE_SIZES_MAX;
+
+	for (i = 0; i < num; i++) {
+		char *dir = get_hugepage_dir(size[i]);
+
+		if (dir == NULL) {
+			_ODP_DBG("No hugetlbfs mount for %" PRIu64 " kB pages\n", size[i] / 1024);
+			continue;
+		}
+
+		_ODP_DBG("Huge page size %" PRIu64 " kB mounted at %s\n", size[i] / 1024, dir);
+		hugeinfo->size[hugeinfo->num_sizes] = size[i];
+		hugeinfo->dir[hugeinfo->num_sizes] = dir;
+		hugeinfo->num_sizes++;
+	}
+
 	return 0;
 }
 
@@ -439,7 +462,13 @@ int _odp_system_info_init(void)
  */
 int _odp_system_info_term(void)
 {
-	free(odp_global_ro.hugepage_info.default_huge_page_dir);
+	hugepage_info_t *hugeinfo = &odp_global_ro.hugepage_info;
+	int i;
+
+	free(hugeinfo->default_huge_page_dir);
+
+	for (i = 0; i < hugeinfo->num_sizes; i++)
+		free(hugeinfo->dir[i]);
 
 	return 0;
 }
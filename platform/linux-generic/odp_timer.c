@@ -46,15 +46,19 @@
 #include <odp_pool_internal.h>
 #include <odp_string_internal.h>
 #include <odp_queue_if.h>
+#include <odp_service_thread_internal.h>
 #include <odp_timer_internal.h>
 #include <odp_types_internal.h>
 
 #include <errno.h>
 #include <inttypes.h>
+#include <limits.h>
+#include <linux/futex.h>
 #include <pthread.h>
 #include <signal.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/prctl.h>
 #include <sys/syscall.h>
 #include <time.h>
 #include <unistd.h>
@@ -105,6 +109,21 @@
 
 #define ACC_SIZE (1ull << 32)
 
+/* Max number of timers processed per burst in timer start/restart multi calls */
+#define TIMER_BURST_MAX 32
+
+/* Number of buckets in statistics histograms */
+#define HIST_SIZE ODP_TIMER_POOL_STATS_HIST_SIZE
+
+/* Maximum number of timer pool threads */
+#define MAX_SVC_THREADS _ODP_SERVICE_THREAD_MAX_CPUS
+
+/* Timer start bursts track timer pool threads in a 64-bit mask */
+ODP_STATIC_ASSERT(MAX_SVC_THREADS <= 64, "Too many timer pool threads");
+
+/* Maximum sleep time of a timer pool thread */
+#define SVC_MAX_SLEEP_NS ODP_TIME_SEC_IN_NS
+
 #include <odp/visibility_begin.h>
 
 /* Fill in timeout header field offsets for inline functions */
@@ -215,6 +234,37 @@ typedef struct timer_pool_s {
 
 	odp_pool_t tmo_pool;
 	uint8_t periodic;
+
+	/* Sharded inline timer scan. Shards are claimed with a running counter. Shard index is
+	 * the counter value modulo number of shards. Claims below 'limit' belong to the current
+	 * scan round, which scans timers expiring at or before 'tick'. Number of shards is fixed
+	 * for the round at round start. */
+	struct ODP_ALIGNED_CACHE {
+		odp_atomic_u64_t claim;
+		odp_atomic_u64_t limit;
+		odp_atomic_u64_t tick;
+		odp_atomic_u32_t num;
+	} shard;
+
+	/* Statistics. Scan statistics are collected into a local structure and updated here
+	 * once per scan. */
+	struct ODP_ALIGNED_CACHE {
+		odp_atomic_u64_t scans;
+		odp_atomic_u64_t missed_scans;
+		odp_atomic_u64_t expired;
+		odp_atomic_u64_t scan_ns_max;
+		odp_atomic_u64_t late_ns_max;
+		odp_atomic_u64_t scan_ns_hist[HIST_SIZE];
+		odp_atomic_u64_t expired_hist[HIST_SIZE];
+		odp_atomic_u64_t late_ns_hist[HIST_SIZE];
+	} stats;
+
+	/* Time of the previous POSIX timer scan, used for missed scan detection */
+	uint64_t posix_last_ns;
+
+	/* Timer pool thread processing this pool, or -1 */
+	int svc_thr;
+
 #if !USE_128BIT_ATOMICS
 	/* Multiple locks per cache line! */
 	_odp_atomic_flag_t locks[NUM_LOCKS] ODP_ALIGNED_CACHE;
@@ -229,6 +279,23 @@ typedef struct timer_pool_s {
 #define TIMER_RES_TEST_LOOP_COUNT 10
 #define TIMER_RES_ROUNDUP_FACTOR 10
 
+typedef struct ODP_ALIGNED_CACHE timer_svc_thread_t {
+	/* Wake up sequence number. Futex word, which is incremented to wake up the thread. */
+	odp_atomic_u32_t seq;
+
+	/* Thread is sleeping or about to sleep */
+	odp_atomic_u32_t sleeping;
+
+	/* Time (odp_time_global_ns()) when the thread is going to scan next. Zero while
+	 * the thread is scanning. */
+	odp_atomic_u64_t wake_ns;
+
+	pthread_t thread;
+	int cpu;
+	int idx;
+
+} timer_svc_thread_t;
+
 typedef struct timer_global_t {
 	odp_ticketlock_t lock;
 	odp_shm_t shm;
@@ -248,10 +315,32 @@ typedef struct timer_global_t {
 	odp_bool_t use_inline_timers;
 	int poll_interval;
 	int highest_tp_idx;
+	uint32_t shard_size;
 	uint8_t thread_type;
+	odp_bool_t stats;
+
+	/* Timer pool threads */
+	struct {
+		odp_ticketlock_t lock;
+		uint32_t num_pools;
+		odp_atomic_u32_t exit;
+		uint8_t enable;
+		int num_thr;
+		int cpu[MAX_SVC_THREADS];
+		timer_svc_thread_t thr[MAX_SVC_THREADS];
+
+	} svc;
 
 } timer_global_t;
 
+/* Statistics of a single scan */
+typedef struct {
+	uint32_t expired;
+	uint64_t late_max;
+	uint32_t late_hist[HIST_SIZE];
+
+} timer_scan_stats_t;
+
 typedef struct timer_local_t {
 	odp_time_t last_run;
 	int        run_cnt;
@@ -266,6 +355,52 @@ static timer_global_t *timer_global;
 /* Timer thread local data */
 static __thread timer_local_t timer_local;
 
+static inline void futex_wait(odp_atomic_u32_t *futex, uint32_t val, uint64_t nsec)
+{
+	struct timespec ts;
+
+	ts.tv_sec  = nsec / ODP_TIME_SEC_IN_NS;
+	ts.tv_nsec = nsec % ODP_TIME_SEC_IN_NS;
+
+	/* Private futex, timer pool threads are not used in process mode */
+	(void)syscall(SYS_futex, &futex->v, FUTEX_WAIT_PRIVATE, val, &ts, NULL, 0);
+}
+
+static inline void futex_wake(odp_atomic_u32_t *futex)
+{
+	(void)syscall(SYS_futex, &futex->v, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+/* Wake up timer pool thread, if it is going to sleep past the new expiration time. Caller has
+ * ordered timer updates before this call with a full barrier, which pairs with the full barrier
+ * after thread's wake_ns store. */
+static void timer_svc_wake(timer_svc_thread_t *thr, uint64_t abs_tick)
+{
+	uint64_t wake_ns = odp_atomic_load_u64(&thr->wake_ns);
+
+	/* Thread is going to wake up in time. Tick is nanoseconds. */
+	if (wake_ns != 0 && abs_tick >= wake_ns)
+		return;
+
+	/* Release pairs with the acquire load of the sequence number in the thread loop */
+	odp_atomic_add_rel_u32(&thr->seq, 1);
+
+	/* Sequence number update must be visible before sleep flag load */
+	odp_mb_full();
+
+	if (odp_atomic_load_u32(&thr->sleeping))
+		futex_wake(&thr->seq);
+}
+
+/* Notify timer pool thread after a single timer has been set */
+static void timer_svc_notify(timer_pool_t *tp, uint64_t abs_tick)
+{
+	/* Timer update must be visible before wake up time load */
+	odp_mb_full();
+
+	timer_svc_wake(&timer_global->svc.thr[tp->svc_thr], abs_tick);
+}
+
 static inline void set_next_free(_odp_timer_t *tim, uint32_t nf)
 {
 	_ODP_ASSERT(tim->queue == ODP_QUEUE_INVALID);
@@ -366,6 +501,31 @@ static void posix_timer_stop(timer_pool_t *tp)
 		_ODP_ABORT("Unable to join thread, err %d\n", ret);
 }
 
+static void timer_svc_stop(int num)
+{
+	odp_atomic_store_rel_u32(&timer_global->svc.exit, 1);
+
+	for (int i = 0; i < num; i++) {
+		timer_svc_thread_t *thr = &timer_global->svc.thr[i];
+
+		odp_atomic_inc_u32(&thr->seq);
+		futex_wake(&thr->seq);
+		(void)_odp_service_thread_join(thr->thread);
+	}
+}
+
+static void timer_svc_pool_rem(void)
+{
+	odp_ticketlock_lock(&timer_global->svc.lock);
+
+	timer_global->svc.num_pools--;
+
+	if (timer_global->svc.num_pools == 0)
+		timer_svc_stop(timer_global->svc.num_thr);
+
+	odp_ticketlock_unlock(&timer_global->svc.lock);
+}
+
 static void odp_timer_pool_del(timer_pool_t *tp)
 {
 	int highest;
@@ -373,7 +533,9 @@ static void odp_timer_pool_del(timer_pool_t *tp)
 
 	odp_spinlock_lock(&tp->lock);
 
-	if (!timer_global->use_inline_timers)
+	if (tp->svc_thr >= 0)
+		timer_svc_pool_rem();
+	else if (!timer_global->use_inline_timers)
 		posix_timer_stop(tp);
 
 	if (tp->num_alloc != 0) {
@@ -453,8 +615,25 @@ static inline odp_timer_t timer_alloc(timer_pool_t *tp, odp_queue_t queue, const
 	return hdl;
 }
 
+static inline void timeout_hdr_fill(timer_pool_t *tp, uint32_t idx, odp_event_t tmo_event)
+{
+	/* Fill in some (constant) header fields for timeout events */
+	if (odp_event_type(tmo_event) == ODP_EVENT_TIMEOUT) {
+		/* Convert from event to timeout hdr */
+		odp_timeout_hdr_t *tmo_hdr = timeout_hdr_from_event(tmo_event);
+
+		tmo_hdr->timer = tp_idx_to_handle(tp, idx);
+		tmo_hdr->user_ptr = tp->timers[idx].user_ptr;
+		/* expiration field filled in when timer expires */
+	}
+	/* Else ignore events of other types */
+}
+
+/* When 'batch' is set, caller has filled in the timeout header and issued a release fence before
+ * the call. Timer state is then updated with relaxed memory ordering, and caller must issue an
+ * acquire fence before accessing the returned old event. */
 static bool timer_reset(uint32_t idx, uint64_t abs_tck, odp_event_t *tmo_event,
-			timer_pool_t *tp)
+			timer_pool_t *tp, int batch)
 {
 	bool success = true;
 	tick_buf_t *tb = &tp->tick_buf[idx];
@@ -486,8 +665,10 @@ static bool timer_reset(uint32_t idx, uint64_t abs_tck, odp_event_t *tmo_event,
 
 			/* Atomic CAS will fail if we experienced torn reads,
 			 * retry update sequence until CAS succeeds */
-		} while (!odp_atomic_cas_rel_u128(&tb->tb_atomic_u128,
-						  &old.tb_u128, new.tb_u128));
+		} while (batch ? !odp_atomic_cas_u128(&tb->tb_atomic_u128,
+						      &old.tb_u128, new.tb_u128) :
+				 !odp_atomic_cas_rel_u128(&tb->tb_atomic_u128,
+							  &old.tb_u128, new.tb_u128));
 #else
 		/* Take a related lock */
 		while (_odp_atomic_flag_tas(IDX2LOCK(tp, idx)))
@@ -510,16 +691,9 @@ static bool timer_reset(uint32_t idx, uint64_t abs_tck, odp_event_t *tmo_event,
 #endif
 	} else {
 		/* We have a new timeout event which replaces any old one */
-		/* Fill in some (constant) header fields for timeout events */
-		if (odp_event_type(*tmo_event) == ODP_EVENT_TIMEOUT) {
-			/* Convert from event to timeout hdr */
-			odp_timeout_hdr_t *tmo_hdr =
-				timeout_hdr_from_event(*tmo_event);
-			tmo_hdr->timer = tp_idx_to_handle(tp, idx);
-			tmo_hdr->user_ptr = tp->timers[idx].user_ptr;
-			/* expiration field filled in when timer expires */
-		}
-		/* Else ignore events of other types */
+		if (!batch)
+			timeout_hdr_fill(tp, idx, *tmo_event);
+
 		odp_event_t old_event = ODP_EVENT_INVALID;
 #if USE_128BIT_ATOMICS
 		tick_buf_t new, old;
@@ -535,7 +709,7 @@ static bool timer_reset(uint32_t idx, uint64_t abs_tck, odp_event_t *tmo_event,
 		_odp_atomic_u128_xchg_mm((_odp_atomic_u128_t *)tb,
 					 (_odp_u128_t *)&new,
 					 (_odp_u128_t *)&old,
-					 _ODP_MEMMODEL_ACQ_RLS);
+					 batch ? _ODP_MEMMODEL_RLX : _ODP_MEMMODEL_ACQ_RLS);
 		old_event = old.tmo_event;
 #else
 		/* Take a related lock */
@@ -557,6 +731,11 @@ static bool timer_reset(uint32_t idx, uint64_t abs_tck, odp_event_t *tmo_event,
 		/* Return old timeout event */
 		*tmo_event = old_event;
 	}
+
+	/* Batch callers notify timer pool threads once per batch */
+	if (odp_unlikely(tp->svc_thr >= 0) && success && !batch)
+		timer_svc_notify(tp, abs_tck);
+
 	return success;
 }
 
@@ -696,7 +875,8 @@ static odp_event_t timer_cancel(timer_pool_t *tp, uint32_t idx)
 	return old_event;
 }
 
-static inline void timer_expire(timer_pool_t *tp, uint32_t idx, uint64_t tick)
+/* Returns 1 and expiration tick when timeout event was delivered, otherwise 0 */
+static inline int timer_expire(timer_pool_t *tp, uint32_t idx, uint64_t tick, uint64_t *exp_out)
 {
 	uint64_t exp_tck;
 	odp_queue_t queue = ODP_QUEUE_INVALID;
@@ -741,7 +921,7 @@ static inline void timer_expire(timer_pool_t *tp, uint32_t idx, uint64_t tick)
 #else
 	/* Try to take a related lock */
 	if (_odp_atomic_flag_tas(IDX2LOCK(tp, idx)))
-		return;
+		return 0;
 
 	/* Proper check for timer expired */
 	exp_tck = tb->exp_tck.v;
@@ -781,18 +961,63 @@ static inline void timer_expire(timer_pool_t *tp, uint32_t idx, uint64_t tick)
 
 		if (odp_unlikely(rc != 0))
 			_ODP_ABORT("Failed to enqueue timeout event (%d)\n", rc);
+
+		*exp_out = exp_tck;
+		return 1;
 	}
+
+	return 0;
 }
 
-static inline uint64_t timer_pool_scan(timer_pool_t *tp, uint64_t tick)
+static inline uint32_t stats_hist_idx(uint64_t val)
+{
+	uint32_t idx;
+
+	if (val < 2)
+		return 0;
+
+	idx = 63 - __builtin_clzll(val);
+
+	return idx < HIST_SIZE ? idx : HIST_SIZE - 1;
+}
+
+static void timer_pool_stats_update(timer_pool_t *tp, const timer_scan_stats_t *scan,
+				    uint64_t scan_ns)
+{
+	odp_atomic_inc_u64(&tp->stats.scans);
+	odp_atomic_max_u64(&tp->stats.scan_ns_max, scan_ns);
+	odp_atomic_inc_u64(&tp->stats.scan_ns_hist[stats_hist_idx(scan_ns)]);
+	odp_atomic_inc_u64(&tp->stats.expired_hist[stats_hist_idx(scan->expired)]);
+
+	if (scan->expired == 0)
+		return;
+
+	for (int i = 0; i < HIST_SIZE; i++) {
+		if (scan->late_hist[i])
+			odp_atomic_add_u64(&tp->stats.late_ns_hist[i], scan->late_hist[i]);
+	}
+
+	odp_atomic_max_u64(&tp->stats.late_ns_max, scan->late_max);
+	odp_atomic_add_rel_u64(&tp->stats.expired, scan->expired);
+}
+
+static inline uint64_t scan_range(timer_pool_t *tp, uint64_t tick, uint32_t first, uint32_t end,
+				  const int stats)
 {
 	tick_buf_t *array = &tp->tick_buf[0];
-	uint32_t high_wm = odp_atomic_load_acq_u32(&tp->high_wm);
 	uint32_t i;
 	uint64_t min = UINT64_MAX;
+	uint64_t start_ns = 0;
+	timer_scan_stats_t scan;
 
-	_ODP_ASSERT(high_wm <= tp->param.num_timers);
-	for (i = 0; i < high_wm; i++) {
+	if (stats) {
+		start_ns = odp_time_local_ns();
+		scan.expired = 0;
+		scan.late_max = 0;
+		memset(scan.late_hist, 0, sizeof(scan.late_hist));
+	}
+
+	for (i = first; i < end; i++) {
 		/* As a rare occurrence, we can outsmart the HW prefetcher
 		 * and the compiler (GCC -fprefetch-loop-arrays) with some
 		 * tuned manual prefetching (32x16=512B ahead), seems to
@@ -802,27 +1027,132 @@ static inline uint64_t timer_pool_scan(timer_pool_t *tp, uint64_t tick)
 		uint64_t exp_tck = array[i].exp_tck.v;
 
 		if (odp_unlikely(exp_tck <= tick)) {
-			/* Attempt to expire timer */
-			timer_expire(tp, i, tick);
+			/* Attempt to expire timer. Tick is nanoseconds, so lateness is the tick
+			 * difference. */
+			if (timer_expire(tp, i, tick, &exp_tck) && stats) {
+				uint64_t late = tick - exp_tck;
+
+				scan.expired++;
+				scan.late_max = _ODP_MAX(scan.late_max, late);
+				scan.late_hist[stats_hist_idx(late)]++;
+			}
 			min = 0;
 		} else {
 			min = _ODP_MIN(min, exp_tck - tick);
 		}
 	}
 
+	if (stats)
+		timer_pool_stats_update(tp, &scan, odp_time_local_ns() - start_ns);
+
 	return min;
 }
 
+static inline uint64_t timer_pool_scan_range(timer_pool_t *tp, uint64_t tick, uint32_t first,
+					      uint32_t end)
+{
+	/* Separate loops with and without statistics collection */
+	if (timer_global->stats)
+		return scan_range(tp, tick, first, end, 1);
+
+	return scan_range(tp, tick, first, end, 0);
+}
+
+static inline uint64_t timer_pool_scan(timer_pool_t *tp, uint64_t tick)
+{
+	uint32_t high_wm = odp_atomic_load_acq_u32(&tp->high_wm);
+
+	_ODP_ASSERT(high_wm <= tp->param.num_timers);
+
+	return timer_pool_scan_range(tp, tick, 0, high_wm);
+}
+
+static void timer_pool_stats_init(timer_pool_t *tp)
+{
+	odp_atomic_init_u64(&tp->stats.scans, 0);
+	odp_atomic_init_u64(&tp->stats.missed_scans, 0);
+	odp_atomic_init_u64(&tp->stats.expired, 0);
+	odp_atomic_init_u64(&tp->stats.scan_ns_max, 0);
+	odp_atomic_init_u64(&tp->stats.late_ns_max, 0);
+
+	for (int i = 0; i < HIST_SIZE; i++) {
+		odp_atomic_init_u64(&tp->stats.scan_ns_hist[i], 0);
+		odp_atomic_init_u64(&tp->stats.expired_hist[i], 0);
+		odp_atomic_init_u64(&tp->stats.late_ns_hist[i], 0);
+	}
+}
+
 /******************************************************************************
  * Inline timer processing
  *****************************************************************************/
 
+/* Claim and scan one shard of the current scan round. Returns 1 when a shard was scanned. */
+static inline int timer_pool_scan_shard(timer_pool_t *tp, uint64_t *min)
+{
+	uint32_t high_wm, first, end, num_shard;
+	uint32_t shard_size = timer_global->shard_size;
+	uint64_t claim, tick, ticks;
+
+	/* Check before claiming to avoid cache line writes when the round is complete */
+	if (odp_atomic_load_u64(&tp->shard.claim) >= odp_atomic_load_u64(&tp->shard.limit))
+		return 0;
+
+	claim = odp_atomic_fetch_inc_u64(&tp->shard.claim);
+
+	/* Acquire pairs with the release in round start, round tick and number of shards are
+	 * at least as new as limit. Number of shards is non-zero when a claim is below limit. */
+	if (claim >= odp_atomic_load_acq_u64(&tp->shard.limit))
+		return 0;
+
+	tick = odp_atomic_load_u64(&tp->shard.tick);
+	num_shard = odp_atomic_load_u32(&tp->shard.num);
+	high_wm = odp_atomic_load_acq_u32(&tp->high_wm);
+	_ODP_ASSERT(high_wm <= tp->param.num_timers);
+	first = (claim % num_shard) * shard_size;
+
+	end = _ODP_MIN(first + shard_size, high_wm);
+	ticks = timer_pool_scan_range(tp, tick, first, end);
+
+	*min = _ODP_MIN(*min, ticks);
+	return 1;
+}
+
+/* Scan one shard of the current round, or all remaining shards when 'all' is set */
+static inline void timer_pool_scan_shards(timer_pool_t *tp, uint64_t *min, int all)
+{
+	while (timer_pool_scan_shard(tp, min) && all)
+		;
+}
+
+/* Start a new sharded scan round. Caller has won the scan tick update. */
+static inline uint64_t timer_pool_scan_round(timer_pool_t *tp, uint64_t tick, int all)
+{
+	uint32_t high_wm = odp_atomic_load_acq_u32(&tp->high_wm);
+	uint32_t shard_size = timer_global->shard_size;
+	uint32_t num_shard = (high_wm + shard_size - 1) / shard_size;
+	uint64_t min = UINT64_MAX;
+
+	/* Shards not claimed in the previous round are scanned here, so that no shard is
+	 * delayed by more than one round when only a few threads poll the pool. */
+	timer_pool_scan_shards(tp, &min, 1);
+
+	odp_atomic_store_u64(&tp->shard.tick, tick);
+	odp_atomic_store_u32(&tp->shard.num, num_shard);
+	odp_atomic_store_rel_u64(&tp->shard.limit, odp_atomic_load_u64(&tp->shard.claim) +
+				 num_shard);
+
+	timer_pool_scan_shards(tp, &min, all);
+
+	return min;
+}
+
 static inline uint64_t timer_pool_scan_inline(int num, odp_time_t now, int force)
 {
 	timer_pool_t *tp;
 	uint64_t new_tick, old_tick, ticks_to_next_expire, nsec, min = UINT64_MAX;
 	int64_t diff;
 	int i;
+	int shard = timer_global->shard_size;
 
 	for (i = 0; i < num; i++) {
 		tp = timer_global->timer_pool[i];
@@ -846,10 +1176,18 @@ static inline uint64_t timer_pool_scan_inline(int num, odp_time_t now, int force
 		old_tick = odp_atomic_load_u64(&tp->cur_tick);
 		diff = new_tick - old_tick;
 
-		if (diff < 1 && !force)
+		if (diff < 1 && (shard || !force)) {
+			/* Help with the current scan round. On force, the thread is going to
+			 * sleep and scans all shards not yet claimed by other threads. */
+			if (shard)
+				timer_pool_scan_shards(tp, &min, force);
 			continue;
+		}
 
 		if (odp_atomic_cas_u64(&tp->cur_tick, &old_tick, new_tick)) {
+			if (odp_unlikely(diff > 1 && old_tick != 0))
+				odp_atomic_add_u64(&tp->stats.missed_scans, diff - 1);
+
 			if (ODP_DEBUG_PRINT && odp_atomic_load_u32(&tp->notify_overrun) == 1 &&
 			    diff > 1) {
 				if (old_tick == 0) {
@@ -861,8 +1199,13 @@ static inline uint64_t timer_pool_scan_inline(int num, odp_time_t now, int force
 					odp_atomic_store_u32(&tp->notify_overrun, 2);
 				}
 			}
-			ticks_to_next_expire = timer_pool_scan(tp, nsec);
+			if (shard)
+				ticks_to_next_expire = timer_pool_scan_round(tp, nsec, force);
+			else
+				ticks_to_next_expire = timer_pool_scan(tp, nsec);
 			min = _ODP_MIN(min, ticks_to_next_expire);
+		} else if (shard) {
+			timer_pool_scan_shards(tp, &min, force);
 		}
 	}
 
@@ -945,6 +1288,16 @@ static inline void timer_run_posix(timer_pool_t *tp)
 		__builtin_prefetch(&array[i], 0, 0);
 
 	nsec = odp_time_global_ns();
+
+	/* Timer signal period is the timer pool resolution */
+	if (tp->posix_last_ns) {
+		uint64_t periods = (nsec - tp->posix_last_ns) / tp->param.res_ns;
+
+		if (odp_unlikely(periods > 1))
+			odp_atomic_add_u64(&tp->stats.missed_scans, periods - 1);
+	}
+
+	tp->posix_last_ns = nsec;
 	timer_pool_scan(tp, nsec);
 }
 
@@ -999,6 +1352,127 @@ static void *timer_thread(void *arg)
 	return NULL;
 }
 
+/******************************************************************************
+ * Timer pool threads
+ * A pool of threads, which process multiple timer pools each. Threads sleep
+ * until the next timer expiration instead of waking up on every resolution
+ * period. A thread is woken up early when a timer is set to expire before
+ * the current wake up time.
+ *****************************************************************************/
+
+/* Scan timer pools of a thread. Returns time of the next scan. */
+static uint64_t timer_svc_scan(int thr_idx, uint64_t now)
+{
+	uint64_t next = now + SVC_MAX_SLEEP_NS;
+
+	for (int i = 0; i < MAX_TIMER_POOLS; i++) {
+		timer_pool_t *tp = timer_global->timer_pool[i];
+		uint64_t ticks_to_next_expire;
+
+		if (tp == NULL || tp->svc_thr != thr_idx)
+			continue;
+
+		ticks_to_next_expire = timer_pool_scan(tp, now);
+
+		/* Zero means that some timers expired and the scan does not tell time to the
+		 * next expiration. Scan again after the normal scan period. */
+		if (ticks_to_next_expire == 0)
+			ticks_to_next_expire = tp->nsec_per_scan;
+
+		if (ticks_to_next_expire < next - now)
+			next = now + ticks_to_next_expire;
+	}
+
+	return next;
+}
+
+static void *timer_svc_thread(void *arg)
+{
+	timer_svc_thread_t *thr = arg;
+	uint64_t now, next;
+	uint32_t seq;
+
+	/* Wake up as close to the requested time as possible */
+	(void)prctl(PR_SET_TIMERSLACK, 1UL, 0, 0, 0);
+
+	while (1) {
+		seq = odp_atomic_load_acq_u32(&thr->seq);
+
+		if (odp_atomic_load_acq_u32(&timer_global->svc.exit))
+			break;
+
+		/* Callers setting timers during the scan update the sequence number */
+		odp_atomic_store_u64(&thr->wake_ns, 0);
+		odp_mb_full();
+
+		now  = odp_time_global_ns();
+		next = timer_svc_scan(thr->idx, now);
+
+		odp_atomic_store_u64(&thr->wake_ns, next);
+		odp_atomic_store_u32(&thr->sleeping, 1);
+		odp_mb_full();
+
+		/* Sleep, unless a timer was set meanwhile. Futex wait returns immediately, if
+		 * the sequence number changes before the thread is sleeping. */
+		if (odp_atomic_load_u32(&thr->seq) == seq) {
+			now = odp_time_global_ns();
+
+			if (next > now)
+				futex_wait(&thr->seq, seq, next - now);
+		}
+
+		odp_atomic_store_u32(&thr->sleeping, 0);
+	}
+
+	return NULL;
+}
+
+static int timer_svc_start(void)
+{
+	timer_svc_thread_t *thr;
+	char name[16];
+	int i;
+
+	odp_atomic_store_u32(&timer_global->svc.exit, 0);
+
+	for (i = 0; i < timer_global->svc.num_thr; i++) {
+		thr = &timer_global->svc.thr[i];
+		odp_atomic_store_u32(&thr->sleeping, 0);
+		odp_atomic_store_u64(&thr->wake_ns, 0);
+		snprintf(name, sizeof(name), "odp-timer%i", i);
+
+		if (_odp_service_thread_start(&thr->thread, name, thr->cpu, timer_svc_thread, thr))
+			goto fail;
+	}
+
+	return 0;
+
+fail:
+	_ODP_ERR("Starting timer pool thread %i failed\n", i);
+	timer_svc_stop(i);
+	return -1;
+}
+
+/* Timer pool threads run while there are timer pools */
+static int timer_svc_pool_add(timer_pool_t *tp)
+{
+	int ret = 0;
+
+	tp->svc_thr = tp->tp_idx % timer_global->svc.num_thr;
+
+	odp_ticketlock_lock(&timer_global->svc.lock);
+
+	if (timer_global->svc.num_pools == 0)
+		ret = timer_svc_start();
+
+	if (ret == 0)
+		timer_global->svc.num_pools++;
+
+	odp_ticketlock_unlock(&timer_global->svc.lock);
+
+	return ret;
+}
+
 /* Get the max timer resolution without overrun and fill in timer_res variable.
  *
  * Set timer's interval with candidate resolutions to get the max resolution
@@ -1319,6 +1793,11 @@ static odp_timer_pool_t timer_pool_new(const char *name, const odp_timer_pool_pa
 	tp->nsec_per_scan = nsec_per_scan;
 
 	odp_atomic_init_u64(&tp->cur_tick, 0);
+	timer_pool_stats_init(tp);
+	odp_atomic_init_u64(&tp->shard.claim, 0);
+	odp_atomic_init_u64(&tp->shard.limit, 0);
+	odp_atomic_init_u64(&tp->shard.tick, 0);
+	odp_atomic_init_u32(&tp->shard.num, 0);
 
 	if (name == NULL)
 		tp->name[0] = 0;
@@ -1378,6 +1857,15 @@ static odp_timer_pool_t timer_pool_new(const char *name, const odp_timer_pool_pa
 	tp->tp_idx = tp_idx;
 	odp_spinlock_init(&tp->lock);
 
+	tp->svc_thr = -1;
+	if (!timer_global->use_inline_timers && timer_global->svc.enable &&
+	    timer_svc_pool_add(tp)) {
+		if (tmo_pool != ODP_POOL_INVALID)
+			(void)odp_pool_destroy(tmo_pool);
+
+		goto error;
+	}
+
 	odp_ticketlock_lock(&timer_global->lock);
 
 	/* Inline timer scan may find the timer pool after this */
@@ -1402,7 +1890,7 @@ static odp_timer_pool_t timer_pool_new(const char *name, const odp_timer_pool_pa
 
 	odp_ticketlock_unlock(&timer_global->lock);
 
-	if (!timer_global->use_inline_timers)
+	if (!timer_global->use_inline_timers && tp->svc_thr < 0)
 		posix_timer_start(tp);
 
 	return timer_pool_to_hdl(tp);
@@ -1450,6 +1938,7 @@ int odp_timer_capability(odp_timer_clk_src_t clk_src,
 	capa->max_tmo.max_tmo = MAX_TMO_NSEC;
 	capa->queue_type_sched = true;
 	capa->queue_type_plain = true;
+	capa->stats = timer_global->stats;
 
 	capa->periodic.min_base_freq_hz.integer = MIN_BASE_HZ;
 	capa->periodic.max_base_freq_hz.integer = timer_global->max_base_hz;
@@ -1666,6 +2155,71 @@ int odp_timer_pool_info(odp_timer_pool_t tpid, odp_timer_pool_info_t *tp_info)
 	return 0;
 }
 
+int odp_timer_pool_stats(odp_timer_pool_t tpid, odp_timer_pool_stats_t *stats)
+{
+	timer_pool_t *tp;
+
+	if (odp_unlikely(tpid == ODP_TIMER_POOL_INVALID)) {
+		_ODP_ERR("Invalid timer pool.\n");
+		return -1;
+	}
+
+	if (odp_unlikely(!timer_global->stats)) {
+		_ODP_ERR("Timer pool statistics not enabled\n");
+		return -1;
+	}
+
+	tp = timer_pool_from_hdl(tpid);
+
+	/* Expired count is read first and scan count last, so that histogram sums are
+	 * consistent with those when there are no concurrent scans in progress */
+	stats->expired      = odp_atomic_load_acq_u64(&tp->stats.expired);
+	stats->missed_scans = odp_atomic_load_u64(&tp->stats.missed_scans);
+	stats->scan_ns_max  = odp_atomic_load_u64(&tp->stats.scan_ns_max);
+	stats->late_ns_max  = odp_atomic_load_u64(&tp->stats.late_ns_max);
+
+	for (int i = 0; i < HIST_SIZE; i++) {
+		stats->hist.scan_ns[i] = odp_atomic_load_u64(&tp->stats.scan_ns_hist[i]);
+		stats->hist.expired[i] = odp_atomic_load_u64(&tp->stats.expired_hist[i]);
+		stats->hist.late_ns[i] = odp_atomic_load_u64(&tp->stats.late_ns_hist[i]);
+	}
+
+	stats->scans = odp_atomic_load_acq_u64(&tp->stats.scans);
+
+	return 0;
+}
+
+int odp_timer_pool_stats_reset(odp_timer_pool_t tpid)
+{
+	timer_pool_t *tp;
+
+	if (odp_unlikely(tpid == ODP_TIMER_POOL_INVALID)) {
+		_ODP_ERR("Invalid timer pool.\n");
+		return -1;
+	}
+
+	if (odp_unlikely(!timer_global->stats)) {
+		_ODP_ERR("Timer pool statistics not enabled\n");
+		return -1;
+	}
+
+	tp = timer_pool_from_hdl(tpid);
+
+	odp_atomic_store_u64(&tp->stats.scans, 0);
+	odp_atomic_store_u64(&tp->stats.missed_scans, 0);
+	odp_atomic_store_u64(&tp->stats.expired, 0);
+	odp_atomic_store_u64(&tp->stats.scan_ns_max, 0);
+	odp_atomic_store_u64(&tp->stats.late_ns_max, 0);
+
+	for (int i = 0; i < HIST_SIZE; i++) {
+		odp_atomic_store_u64(&tp->stats.scan_ns_hist[i], 0);
+		odp_atomic_store_u64(&tp->stats.expired_hist[i], 0);
+		odp_atomic_store_u64(&tp->stats.late_ns_hist[i], 0);
+	}
+
+	return 0;
+}
+
 uint64_t odp_timer_pool_to_u64(odp_timer_pool_t tpid)
 {
 	return _odp_pri(tpid);
@@ -1694,13 +2248,11 @@ odp_timer_t odp_timer_alloc(odp_timer_pool_t tpid, odp_queue_t queue, const void
 	return timer_alloc(tp, queue, user_ptr);
 }
 
-int odp_timer_start(odp_timer_t timer, const odp_timer_start_t *start_param)
+/* Check start parameters and calculate absolute expiration tick */
+static inline int timer_abs_tick(timer_pool_t *tp, const odp_timer_start_t *start_param,
+				 uint64_t cur_tick, uint64_t *abs_tick_out)
 {
 	uint64_t abs_tick, rel_tick;
-	timer_pool_t *tp = handle_to_tp(timer);
-	uint64_t cur_tick = odp_time_global_ns();
-	uint32_t idx = handle_to_idx(timer, tp);
-	odp_event_t tmo_ev = start_param->tmo_ev;
 
 	if (odp_unlikely(tp->periodic)) {
 		_ODP_ERR("Not a single shot timer\n");
@@ -1724,7 +2276,33 @@ int odp_timer_start(odp_timer_t timer, const odp_timer_start_t *start_param)
 	if (odp_unlikely(rel_tick > tp->max_rel_tck))
 		return ODP_TIMER_TOO_FAR;
 
-	if (!timer_reset(idx, abs_tick, &tmo_ev, tp))
+	*abs_tick_out = abs_tick;
+	return ODP_TIMER_SUCCESS;
+}
+
+static inline void timer_notify_overrun(timer_pool_t *tp)
+{
+	if (ODP_DEBUG_PRINT) {
+		uint32_t old_val = 0;
+
+		odp_atomic_cas_u32(&tp->notify_overrun, &old_val, 1);
+	}
+}
+
+int odp_timer_start(odp_timer_t timer, const odp_timer_start_t *start_param)
+{
+	uint64_t abs_tick;
+	timer_pool_t *tp = handle_to_tp(timer);
+	uint64_t cur_tick = odp_time_global_ns();
+	uint32_t idx = handle_to_idx(timer, tp);
+	odp_event_t tmo_ev = start_param->tmo_ev;
+	int ret;
+
+	ret = timer_abs_tick(tp, start_param, cur_tick, &abs_tick);
+	if (odp_unlikely(ret != ODP_TIMER_SUCCESS))
+		return ret;
+
+	if (!timer_reset(idx, abs_tick, &tmo_ev, tp, 0))
 		return ODP_TIMER_FAIL;
 
 	/* Check that timer was not active */
@@ -1733,49 +2311,147 @@ int odp_timer_start(odp_timer_t timer, const odp_timer_start_t *start_param)
 		odp_event_free(tmo_ev);
 	}
 
-	if (ODP_DEBUG_PRINT) {
-		uint32_t old_val = 0;
-
-		odp_atomic_cas_u32(&tp->notify_overrun, &old_val, 1);
-	}
+	timer_notify_overrun(tp);
 
 	return ODP_TIMER_SUCCESS;
 }
 
 int odp_timer_restart(odp_timer_t timer, const odp_timer_start_t *start_param)
 {
-	uint64_t abs_tick, rel_tick;
+	uint64_t abs_tick;
 	timer_pool_t *tp = handle_to_tp(timer);
 	uint64_t cur_tick = odp_time_global_ns();
 	uint32_t idx = handle_to_idx(timer, tp);
+	int ret;
 
-	if (odp_unlikely(tp->periodic)) {
-		_ODP_ERR("Not a single shot timer\n");
+	ret = timer_abs_tick(tp, start_param, cur_tick, &abs_tick);
+	if (odp_unlikely(ret != ODP_TIMER_SUCCESS))
+		return ret;
+
+	/* Reset timer without changing the event */
+	if (!timer_reset(idx, abs_tick, NULL, tp, 0))
 		return ODP_TIMER_FAIL;
+
+	return ODP_TIMER_SUCCESS;
+}
+
+/* Start or restart a burst of timers. Current time is read, timeout headers are published with
+ * a release fence, and timer pool threads are notified, once per burst. Returns number of timers
+ * started, or failure code when the first timer could not be started. */
+static int timer_start_burst(const odp_timer_t timer[], const odp_timer_start_t start_param[],
+			     int num, uint64_t cur_tick, int restart)
+{
+	uint64_t abs_tick[TIMER_BURST_MAX];
+	timer_pool_t *tp[TIMER_BURST_MAX];
+	uint32_t idx[TIMER_BURST_MAX];
+	/* Earliest expiration time per timer pool thread */
+	uint64_t svc_tick[MAX_SVC_THREADS];
+	uint64_t svc_mask = 0;
+	odp_event_t tmo_ev;
+	int i, num_ok;
+	int ret = ODP_TIMER_SUCCESS;
+
+	for (i = 0; i < num; i++) {
+		tp[i] = handle_to_tp(timer[i]);
+		idx[i] = handle_to_idx(timer[i], tp[i]);
+
+		ret = timer_abs_tick(tp[i], &start_param[i], cur_tick, &abs_tick[i]);
+		if (odp_unlikely(ret != ODP_TIMER_SUCCESS))
+			break;
+
+		if (!restart)
+			timeout_hdr_fill(tp[i], idx[i], start_param[i].tmo_ev);
 	}
 
-	if (start_param->tick_type == ODP_TIMER_TICK_ABS) {
-		abs_tick = start_param->tick;
-		rel_tick = abs_tick - cur_tick;
+	num_ok = i;
+	if (odp_unlikely(num_ok == 0))
+		return ret;
 
-		if (odp_unlikely(abs_tick < cur_tick + tp->min_rel_tck))
-			return ODP_TIMER_TOO_NEAR;
-	} else {
-		rel_tick = start_param->tick;
-		abs_tick = rel_tick + cur_tick;
+	/* Timeout header writes must be visible before the events are handed to the timer */
+	odp_mb_release();
 
-		if (odp_unlikely(rel_tick < tp->min_rel_tck))
-			return ODP_TIMER_TOO_NEAR;
+	for (i = 0; i < num_ok; i++) {
+		int svc_thr = tp[i]->svc_thr;
+
+		if (restart) {
+			if (odp_unlikely(!timer_reset(idx[i], abs_tick[i], NULL, tp[i], 1)))
+				break;
+		} else {
+			tmo_ev = start_param[i].tmo_ev;
+			timer_reset(idx[i], abs_tick[i], &tmo_ev, tp[i], 1);
+
+			/* Check that timer was not active */
+			if (odp_unlikely(tmo_ev != ODP_EVENT_INVALID)) {
+				odp_mb_acquire();
+				_ODP_ERR("Timer was active already\n");
+				odp_event_free(tmo_ev);
+			}
+		}
+
+		if (odp_unlikely(svc_thr >= 0)) {
+			if (!(svc_mask & (1ULL << svc_thr))) {
+				svc_mask |= 1ULL << svc_thr;
+				svc_tick[svc_thr] = abs_tick[i];
+			} else {
+				svc_tick[svc_thr] = _ODP_MIN(svc_tick[svc_thr], abs_tick[i]);
+			}
+		}
 	}
 
-	if (odp_unlikely(rel_tick > tp->max_rel_tck))
-		return ODP_TIMER_TOO_FAR;
+	num_ok = i;
 
-	/* Reset timer without changing the event */
-	if (!timer_reset(idx, abs_tick, NULL, tp))
+	if (odp_unlikely(svc_mask)) {
+		/* Timer updates must be visible before wake up time loads */
+		odp_mb_full();
+
+		for (int t = 0; t < MAX_SVC_THREADS; t++) {
+			if (svc_mask & (1ULL << t))
+				timer_svc_wake(&timer_global->svc.thr[t], svc_tick[t]);
+		}
+	}
+
+	if (odp_unlikely(num_ok == 0))
 		return ODP_TIMER_FAIL;
 
-	return ODP_TIMER_SUCCESS;
+	if (!restart)
+		timer_notify_overrun(tp[0]);
+
+	return num_ok;
+}
+
+static int timer_start_multi(const odp_timer_t timer[], const odp_timer_start_t start_param[],
+			     int num, int restart)
+{
+	uint64_t cur_tick = odp_time_global_ns();
+	int num_started = 0;
+
+	while (num_started < num) {
+		int burst = _ODP_MIN(num - num_started, TIMER_BURST_MAX);
+		int ret = timer_start_burst(&timer[num_started], &start_param[num_started], burst,
+					    cur_tick, restart);
+
+		if (odp_unlikely(ret <= 0))
+			return num_started ? num_started : ret;
+
+		num_started += ret;
+
+		if (odp_unlikely(ret < burst))
+			break;
+	}
+
+	return num_started;
+}
+
+int odp_timer_start_multi(const odp_timer_t timer[], const odp_timer_start_t start_param[],
+			  int num)
+{
+	return timer_start_multi(timer, start_param, num, 0);
+}
+
+int odp_timer_restart_multi(const odp_timer_t timer[], const odp_timer_start_t start_param[],
+			    int num)
+{
+	return timer_start_multi(timer, start_param, num, 1);
 }
 
 void odp_timer_periodic_param_init(odp_timer_periodic_param_t *param)
@@ -1904,7 +2580,7 @@ int odp_timer_periodic_start(odp_timer_t timer, const odp_timer_periodic_start_t
 		abs_tick = cur_tick + tim->periodic_ticks;
 	}
 
-	if (!timer_reset(idx, abs_tick, &tmo_ev, tp))
+	if (!timer_reset(idx, abs_tick, &tmo_ev, tp, 0))
 		return ODP_TIMER_FAIL;
 
 	/* Check that timer was not active */
@@ -1949,7 +2625,7 @@ int odp_timer_periodic_ack(odp_timer_t timer, odp_event_t tmo_ev)
 	tim->periodic_ticks_frac_acc = acc;
 	abs_tick += odp_timeout_tick(tmo);
 
-	if (!timer_reset(idx, abs_tick, &tmo_ev, tp))
+	if (!timer_reset(idx, abs_tick, &tmo_ev, tp, 0))
 		return -1;
 
 	/* This should never happen. Timer should be always inactive before
@@ -1983,6 +2659,32 @@ int odp_timer_cancel(odp_timer_t hdl, odp_event_t *tmo_ev)
 	return ODP_TIMER_TOO_NEAR;
 }
 
+int odp_timer_cancel_multi(const odp_timer_t timer[], odp_event_t tmo_ev[], int num)
+{
+	int i;
+
+	for (i = 0; i < num; i++) {
+		timer_pool_t *tp = handle_to_tp(timer[i]);
+		uint32_t idx = handle_to_idx(timer[i], tp);
+		odp_event_t old_event;
+
+		if (odp_unlikely(tp->periodic)) {
+			_ODP_ERR("Not a single shot timer\n");
+			return i ? i : ODP_TIMER_FAIL;
+		}
+
+		old_event = timer_cancel(tp, idx);
+
+		/* Timer expired already */
+		if (old_event == ODP_EVENT_INVALID)
+			return i ? i : ODP_TIMER_TOO_NEAR;
+
+		tmo_ev[i] = old_event;
+	}
+
+	return i;
+}
+
 int odp_timer_periodic_cancel(odp_timer_t hdl)
 {
 	timer_pool_t *tp;
@@ -2102,11 +2804,30 @@ void odp_timeout_free_multi(odp_timeout_t tmo[], int num)
 	_odp_event_free_multi((_odp_event_hdr_t **)(uintptr_t)tmo, num);
 }
 
+static int stats_hist_print(char *str, int size, const char *name, const uint64_t hist[])
+{
+	int len = 0;
+
+	len += _odp_snprint(&str[len], size - len, "    %s\n", name);
+
+	for (int i = 0; i < HIST_SIZE; i++) {
+		if (hist[i] == 0)
+			continue;
+
+		len += _odp_snprint(&str[len], size - len, "      %s%-10" PRIu64 " %" PRIu64 "\n",
+				    i == HIST_SIZE - 1 ? ">=" : "< ", i == HIST_SIZE - 1 ?
+				    UINT64_C(1) << i : UINT64_C(2) << i, hist[i]);
+	}
+
+	return len;
+}
+
 void odp_timer_pool_print(odp_timer_pool_t timer_pool)
 {
 	timer_pool_t *tp;
+	odp_timer_pool_stats_t stats;
 	int len = 0;
-	int max_len = 512;
+	int max_len = 4096;
 	int n = max_len - 1;
 	char str[max_len];
 
@@ -2128,6 +2849,25 @@ void odp_timer_pool_print(odp_timer_pool_t timer_pool)
 	len += _odp_snprint(&str[len], n - len, "  inline timers  %i\n",
 			    timer_global->use_inline_timers);
 	len += _odp_snprint(&str[len], n - len, "  periodic       %i\n", tp->periodic);
+	len += _odp_snprint(&str[len], n - len, "  timer thread   %i\n", tp->svc_thr);
+
+	if (timer_global->stats && odp_timer_pool_stats(timer_pool, &stats) == 0) {
+		len += _odp_snprint(&str[len], n - len, "  scans          %" PRIu64 "\n",
+				    stats.scans);
+		len += _odp_snprint(&str[len], n - len, "  missed scans   %" PRIu64 "\n",
+				    stats.missed_scans);
+		len += _odp_snprint(&str[len], n - len, "  expired        %" PRIu64 "\n",
+				    stats.expired);
+		len += _odp_snprint(&str[len], n - len, "  max scan ns    %" PRIu64 "\n",
+				    stats.scan_ns_max);
+		len += _odp_snprint(&str[len], n - len, "  max late ns    %" PRIu64 "\n",
+				    stats.late_ns_max);
+		len += _odp_snprint(&str[len], n - len, "  histograms (upper limit, count)\n");
+		len += stats_hist_print(&str[len], n - len, "scan ns", stats.hist.scan_ns);
+		len += stats_hist_print(&str[len], n - len, "expired per scan", stats.hist.expired);
+		len += stats_hist_print(&str[len], n - len, "late ns", stats.hist.late_ns);
+	}
+
 	str[len] = 0;
 
 	_ODP_PRINT("%s\n", str);
@@ -2288,7 +3028,70 @@ int _odp_timer_init_global(const odp_init_t *params)
 	}
 	timer_global->thread_type = val;
 	_ODP_PRINT("  %s: %i\n", conf_str, val);
-	_ODP_PRINT("\n");
+
+	conf_str =  "timer.inline_shard_size";
+	if (!_odp_libconfig_lookup_int(conf_str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", conf_str);
+		goto error;
+	}
+	if (val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", conf_str, val);
+		goto error;
+	}
+	timer_global->shard_size = val;
+	_ODP_PRINT("  %s: %i\n", conf_str, val);
+
+	conf_str =  "timer.stats";
+	if (!_odp_libconfig_lookup_int(conf_str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", conf_str);
+		goto error;
+	}
+	timer_global->stats = !!val;
+	_ODP_PRINT("  %s: %i\n", conf_str, val);
+
+	conf_str =  "timer.thread_pool";
+	if (!_odp_libconfig_lookup_int(conf_str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", conf_str);
+		goto error;
+	}
+	timer_global->svc.enable = !!val;
+	_ODP_PRINT("  %s: %i\n", conf_str, val);
+
+	conf_str =  "timer.thread_pool_cpus";
+	val = _odp_service_thread_cpus(conf_str, timer_global->svc.cpu, MAX_SVC_THREADS);
+	if (val < 0)
+		goto error;
+
+	_ODP_PRINT("  %s: [", conf_str);
+	for (i = 0; i < (uint32_t)val; i++)
+		_ODP_PRINT("%s%i", i ? ", " : "", timer_global->svc.cpu[i]);
+	_ODP_PRINT("]\n\n");
+
+	/* One unpinned thread when CPUs are not listed */
+	timer_global->svc.num_thr = val;
+	if (val == 0) {
+		timer_global->svc.num_thr = 1;
+		timer_global->svc.cpu[0] = -1;
+	}
+
+	if (timer_global->svc.enable && !timer_global->use_inline_timers &&
+	    odp_global_ro.init_param.mem_model == ODP_MEM_MODEL_PROCESS) {
+		_ODP_PRINT("Timer thread pool not supported in process mode, disabled\n\n");
+		timer_global->svc.enable = 0;
+	}
+
+	odp_ticketlock_init(&timer_global->svc.lock);
+	odp_atomic_init_u32(&timer_global->svc.exit, 0);
+
+	for (i = 0; i < MAX_SVC_THREADS; i++) {
+		timer_svc_thread_t *thr = &timer_global->svc.thr[i];
+
+		odp_atomic_init_u32(&thr->seq, 0);
+		odp_atomic_init_u32(&thr->sleeping, 0);
+		odp_atomic_init_u64(&thr->wake_ns, 0);
+		thr->cpu = timer_global->svc.cpu[i];
+		thr->idx = i;
+	}
 
 	if (!timer_global->use_inline_timers) {
 		timer_res_init();
@@ -2326,7 +3129,9 @@ int _odp_timer_term_global(void)
 			if (!timer_global->use_inline_timers) {
 				timer_pool_t *tp = timer_global->timer_pool[i];
 
-				if (tp != NULL)
+				if (tp != NULL && tp->svc_thr >= 0)
+					timer_svc_pool_rem();
+				else if (tp != NULL)
 					posix_timer_stop(tp);
 			}
 		}
@@ -21,6 +21,7 @@
 #include <odp_traffic_mngr_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_init_internal.h>
+#include <odp_libconfig_internal.h>
 #include <odp_global_data.h>
 #include <odp_schedule_if.h>
 #include <odp_event_internal.h>
@@ -163,6 +164,12 @@ typedef struct {
 	odp_atomic_u64_t currently_serving_cnt;
 	odp_atomic_u64_t atomic_done_cnt;
 
+	struct {
+		int sorted_list_type;
+		uint32_t sorted_heap_min_queues;
+		_odp_lock_type_t input_lock_type;
+	} config;
+
 	odp_shm_t shm;
 } tm_global_t;
 
@@ -406,7 +413,8 @@ static void input_work_queue_init(input_work_queue_t *input_work_queue)
 {
 	memset(input_work_queue, 0, sizeof(input_work_queue_t));
 	odp_atomic_init_u64(&input_work_queue->queue_cnt, 0);
-	odp_ticketlock_init(&input_work_queue->lock);
+	input_work_queue->lock_type = tm_glb->config.input_lock_type;
+	_odp_lock_init(&input_work_queue->lock, input_work_queue->lock_type);
 }
 
 static void input_work_queue_destroy(input_work_queue_t *input_work_queue)
@@ -415,7 +423,7 @@ static void input_work_queue_destroy(input_work_queue_t *input_work_queue)
 	* freeing it.  Of course, elsewhere it is essential to have first
 	* stopped new tm_enq() (et al) calls from succeeding.
 	*/
-	odp_ticketlock_lock(&input_work_queue->lock);
+	_odp_lock(&input_work_queue->lock, input_work_queue->lock_type);
 	memset(input_work_queue, 0, sizeof(input_work_queue_t));
 }
 
@@ -433,7 +441,7 @@ static int input_work_queue_append(tm_system_t *tm_system,
 		return -1;
 	}
 
-	odp_ticketlock_lock(&input_work_queue->lock);
+	_odp_lock(&input_work_queue->lock, input_work_queue->lock_type);
 	tail_idx = input_work_queue->tail_idx;
 	entry_ptr = &input_work_queue->work_ring[tail_idx];
 
@@ -444,7 +452,7 @@ static int input_work_queue_append(tm_system_t *tm_system,
 
 	input_work_queue->total_enqueues++;
 	input_work_queue->tail_idx = tail_idx;
-	odp_ticketlock_unlock(&input_work_queue->lock);
+	_odp_unlock(&input_work_queue->lock, input_work_queue->lock_type);
 	odp_atomic_inc_u64(&input_work_queue->queue_cnt);
 	if (input_work_queue->peak_cnt <= queue_cnt)
 		input_work_queue->peak_cnt = queue_cnt + 1;
@@ -461,7 +469,7 @@ static int input_work_queue_remove(input_work_queue_t *input_work_queue,
 	if (queue_cnt == 0)
 		return -1;
 
-	odp_ticketlock_lock(&input_work_queue->lock);
+	_odp_lock(&input_work_queue->lock, input_work_queue->lock_type);
 	head_idx = input_work_queue->head_idx;
 	entry_ptr = &input_work_queue->work_ring[head_idx];
 
@@ -472,7 +480,7 @@ static int input_work_queue_remove(input_work_queue_t *input_work_queue,
 
 	input_work_queue->total_dequeues++;
 	input_work_queue->head_idx = head_idx;
-	odp_ticketlock_unlock(&input_work_queue->lock);
+	_odp_unlock(&input_work_queue->lock, input_work_queue->lock_type);
 	odp_atomic_dec_u64(&input_work_queue->queue_cnt);
 	return 0;
 }
@@ -3045,6 +3053,7 @@ odp_tm_t odp_tm_create(const char            *name,
 	odp_pktout_queue_t pktout;
 	uint32_t max_num_queues, max_queued_pkts, max_timers;
 	uint32_t max_tm_queues, max_sorted_lists;
+	_odp_int_sorted_pool_type_t sorted_pool_type;
 	int rc;
 
 	if (odp_global_ro.disable.traffic_mngr) {
@@ -3106,6 +3115,12 @@ odp_tm_t odp_tm_create(const char            *name,
 
 	tm_init_random_data(&tm_system->tm_random_data);
 
+	sorted_pool_type = _ODP_INT_SORTED_POOL_LIST;
+	if (tm_glb->config.sorted_list_type == 1 ||
+	    (tm_glb->config.sorted_list_type == 2 &&
+	     max_tm_queues >= tm_glb->config.sorted_heap_min_queues))
+		sorted_pool_type = _ODP_INT_SORTED_POOL_HEAP;
+
 	max_sorted_lists = 2 * max_tm_queues;
 	max_num_queues = max_tm_queues;
 	max_queued_pkts = 16 * max_tm_queues;
@@ -3119,7 +3134,8 @@ odp_tm_t odp_tm_create(const char            *name,
 	odp_ticketlock_init(&tm_system->tm_system_lock);
 	odp_atomic_init_u64(&tm_system->destroying, 0);
 
-	tm_system->_odp_int_sorted_pool = _odp_sorted_pool_create(max_sorted_lists);
+	tm_system->_odp_int_sorted_pool = _odp_sorted_pool_create(max_sorted_lists,
+								  sorted_pool_type);
 	create_fail |= tm_system->_odp_int_sorted_pool
 		== _ODP_INT_SORTED_POOL_INVALID;
 
@@ -5058,6 +5074,58 @@ uint64_t odp_tm_wred_to_u64(odp_tm_wred_t hdl)
 	return _odp_pri(hdl);
 }
 
+static int read_config_file(void)
+{
+	const char *str;
+	int val = 0;
+
+	_ODP_PRINT("Traffic manager config:\n");
+
+	str = "tm.sorted_list_type";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > 2) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	tm_glb->config.sorted_list_type = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "tm.sorted_heap_min_queues";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	tm_glb->config.sorted_heap_min_queues = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "tm.input_lock_type";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > _ODP_LOCK_TYPE_MAX) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	tm_glb->config.input_lock_type = val;
+	_ODP_PRINT("  %s: %i\n\n", str, val);
+
+	return 0;
+}
+
 int _odp_tm_init_global(void)
 {
 	odp_shm_t shm;
@@ -5077,6 +5145,11 @@ int _odp_tm_init_global(void)
 	tm_glb->shm = shm;
 	tm_glb->main_thread_cpu = -1;
 
+	if (read_config_file()) {
+		odp_shm_free(shm);
+		return -1;
+	}
+
 	odp_ticketlock_init(&tm_glb->queue_obj.lock);
 	odp_ticketlock_init(&tm_glb->node_obj.lock);
 	odp_ticketlock_init(&tm_glb->system_group.lock);
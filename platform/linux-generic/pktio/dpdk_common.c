@@ -12,6 +12,7 @@
 #include <odp/api/hints.h>
 #include <odp/api/packet_io.h>
 
+#include <odp_classification_internal.h>
 #include <odp_debug_internal.h>
 #include <odp_dpdk_common.h>
 #include <odp_string_internal.h>
@@ -118,6 +119,13 @@ int _odp_dpdk_prepare_rss_conf(uint16_t port_id, struct rte_eth_rss_conf *rss_co
 	/* Filter out unsupported hash functions */
 	rss_conf->rss_hf &= rss_hf_capa;
 
+	/* Use the same Toeplitz key as software hashing, so that flows are distributed
+	 * identically */
+	if (dev_info.hash_key_size == THASH_KEY_LEN) {
+		rss_conf->rss_key = _odp_cls_global->rss_key.u8;
+		rss_conf->rss_key_len = THASH_KEY_LEN;
+	}
+
 	return 0;
 }
 
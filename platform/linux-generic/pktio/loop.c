@@ -5,7 +5,6 @@
 
 #include <odp/api/debug.h>
 #include <odp/api/event.h>
-#include <odp/api/hash.h>
 #include <odp/api/hints.h>
 #include <odp/api/packet.h>
 #include <odp/api/packet_io.h>
@@ -29,11 +28,13 @@
 
 #include <protocols/eth.h>
 #include <protocols/ip.h>
+#include <protocols/thash.h>
 
 #include <inttypes.h>
 #include <limits.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define MAX_QUEUES (ODP_PKTIN_MAX_QUEUES > ODP_PKTOUT_MAX_QUEUES ? \
 			ODP_PKTIN_MAX_QUEUES : ODP_PKTOUT_MAX_QUEUES)
@@ -258,11 +259,19 @@ static int loopback_recv(pktio_entry_t *pktio_entry, int index, odp_packet_t pkt
 	stats_t *stats = &entry->stats;
 	_odp_event_hdr_t *hdr_tbl[QUEUE_MULTI_MAX];
 	odp_packet_t cls_tbl[QUEUE_MULTI_MAX];
+	odp_packet_t pkt_tbl[QUEUE_MULTI_MAX];
+	odp_packet_t ipsec_tbl[QUEUE_MULTI_MAX];
+	uint32_t len_tbl[QUEUE_MULTI_MAX];
+	uint8_t ipsec_idx[QUEUE_MULTI_MAX];
+	uint8_t ipsec_done[QUEUE_MULTI_MAX];
+	uint8_t ipsec_enq[QUEUE_MULTI_MAX];
 	odp_packet_hdr_t *pkt_hdr;
 	odp_packet_t pkt;
 	odp_time_t ts_val;
 	odp_time_t *ts = NULL;
 	int num_rx = 0;
+	int num_pkt = 0;
+	int num_ipsec = 0;
 	int packets = 0;
 	int num_cls = 0;
 	const int cls_enabled = pktio_cls_enabled(pktio_entry);
@@ -282,7 +291,6 @@ static int loopback_recv(pktio_entry_t *pktio_entry, int index, odp_packet_t pkt
 
 	for (i = 0; i < nbr; i++) {
 		uint32_t pkt_len;
-		int do_ipsec_enq = 0;
 
 		pkt = packet_from_event_hdr(hdr_tbl[i]);
 		pkt_len = odp_packet_len(pkt);
@@ -341,20 +349,41 @@ static int loopback_recv(pktio_entry_t *pktio_entry, int index, odp_packet_t pkt
 		packet_set_ts(pkt_hdr, ts);
 		pkt_hdr->input = pktio_entry->handle;
 
-		/* Try IPsec inline processing */
+		/* Collect packets for burst IPsec inline processing */
+		ipsec_enq[num_pkt] = 0;
 		if (pktio_entry->config.inbound_ipsec &&
 		    !pkt_hdr->p.flags.ip_err &&
 		    odp_packet_has_ipsec(pkt)) {
-			do_ipsec_enq = !_odp_ipsec_try_inline(&pkt);
-			pkt_hdr = packet_hdr(pkt);
+			ipsec_idx[num_ipsec] = num_pkt;
+			ipsec_tbl[num_ipsec++] = pkt;
 		}
 
+		len_tbl[num_pkt] = pkt_len;
+		pkt_tbl[num_pkt++] = pkt;
+	}
+
+	/* Try IPsec inline processing */
+	if (num_ipsec) {
+		_odp_ipsec_try_inline_multi(ipsec_tbl, ipsec_done, num_ipsec);
+
+		for (i = 0; i < num_ipsec; i++) {
+			pkt_tbl[ipsec_idx[i]] = ipsec_tbl[i];
+			ipsec_enq[ipsec_idx[i]] = ipsec_done[i];
+		}
+	}
+
+	for (i = 0; i < num_pkt; i++) {
+		uint32_t pkt_len = len_tbl[i];
+
+		pkt = pkt_tbl[i];
+		pkt_hdr = packet_hdr(pkt);
+
 		if (!pkt_hdr->p.flags.all.error) {
 			octets += pkt_len;
 			packets++;
 		}
 
-		if (do_ipsec_enq) {
+		if (ipsec_enq[i]) {
 			if (odp_unlikely(odp_queue_enq(pkt_hdr->dst_queue,
 						       odp_packet_to_event(pkt)))) {
 				odp_atomic_inc_u64(&stats->in_discards);
@@ -367,7 +396,7 @@ static int loopback_recv(pktio_entry_t *pktio_entry, int index, odp_packet_t pkt
 		} else if (cls_enabled) {
 			/* Enqueue packets directly to classifier destination queue */
 			cls_tbl[num_cls++] = pkt;
-			num_cls = _odp_cls_enq(cls_tbl, num_cls, (i + 1 == nbr));
+			num_cls = _odp_cls_enq(cls_tbl, num_cls, (i + 1 == num_pkt));
 		} else {
 			pkts[num_rx++] = pkt;
 		}
@@ -471,62 +500,50 @@ static inline void loopback_fix_checksums(odp_packet_t pkt,
 		_odp_packet_sctp_chksum_insert(pkt);
 }
 
-static inline uint8_t *add_data(uint8_t *data, void *src, uint32_t len)
-{
-	return (uint8_t *)memcpy(data, src, len) + len;
-}
-
 static inline odp_queue_t get_dest_queue(const pkt_loop_t *pkt_loop, odp_packet_t pkt, int index)
 {
 	const odp_pktin_hash_proto_t *hash = &pkt_loop->hash;
-	_odp_udphdr_t udp;
-	_odp_tcphdr_t tcp;
 	_odp_ipv4hdr_t ipv4;
 	_odp_ipv6hdr_t ipv6;
 	uint32_t off;
-	/* Space for UDP/TCP source and destination ports and IPv4/IPv6 source and destination
-	 * addresses. */
-	uint8_t data[2 * sizeof(uint16_t) + 2 * 4 * sizeof(uint32_t)];
-	uint8_t *head = data;
+	/* Toeplitz hash input: IPv4/IPv6 source and destination addresses followed by UDP/TCP
+	 * source and destination ports */
+	uint8_t data[THASH_INPUT_MAX];
+	uint32_t len = 0;
 
 	if (hash->all_bits == 0)
 		return pkt_loop->loopqs[index % pkt_loop->num_qs].queue;
 
-	memset(data, 0, sizeof(data));
-	off = odp_packet_l4_offset(pkt);
-
-	if (off != ODP_PACKET_OFFSET_INVALID) {
-		if ((hash->proto.ipv4_udp || hash->proto.ipv6_udp) && odp_packet_has_udp(pkt)) {
-			if (odp_packet_copy_to_mem(pkt, off, _ODP_UDPHDR_LEN, &udp) == 0) {
-				head = add_data(head, &udp.src_port, sizeof(udp.src_port));
-				head = add_data(head, &udp.dst_port, sizeof(udp.dst_port));
-			}
-		} else if ((hash->proto.ipv4_tcp || hash->proto.ipv6_tcp) &&
-			   odp_packet_has_tcp(pkt)) {
-			if (odp_packet_copy_to_mem(pkt, off, _ODP_TCPHDR_LEN, &tcp) == 0) {
-				head = add_data(head, &tcp.src_port, sizeof(tcp.src_port));
-				head = add_data(head, &tcp.dst_port, sizeof(tcp.dst_port));
-			}
-		}
-	}
-
 	off = odp_packet_l3_offset(pkt);
 
 	if (off != ODP_PACKET_OFFSET_INVALID) {
 		if (hash->proto.ipv4 && odp_packet_has_ipv4(pkt)) {
 			if (odp_packet_copy_to_mem(pkt, off, _ODP_IPV4HDR_LEN, &ipv4) == 0) {
-				head = add_data(head, &ipv4.src_addr, sizeof(ipv4.src_addr));
-				head = add_data(head, &ipv4.dst_addr, sizeof(ipv4.dst_addr));
+				memcpy(data, &ipv4.src_addr, _ODP_IPV4ADDR_LEN);
+				memcpy(&data[_ODP_IPV4ADDR_LEN], &ipv4.dst_addr, _ODP_IPV4ADDR_LEN);
+				len = 2 * _ODP_IPV4ADDR_LEN;
 			}
 		} else if (hash->proto.ipv6 && odp_packet_has_ipv6(pkt)) {
 			if (odp_packet_copy_to_mem(pkt, off, _ODP_IPV6HDR_LEN, &ipv6) == 0) {
-				head = add_data(head, &ipv6.src_addr, sizeof(ipv6.src_addr));
-				head = add_data(head, &ipv6.dst_addr, sizeof(ipv6.dst_addr));
+				memcpy(data, &ipv6.src_addr, _ODP_IPV6ADDR_LEN);
+				memcpy(&data[_ODP_IPV6ADDR_LEN], &ipv6.dst_addr, _ODP_IPV6ADDR_LEN);
+				len = 2 * _ODP_IPV6ADDR_LEN;
 			}
 		}
 	}
 
-	return pkt_loop->loopqs[odp_hash_crc32c(data, head - data, 0) % pkt_loop->num_qs].queue;
+	off = odp_packet_l4_offset(pkt);
+
+	if (off != ODP_PACKET_OFFSET_INVALID &&
+	    (((hash->proto.ipv4_udp || hash->proto.ipv6_udp) && odp_packet_has_udp(pkt)) ||
+	     ((hash->proto.ipv4_tcp || hash->proto.ipv6_tcp) && odp_packet_has_tcp(pkt)))) {
+		/* Source and destination ports are the first four bytes of UDP and TCP headers */
+		if (odp_packet_copy_to_mem(pkt, off, 2 * sizeof(uint16_t), &data[len]) == 0)
+			len += 2 * sizeof(uint16_t);
+	}
+
+	return pkt_loop->loopqs[_odp_cls_rss_queue(_odp_cls_rss_hash(data, len),
+						   pkt_loop->num_qs)].queue;
 }
 
 static int loopback_send(pktio_entry_t *pktio_entry, int index, const odp_packet_t pkt_tbl[],
@@ -0,0 +1,49 @@
+#!/bin/sh
+#
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2026 Nokia
+#
+# Compare classifier PMR matching with and without the flow cache. Prints packet counts of each
+# CoS per second, and flow cache hit and miss counters from pktio extra statistics.
+
+TEST_DIR="${TEST_DIR:-$(dirname $0)}"
+
+# exit code expected by automake for skipped tests
+TEST_SKIPPED=77
+
+cd $TEST_DIR
+BIN_DIR=../../../../example/classifier
+BIN_NAME=odp_classifier
+TIME=2
+
+PCAP_IN=`find . $BIN_DIR -name udp64.pcap -print -quit`
+
+if [ ! -x $BIN_DIR/${BIN_NAME}${EXEEXT} ] || [ -z "$PCAP_IN" ]; then
+	echo "$BIN_NAME or udp64.pcap not found, skipping test"
+	exit $TEST_SKIPPED
+fi
+
+run()
+{
+	echo "odp_classifier: $1"
+	echo "===================================="
+
+	$BIN_DIR/${BIN_NAME}${EXEEXT} -t $TIME -i pcap:in=${PCAP_IN}:loops=100000 -m 0 \
+		-p "ODP_PMR_UDP_DPORT:5000:0xFFFF:queue1" \
+		-p "ODP_PMR_UDP_SPORT:6000:0xFFFF:queue2" \
+		-p "ODP_PMR_SIP_ADDR:10.10.10.0:0xFFFFFF00:queue3"
+	ret=$?
+
+	if [ $ret -ne 0 ]; then
+		echo "Test FAILED, exiting"
+		exit 1
+	fi
+}
+
+run "PMR matching"
+
+export ODP_CONFIG_FILE=$(pwd)/cls_flow_cache.conf
+
+run "PMR matching with flow cache"
+
+exit 0
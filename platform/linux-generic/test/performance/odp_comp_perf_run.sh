@@ -0,0 +1,40 @@
+#!/bin/sh
+#
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2026 Nokia
+#
+# Compare synchronous, asynchronous and offloaded (worker thread) compression
+
+TEST_DIR="${TEST_DIR:-$(dirname $0)}"
+
+cd $TEST_DIR
+BIN_DIR=../../../../test/performance
+BIN_NAME=odp_comp_perf
+LEN=16384
+NUM=200
+
+run()
+{
+	echo "odp_comp_perf: $1"
+	echo "===================================="
+	shift
+
+	$BIN_DIR/${BIN_NAME}${EXEEXT} -l $LEN -n $NUM $@
+	ret=$?
+
+	if [ $ret -ne 0 ]; then
+		echo "Test FAILED, exiting"
+		exit 1
+	fi
+}
+
+run "synchronous deflate" -m 0
+run "asynchronous deflate" -m 1
+run "synchronous zlib" -m 0 -a 1
+
+export ODP_CONFIG_FILE=$(pwd)/comp_offload.conf
+
+run "offloaded deflate" -m 1 -i 8
+run "offloaded zlib" -m 1 -i 8 -a 1
+
+exit 0
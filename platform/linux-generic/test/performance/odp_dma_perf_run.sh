@@ -0,0 +1,42 @@
+#!/bin/sh
+#
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2026 Nokia
+#
+# Compare synchronous, asynchronous and offloaded (copy thread) DMA transfers
+
+TEST_DIR="${TEST_DIR:-$(dirname $0)}"
+
+cd $TEST_DIR
+BIN_DIR=../../../../test/performance
+BIN_NAME=odp_dma_perf
+SEGS=65536
+INFL=16
+TIME=0.1
+
+run()
+{
+	echo "odp_dma_perf: $1"
+	echo "===================================="
+	shift
+
+	$BIN_DIR/${BIN_NAME}${EXEEXT} -i 1 -o 1 -s $SEGS -S 2 -f $INFL -T $TIME -v $@
+	ret=$?
+
+	if [ $ret -eq 1 ]; then
+		echo "Test FAILED, exiting"
+		exit 1
+	fi
+}
+
+run "synchronous DMA transfer" -t 0
+run "SW memory copy" -t 2
+run "asynchronous DMA transfer, poll" -t 1 -m 0
+run "asynchronous DMA transfer, event" -t 1 -m 1
+
+export ODP_CONFIG_FILE=$(pwd)/dma_offload.conf
+
+run "offloaded DMA transfer, poll" -t 1 -m 0
+run "offloaded DMA transfer, event" -t 1 -m 1
+
+exit 0
@@ -18,3 +18,10 @@ run_conv -m 0 -r 1000
 run_conv -m 0 -r 1000 -l
 run_conv -m 2 -l
 run_conv -m 3 -l
+
+# Throughput per number of runs combined into a batched inference
+export ODP_CONFIG_FILE=$(pwd)/ml_batch.conf
+
+for num_run in 1 4 16 64; do
+        run_conv -m 0 -r 100 -n $num_run
+done
@@ -0,0 +1,38 @@
+#!/bin/sh
+#
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2026 Nokia
+#
+# Compare random data throughput and latency with and without the per thread DRBG
+
+TEST_DIR="${TEST_DIR:-$(dirname $0)}"
+
+cd $TEST_DIR
+BIN_DIR=../../../../test/performance
+BIN_NAME=odp_random
+TIME=100
+
+run()
+{
+	echo "odp_random: $1"
+	echo "===================================="
+	shift
+
+	$BIN_DIR/${BIN_NAME}${EXEEXT} -t $TIME $@
+	ret=$?
+
+	if [ $ret -ne 0 ]; then
+		echo "Test FAILED, exiting"
+		exit 1
+	fi
+}
+
+run "throughput" -m 0
+run "latency" -m 1 -s 16
+
+export ODP_CONFIG_FILE=$(pwd)/random_drbg.conf
+
+run "throughput with DRBG" -m 0
+run "latency with DRBG" -m 1 -s 16
+
+exit 0
@@ -0,0 +1,33 @@
+#!/bin/sh
+#
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2026 Nokia
+#
+# Compare linked list and binary heap based TM schedulers over a fan-in sweep
+
+TEST_DIR="${TEST_DIR:-$(dirname $0)}"
+
+cd $TEST_DIR
+BIN_DIR=../../../../test/performance
+BIN_NAME=odp_tm_perf
+MAX_FANIN=1024
+NUM=20000
+
+run()
+{
+	echo "odp_tm_perf: $1"
+	echo "===================================="
+
+	ODP_CONFIG_FILE=$(pwd)/$2 $BIN_DIR/${BIN_NAME}${EXEEXT} -F $MAX_FANIN -n $NUM
+	ret=$?
+
+	if [ $ret -ne 0 ]; then
+		echo "Test FAILED, exiting"
+		exit 1
+	fi
+}
+
+run "linked lists" tm_sorted_list.conf
+run "binary heaps" tm_sorted_heap.conf
+
+exit 0
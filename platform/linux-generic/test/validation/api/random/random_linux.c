@@ -0,0 +1,134 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/* Known answer tests for the linux-generic ChaCha20 based DRBG */
+
+#include <string.h>
+#include <odp_api.h>
+#include "odp_cunit_common.h"
+
+#include <odp_random_drbg_internal.h>
+
+#define BLOCK_SIZE 64
+#define KEY_SIZE   32
+/* DRBG output bytes per buffer fill: 8 blocks minus the new key */
+#define FILL_SIZE  (8 * BLOCK_SIZE - KEY_SIZE)
+
+/* RFC 8439, Appendix A.1, test vector #1: all zero key, block counter 0 */
+static const uint8_t chacha20_tv1[BLOCK_SIZE] = {
+	0x76, 0xb8, 0xe0, 0xad, 0xa0, 0xf1, 0x3d, 0x90,
+	0x40, 0x5d, 0x6a, 0xe5, 0x53, 0x86, 0xbd, 0x28,
+	0xbd, 0xd2, 0x19, 0xb8, 0xa0, 0x8d, 0xed, 0x1a,
+	0xa8, 0x36, 0xef, 0xcc, 0x8b, 0x77, 0x0d, 0xc7,
+	0xda, 0x41, 0x59, 0x7c, 0x51, 0x57, 0x48, 0x8d,
+	0x77, 0x24, 0xe0, 0x3f, 0xb8, 0xd8, 0x4a, 0x37,
+	0x6a, 0x43, 0xb8, 0xf4, 0x15, 0x18, 0xa1, 0x1c,
+	0xc3, 0x87, 0xb6, 0x69, 0xb2, 0xee, 0x65, 0x86
+};
+
+/* RFC 8439, Appendix A.1, test vector #3: last key byte 0x01, block counter 1 */
+static const uint8_t chacha20_tv3[BLOCK_SIZE] = {
+	0x3a, 0xeb, 0x52, 0x24, 0xec, 0xf8, 0x49, 0x92,
+	0x9b, 0x9d, 0x82, 0x8d, 0xb1, 0xce, 0xd4, 0xdd,
+	0x83, 0x20, 0x25, 0xe8, 0x01, 0x8b, 0x81, 0x60,
+	0xb8, 0x22, 0x84, 0xf3, 0xc9, 0x49, 0xaa, 0x5a,
+	0x8e, 0xca, 0x00, 0xbb, 0xb4, 0xa7, 0x3b, 0xda,
+	0xd1, 0x92, 0xb5, 0xc4, 0x2f, 0x73, 0xf2, 0xfd,
+	0x4e, 0x27, 0x36, 0x44, 0xc8, 0xb3, 0x61, 0x25,
+	0xa6, 0x4a, 0xdd, 0xeb, 0x00, 0x6c, 0x13, 0xa0
+};
+
+/* DRBG output with seed 0x00, 0x01, ..., 0x1f. First fill outputs ChaCha20 keystream bytes
+ * 32..511 of the seed, second fill the same bytes of the key from keystream bytes 0..31. */
+static const uint8_t drbg_out_0[KEY_SIZE] = {
+	0x2b, 0x23, 0xcc, 0xe7, 0xa2, 0x60, 0x23, 0xab,
+	0x3f, 0x0e, 0xef, 0x69, 0x3a, 0xc8, 0x7f, 0x64,
+	0x25, 0x82, 0x35, 0xea, 0xb1, 0xf7, 0xa3, 0x2d,
+	0xc2, 0x27, 0x62, 0xa0, 0x48, 0x5b, 0x41, 0x0c
+};
+
+/* Last bytes of the first fill */
+static const uint8_t drbg_out_448[KEY_SIZE] = {
+	0x17, 0xcd, 0x76, 0x04, 0x3d, 0x85, 0xfe, 0xff,
+	0x6c, 0xfc, 0x72, 0x72, 0xf1, 0xe6, 0xdf, 0xb2,
+	0x01, 0xde, 0xf1, 0x02, 0xac, 0xf0, 0x17, 0x5b,
+	0x4f, 0xe4, 0x1f, 0x02, 0x6a, 0x6d, 0x9c, 0xf2
+};
+
+/* First bytes of the second fill */
+static const uint8_t drbg_out_480[KEY_SIZE] = {
+	0x2d, 0x41, 0xa5, 0x9c, 0x90, 0xe4, 0x1a, 0x8e,
+	0x7a, 0x4d, 0xcc, 0xaa, 0x1c, 0x46, 0x06, 0x99,
+	0x83, 0xb1, 0xa3, 0x33, 0xce, 0x25, 0x71, 0x9e,
+	0xc3, 0x43, 0x77, 0x68, 0xab, 0x57, 0xfa, 0x42
+};
+
+static void random_test_chacha20_block(void)
+{
+	uint32_t key[KEY_SIZE / 4];
+	uint8_t out[BLOCK_SIZE];
+
+	memset(key, 0, sizeof(key));
+	_odp_chacha20_block(key, 0, out);
+	CU_ASSERT(memcmp(out, chacha20_tv1, BLOCK_SIZE) == 0);
+
+	/* Key words are little endian */
+	key[7] = 0x01000000;
+	_odp_chacha20_block(key, 1, out);
+	CU_ASSERT(memcmp(out, chacha20_tv3, BLOCK_SIZE) == 0);
+}
+
+static void random_test_drbg(void)
+{
+	uint8_t seed[KEY_SIZE];
+	uint8_t out[2 * FILL_SIZE];
+	uint32_t pos = 0;
+
+	for (int i = 0; i < KEY_SIZE; i++)
+		seed[i] = i;
+
+	_odp_random_drbg_seed(seed);
+
+	/* Request sizes that do not align with buffer fills */
+	while (pos < sizeof(out)) {
+		uint32_t len = sizeof(out) - pos < 100 ? sizeof(out) - pos : 100;
+
+		CU_ASSERT_FATAL(_odp_random_drbg_data(&out[pos], len) == (int32_t)len);
+		pos += len;
+	}
+
+	CU_ASSERT(memcmp(&out[0], drbg_out_0, KEY_SIZE) == 0);
+	CU_ASSERT(memcmp(&out[FILL_SIZE - KEY_SIZE], drbg_out_448, KEY_SIZE) == 0);
+	CU_ASSERT(memcmp(&out[FILL_SIZE], drbg_out_480, KEY_SIZE) == 0);
+
+	/* Clear test state, generator is reseeded from the OS on next use */
+	CU_ASSERT(_odp_random_drbg_term_local() == 0);
+}
+
+odp_testinfo_t random_suite[] = {
+	ODP_TEST_INFO(random_test_chacha20_block),
+	ODP_TEST_INFO(random_test_drbg),
+	ODP_TEST_INFO_NULL,
+};
+
+odp_suiteinfo_t random_suites[] = {
+	{"Random DRBG", NULL, NULL, random_suite},
+	ODP_SUITE_INFO_NULL,
+};
+
+int main(int argc, char *argv[])
+{
+	int ret;
+
+	/* parse common options: */
+	if (odp_cunit_parse_options(&argc, argv))
+		return -1;
+
+	ret = odp_cunit_register(random_suites);
+
+	if (ret == 0)
+		ret = odp_cunit_run();
+
+	return ret;
+}
@@ -0,0 +1,17 @@
+#!/bin/bash
+set -e
+
+# Build with a large number of scheduled queues
+CONF="${CONF} --with-max-sched-queues=65536" "`dirname "$0"`"/build_${ARCH}.sh
+
+cd "$(dirname "$0")"/../..
+
+./test/validation/api/queue/queue_main
+ODP_SCHEDULER=basic ./test/validation/api/scheduler/scheduler_main
+
+# 50k atomic, parallel and ordered queues with a single event each
+for type in 0 1 2; do
+	echo odp_sched_perf -q 50000 -e 1 -t $type
+	echo ===============================================
+	./test/performance/odp_sched_perf -c 2 -q 50000 -e 1 -t $type -s 1000000
+done
@@ -0,0 +1,765 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/**
+ * @example odp_comp_perf.c
+ *
+ * Performance test application for compression APIs. Measures throughput and worker side
+ * latency of synchronous (odp_comp_op()) and asynchronous (odp_comp_op_enq()) operations.
+ *
+ * @cond _ODP_HIDE_FROM_DOXYGEN_
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+#include <export_results.h>
+
+#define MAX_INFLIGHT 64
+
+/* Output packet space in addition to input data length */
+#define OUT_EXTRA_LEN 1024
+
+enum {
+	MODE_SYNC = 0,
+	MODE_ASYNC
+};
+
+typedef struct test_options_t {
+	uint32_t num_cpu;
+	uint32_t num_op;
+	uint32_t data_len;
+	uint32_t inflight;
+	uint32_t level;
+	int mode;
+	odp_comp_alg_t alg;
+
+} test_options_t;
+
+typedef struct test_stat_t {
+	uint64_t ops;
+	uint64_t bytes_in;
+	uint64_t bytes_out;
+	uint64_t nsec;
+	uint64_t call_cycles;
+	uint64_t max_call_cycles;
+	uint64_t compl_nsec;
+	uint64_t max_compl_nsec;
+	uint64_t errors;
+
+} test_stat_t;
+
+typedef struct test_global_t {
+	odp_barrier_t barrier;
+	test_options_t options;
+	odp_instance_t instance;
+	odp_pool_t pool;
+	odp_atomic_u32_t worker_idx;
+	odp_comp_session_t session[ODP_THREAD_COUNT_MAX];
+	odp_queue_t queue[ODP_THREAD_COUNT_MAX];
+	odph_thread_t thread_tbl[ODP_THREAD_COUNT_MAX];
+	test_stat_t stat[ODP_THREAD_COUNT_MAX];
+	test_common_options_t common_options;
+
+} test_global_t;
+
+static void print_usage(void)
+{
+	printf("\n"
+	       "Compression performance test\n"
+	       "\n"
+	       "Usage: odp_comp_perf [options]\n"
+	       "\n"
+	       "  -c, --num_cpu <num>    Number of worker threads. Default: 1\n"
+	       "  -m, --mode <num>       Operation mode. Default: 0\n"
+	       "                           0: Synchronous (odp_comp_op())\n"
+	       "                           1: Asynchronous (odp_comp_op_enq())\n"
+	       "  -a, --alg <num>        Algorithm. Default: 0\n"
+	       "                           0: Deflate\n"
+	       "                           1: Zlib\n"
+	       "  -l, --len <bytes>      Data length per operation. Default: 8192\n"
+	       "  -L, --level <num>      Compression level (0: implementation default). Default: 0\n"
+	       "  -i, --inflight <num>   Max number of asynchronous operations in flight per\n"
+	       "                         worker. Default: 8, max %u\n"
+	       "  -n, --num_op <num>     Number of operations per worker. Default: 1000\n"
+	       "  -h, --help             This help\n"
+	       "\n", MAX_INFLIGHT);
+}
+
+static int parse_options(int argc, char *argv[], test_options_t *test_options)
+{
+	int opt;
+	int ret = 0;
+
+	static const struct option longopts[] = {
+		{ "num_cpu", required_argument, NULL, 'c' },
+		{ "mode", required_argument, NULL, 'm' },
+		{ "alg", required_argument, NULL, 'a' },
+		{ "len", required_argument, NULL, 'l' },
+		{ "level", required_argument, NULL, 'L' },
+		{ "inflight", required_argument, NULL, 'i' },
+		{ "num_op", required_argument, NULL, 'n' },
+		{ "help", no_argument, NULL, 'h' },
+		{ NULL, 0, NULL, 0 }
+	};
+
+	static const char *shortopts = "+c:m:a:l:L:i:n:h";
+
+	test_options->num_cpu = 1;
+	test_options->mode = MODE_SYNC;
+	test_options->alg = ODP_COMP_ALG_DEFLATE;
+	test_options->data_len = 8192;
+	test_options->level = 0;
+	test_options->inflight = 8;
+	test_options->num_op = 1000;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, NULL);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'c':
+			test_options->num_cpu = atoi(optarg);
+			break;
+		case 'm':
+			test_options->mode = atoi(optarg);
+			break;
+		case 'a':
+			test_options->alg = atoi(optarg) ? ODP_COMP_ALG_ZLIB : ODP_COMP_ALG_DEFLATE;
+			break;
+		case 'l':
+			test_options->data_len = atoi(optarg);
+			break;
+		case 'L':
+			test_options->level = atoi(optarg);
+			break;
+		case 'i':
+			test_options->inflight = atoi(optarg);
+			break;
+		case 'n':
+			test_options->num_op = atoi(optarg);
+			break;
+		case 'h':
+			/* fall through */
+		default:
+			print_usage();
+			ret = -1;
+			break;
+		}
+	}
+
+	if (test_options->mode != MODE_SYNC && test_options->mode != MODE_ASYNC) {
+		ODPH_ERR("Bad mode %i\n", test_options->mode);
+		return -1;
+	}
+
+	if (test_options->inflight == 0 || test_options->inflight > MAX_INFLIGHT) {
+		ODPH_ERR("Bad number of inflight operations %u\n", test_options->inflight);
+		return -1;
+	}
+
+	if (test_options->data_len == 0) {
+		ODPH_ERR("Bad data length\n");
+		return -1;
+	}
+
+	if (test_options->mode == MODE_SYNC)
+		test_options->inflight = 1;
+
+	return ret;
+}
+
+static int set_num_cpu(test_global_t *global)
+{
+	odp_cpumask_t cpumask;
+	test_options_t *test_options = &global->options;
+	int num_cpu = test_options->num_cpu;
+	int ret;
+
+	ret = odp_cpumask_default_worker(&cpumask, num_cpu);
+
+	if (num_cpu && ret != num_cpu) {
+		ODPH_ERR("Too many workers. Max supported %i.\n", ret);
+		return -1;
+	}
+
+	/* Zero: all available workers */
+	if (num_cpu == 0)
+		test_options->num_cpu = ret;
+
+	return 0;
+}
+
+static int create_resources(test_global_t *global)
+{
+	odp_comp_capability_t capa;
+	odp_comp_alg_capability_t alg_capa;
+	odp_pool_capability_t pool_capa;
+	odp_pool_param_t pool_param;
+	odp_queue_param_t queue_param;
+	odp_comp_session_param_t ses_param;
+	test_options_t *test_options = &global->options;
+	uint32_t num_cpu = test_options->num_cpu;
+	uint32_t out_len = test_options->data_len + OUT_EXTRA_LEN;
+	uint32_t num_pkt = num_cpu * (test_options->inflight + 1);
+
+	printf("\nCompression performance test\n");
+	printf("  mode                 %s\n", test_options->mode == MODE_SYNC ?
+	       "synchronous" : "asynchronous");
+	printf("  algorithm            %s\n", test_options->alg == ODP_COMP_ALG_ZLIB ?
+	       "zlib" : "deflate");
+	printf("  compression level    %u\n", test_options->level);
+	printf("  data length          %u\n", test_options->data_len);
+	printf("  num operations       %u\n", test_options->num_op);
+	printf("  max inflight         %u\n", test_options->inflight);
+	printf("  num workers          %u\n\n", num_cpu);
+
+	if (odp_comp_capability(&capa)) {
+		ODPH_ERR("Comp capability failed\n");
+		return -1;
+	}
+
+	if ((test_options->mode == MODE_SYNC && capa.sync == ODP_SUPPORT_NO) ||
+	    (test_options->mode == MODE_ASYNC && capa.async == ODP_SUPPORT_NO)) {
+		ODPH_ERR("Operation mode not supported\n");
+		return -1;
+	}
+
+	if ((test_options->alg == ODP_COMP_ALG_DEFLATE && !capa.comp_algos.bit.deflate) ||
+	    (test_options->alg == ODP_COMP_ALG_ZLIB && !capa.comp_algos.bit.zlib)) {
+		ODPH_ERR("Algorithm not supported\n");
+		return -1;
+	}
+
+	if (num_cpu > capa.max_sessions) {
+		ODPH_ERR("Too many workers. Max %u sessions supported.\n", capa.max_sessions);
+		return -1;
+	}
+
+	if (odp_comp_alg_capability(test_options->alg, &alg_capa)) {
+		ODPH_ERR("Algorithm capability failed\n");
+		return -1;
+	}
+
+	if (test_options->level > alg_capa.max_level) {
+		ODPH_ERR("Max compression level %u\n", alg_capa.max_level);
+		return -1;
+	}
+
+	if (odp_pool_capability(&pool_capa)) {
+		ODPH_ERR("Pool capability failed\n");
+		return -1;
+	}
+
+	if (pool_capa.pkt.max_len && out_len > pool_capa.pkt.max_len) {
+		ODPH_ERR("Too long data. Max packet length %u\n", pool_capa.pkt.max_len);
+		return -1;
+	}
+
+	if (pool_capa.pkt.max_num && 2 * num_pkt > pool_capa.pkt.max_num) {
+		ODPH_ERR("Too many packets. Max %u\n", pool_capa.pkt.max_num);
+		return -1;
+	}
+
+	odp_pool_param_init(&pool_param);
+	pool_param.type = ODP_POOL_PACKET;
+	pool_param.pkt.num = 2 * num_pkt;
+	pool_param.pkt.len = out_len;
+	pool_param.pkt.max_len = out_len;
+
+	global->pool = odp_pool_create("comp_perf_pool", &pool_param);
+	if (global->pool == ODP_POOL_INVALID) {
+		ODPH_ERR("Pool create failed\n");
+		return -1;
+	}
+
+	for (uint32_t i = 0; i < num_cpu; i++) {
+		odp_queue_param_init(&queue_param);
+		queue_param.type = ODP_QUEUE_TYPE_PLAIN;
+
+		global->queue[i] = odp_queue_create("comp_perf_compl", &queue_param);
+		if (global->queue[i] == ODP_QUEUE_INVALID) {
+			ODPH_ERR("Queue create failed\n");
+			return -1;
+		}
+
+		odp_comp_session_param_init(&ses_param);
+		ses_param.op = ODP_COMP_OP_COMPRESS;
+		ses_param.mode = test_options->mode == MODE_SYNC ? ODP_COMP_OP_MODE_SYNC :
+							   ODP_COMP_OP_MODE_ASYNC;
+		ses_param.comp_algo = test_options->alg;
+		ses_param.hash_algo = ODP_COMP_HASH_ALG_NONE;
+		ses_param.compl_queue = global->queue[i];
+		ses_param.packet_order = 1;
+
+		if (test_options->alg == ODP_COMP_ALG_ZLIB) {
+			ses_param.alg_param.zlib.deflate.comp_level = test_options->level;
+			ses_param.alg_param.zlib.deflate.huffman_code = ODP_COMP_HUFFMAN_DEFAULT;
+		} else {
+			ses_param.alg_param.deflate.comp_level = test_options->level;
+			ses_param.alg_param.deflate.huffman_code = ODP_COMP_HUFFMAN_DEFAULT;
+		}
+
+		global->session[i] = odp_comp_session_create(&ses_param);
+		if (global->session[i] == ODP_COMP_SESSION_INVALID) {
+			ODPH_ERR("Session create failed\n");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int destroy_resources(test_global_t *global)
+{
+	int ret = 0;
+
+	for (uint32_t i = 0; i < global->options.num_cpu; i++) {
+		if (global->session[i] != ODP_COMP_SESSION_INVALID &&
+		    odp_comp_session_destroy(global->session[i])) {
+			ODPH_ERR("Session destroy failed\n");
+			ret = -1;
+		}
+
+		if (global->queue[i] != ODP_QUEUE_INVALID && odp_queue_destroy(global->queue[i])) {
+			ODPH_ERR("Queue destroy failed\n");
+			ret = -1;
+		}
+	}
+
+	if (global->pool != ODP_POOL_INVALID && odp_pool_destroy(global->pool)) {
+		ODPH_ERR("Pool destroy failed\n");
+		ret = -1;
+	}
+
+	return ret;
+}
+
+/* Fill data that compresses roughly like text */
+static int init_input(odp_packet_t pkt, uint32_t len)
+{
+	static const char * const words[] = { "packet ", "queue ", "event ", "pool ",
+					      "schedule ", "compress ", "timer ", "ipsec " };
+	uint8_t data[256];
+	uint32_t offset = 0;
+	uint32_t seed = 1;
+
+	while (offset < len) {
+		uint32_t n = 0;
+
+		while (n < sizeof(data) - 16) {
+			const char *w = words[(seed >> 16) % ODPH_ARRAY_SIZE(words)];
+			uint32_t wlen = strlen(w);
+
+			memcpy(&data[n], w, wlen);
+			n += wlen;
+			seed = seed * 1103515245 + 12345;
+		}
+
+		if (n > len - offset)
+			n = len - offset;
+
+		if (odp_packet_copy_from_mem(pkt, offset, n, data))
+			return -1;
+
+		offset += n;
+	}
+
+	return 0;
+}
+
+static inline void update_result(test_stat_t *stat, odp_packet_t pkt_out, uint32_t data_len)
+{
+	odp_comp_packet_result_t result;
+
+	if (odp_comp_result(&result, pkt_out) || result.status != ODP_COMP_STATUS_SUCCESS) {
+		stat->errors++;
+		return;
+	}
+
+	stat->ops++;
+	stat->bytes_in += data_len;
+	stat->bytes_out += result.output_data_range.length;
+}
+
+static int run_test(void *arg)
+{
+	test_global_t *global = arg;
+	test_options_t *test_options = &global->options;
+	uint32_t idx = odp_atomic_fetch_inc_u32(&global->worker_idx);
+	test_stat_t *stat = &global->stat[idx];
+	odp_comp_session_t session = global->session[idx];
+	odp_queue_t queue = global->queue[idx];
+	uint32_t data_len = test_options->data_len;
+	uint32_t out_len = data_len + OUT_EXTRA_LEN;
+	uint32_t inflight = test_options->inflight;
+	uint32_t num_op = test_options->num_op;
+	uint32_t submitted = 0;
+	uint32_t completed = 0;
+	odp_packet_t pkt_in;
+	odp_packet_t pkt_out[MAX_INFLIGHT];
+	odp_time_t start_time[MAX_INFLIGHT];
+	odp_comp_packet_op_param_t param;
+	uint64_t c1, c2, cycles;
+	odp_time_t t1, t2, t;
+	uint32_t i;
+	int ret = 0;
+
+	pkt_in = odp_packet_alloc(global->pool, data_len);
+	if (pkt_in == ODP_PACKET_INVALID || init_input(pkt_in, data_len)) {
+		ODPH_ERR("Input packet init failed\n");
+		return -1;
+	}
+
+	for (i = 0; i < inflight; i++) {
+		pkt_out[i] = odp_packet_alloc(global->pool, out_len);
+		if (pkt_out[i] == ODP_PACKET_INVALID) {
+			ODPH_ERR("Packet alloc failed\n");
+			return -1;
+		}
+	}
+
+	memset(&param, 0, sizeof(param));
+	param.session = session;
+	param.in_data_range.offset = 0;
+	param.in_data_range.length = data_len;
+	param.out_data_range.offset = 0;
+	param.out_data_range.length = out_len;
+
+	/* Start all workers at the same time */
+	odp_barrier_wait(&global->barrier);
+
+	t1 = odp_time_local();
+
+	if (test_options->mode == MODE_SYNC) {
+		for (i = 0; i < num_op; i++) {
+			c1 = odp_cpu_cycles();
+			ret = odp_comp_op(&pkt_in, &pkt_out[0], 1, &param);
+			c2 = odp_cpu_cycles();
+
+			if (odp_unlikely(ret != 1)) {
+				stat->errors++;
+				continue;
+			}
+
+			cycles = odp_cpu_cycles_diff(c2, c1);
+			stat->call_cycles += cycles;
+			if (cycles > stat->max_call_cycles)
+				stat->max_call_cycles = cycles;
+
+			update_result(stat, pkt_out[0], data_len);
+		}
+
+		ret = 0;
+	} else {
+		uint32_t num_free = inflight;
+		odp_packet_t free_pkt[MAX_INFLIGHT];
+
+		for (i = 0; i < inflight; i++)
+			free_pkt[i] = pkt_out[i];
+
+		while (completed < submitted || submitted < num_op) {
+			odp_event_t ev;
+			odp_packet_t pkt;
+			uint64_t nsec;
+
+			/* Keep max number of operations in flight */
+			while (num_free && submitted < num_op) {
+				pkt = free_pkt[num_free - 1];
+				start_time[num_free - 1] = odp_time_local_strict();
+				odp_packet_user_ptr_set(pkt, &start_time[num_free - 1]);
+
+				c1 = odp_cpu_cycles();
+				ret = odp_comp_op_enq(&pkt_in, &pkt, 1, &param);
+				c2 = odp_cpu_cycles();
+
+				if (ret < 0) {
+					ODPH_ERR("odp_comp_op_enq() failed\n");
+					goto exit;
+				}
+
+				if (ret == 0)
+					break;
+
+				cycles = odp_cpu_cycles_diff(c2, c1);
+				stat->call_cycles += cycles;
+				if (cycles > stat->max_call_cycles)
+					stat->max_call_cycles = cycles;
+
+				num_free--;
+				submitted++;
+			}
+
+			ev = odp_queue_deq(queue);
+			if (ev == ODP_EVENT_INVALID) {
+				odp_cpu_pause();
+				continue;
+			}
+
+			pkt = odp_comp_packet_from_event(ev);
+			t = odp_time_local_strict();
+			nsec = odp_time_diff_ns(t, *(odp_time_t *)odp_packet_user_ptr(pkt));
+			stat->compl_nsec += nsec;
+			if (nsec > stat->max_compl_nsec)
+				stat->max_compl_nsec = nsec;
+
+			update_result(stat, pkt, data_len);
+			free_pkt[num_free++] = pkt;
+			completed++;
+		}
+
+		ret = 0;
+	}
+
+	t2 = odp_time_local();
+	stat->nsec = odp_time_diff_ns(t2, t1);
+
+exit:
+	/* Packets of unfinished operations are left to the completion queue */
+	if (test_options->mode == MODE_SYNC || completed == submitted)
+		odp_packet_free_multi(pkt_out, inflight);
+
+	odp_packet_free(pkt_in);
+
+	return ret;
+}
+
+static int start_workers(test_global_t *global)
+{
+	odph_thread_common_param_t thr_common;
+	odph_thread_param_t thr_param;
+	odp_cpumask_t cpumask;
+	int num_cpu = global->options.num_cpu;
+
+	odp_cpumask_default_worker(&cpumask, num_cpu);
+	odp_barrier_init(&global->barrier, num_cpu);
+	odp_atomic_init_u32(&global->worker_idx, 0);
+
+	odph_thread_common_param_init(&thr_common);
+	thr_common.instance = global->instance;
+	thr_common.cpumask = &cpumask;
+	thr_common.share_param = 1;
+
+	odph_thread_param_init(&thr_param);
+	thr_param.start = run_test;
+	thr_param.arg = global;
+	thr_param.thr_type = ODP_THREAD_WORKER;
+
+	if (odph_thread_create(global->thread_tbl, &thr_common, &thr_param,
+			       num_cpu) != num_cpu)
+		return -1;
+
+	return 0;
+}
+
+static int output_results(test_global_t *global)
+{
+	test_options_t *test_options = &global->options;
+	uint32_t num_cpu = test_options->num_cpu;
+	uint64_t ops = 0, bytes_in = 0, bytes_out = 0, nsec = 0, call_cycles = 0;
+	uint64_t compl_nsec = 0, errors = 0, max_call_cycles = 0, max_compl_nsec = 0;
+	double nsec_ave, ops_sec, mbit_sec, call_ave, compl_ave, ratio;
+
+	for (uint32_t i = 0; i < num_cpu; i++) {
+		test_stat_t *stat = &global->stat[i];
+
+		ops += stat->ops;
+		bytes_in += stat->bytes_in;
+		bytes_out += stat->bytes_out;
+		nsec += stat->nsec;
+		call_cycles += stat->call_cycles;
+		compl_nsec += stat->compl_nsec;
+		errors += stat->errors;
+
+		if (stat->max_call_cycles > max_call_cycles)
+			max_call_cycles = stat->max_call_cycles;
+
+		if (stat->max_compl_nsec > max_compl_nsec)
+			max_compl_nsec = stat->max_compl_nsec;
+	}
+
+	if (ops == 0) {
+		printf("No results.\n");
+		return errors ? -1 : 0;
+	}
+
+	nsec_ave = (double)nsec / num_cpu;
+	ops_sec = (1000000000.0 * ops) / nsec_ave;
+	mbit_sec = (8000.0 * bytes_in) / nsec_ave;
+	call_ave = (double)call_cycles / ops;
+	compl_ave = (double)compl_nsec / ops;
+	ratio = (100.0 * bytes_out) / bytes_in;
+
+	printf("RESULTS - average over %u workers:\n", num_cpu);
+	printf("----------------------------------\n");
+	printf("  duration:                 %.3f msec\n", nsec_ave / 1000000);
+	printf("  operations:               %" PRIu64 "\n", ops);
+	printf("  errors:                   %" PRIu64 "\n", errors);
+	printf("  compressed size:          %.1f %%\n", ratio);
+	printf("  worker cycles per op:     %.1f (max %" PRIu64 ")\n", call_ave,
+	       max_call_cycles);
+
+	if (test_options->mode == MODE_ASYNC)
+		printf("  completion latency:       %.1f usec (max %.1f usec)\n", compl_ave / 1000,
+		       max_compl_nsec / 1000.0);
+
+	printf("  ops per sec:              %.1f\n", ops_sec);
+	printf("  throughput:               %.3f Mbit/s\n\n", mbit_sec);
+
+	if (global->common_options.is_export) {
+		if (test_common_write("duration (msec),ops,errors,compressed size (%%),"
+				      "worker cycles per op,max worker cycles,"
+				      "completion latency (usec),max completion latency (usec),"
+				      "ops per sec,throughput (Mbit/s)\n")) {
+			ODPH_ERR("Export failed\n");
+			test_common_write_term();
+			return -1;
+		}
+
+		if (test_common_write("%f,%" PRIu64 ",%" PRIu64 ",%f,%f,%" PRIu64 ",%f,%f,%f,%f\n",
+				      nsec_ave / 1000000, ops, errors, ratio, call_ave,
+				      max_call_cycles, compl_ave / 1000, max_compl_nsec / 1000.0,
+				      ops_sec, mbit_sec)) {
+			ODPH_ERR("Export failed\n");
+			test_common_write_term();
+			return -1;
+		}
+
+		test_common_write_term();
+	}
+
+	return errors ? -1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+	odph_helper_options_t helper_options;
+	odp_instance_t instance;
+	odp_init_t init;
+	odp_shm_t shm;
+	test_global_t *global;
+	test_common_options_t common_options;
+	int ret = 0;
+
+	/* Let helper collect its own arguments (e.g. --odph_proc) */
+	argc = odph_parse_options(argc, argv);
+	if (odph_options(&helper_options)) {
+		ODPH_ERR("Error: Reading ODP helper options failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	argc = test_common_parse_options(argc, argv);
+	if (test_common_options(&common_options)) {
+		ODPH_ERR("Error: Reading test options failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* List features not to be used */
+	odp_init_param_init(&init);
+	init.not_used.feat.cls = 1;
+	init.not_used.feat.crypto = 1;
+	init.not_used.feat.ipsec = 1;
+	init.not_used.feat.schedule = 1;
+	init.not_used.feat.timer = 1;
+	init.not_used.feat.tm = 1;
+
+	init.mem_model = helper_options.mem_model;
+
+	/* Init ODP before calling anything else */
+	if (odp_init_global(&instance, &init, NULL)) {
+		ODPH_ERR("Error: Global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* Init this thread */
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		ODPH_ERR("Error: Local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	shm = odp_shm_reserve("comp_perf_global", sizeof(test_global_t),
+			      ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		ODPH_ERR("Error: Shared mem reserve failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	global = odp_shm_addr(shm);
+	if (global == NULL) {
+		ODPH_ERR("Error: Shared mem alloc failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	memset(global, 0, sizeof(test_global_t));
+
+	global->common_options = common_options;
+	global->pool = ODP_POOL_INVALID;
+
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		global->session[i] = ODP_COMP_SESSION_INVALID;
+		global->queue[i] = ODP_QUEUE_INVALID;
+	}
+
+	if (parse_options(argc, argv, &global->options))
+		exit(EXIT_FAILURE);
+
+	odp_sys_info_print();
+
+	global->instance = instance;
+
+	if (set_num_cpu(global)) {
+		ret = -1;
+		goto destroy;
+	}
+
+	if (create_resources(global)) {
+		ODPH_ERR("Error: Create resources failed.\n");
+		ret = -1;
+		goto destroy;
+	}
+
+	if (start_workers(global)) {
+		ODPH_ERR("Error: Test start failed.\n");
+		ret = -1;
+		goto destroy;
+	}
+
+	/* Wait workers to exit */
+	odph_thread_join(global->thread_tbl, global->options.num_cpu);
+
+	if (output_results(global))
+		ret = -1;
+
+destroy:
+	if (destroy_resources(global)) {
+		ODPH_ERR("Error: Destroy resources failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_shm_free(shm)) {
+		ODPH_ERR("Error: Shared mem free failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_local()) {
+		ODPH_ERR("Error: term local failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		ODPH_ERR("Error: term global failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ret;
+}
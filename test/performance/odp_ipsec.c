@@ -163,6 +163,20 @@ typedef struct {
 	 * Specified through -v or --vector argument.
 	 */
 	uint32_t vec_pkt_size;
+
+	/*
+	 * Anti-replay window size of the inbound SA. When non-zero, packets
+	 * are encrypted and then decrypted by all worker threads through
+	 * one shared outbound and inbound SA pair.
+	 * Specified through -r or --replay argument.
+	 */
+	uint32_t replay_window;
+
+	/*
+	 * Number of worker threads in anti-replay mode.
+	 * Specified through -w or --workers argument.
+	 */
+	int num_workers;
 } ipsec_args_t;
 
 /*
@@ -595,6 +609,30 @@ create_sa_from_config(ipsec_alg_config_t *config,
 	return odp_ipsec_sa_create(&param);
 }
 
+/**
+ * Create inbound ODP IPsec SA with anti-replay enabled for given config.
+ */
+static odp_ipsec_sa_t
+create_in_sa_from_config(ipsec_alg_config_t *config,
+			 ipsec_args_t *cargs)
+{
+	odp_ipsec_sa_param_t param;
+
+	odp_ipsec_sa_param_init(&param);
+	memcpy(&param.crypto, &config->crypto,
+	       sizeof(odp_ipsec_crypto_param_t));
+
+	param.proto = ODP_IPSEC_ESP;
+	param.dir = ODP_IPSEC_DIR_INBOUND;
+	param.mode = cargs->tunnel ? ODP_IPSEC_MODE_TUNNEL :
+				     ODP_IPSEC_MODE_TRANSPORT;
+	param.inbound.lookup_mode = ODP_IPSEC_LOOKUP_DISABLED;
+	param.inbound.antireplay_ws = cargs->replay_window;
+	param.dest_queue = ODP_QUEUE_INVALID;
+
+	return odp_ipsec_sa_create(&param);
+}
+
 static uint8_t test_data[] = {
 	/* IP */
 	0x45, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00,
@@ -1024,6 +1062,253 @@ static int run_thr_func(void *arg)
 	return 0;
 }
 
+typedef struct replay_thr_arg {
+	ipsec_args_t *cargs;
+	odp_ipsec_sa_t out_sa;
+	odp_ipsec_sa_t in_sa;
+	unsigned int payload_length;
+	time_record_t start;
+	time_record_t end;
+	uint64_t replay_drops;
+	int rc;
+} replay_thr_arg_t;
+
+/**
+ * Encrypt packets on the shared outbound SA and decrypt them on the shared
+ * inbound SA. All workers update the same anti-replay window.
+ */
+static int run_replay_thr_func(void *arg)
+{
+	replay_thr_arg_t *targ = arg;
+	ipsec_args_t *cargs = targ->cargs;
+	const int burst_size = cargs->burst_size;
+	const int packet_count = cargs->packet_count;
+	const int debug = cargs->debug_packets;
+	odp_ipsec_out_param_t out_param;
+	odp_ipsec_in_param_t in_param;
+	odp_pool_t pkt_pool;
+	int packets_done = 0;
+	int rc = 0;
+
+	targ->rc = -1;
+	targ->replay_drops = 0;
+
+	pkt_pool = odp_pool_lookup("packet_pool");
+	if (pkt_pool == ODP_POOL_INVALID) {
+		ODPH_ERR("pkt_pool not found\n");
+		return -1;
+	}
+
+	memset(&out_param, 0, sizeof(out_param));
+	out_param.num_sa = 1;
+	out_param.sa = &targ->out_sa;
+
+	memset(&in_param, 0, sizeof(in_param));
+	in_param.num_sa = 1;
+	in_param.sa = &targ->in_sa;
+
+	fill_time_record(&targ->start);
+
+	while (packets_done < packet_count) {
+		int num_pkts = packet_count - packets_done;
+		int num_out, num_in, i;
+
+		num_pkts = num_pkts > burst_size ? burst_size : num_pkts;
+
+		odp_packet_t pkt[num_pkts];
+		odp_packet_t out_pkt[num_pkts];
+		odp_packet_t in_pkt[num_pkts];
+
+		if (odp_unlikely(make_packet_multi(pkt_pool, targ->payload_length,
+						   pkt, num_pkts)))
+			return -1;
+
+		num_out = num_pkts;
+		rc = odp_ipsec_out(pkt, num_pkts, out_pkt, &num_out, &out_param);
+		if (odp_unlikely(rc <= 0)) {
+			ODPH_ERR("Failed odp_ipsec_out: rc = %d\n", rc);
+			odp_packet_free_sp(pkt, num_pkts);
+			return -1;
+		}
+
+		if (odp_unlikely(rc != num_pkts))
+			odp_packet_free_sp(&pkt[rc], num_pkts - rc);
+
+		for (i = 0; i < num_out; i++)
+			check_ipsec_result(out_pkt[i]);
+
+		num_in = num_out;
+		rc = odp_ipsec_in(out_pkt, num_out, in_pkt, &num_in, &in_param);
+		if (odp_unlikely(rc <= 0)) {
+			ODPH_ERR("Failed odp_ipsec_in: rc = %d\n", rc);
+			odp_packet_free_multi(out_pkt, num_out);
+			return -1;
+		}
+
+		if (odp_unlikely(rc != num_out))
+			odp_packet_free_multi(&out_pkt[rc], num_out - rc);
+
+		for (i = 0; i < num_in; i++) {
+			odp_ipsec_packet_result_t result;
+
+			if (odp_unlikely(odp_ipsec_result(&result, in_pkt[i]))) {
+				ODPH_ERR("odp_ipsec_result() failed\n");
+			} else if (odp_unlikely(result.status.error.all)) {
+				/* Reordering between workers may push packets
+				 * out of a small window */
+				if (result.status.error.antireplay)
+					targ->replay_drops++;
+				else
+					ODPH_ERR("IPsec processing error: %" PRIu32 "\n",
+						 result.status.error.all);
+			}
+		}
+
+		debug_packets(debug, in_pkt, num_in);
+		odp_packet_free_multi(in_pkt, num_in);
+		packets_done += num_pkts;
+	}
+
+	fill_time_record(&targ->end);
+	targ->rc = 0;
+
+	return 0;
+}
+
+/**
+ * Run anti-replay test for one algorithm. Worker threads share one outbound
+ * and one inbound SA, so that the inbound anti-replay window is updated
+ * concurrently from all workers.
+ */
+static int
+run_measure_replay_config(ipsec_args_t *cargs,
+			  ipsec_alg_config_t *config,
+			  odp_instance_t instance)
+{
+	unsigned int num_payloads = global_num_payloads;
+	unsigned int *payloads = global_payloads;
+	odp_ipsec_capability_t capa;
+	odp_ipsec_sa_t out_sa, in_sa;
+	odp_cpumask_t cpumask;
+	int num_workers;
+	unsigned int i;
+	int rc = 0;
+
+	if (odp_ipsec_capability(&capa) < 0) {
+		ODPH_ERR("IPSEC capability call failed.\n");
+		return -1;
+	}
+
+	if (cargs->replay_window > capa.max_antireplay_ws) {
+		ODPH_ERR("Anti-replay window %" PRIu32 " not supported (max %" PRIu32 ").\n",
+			 cargs->replay_window, capa.max_antireplay_ws);
+		return -1;
+	}
+
+	rc = odph_ipsec_alg_check(&capa, config->crypto.cipher_alg,
+				  config->crypto.cipher_key.length,
+				  config->crypto.auth_alg,
+				  config->crypto.auth_key.length);
+
+	if (rc) {
+		printf("    => %s skipped\n\n", config->name);
+		return 0;
+	}
+
+	num_workers = odp_cpumask_default_worker(&cpumask, cargs->num_workers);
+
+	out_sa = create_sa_from_config(config, cargs);
+	if (out_sa == ODP_IPSEC_SA_INVALID) {
+		ODPH_ERR("IPsec SA create failed.\n");
+		return -1;
+	}
+
+	in_sa = create_in_sa_from_config(config, cargs);
+	if (in_sa == ODP_IPSEC_SA_INVALID) {
+		ODPH_ERR("IPsec inbound SA create failed.\n");
+		odp_ipsec_sa_disable(out_sa);
+		odp_ipsec_sa_destroy(out_sa);
+		return -1;
+	}
+
+	print_result_header();
+	if (cargs->payload_length) {
+		num_payloads = 1;
+		payloads = &cargs->payload_length;
+	}
+
+	for (i = 0; i < num_payloads && rc == 0; i++) {
+		odph_thread_t thread_tbl[num_workers];
+		odph_thread_param_t thr_param[num_workers];
+		replay_thr_arg_t thr_arg[num_workers];
+		odph_thread_common_param_t thr_common;
+		uint64_t total = (uint64_t)cargs->packet_count * num_workers;
+		uint64_t replay_drops = 0;
+		double rusage_thread = 0.0;
+		ipsec_run_result_t result;
+		time_record_t start, end;
+		int j;
+
+		odph_thread_common_param_init(&thr_common);
+		thr_common.instance = instance;
+		thr_common.cpumask = &cpumask;
+
+		for (j = 0; j < num_workers; j++) {
+			thr_arg[j].cargs = cargs;
+			thr_arg[j].out_sa = out_sa;
+			thr_arg[j].in_sa = in_sa;
+			thr_arg[j].payload_length = payloads[i];
+
+			odph_thread_param_init(&thr_param[j]);
+			thr_param[j].start = run_replay_thr_func;
+			thr_param[j].arg = &thr_arg[j];
+			thr_param[j].thr_type = ODP_THREAD_WORKER;
+		}
+
+		memset(thread_tbl, 0, sizeof(thread_tbl));
+		fill_time_record(&start);
+
+		if (odph_thread_create(thread_tbl, &thr_common, thr_param,
+				       num_workers) != num_workers) {
+			ODPH_ERR("Worker create failed.\n");
+			rc = -1;
+			break;
+		}
+
+		odph_thread_join(thread_tbl, num_workers);
+		fill_time_record(&end);
+
+		for (j = 0; j < num_workers; j++) {
+			if (thr_arg[j].rc) {
+				rc = -1;
+				continue;
+			}
+
+			rusage_thread += get_rusage_thread_diff(&thr_arg[j].start,
+								&thr_arg[j].end);
+			replay_drops += thr_arg[j].replay_drops;
+		}
+
+		if (rc)
+			break;
+
+		result.elapsed = get_elapsed_usec(&start, &end) / total;
+		result.rusage_self = get_rusage_self_diff(&start, &end) / total;
+		result.rusage_thread = rusage_thread / total;
+
+		print_result(cargs, payloads[i], config, &result);
+		printf("%30.30s %15i %15" PRIu64 "\n", "workers, replay drops",
+		       num_workers, replay_drops);
+	}
+
+	odp_ipsec_sa_disable(in_sa);
+	odp_ipsec_sa_destroy(in_sa);
+	odp_ipsec_sa_disable(out_sa);
+	odp_ipsec_sa_destroy(out_sa);
+
+	return rc;
+}
+
 /**
  * Print usage information
  */
@@ -1050,6 +1335,9 @@ static void usage(char *progname)
 	       "  -p, --poll           Poll completion queue for completion events.\n"
 	       "  -t, --tunnel         Use tunnel-mode IPsec transformation.\n"
 	       "  -u, --ah             Use AH transformation instead of ESP.\n"
+	       "  -r, --replay <size>  Decrypt on one inbound SA with the given anti-replay\n"
+	       "                       window size, shared by all worker threads (sync mode only).\n"
+	       "  -w, --workers <num>  Number of worker threads with -r (default 1).\n"
 	       "  -h, --help	       Display help and exit.\n"
 	       "\n");
 }
@@ -1071,10 +1359,12 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 		{"schedule", no_argument, NULL, 's'},
 		{"tunnel", no_argument, NULL, 't'},
 		{"ah", no_argument, NULL, 'u'},
+		{"replay", required_argument, NULL, 'r'},
+		{"workers", required_argument, NULL, 'w'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+a:b:c:df:hm:nl:sptuv:";
+	static const char *shortopts = "+a:b:c:df:hm:nl:r:sptuv:w:";
 
 	cargs->in_flight = 1;
 	cargs->debug_packets = 0;
@@ -1085,6 +1375,8 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 	cargs->alg_config = NULL;
 	cargs->schedule = 0;
 	cargs->ah = 0;
+	cargs->replay_window = 0;
+	cargs->num_workers = 1;
 
 	while (1) {
 		opt = getopt_long(argc, argv, shortopts, longopts, NULL);
@@ -1146,6 +1438,12 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 		case 'u':
 			cargs->ah = 1;
 			break;
+		case 'r':
+			cargs->replay_window = atoi(optarg);
+			break;
+		case 'w':
+			cargs->num_workers = atoi(optarg);
+			break;
 		default:
 			break;
 		}
@@ -1163,6 +1461,17 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 		usage(argv[0]);
 		exit(-1);
 	}
+
+	if (cargs->replay_window && (cargs->schedule || cargs->poll)) {
+		printf("-r (replay) is supported only in sync mode\n");
+		usage(argv[0]);
+		exit(-1);
+	}
+
+	if (cargs->num_workers < 1) {
+		printf("Invalid number of workers: %d\n", cargs->num_workers);
+		exit(-1);
+	}
 }
 
 int main(int argc, char *argv[])
@@ -1356,11 +1665,22 @@ int main(int argc, char *argv[])
 		       cpumaskstr);
 	} else if (cargs.poll) {
 		printf("Run in async poll mode\n");
+	} else if (cargs.replay_window) {
+		printf("Run in sync anti-replay mode\n");
 	} else {
 		printf("Run in sync mode\n");
 	}
 
-	if (cargs.alg_config) {
+	if (cargs.replay_window) {
+		for (i = 0; i < ODPH_ARRAY_SIZE(algs_config); i++) {
+			if (cargs.alg_config && cargs.alg_config != &algs_config[i])
+				continue;
+			if (run_measure_replay_config(&cargs, algs_config + i, instance)) {
+				ODPH_ERR("Anti-replay test failed.\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+	} else if (cargs.alg_config) {
 		odph_thread_common_param_init(&thr_common);
 		thr_common.instance = instance;
 		thr_common.cpumask = &cpumask;
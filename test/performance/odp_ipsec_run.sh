@@ -15,4 +15,12 @@ if [ $? -ne 0 ] ; then
     exit 1
 fi
 
+# Two workers updating the anti-replay window of one inbound SA
+$TEST_DIR/odp_ipsec${EXEEXT} -c 100 -a aes-cbc-hmac-sha1-96 -r 1024 -w 2
+
+if [ $? -ne 0 ] ; then
+    echo Test FAILED
+    exit 1
+fi
+
 exit 0
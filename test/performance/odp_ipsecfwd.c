@@ -165,6 +165,7 @@ typedef struct prog_config_s {
 	int num_thrs;
 	odp_bool_t is_dir_rx;
 	odp_bool_t is_hashed_tx;
+	odp_bool_t is_inline_in;
 	uint8_t mode;
 } prog_config_t;
 
@@ -433,6 +434,10 @@ static void print_usage(void)
 	       "                      directly. '--mode', '--num_input_qs' and '--num_output_qs'\n"
 	       "                      options are ignored, input and output queue counts will\n"
 	       "                      match worker count.\n"
+	       "  -L, --inline_in     Use inline inbound IPsec processing. Inbound SAs are\n"
+	       "                      looked up by the implementation during packet input,\n"
+	       "                      so 'lookup_mode' needs to be set for inbound SAs.\n"
+	       "                      Not supported with '--direct_rx'.\n"
 	       "  -h, --help          This help.\n"
 	       "\n", pool_capa.pkt.max_num > 0U ? ODPH_MIN(pool_capa.pkt.max_num, PKT_CNT) :
 	       PKT_CNT, pool_capa.pkt.max_len > 0U ? ODPH_MIN(pool_capa.pkt.max_len, PKT_SIZE) :
@@ -971,8 +976,19 @@ static odp_bool_t setup_ipsec(prog_config_t *config)
 
 	odp_ipsec_config_init(&ipsec_config);
 
+	if (config->is_inline_in) {
+		odp_ipsec_capability_t ipsec_capa;
+
+		if (odp_ipsec_capability(&ipsec_capa) < 0 ||
+		    ipsec_capa.op_mode_inline_in == ODP_SUPPORT_NO) {
+			ODPH_ERR("Inline inbound IPsec not supported\n");
+			return false;
+		}
+	}
+
 	if (!config->is_dir_rx) {
-		ipsec_config.inbound_mode = ODP_IPSEC_OP_MODE_ASYNC;
+		ipsec_config.inbound_mode = config->is_inline_in ? ODP_IPSEC_OP_MODE_INLINE :
+								   ODP_IPSEC_OP_MODE_ASYNC;
 		ipsec_config.outbound_mode = ODP_IPSEC_OP_MODE_ASYNC;
 		config->ops.proc = process_packets_in_enq;
 		config->ops.compl = complete_ipsec_ops;
@@ -1458,6 +1474,11 @@ static parse_result_t check_options(prog_config_t *config)
 		return PRS_NOK;
 	}
 
+	if (config->is_dir_rx && config->is_inline_in) {
+		ODPH_ERR("Inline inbound IPsec not supported with direct RX\n");
+		return PRS_NOK;
+	}
+
 	if (config->is_dir_rx) {
 		config->num_input_qs = config->num_thrs;
 		config->num_output_qs = config->num_thrs;
@@ -1482,11 +1503,12 @@ static parse_result_t parse_options(int argc, char **argv, prog_config_t *config
 		{ "num_sa_qs", required_argument, NULL, 'S' },
 		{ "num_output_qs", required_argument, NULL, 'O' },
 		{ "direct_rx", no_argument, NULL, 'd' },
+		{ "inline_in", no_argument, NULL, 'L' },
 		{ "help", no_argument, NULL, 'h' },
 		{ NULL, 0, NULL, 0 }
 	};
 
-	static const char *shortopts = "i:n:l:c:m:C:I:S:O:dh";
+	static const char *shortopts = "i:n:l:c:m:C:I:S:O:dLh";
 
 	while (true) {
 		opt = getopt_long(argc, argv, shortopts, longopts, NULL);
@@ -1525,6 +1547,9 @@ static parse_result_t parse_options(int argc, char **argv, prog_config_t *config
 		case 'd':
 			config->is_dir_rx = true;
 			break;
+		case 'L':
+			config->is_inline_in = true;
+			break;
 		case 'h':
 			print_usage();
 			return PRS_TERM;
@@ -1731,6 +1756,16 @@ static odp_bool_t setup_pktios(prog_config_t *config)
 
 		odp_pktio_config_init(&pktio_config);
 
+		if (config->is_inline_in) {
+			if (!capa.config.inbound_ipsec) {
+				ODPH_ERR("Inline inbound IPsec not supported by packet I/O (%s)\n",
+					 pktio->name);
+				return false;
+			}
+
+			pktio_config.inbound_ipsec = 1;
+		}
+
 		if (odp_pktio_config(pktio->handle, &pktio_config) < 0) {
 			ODPH_ERR("Error configuring packet I/O extra options (%s)\n", pktio->name);
 			return false;
@@ -1890,10 +1925,12 @@ static void print_stats(const prog_config_t *config)
 	       "    input queue count:  %u\n"
 	       "    SA queue count:     %u\n"
 	       "    output queue count: %u\n"
-	       "    RX mode:            %s\n", config->conf_file,
+	       "    RX mode:            %s\n"
+	       "    inbound IPsec mode: %s\n", config->conf_file,
 	       config->mode == ORDERED ? "ordered" : "parallel", config->num_input_qs,
 	       config->num_sa_qs, config->num_output_qs,
-	       config->is_dir_rx ? "direct" : "scheduled");
+	       config->is_dir_rx ? "direct" : "scheduled",
+	       config->is_inline_in ? "inline" : config->is_dir_rx ? "sync" : "async");
 
 	for (int i = 0; i < config->num_thrs; ++i) {
 		stats = &config->thread_config[i].stats;
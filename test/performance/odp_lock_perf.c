@@ -1,5 +1,5 @@
 /* SPDX-License-Identifier: BSD-3-Clause
- * Copyright (c) 2021-2024 Nokia
+ * Copyright (c) 2021-2026 Nokia
  */
 
 /**
@@ -30,6 +30,9 @@
 
 #define TEST_INFO(name, test, validate) { name, test, validate }
 
+/* Read-mostly tests take the write lock once per this many rounds */
+#define READ_MOSTLY_WRITE_INTERVAL 64
+
 /* Maximum number of results to be held */
 #define TEST_MAX_BENCH 50
 
@@ -83,6 +86,29 @@ typedef struct test_thread_ctx_t {
 	uint32_t idx;
 } test_thread_ctx_t;
 
+/* Queued (MCS style) lock for comparison with the API locks. Lock waiters
+ * spin on their own wait node instead of the shared lock word. */
+typedef struct {
+	odp_atomic_u32_t locked;
+	/* 0: empty, otherwise thread id + 1 */
+	odp_atomic_u32_t tail;
+} queued_lock_t;
+
+typedef struct ODP_ALIGNED_CACHE {
+	odp_atomic_u32_t wait;
+	odp_atomic_u32_t next;
+} queued_lock_node_t;
+
+/* Big reader lock: per thread reader indicators, writer scans all of them */
+typedef struct ODP_ALIGNED_CACHE {
+	odp_atomic_u32_t cnt;
+} brlock_reader_t;
+
+typedef struct {
+	odp_atomic_u32_t writer;
+	brlock_reader_t reader[ODP_THREAD_COUNT_MAX];
+} brlock_t;
+
 typedef struct results_t {
 	const char *test_name;
 	double cycles_per_round;
@@ -122,6 +148,14 @@ struct test_global_t {
 			odp_ticketlock_t lock;
 			uint64_t counter[MAX_COUNTERS];
 		} ticketlock;
+		struct ODP_ALIGNED_CACHE {
+			queued_lock_t lock;
+			uint64_t counter[MAX_COUNTERS];
+		} queued_lock;
+		struct ODP_ALIGNED_CACHE {
+			brlock_t lock;
+			uint64_t counter[MAX_COUNTERS];
+		} brlock;
 		struct ODP_ALIGNED_CACHE {
 			uint64_t counter[MAX_COUNTERS];
 		} separate;
@@ -129,6 +163,7 @@ struct test_global_t {
 			uint64_t ODP_ALIGNED_CACHE counter;
 		} all_separate[MAX_COUNTERS];
 	} item;
+	queued_lock_node_t queued_lock_node[ODP_THREAD_COUNT_MAX];
 };
 
 typedef struct {
@@ -227,6 +262,158 @@ static inline void test_ticketlock(test_global_t *g, uint64_t **counter,
 	}
 }
 
+static inline int queued_lock_try(queued_lock_t *lock)
+{
+	uint32_t unlocked = 0;
+
+	return odp_atomic_load_u32(&lock->locked) == 0 &&
+	       odp_atomic_cas_acq_u32(&lock->locked, &unlocked, 1);
+}
+
+static inline void queued_lock_lock(queued_lock_t *lock, queued_lock_node_t *node_tbl,
+				    uint32_t me)
+{
+	queued_lock_node_t *node = &node_tbl[me - 1];
+	uint32_t prev, next;
+
+	if (odp_atomic_load_u32(&lock->tail) == 0 && queued_lock_try(lock))
+		return;
+
+	odp_atomic_store_u32(&node->next, 0);
+	odp_atomic_store_u32(&node->wait, 1);
+
+	prev = odp_atomic_xchg_u32(&lock->tail, me);
+
+	if (prev) {
+		odp_atomic_store_rel_u32(&node_tbl[prev - 1].next, me);
+
+		while (odp_atomic_load_acq_u32(&node->wait))
+			odp_cpu_pause();
+	}
+
+	while (!queued_lock_try(lock))
+		odp_cpu_pause();
+
+	prev = me;
+	if (odp_atomic_cas_rel_u32(&lock->tail, &prev, 0))
+		return;
+
+	while ((next = odp_atomic_load_acq_u32(&node->next)) == 0)
+		odp_cpu_pause();
+
+	odp_atomic_store_rel_u32(&node_tbl[next - 1].wait, 0);
+}
+
+static inline void queued_lock_unlock(queued_lock_t *lock)
+{
+	odp_atomic_store_rel_u32(&lock->locked, 0);
+}
+
+static inline void test_queued_lock(test_global_t *g, uint64_t **counter,
+				    uint32_t num_counter)
+{
+	queued_lock_t *lock = &g->item.queued_lock.lock;
+	queued_lock_node_t *node_tbl = g->queued_lock_node;
+	uint32_t me = odp_thread_id() + 1;
+
+	for (uint64_t i = 0; i < g->test_options.num_round; i++) {
+		queued_lock_lock(lock, node_tbl, me);
+		for (uint32_t j = 0; j < num_counter; j++)
+			(*counter[j])++;
+		queued_lock_unlock(lock);
+	}
+}
+
+static inline void brlock_read_lock(brlock_t *lock, brlock_reader_t *reader)
+{
+	while (1) {
+		odp_atomic_inc_u32(&reader->cnt);
+		odp_mb_full();
+
+		if (odp_atomic_load_acq_u32(&lock->writer) == 0)
+			return;
+
+		odp_atomic_dec_u32(&reader->cnt);
+
+		while (odp_atomic_load_u32(&lock->writer))
+			odp_cpu_pause();
+	}
+}
+
+static inline void brlock_read_unlock(brlock_reader_t *reader)
+{
+	odp_atomic_sub_rel_u32(&reader->cnt, 1);
+}
+
+static inline void brlock_write_lock(brlock_t *lock)
+{
+	uint32_t unlocked = 0;
+
+	while (!odp_atomic_cas_acq_u32(&lock->writer, &unlocked, 1)) {
+		unlocked = 0;
+		odp_cpu_pause();
+	}
+
+	odp_mb_full();
+
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		while (odp_atomic_load_acq_u32(&lock->reader[i].cnt))
+			odp_cpu_pause();
+	}
+}
+
+static inline void brlock_write_unlock(brlock_t *lock)
+{
+	odp_atomic_store_rel_u32(&lock->writer, 0);
+}
+
+static inline void test_rwlock_read_mostly(test_global_t *g, uint64_t **counter,
+					   uint32_t num_counter)
+{
+	odp_rwlock_t *lock = &g->item.rwlock.lock;
+
+	for (uint64_t i = 0; i < g->test_options.num_round; i++) {
+		if (i % READ_MOSTLY_WRITE_INTERVAL == 0) {
+			odp_rwlock_write_lock(lock);
+			for (uint32_t j = 0; j < num_counter; j++)
+				(*counter[j])++;
+			odp_rwlock_write_unlock(lock);
+		}
+		odp_rwlock_read_lock(lock);
+		for (uint32_t j = 1; j < num_counter; j++)
+			if (*counter[0] != *counter[j]) {
+				odp_rwlock_read_unlock(lock);
+				ODPH_ERR("Error: Counter mismatch\n");
+				return;
+			}
+		odp_rwlock_read_unlock(lock);
+	}
+}
+
+static inline void test_brlock_read_mostly(test_global_t *g, uint64_t **counter,
+					   uint32_t num_counter)
+{
+	brlock_t *lock = &g->item.brlock.lock;
+	brlock_reader_t *reader = &lock->reader[odp_thread_id()];
+
+	for (uint64_t i = 0; i < g->test_options.num_round; i++) {
+		if (i % READ_MOSTLY_WRITE_INTERVAL == 0) {
+			brlock_write_lock(lock);
+			for (uint32_t j = 0; j < num_counter; j++)
+				(*counter[j])++;
+			brlock_write_unlock(lock);
+		}
+		brlock_read_lock(lock, reader);
+		for (uint32_t j = 1; j < num_counter; j++)
+			if (*counter[0] != *counter[j]) {
+				brlock_read_unlock(reader);
+				ODPH_ERR("Error: Counter mismatch\n");
+				return;
+			}
+		brlock_read_unlock(reader);
+	}
+}
+
 static inline int validate_generic(test_global_t *g, uint64_t **counter,
 				   uint32_t num_counter)
 {
@@ -244,6 +431,25 @@ static inline int validate_generic(test_global_t *g, uint64_t **counter,
 	return status;
 }
 
+static inline int validate_read_mostly(test_global_t *g, uint64_t **counter,
+				       uint32_t num_counter)
+{
+	int status = 0;
+	uint64_t num_write = (g->test_options.num_round + READ_MOSTLY_WRITE_INTERVAL - 1) /
+			     READ_MOSTLY_WRITE_INTERVAL;
+	uint64_t total = (uint64_t)g->test_options.num_cpu * num_write;
+
+	for (uint32_t i = 0; i < num_counter; i++) {
+		if (*counter[i] != total) {
+			status = 1;
+			ODPH_ERR("Error: Counter %d value %" PRIu64 " expected %" PRIu64 "\n",
+				 i, *counter[i], total);
+		}
+	}
+
+	return status;
+}
+
 static void print_usage(void)
 {
 	printf("\n"
@@ -258,6 +464,9 @@ static void print_usage(void)
 	       "                             3: odp_rwlock_t\n"
 	       "                             4: odp_rwlock_recursive_t\n"
 	       "                             5: odp_ticketlock_t\n"
+	       "                             6: queued (MCS style) lock implemented with odp_atomic_u32_t\n"
+	       "                             7: odp_rwlock_t, read-mostly (one write per %d rounds)\n"
+	       "                             8: big reader lock implemented with odp_atomic_u32_t, read-mostly\n"
 	       "  -r, --num_round        Number of rounds (default %" PRIu64 ")\n"
 	       "  -e, --repeat           Repeat the tests (default %u)\n"
 	       "                             0: no repeat, run the tests once\n"
@@ -270,7 +479,7 @@ static void print_usage(void)
 	       "                             2: place each counter to separate cache line\n"
 	       "  -h, --help             This help\n"
 	       "\n",
-	       DEFAULT_MAX_WORKERS, test_options_def.type,
+	       DEFAULT_MAX_WORKERS, test_options_def.type, READ_MOSTLY_WRITE_INTERVAL,
 	       test_options_def.num_round, test_options_def.repeat,
 	       test_options_def.num_counter, test_options_def.place);
 }
@@ -448,6 +657,11 @@ static int init_test(test_global_t *g, const char *name)
 	odp_rwlock_init(&g->item.rwlock.lock);
 	odp_rwlock_recursive_init(&g->item.rwlock_recursive.lock);
 	odp_ticketlock_init(&g->item.ticketlock.lock);
+	odp_atomic_init_u32(&g->item.queued_lock.lock.locked, 0);
+	odp_atomic_init_u32(&g->item.queued_lock.lock.tail, 0);
+	odp_atomic_init_u32(&g->item.brlock.lock.writer, 0);
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		odp_atomic_init_u32(&g->item.brlock.lock.reader[i].cnt, 0);
 
 	return 0;
 }
@@ -477,6 +691,15 @@ static void fill_counter_ptrs(test_global_t *g, uint64_t **counter_out)
 			case 4:
 				counter_out[i] = &g->item.ticketlock.counter[i];
 				break;
+			case 5:
+				counter_out[i] = &g->item.queued_lock.counter[i];
+				break;
+			case 6:
+				counter_out[i] = &g->item.rwlock.counter[i];
+				break;
+			case 7:
+				counter_out[i] = &g->item.brlock.counter[i];
+				break;
 			}
 		}
 		break;
@@ -584,6 +807,9 @@ static test_case_t test_suite[] = {
 	TEST_INFO("odp_rwlock", test_rwlock, validate_generic),
 	TEST_INFO("odp_rwlock_recursive", test_rwlock_recursive, validate_generic),
 	TEST_INFO("odp_ticketlock", test_ticketlock, validate_generic),
+	TEST_INFO("queued_lock", test_queued_lock, validate_generic),
+	TEST_INFO("odp_rwlock_read_mostly", test_rwlock_read_mostly, validate_read_mostly),
+	TEST_INFO("brlock_read_mostly", test_brlock_read_mostly, validate_read_mostly),
 };
 
 ODP_STATIC_ASSERT(ODPH_ARRAY_SIZE(test_suite) < TEST_MAX_BENCH,
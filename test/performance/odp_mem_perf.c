@@ -20,6 +20,9 @@
 #include <odp_api.h>
 #include <odp/helper/odph_api.h>
 
+/* Access granularity of random access mode */
+#define RAND_ACCESS_LEN 64
+
 typedef struct test_options_t {
 	uint32_t num_cpu;
 	uint32_t num_round;
@@ -69,6 +72,9 @@ static void print_usage(void)
 	       "  -m, --mode             0: Memset data (default)\n"
 	       "                         1: Memcpy data. On each round, reads data from one half of the memory area\n"
 	       "                            and writes it to the other half.\n"
+	       "                         2: Random access. On each round, increments data_len / 64 bytes at\n"
+	       "                            random 64 byte aligned offsets. Results depend on TLB reach,\n"
+	       "                            e.g. on the huge page size used for the memory area.\n"
 	       "  -h, --help             This help\n"
 	       "\n");
 }
@@ -177,6 +183,8 @@ static int set_num_cpu(test_global_t *global)
 static int create_shm(test_global_t *global)
 {
 	odp_shm_capability_t shm_capa;
+	odp_shm_info_t info;
+	odp_time_t t1, t2;
 	odp_shm_t shm;
 	void *addr;
 	uint32_t i, num_shm;
@@ -221,7 +229,9 @@ static int create_shm(test_global_t *global)
 		name[9]  = '0' + i / 10;
 		name[10] = '0' + i % 10;
 
+		t1 = odp_time_local_strict();
 		shm = odp_shm_reserve(name, data_len, ODP_CACHE_LINE_SIZE, shm_flags);
+		t2 = odp_time_local_strict();
 
 		if (shm == ODP_SHM_INVALID) {
 			ODPH_ERR("SHM[%u] reserve failed.\n", i);
@@ -239,6 +249,11 @@ static int create_shm(test_global_t *global)
 		global->shm_addr[i] = addr;
 
 		printf("  shm addr[%u]      %p\n", i, addr);
+
+		printf("  shm reserve[%u]   %.3f msec\n", i, odp_time_diff_ns(t2, t1) / 1000000.0);
+
+		if (odp_shm_info(shm, &info) == 0)
+			printf("  shm page size[%u] %" PRIu64 " kB\n", i, info.page_size / 1024);
 	}
 
 	printf("\n");
@@ -288,13 +303,28 @@ static int run_test(void *arg)
 	if (mode == 0) {
 		for (i = 0; i < num_round; i++)
 			memset(addr, thr + i, data_len);
-	} else {
+	} else if (mode == 1) {
 		for (i = 0; i < num_round; i++) {
 			if ((i & 0x1) == 0)
 				memcpy(&addr[half_len], addr, half_len);
 			else
 				memcpy(addr, &addr[half_len], half_len);
 		}
+	} else {
+		uint64_t j;
+		uint64_t num_line = data_len / RAND_ACCESS_LEN;
+		uint64_t seed = 0x9e3779b97f4a7c15ULL + thr;
+
+		for (i = 0; i < num_round; i++) {
+			for (j = 0; j < num_line; j++) {
+				/* xorshift64 */
+				seed ^= seed << 13;
+				seed ^= seed >> 7;
+				seed ^= seed << 17;
+
+				addr[(seed % num_line) * RAND_ACCESS_LEN]++;
+			}
+		}
 	}
 
 	t2 = odp_time_local();
@@ -21,6 +21,9 @@
 /* Max number of inputs and outputs */
 #define MAX_IO 8
 
+/* Max number of runs per odp_ml_run_multi() call */
+#define MAX_RUNS 64
+
 #define TEST_SKIP 77
 
 enum {
@@ -36,6 +39,7 @@ typedef struct {
 	char *model_name, *input_name, *reference_name;
 	float scale_q, scale_d;
 	int num_batch;
+	int num_run;
 } test_opt_t;
 
 static test_opt_t opt_def = {
@@ -43,6 +47,7 @@ static test_opt_t opt_def = {
 	.rounds = 50,
 	.warmup = 5,
 	.num_batch = 1,
+	.num_run = 1,
 };
 
 typedef struct io_size {
@@ -195,9 +200,11 @@ static void usage(const char *prog)
 	       "  -q, --quant         Quantization scale\n"
 	       "  -d, --dequant       Dequantization scale\n"
 	       "  -b, --batches       Number of batches\n"
+	       "  -n, --num_run       Number of runs per odp_ml_run_multi() call. With 1,\n"
+	       "                      odp_ml_run() is used. Default 1, max %d.\n"
 	       "  -h, --help          Help\n"
 	       "\n",
-	       prog, opt_def.rounds, opt_def.warmup);
+	       prog, opt_def.rounds, opt_def.warmup, MAX_RUNS);
 }
 
 static int parse_args(int argc, char *argv[])
@@ -214,10 +221,11 @@ static int parse_args(int argc, char *argv[])
 		{ "quant", required_argument, NULL, 'q' },
 		{ "dequant", required_argument, NULL, 'd' },
 		{ "batches", required_argument, NULL, 'b' },
+		{ "num_run", required_argument, NULL, 'n' },
 		{ "help", no_argument, NULL, 'h' },
 		{ NULL, 0, NULL, 0 } };
 
-	static const char *shortopts = "+M:I:c:r:m:lw:R:q:d:b:h";
+	static const char *shortopts = "+M:I:c:r:m:lw:R:q:d:b:n:h";
 
 	glb->opt = opt_def;
 
@@ -261,6 +269,9 @@ static int parse_args(int argc, char *argv[])
 		case 'b':
 			glb->opt.num_batch = atoi(optarg);
 			break;
+		case 'n':
+			glb->opt.num_run = atoi(optarg);
+			break;
 		case 'h':
 			usage(argv[0]);
 			return 1;
@@ -287,6 +298,11 @@ static int parse_args(int argc, char *argv[])
 		exit(EXIT_FAILURE);
 	}
 
+	if (glb->opt.num_run < 1 || glb->opt.num_run > MAX_RUNS) {
+		ODPH_ERR("Invalid number of runs per call: %d\n", glb->opt.num_run);
+		exit(EXIT_FAILURE);
+	}
+
 	printf("Options:\n");
 	printf("--------\n");
 	printf("model_name: %s\n", glb->opt.model_name);
@@ -300,6 +316,7 @@ static int parse_args(int argc, char *argv[])
 	printf("scale_q: %g\n", glb->opt.scale_q);
 	printf("scale_d: %g\n", glb->opt.scale_d);
 	printf("num_batch: %d\n", glb->opt.num_batch);
+	printf("num_run: %d\n", glb->opt.num_run);
 	printf("\n");
 
 	return 0;
@@ -464,8 +481,11 @@ static int test_ml(void *ptr)
 	odp_time_t time = ODP_TIME_NULL;
 	odp_ml_data_seg_t inp_seg[MAX_IO];
 	uint8_t *inp_addr;
-	odp_ml_data_seg_t out_seg[MAX_IO];
+	odp_ml_data_seg_t out_seg[MAX_RUNS][MAX_IO];
 	uint8_t *out_addr;
+	odp_ml_data_t data[MAX_RUNS];
+	odp_ml_run_param_t run_param[MAX_RUNS];
+	const int num_run = glb->opt.num_run;
 	int thread_idx = (int)(uintptr_t)ptr;
 	void *input = NULL, *output = NULL, *output_file = NULL;
 	void *output_final = NULL;
@@ -491,10 +511,11 @@ static int test_ml(void *ptr)
 		inp_addr += glb->inp[i].size;
 	}
 
-	output = malloc(glb->out_size_q);
+	/* Separate output space for each run */
+	output = malloc(glb->out_size_q * num_run);
 
 	if (!output) {
-		ODPH_ERR("Allocating %" PRIu64 " bytes failed\n", glb->out_size_q);
+		ODPH_ERR("Allocating %" PRIu64 " bytes failed\n", glb->out_size_q * num_run);
 		ret = -1;
 		goto error;
 	}
@@ -515,22 +536,22 @@ static int test_ml(void *ptr)
 		out_size_final = glb->out_size_d;
 	}
 
-	for (int i = 0; i < glb->num_out; i++) {
-		out_seg[i].addr = out_addr;
-		out_seg[i].size = glb->out[i].size;
-		out_addr += glb->out[i].size;
-	}
+	for (int r = 0; r < num_run; r++) {
+		for (int i = 0; i < glb->num_out; i++) {
+			out_seg[r][i].addr = out_addr;
+			out_seg[r][i].size = glb->out[i].size;
+			out_addr += glb->out[i].size;
+		}
 
-	odp_ml_data_t data = {
-		.input_seg = inp_seg,
-		.num_input_seg = glb->num_inp,
-		.output_seg = out_seg,
-		.num_output_seg = glb->num_out,
-	};
-	odp_ml_run_param_t run_param;
+		/* All runs use the same input data */
+		data[r].input_seg = inp_seg;
+		data[r].num_input_seg = glb->num_inp;
+		data[r].output_seg = out_seg[r];
+		data[r].num_output_seg = glb->num_out;
 
-	odp_ml_run_param_init(&run_param);
-	run_param.batch_size = glb->opt.num_batch;
+		odp_ml_run_param_init(&run_param[r]);
+		run_param[r].batch_size = glb->opt.num_batch;
+	}
 
 	if (glb->opt.mode != MODE_INFERENCE_QUANT && glb->opt.scale_q > 0.0)
 		quantize_input(input, glb->inp_file_data);
@@ -546,12 +567,25 @@ static int test_ml(void *ptr)
 
 		int r;
 
-		while (!(r = odp_ml_run(glb->mdl, &data, &run_param)))
-			;
-		if (r != 1) {
-			ODPH_ERR("odp_ml_run() failed\n");
-			ret = -1;
-			goto error;
+		if (num_run == 1) {
+			while (!(r = odp_ml_run(glb->mdl, &data[0], &run_param[0])))
+				;
+			if (r != 1) {
+				ODPH_ERR("odp_ml_run() failed\n");
+				ret = -1;
+				goto error;
+			}
+		} else {
+			for (int num = 0; num < num_run; num += r) {
+				while (!(r = odp_ml_run_multi(glb->mdl, &data[num], &run_param[num],
+							      num_run - num)))
+					;
+				if (r < 0) {
+					ODPH_ERR("odp_ml_run_multi() failed\n");
+					ret = -1;
+					goto error;
+				}
+			}
 		}
 
 		if (glb->opt.mode == MODE_INFERENCE_QUANT && glb->opt.scale_d > 0.0)
@@ -567,6 +601,15 @@ static int test_ml(void *ptr)
 	if (glb->opt.mode != MODE_INFERENCE_QUANT && glb->opt.scale_d > 0.0)
 		dequantize_output(output_file, output);
 
+	/* Output of all runs must match */
+	for (int r = 1; r < num_run; r++) {
+		if (memcmp(output, (uint8_t *)output + r * glb->out_size_q, glb->out_size_q)) {
+			ODPH_ERR("Output of run %d differs from output of run 0\n", r);
+			ret = -1;
+			goto error;
+		}
+	}
+
 	if (glb->ref_file_data) {
 		if (out_size_final != glb->ref_file_size) {
 			ODPH_ERR("Output size mismatch: %" PRIu64
@@ -746,6 +789,31 @@ static void print_results_min_avg_max(void)
 	}
 }
 
+static void print_throughput(void)
+{
+	int num_threads = glb->opt.num_threads;
+	uint64_t sum = 0;
+	double rounds_sec, runs_sec;
+
+	if (glb->opt.mode != MODE_INFERENCE && glb->opt.mode != MODE_INFERENCE_QUANT)
+		return;
+
+	/* Result printing above has converted stat sums to per round averages */
+	for (int i = 0; i < num_threads; i++)
+		sum += glb->stat[i].sum;
+
+	if (!sum)
+		return;
+
+	rounds_sec = (double)ODP_TIME_SEC_IN_NS * num_threads * num_threads / sum;
+	runs_sec = rounds_sec * glb->opt.num_run;
+
+	printf("\nThroughput, all threads (batch size %d, %d runs per call):\n",
+	       glb->opt.num_batch, glb->opt.num_run);
+	printf("  runs / sec:    %15.1f\n", runs_sec);
+	printf("  samples / sec: %15.1f\n", runs_sec * glb->opt.num_batch);
+}
+
 static void print_results(void)
 {
 	printf("\n");
@@ -755,6 +823,8 @@ static void print_results(void)
 	else
 		print_results_avg();
 
+	print_throughput();
+
 	printf("\n");
 }
 
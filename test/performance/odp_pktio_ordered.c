@@ -134,6 +134,7 @@ typedef struct {
 	int num_rx_q;		/**< Number of input queues per interface */
 	int num_flows;		/**< Number of packet flows */
 	int extra_rounds;	/**< Number of extra input processing rounds */
+	int extra_var;		/**< Max number of random extra input processing rounds */
 	char **if_names;	/**< Array of pointers to interface names */
 	odph_ethaddr_t addrs[MAX_PKTIOS]; /**< Array of dst addresses */
 	pktin_mode_t in_mode;	/**< Packet input mode */
@@ -434,20 +435,23 @@ static inline void process_flow(odp_event_t ev_tbl[], int num, stats_t *stats,
  * @param num      Number of events in the array
  * @param stats    Pointer for storing thread statistics
  * @param qcontext Source queue context
+ * @param seed     Random seed for variable cost processing
  */
 static inline void process_input(odp_event_t ev_tbl[], int num, stats_t *stats,
-				 qcontext_t *qcontext)
+				 qcontext_t *qcontext, uint64_t *seed)
 {
 	flow_t *flow;
 	flow_t *flow_tbl[MAX_PKT_BURST];
 	int ret;
 	int i, j;
 	int pkts = 0;
+	int extra_var = gbl_args->appl.extra_var;
 
 	for (i = 0; i < num; i++) {
 		odp_packet_t pkt;
 		packet_hdr_t hdr;
 		int  flow_idx;
+		int  extra_rounds;
 
 		pkt = odp_packet_from_event(ev_tbl[i]);
 
@@ -470,8 +474,17 @@ static inline void process_input(odp_event_t ev_tbl[], int num, stats_t *stats,
 		flow->dst_idx = lookup_dest_port(pkt);
 		flow_tbl[pkts] = flow;
 
+		extra_rounds = gbl_args->appl.extra_rounds;
+
+		/* Vary processing cost per packet, so that threads complete their ordered
+		 * contexts out of order */
+		if (extra_var) {
+			*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			extra_rounds += (*seed >> 32) % (extra_var + 1);
+		}
+
 		/* Simulate "fat pipe" processing by generating extra work */
-		for (j = 0; j < gbl_args->appl.extra_rounds; j++)
+		for (j = 0; j < extra_rounds; j++)
 			flow->crc = dummy_hash_crc32c(odp_packet_data(pkt),
 						      odp_packet_len(pkt), 0);
 		pkts++;
@@ -520,6 +533,7 @@ static int run_worker(void *arg)
 	qcontext_t *qcontext;
 	thread_args_t *thr_args = arg;
 	stats_t *stats = thr_args->stats;
+	uint64_t seed = odp_thread_id();
 	int pkts;
 	int i, j;
 
@@ -543,7 +557,7 @@ static int run_worker(void *arg)
 		qcontext = odp_queue_context(queue);
 
 		if (qcontext->input_queue)
-			process_input(ev_tbl, pkts, stats, qcontext);
+			process_input(ev_tbl, pkts, stats, qcontext, &seed);
 		else
 			process_flow(ev_tbl, pkts, stats, qcontext, pktout);
 	}
@@ -833,6 +847,9 @@ static void usage(char *progname)
 	       "  -r, --num_rx_q    Number of RX queues per interface\n"
 	       "  -f, --num_flows   Number of packet flows\n"
 	       "  -e, --extra_input <number>  Number of extra input processing rounds\n"
+	       "  -x, --extra_var <number>    Maximum number of additional extra input processing\n"
+	       "                              rounds. The number is selected randomly per packet,\n"
+	       "                              which emulates variable cost processing. Default: 0\n"
 	       "  -c, --count <number>        CPU count, 0=all available, default=1\n"
 	       "  -t, --time  <number>        Time in seconds to run.\n"
 	       "  -a, --accuracy <number>     Statistics print interval in seconds\n"
@@ -868,12 +885,13 @@ static void parse_args(int argc, char *argv[], appl_args_t *appl_args)
 		{"num_rx_q", required_argument, NULL, 'r'},
 		{"num_flows", required_argument, NULL, 'f'},
 		{"extra_input", required_argument, NULL, 'e'},
+		{"extra_var", required_argument, NULL, 'x'},
 		{"promisc_mode", no_argument, NULL, 'P'},
 		{"help", no_argument, NULL, 'h'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts =  "+c:t:a:i:m:d:r:f:e:Ph";
+	static const char *shortopts =  "+c:t:a:i:m:d:r:f:e:x:Ph";
 
 	appl_args->time = 0; /* loop forever if time to run is 0 */
 	appl_args->accuracy = DEF_STATS_INT;
@@ -881,6 +899,7 @@ static void parse_args(int argc, char *argv[], appl_args_t *appl_args)
 	appl_args->num_rx_q = DEF_NUM_RX_QUEUES;
 	appl_args->num_flows = DEF_NUM_FLOWS;
 	appl_args->extra_rounds = DEF_EXTRA_ROUNDS;
+	appl_args->extra_var = 0;
 	appl_args->promisc_mode = 0;
 
 	while (1) {
@@ -995,6 +1014,9 @@ static void parse_args(int argc, char *argv[], appl_args_t *appl_args)
 		case 'e':
 			appl_args->extra_rounds = atoi(optarg);
 			break;
+		case 'x':
+			appl_args->extra_var = atoi(optarg);
+			break;
 		case 'P':
 			appl_args->promisc_mode = 1;
 			break;
@@ -1050,11 +1072,12 @@ static void print_info(char *progname, appl_args_t *appl_args)
 	       "Mode:               %s\n"
 	       "Flows:              %d\n"
 	       "Extra rounds:       %d\n"
+	       "Extra variation:    %d\n"
 	       "Promisc mode:       %s\n", appl_args->num_rx_q,
 	       (appl_args->in_mode == SCHED_ATOMIC) ? "PKTIN_SCHED_ATOMIC" :
 	       (appl_args->in_mode == SCHED_PARALLEL ? "PKTIN_SCHED_PARALLEL" :
 	       "PKTIN_SCHED_ORDERED"), appl_args->num_flows,
-	       appl_args->extra_rounds, appl_args->promisc_mode ?
+	       appl_args->extra_rounds, appl_args->extra_var, appl_args->promisc_mode ?
 	       "enabled" : "disabled");
 	fflush(NULL);
 }
@@ -212,12 +212,42 @@ static int set_num_cpu(test_global_t *global)
 	return 0;
 }
 
+/* Print memory blocks used by the pool, page size affects TLB usage */
+static void print_pool_mem(const char *name)
+{
+	odp_system_meminfo_t info;
+	int32_t i, num;
+
+	num = odp_system_meminfo(&info, NULL, 0);
+	if (num <= 0)
+		return;
+
+	int32_t max_num = num;
+	odp_system_memblock_t block[max_num];
+
+	num = odp_system_meminfo(&info, block, max_num);
+	if (num > max_num)
+		num = max_num;
+
+	for (i = 0; i < num; i++) {
+		if (strstr(block[i].name, name) == NULL)
+			continue;
+
+		printf("  mem block          %s\n", block[i].name);
+		printf("    used             %" PRIu64 " kB\n", block[i].used / 1024);
+		printf("    page size        %" PRIu64 " kB\n", block[i].page_size / 1024);
+	}
+
+	printf("\n");
+}
+
 static int create_pool(test_global_t *global)
 {
 	odp_pool_capability_t pool_capa;
 	odp_pool_param_t pool_param;
 	odp_pool_t pool;
 	odp_pool_stats_opt_t stats, stats_capa;
+	odp_time_t t1, t2;
 	uint32_t max_num, max_size, min_cache_size, max_cache_size;
 	test_options_t *test_options = &global->test_options;
 	uint32_t num_event  = test_options->num_event;
@@ -324,7 +354,9 @@ static int create_pool(test_global_t *global)
 
 	pool_param.stats.all = stats.all;
 
+	t1 = odp_time_local_strict();
 	pool = odp_pool_create("pool perf", &pool_param);
+	t2 = odp_time_local_strict();
 
 	if (pool == ODP_POOL_INVALID) {
 		printf("Error: Pool create failed.\n");
@@ -333,6 +365,10 @@ static int create_pool(test_global_t *global)
 
 	global->pool = pool;
 
+	printf("  pool create time   %.3f msec\n", odp_time_diff_ns(t2, t1) / 1000000.0);
+
+	print_pool_mem("pool perf");
+
 	return 0;
 }
 
@@ -792,6 +828,7 @@ int main(int argc, char **argv)
 	odph_helper_options_t helper_options;
 	odp_instance_t instance;
 	odp_init_t init;
+	odp_time_startup_t startup;
 	odp_shm_t shm;
 	test_global_t *global;
 	test_common_options_t common_options;
@@ -833,6 +870,10 @@ int main(int argc, char **argv)
 		return -1;
 	}
 
+	odp_time_startup(&startup);
+	printf("\nODP init time: %.3f msec\n",
+	       odp_time_diff_ns(odp_time_global_strict(), startup.global) / 1000000.0);
+
 	shm = odp_shm_reserve("pool_perf_global", sizeof(test_global_t), ODP_CACHE_LINE_SIZE, 0);
 	if (shm == ODP_SHM_INVALID) {
 		ODPH_ERR("Error: Shared mem reserve failed.\n");
@@ -44,6 +44,11 @@
 
 #define MAX_BURST_SIZE 64
 
+/* Timer load resolution and timeout. Timeout is long enough to never expire
+ * during the test. */
+#define TIMER_RES_NS	  ODP_TIME_MSEC_IN_NS
+#define TIMER_TMO_NS	  (3600 * ODP_TIME_SEC_IN_NS)
+
 /** Test event types */
 typedef enum {
 	WARM_UP,  /**< Warm-up event */
@@ -88,8 +93,18 @@ typedef struct {
 	} prio[NUM_PRIOS];
 	odp_bool_t sample_per_prio; /**< Allocate a separate sample for each priority */
 	uint64_t wait_ns;	/**< Number of nsec to wait after scheduling events */
+	uint32_t num_timer;	/**< Number of background timers */
 } test_args_t;
 
+/** Background timer load */
+typedef struct {
+	odp_timer_pool_t tp;	/**< Timer pool */
+	odp_pool_t pool;	/**< Timeout pool */
+	odp_queue_t queue;	/**< Timeout destination queue */
+	odp_timer_t *timer;	/**< Timers */
+	uint32_t num;		/**< Number of allocated timers */
+} timer_load_t;
+
 /** Latency measurements statistics */
 typedef struct {
 	uint64_t events;   /**< Total number of received events */
@@ -845,6 +860,9 @@ static void usage(void)
 	       "               2: ODP_SCHED_SYNC_ORDERED\n"
 	       "  -w, --warm-up <number> Number of warm-up rounds, default=100, min=1\n"
 	       "  -W, --wait-ns <number> Number of nsec to wait per schedule round to simulate work (default=0)\n"
+	       "  -T, --timers <number> Number of background timers (default=0). Timers are started\n"
+	       "                        before the test and do not expire during it, but add load to\n"
+	       "                        timer processing (e.g. inline timer scan in the scheduler).\n"
 	       "  -h, --help   Display help and exit.\n\n");
 }
 
@@ -877,11 +895,12 @@ static void parse_args(int argc, char *argv[], test_args_t *args)
 		{"warm-up", required_argument, NULL, 'w'},
 		{"wait-ns", required_argument, NULL, 'W'},
 		{"sample-per-prio", no_argument, NULL, 'r'},
+		{"timers", required_argument, NULL, 'T'},
 		{"help", no_argument, NULL, 'h'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+c:b:d:f:g:i:l:t:m:n:o:p:s:w:W:rh";
+	static const char *shortopts = "+c:b:d:f:g:i:l:t:m:n:o:p:s:w:W:T:rh";
 
 	args->cpu_count = 1;
 	args->forward_mode = EVENT_FORWARD_RAND;
@@ -965,6 +984,9 @@ static void parse_args(int argc, char *argv[], test_args_t *args)
 		case 'b':
 			args->burst_size = atoi(optarg);
 			break;
+		case 'T':
+			args->num_timer = atoi(optarg);
+			break;
 		case 'h':
 			usage();
 			exit(EXIT_SUCCESS);
@@ -1225,6 +1247,165 @@ static void init_global_data(test_globals_t *globals, test_args_t *args,
 	}
 }
 
+static int create_timers(timer_load_t *tl, uint32_t num)
+{
+	odp_timer_capability_t timer_capa;
+	odp_timer_res_capability_t res_capa;
+	odp_timer_pool_param_t tp_param;
+	odp_pool_param_t pool_param;
+	odp_queue_param_t queue_param;
+	odp_timer_start_t start_param;
+	uint64_t max_tmo;
+
+	if (odp_timer_capability(ODP_CLOCK_DEFAULT, &timer_capa)) {
+		ODPH_ERR("Timer capability failed\n");
+		return -1;
+	}
+
+	if (timer_capa.max_timers && num > timer_capa.max_timers) {
+		ODPH_ERR("Too many timers (max %u)\n", timer_capa.max_timers);
+		return -1;
+	}
+
+	memset(&res_capa, 0, sizeof(odp_timer_res_capability_t));
+	res_capa.res_ns = TIMER_RES_NS;
+	if (odp_timer_res_capability(ODP_CLOCK_DEFAULT, &res_capa)) {
+		ODPH_ERR("Timer resolution capability failed\n");
+		return -1;
+	}
+
+	max_tmo = TIMER_TMO_NS;
+	if (max_tmo > res_capa.max_tmo)
+		max_tmo = res_capa.max_tmo;
+
+	odp_timer_pool_param_init(&tp_param);
+	tp_param.res_ns     = TIMER_RES_NS;
+	tp_param.min_tmo    = res_capa.min_tmo;
+	tp_param.max_tmo    = max_tmo;
+	tp_param.num_timers = num;
+	tp_param.clk_src    = ODP_CLOCK_DEFAULT;
+
+	tl->tp = odp_timer_pool_create("timer_load", &tp_param);
+	if (tl->tp == ODP_TIMER_POOL_INVALID) {
+		ODPH_ERR("Timer pool create failed\n");
+		return -1;
+	}
+
+	if (odp_timer_pool_start_multi(&tl->tp, 1) != 1) {
+		ODPH_ERR("Timer pool start failed\n");
+		return -1;
+	}
+
+	odp_pool_param_init(&pool_param);
+	pool_param.type    = ODP_POOL_TIMEOUT;
+	pool_param.tmo.num = num;
+
+	tl->pool = odp_pool_create("timer_load", &pool_param);
+	if (tl->pool == ODP_POOL_INVALID) {
+		ODPH_ERR("Timeout pool create failed\n");
+		return -1;
+	}
+
+	/* Timeouts are never received, so a plain queue is used when possible
+	 * to keep them out of the scheduler */
+	odp_queue_param_init(&queue_param);
+	if (timer_capa.queue_type_plain) {
+		queue_param.type = ODP_QUEUE_TYPE_PLAIN;
+	} else {
+		queue_param.type = ODP_QUEUE_TYPE_SCHED;
+		queue_param.sched.prio = odp_schedule_min_prio();
+		queue_param.sched.sync = ODP_SCHED_SYNC_PARALLEL;
+		queue_param.sched.group = ODP_SCHED_GROUP_ALL;
+	}
+
+	tl->queue = odp_queue_create("timer_load", &queue_param);
+	if (tl->queue == ODP_QUEUE_INVALID) {
+		ODPH_ERR("Timeout queue create failed\n");
+		return -1;
+	}
+
+	tl->timer = calloc(num, sizeof(odp_timer_t));
+	if (tl->timer == NULL) {
+		ODPH_ERR("Timer table alloc failed\n");
+		return -1;
+	}
+
+	start_param.tick_type = ODP_TIMER_TICK_REL;
+	start_param.tick = odp_timer_ns_to_tick(tl->tp, max_tmo);
+
+	for (uint32_t i = 0; i < num; i++) {
+		odp_timeout_t tmo = odp_timeout_alloc(tl->pool);
+		odp_timer_t timer;
+
+		if (tmo == ODP_TIMEOUT_INVALID) {
+			ODPH_ERR("Timeout alloc failed (%u)\n", i);
+			return -1;
+		}
+
+		timer = odp_timer_alloc(tl->tp, tl->queue, NULL);
+		if (timer == ODP_TIMER_INVALID) {
+			ODPH_ERR("Timer alloc failed (%u)\n", i);
+			odp_timeout_free(tmo);
+			return -1;
+		}
+
+		tl->timer[tl->num++] = timer;
+		start_param.tmo_ev = odp_timeout_to_event(tmo);
+
+		if (odp_timer_start(timer, &start_param) != ODP_TIMER_SUCCESS) {
+			ODPH_ERR("Timer start failed (%u)\n", i);
+			odp_timeout_free(tmo);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int destroy_timers(timer_load_t *tl)
+{
+	int ret = 0;
+
+	for (uint32_t i = 0; i < tl->num; i++) {
+		odp_event_t ev;
+
+		if (odp_timer_cancel(tl->timer[i], &ev) == ODP_TIMER_SUCCESS)
+			odp_event_free(ev);
+
+		if (odp_timer_free(tl->timer[i])) {
+			ODPH_ERR("Timer free failed (%u)\n", i);
+			ret = -1;
+		}
+	}
+
+	free(tl->timer);
+
+	if (tl->queue != ODP_QUEUE_INVALID) {
+		odp_event_t ev;
+
+		/* Drain possible timeouts */
+		while ((ev = odp_queue_deq(tl->queue)) != ODP_EVENT_INVALID)
+			odp_event_free(ev);
+
+		if (odp_queue_destroy(tl->queue)) {
+			ODPH_ERR("Timeout queue destroy failed\n");
+			ret = -1;
+		}
+	}
+
+	if (tl->tp != ODP_TIMER_POOL_INVALID)
+		odp_timer_pool_destroy(tl->tp);
+
+	if (tl->pool != ODP_POOL_INVALID) {
+		if (odp_pool_destroy(tl->pool)) {
+			ODPH_ERR("Timeout pool destroy failed\n");
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
+
 /**
  * Test main function
  */
@@ -1251,6 +1432,8 @@ int main(int argc, char *argv[])
 	odp_shm_t shm = ODP_SHM_INVALID;
 	odp_pool_t pool = ODP_POOL_INVALID;
 	test_common_options_t common_options;
+	timer_load_t timer_load = {.tp = ODP_TIMER_POOL_INVALID, .pool = ODP_POOL_INVALID,
+				   .queue = ODP_QUEUE_INVALID};
 
 	printf("\nODP scheduling latency benchmark starts\n\n");
 
@@ -1315,6 +1498,7 @@ int main(int argc, char *argv[])
 	printf("  Isolated groups:  %i\n", args.isolate);
 	printf("  Number of groups: %i\n", num_group);
 	printf("  Created groups:   %i\n", tot_group);
+	printf("  Timers:           %u\n", args.num_timer);
 	printf("\n");
 
 	shm = odp_shm_reserve("test_globals", sizeof(test_globals_t), ODP_CACHE_LINE_SIZE, 0);
@@ -1371,6 +1555,12 @@ int main(int argc, char *argv[])
 		goto error;
 	}
 
+	if (args.num_timer && create_timers(&timer_load, args.num_timer)) {
+		ODPH_ERR("Creating background timers failed.\n");
+		err = -1;
+		goto error;
+	}
+
 	/* Create and launch worker threads */
 	memset(thread_tbl, 0, sizeof(thread_tbl));
 
@@ -1409,6 +1599,11 @@ int main(int argc, char *argv[])
 	}
 
 error:
+	if (args.num_timer && destroy_timers(&timer_load)) {
+		ODPH_ERR("Background timer destroy failed\n");
+		err = -1;
+	}
+
 	if (destroy_groups(group, tot_group)) {
 		ODPH_ERR("Group destroy failed\n");
 		err = -1;
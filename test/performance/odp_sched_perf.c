@@ -47,6 +47,7 @@ typedef struct test_options_t {
 	uint32_t num_low;
 	uint32_t num_high;
 	uint32_t num_dummy;
+	uint32_t num_prio;
 	uint32_t num_event;
 	uint32_t num_sched;
 	int      num_group;
@@ -77,6 +78,7 @@ typedef struct test_options_t {
 	uint32_t uarea_rw;
 	uint32_t uarea_size;
 	uint64_t wait_ns;
+	uint64_t wait_var_ns;
 	int      verbose;
 
 } test_options_t;
@@ -217,6 +219,8 @@ static void print_usage(void)
 	       "  -L, --num_low          Number of lowest priority queues. Default: 0.\n"
 	       "  -H, --num_high         Number of highest priority queues. Default: 0.\n"
 	       "  -d, --num_dummy        Number of empty queues. Default: 0.\n"
+	       "  -r, --num_prio         Number of priority levels to divide default priority queues into, starting\n"
+	       "                         from the lowest priority. Default: 1 (all queues use the default priority).\n"
 	       "  -e, --num_event        Number of events per queue. Default: 100.\n"
 	       "  -s, --num_sched        Number of events to schedule per thread. If zero, the application runs\n"
 	       "                         until SIGINT is received. Default: 100 000.\n"
@@ -242,6 +246,9 @@ static void print_usage(void)
 	       "                            queues is N * (num_def + num_low + num_high).\n"
 	       "  -F, --fairness         0: Don't count events per queue, 1: Count and report events relative to average. Default: 0.\n"
 	       "  -w, --wait_ns          Number of nsec to wait before enqueueing events. Default: 0.\n"
+	       "  -W, --wait_var_ns      Maximum number of nsec to wait in addition to wait_ns. The additional wait time\n"
+	       "                         is selected randomly per schedule call, which emulates variable cost processing\n"
+	       "                         (e.g. with ordered queues). Default: 0.\n"
 	       "  -S, --stress           CPU stress function(s) to be called for each event data word (requires -n or -m).\n"
 	       "                         Data is processed as uint32_t words. Multiple flags may be selected.\n"
 	       "                         0:   No extra data processing (default)\n"
@@ -275,6 +282,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{"num_low",      required_argument, NULL, 'L'},
 		{"num_high",     required_argument, NULL, 'H'},
 		{"num_dummy",    required_argument, NULL, 'd'},
+		{"num_prio",     required_argument, NULL, 'r'},
 		{"num_event",    required_argument, NULL, 'e'},
 		{"num_sched",    required_argument, NULL, 's'},
 		{"num_group",    required_argument, NULL, 'g'},
@@ -286,6 +294,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{"forward",      required_argument, NULL, 'f'},
 		{"fairness",     required_argument, NULL, 'F'},
 		{"wait_ns",      required_argument, NULL, 'w'},
+		{"wait_var_ns",  required_argument, NULL, 'W'},
 		{"stress",       required_argument, NULL, 'S'},
 		{"ctx_rd_words", required_argument, NULL, 'k'},
 		{"ctx_rw_words", required_argument, NULL, 'l'},
@@ -300,13 +309,14 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+c:q:L:H:d:e:s:g:j:b:C:t:T:f:F:w:S:k:l:n:m:p:P:u:U:vh";
+	static const char *shortopts = "+c:q:L:H:d:r:e:s:g:j:b:C:t:T:f:F:w:W:S:k:l:n:m:p:P:u:U:vh";
 
 	test_options->num_cpu    = 1;
 	test_options->num_def    = 1;
 	test_options->num_event  = 100;
 	test_options->num_sched  = 100000;
 	test_options->max_burst  = 100;
+	test_options->num_prio   = 1;
 
 	while (1) {
 		opt = getopt_long(argc, argv, shortopts, longopts, NULL);
@@ -330,6 +340,9 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		case 'd':
 			test_options->num_dummy = atoi(optarg);
 			break;
+		case 'r':
+			test_options->num_prio = atoi(optarg);
+			break;
 		case 'e':
 			test_options->num_event = atoi(optarg);
 			break;
@@ -391,6 +404,9 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		case 'w':
 			test_options->wait_ns = atoll(optarg);
 			break;
+		case 'W':
+			test_options->wait_var_ns = atoll(optarg);
+			break;
 		case 'v':
 			test_options->verbose = 1;
 			break;
@@ -557,6 +573,7 @@ static void print_options(test_options_t *options)
 	printf("  num lowest prio queues    %u\n", options->num_low);
 	printf("  num highest prio queues   %u\n", options->num_high);
 	printf("  num empty queues          %u\n", options->num_dummy);
+	printf("  num default prio levels   %u\n", options->num_prio);
 	printf("  total queues              %u\n", options->tot_queue);
 	printf("  num groups                %i", options->num_group);
 
@@ -570,6 +587,7 @@ static void print_options(test_options_t *options)
 	printf("  num join                  %u\n", options->num_join);
 	printf("  forward events            %i\n", options->forward);
 	printf("  wait                      %" PRIu64 " nsec\n", options->wait_ns);
+	printf("  wait variation            %" PRIu64 " nsec\n", options->wait_var_ns);
 	printf("  events per queue          %u\n", options->num_event);
 	printf("  queue size                %u\n", options->queue_size);
 	printf("  max burst size            %u\n", options->max_burst);
@@ -879,7 +897,7 @@ static int set_queue_contexts(test_global_t *global, uint8_t *ctx)
 }
 
 static int create_queues(test_global_t *global, odp_queue_param_t *queue_param, int num_groups,
-			 odp_queue_t queue[], uint32_t num)
+			 uint32_t num_prio, odp_queue_t queue[], uint32_t num)
 {
 	static uint32_t total_queues;
 
@@ -887,6 +905,9 @@ static int create_queues(test_global_t *global, odp_queue_param_t *queue_param,
 		if (num_groups > 0) /* Divide all queues evenly into groups */
 			queue_param->sched.group = global->group[(total_queues + i) % num_groups];
 
+		if (num_prio > 1) /* Divide queues evenly into priority levels */
+			queue_param->sched.prio = odp_schedule_min_prio() + (i % num_prio);
+
 		queue[i] = odp_queue_create(NULL, queue_param);
 
 		if (queue[i] == ODP_QUEUE_INVALID) {
@@ -936,6 +957,12 @@ static int create_all_queues(test_global_t *global)
 		return -1;
 	}
 
+	if (test_options->num_prio == 0 || (int)test_options->num_prio > odp_schedule_num_prio()) {
+		ODPH_ERR("Bad number of priority levels %u (max %i)\n", test_options->num_prio,
+			 odp_schedule_num_prio());
+		return -1;
+	}
+
 	if (global->schedule_config.queue_size &&
 	    queue_size > global->schedule_config.queue_size) {
 		ODPH_ERR("Max queue size %u\n", global->schedule_config.queue_size);
@@ -963,7 +990,7 @@ static int create_all_queues(test_global_t *global)
 	first = test_options->num_dummy;
 
 	/* Dummy queues */
-	if (create_queues(global, &queue_param, num_group, global->queue.dummy,
+	if (create_queues(global, &queue_param, num_group, 1, global->queue.dummy,
 			  test_options->num_dummy)) {
 		ODPH_ERR("Dummy queue create failed\n");
 		return -1;
@@ -971,21 +998,23 @@ static int create_all_queues(test_global_t *global)
 
 	/* Lowest priority queues */
 	queue_param.sched.prio = odp_schedule_min_prio();
-	if (create_queues(global, &queue_param, num_group, global->queue.low_prio, num_low)) {
+	if (create_queues(global, &queue_param, num_group, 1, global->queue.low_prio, num_low)) {
 		ODPH_ERR("Lowest priority queue create failed\n");
 		return -1;
 	}
 
 	/* Highest priority queues */
 	queue_param.sched.prio = odp_schedule_max_prio();
-	if (create_queues(global, &queue_param, num_group, global->queue.high_prio, num_high)) {
+	if (create_queues(global, &queue_param, num_group, 1, global->queue.high_prio,
+			  num_high)) {
 		ODPH_ERR("Highest priority queue create failed\n");
 		return -1;
 	}
 
 	/* Default priority queues */
 	queue_param.sched.prio = odp_schedule_default_prio();
-	if (create_queues(global, &queue_param, num_group, global->queue.def_prio, num_default)) {
+	if (create_queues(global, &queue_param, num_group, test_options->num_prio,
+			  global->queue.def_prio, num_default)) {
 		ODPH_ERR("Default priority queue create failed\n");
 		return -1;
 	}
@@ -1072,6 +1101,14 @@ static int schedule_config(test_global_t *global)
 
 	odp_schedule_config_init(&global->schedule_config);
 	odp_schedule_group_param_init(&group_param);
+
+	if (test_options->tot_queue > global->schedule_config.num_queues) {
+		ODPH_ERR("Max queues supported %u\n", global->schedule_config.num_queues);
+		return -1;
+	}
+
+	/* Request only the required number of queues */
+	global->schedule_config.num_queues = test_options->tot_queue;
 	group_param.cache_stash_hints.common = test_options->cache_stash_config;
 
 	if (test_options->num_group == -1)
@@ -1322,6 +1359,14 @@ static uint64_t rw_data_stress(odp_event_t ev[], int num, uint32_t rd_words, uin
 	return sum;
 }
 
+/* Random additional wait time in range [0, max_ns] */
+static inline uint64_t wait_var(uint64_t *seed, uint64_t max_ns)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	return (*seed >> 32) % (max_ns + 1);
+}
+
 static int test_sched(void *arg)
 {
 	int num, num_enq, ret, thr;
@@ -1358,9 +1403,12 @@ static int test_sched(void *arg)
 	uint64_t ctx_sum = 0;
 	uint64_t uarea_sum = 0;
 	uint64_t wait_ns = test_options->wait_ns;
+	uint64_t wait_var_ns = test_options->wait_var_ns;
+	uint64_t seed;
 	odp_event_t ev[max_burst];
 
 	thr = odp_thread_id();
+	seed = thr;
 
 	if (forward || fairness)
 		ctx_offset = ODPH_ROUNDUP_MULTIPLE(sizeof(queue_context_t), 8);
@@ -1450,9 +1498,12 @@ static int test_sched(void *arg)
 				}
 			}
 
-			if (odp_unlikely(wait_ns)) {
+			if (odp_unlikely(wait_ns || wait_var_ns)) {
 				waits++;
-				odp_time_wait_ns(wait_ns);
+				if (wait_var_ns)
+					odp_time_wait_ns(wait_ns + wait_var(&seed, wait_var_ns));
+				else
+					odp_time_wait_ns(wait_ns);
 			}
 
 			if (num_prefetch)
@@ -1648,7 +1699,8 @@ static int output_results(test_global_t *global)
 	double waits_ave, wait_cycles, wait_cycles_ave;
 	test_options_t *test_options = &global->test_options;
 	int num_cpu = test_options->num_cpu;
-	uint64_t wait_ns = test_options->wait_ns;
+	/* Average wait time per round */
+	uint64_t wait_ns = test_options->wait_ns + test_options->wait_var_ns / 2;
 	uint64_t rounds_sum = 0;
 	uint64_t enqueues_sum = 0;
 	uint64_t events_sum = 0;
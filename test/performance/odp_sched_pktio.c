@@ -49,6 +49,7 @@ typedef struct test_options_t {
 	int pipe_queues;
 	uint32_t pipe_queue_size;
 	uint8_t collect_stat;
+	uint8_t flow_aware;
 	uint32_t wait_sec;
 	char pktio_name[MAX_PKTIOS][MAX_PKTIO_NAME + 1];
 
@@ -135,6 +136,9 @@ typedef struct {
 	uint64_t rx_pkt_sum;
 	uint64_t tx_pkt_sum;
 
+	/* Number of flows in flow aware mode, 0 otherwise */
+	uint32_t num_flows;
+
 	odp_schedule_config_t schedule_config;
 
 } test_global_t;
@@ -291,6 +295,29 @@ static inline void enqueue_events(odp_queue_t dst_queue, odp_event_t ev[],
 		test_global->worker_stat[worker_id].pipe_drop += drop;
 }
 
+/* Select flow ID for a packet. Packet flow hash is used when available. Otherwise,
+ * IPv4 addresses and L4 ports are hashed. Packets are expected to have an Ethernet
+ * header without VLAN tags and an IPv4 header without options. */
+static inline uint32_t packet_flow_id(odp_packet_t pkt, uint32_t num_flows)
+{
+	uint32_t seg_len;
+	const uint8_t *data;
+	const odph_ethhdr_t *eth;
+
+	if (odp_packet_has_flow_hash(pkt))
+		return odp_packet_flow_hash(pkt) % num_flows;
+
+	data = odp_packet_data_seg_len(pkt, &seg_len);
+	eth = (const odph_ethhdr_t *)data;
+
+	if (seg_len < ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN + 4 ||
+	    eth->type != odp_cpu_to_be_16(ODPH_ETHTYPE_IPV4))
+		return 0;
+
+	/* Source and destination addresses, and the following L4 ports */
+	return odp_hash_crc32c(data + ODPH_ETHHDR_LEN + 12, 12, 0) % num_flows;
+}
+
 static inline odp_queue_t next_queue(test_global_t *test_global, int input,
 				     uint16_t stage, uint16_t queue_idx)
 {
@@ -311,6 +338,7 @@ static int worker_thread_pipeline(void *arg)
 	int pipe_queues = test_global->opt.pipe_queues;
 	int num_pktio = test_global->opt.num_pktio;
 	int num_pktio_queue = test_global->opt.num_pktio_queue;
+	uint32_t num_flows = test_global->num_flows;
 	uint32_t polls = 0;
 	int burst_size = test_global->opt.burst_size;
 
@@ -354,6 +382,16 @@ static int worker_thread_pipeline(void *arg)
 				test_global->worker_stat[worker_id].rx_pkt +=
 					num_pkt;
 
+			/* In flow aware mode, atomicity of pipeline queues is
+			 * maintained per flow */
+			if (num_flows) {
+				for (i = 0; i < num_pkt; i++) {
+					odp_packet_t p = odp_packet_from_event(ev[i]);
+
+					odp_event_flow_id_set(ev[i], packet_flow_id(p, num_flows));
+				}
+			}
+
 			/* The first stage (packet input). Forward packet flows
 			 * into first pipeline queues. */
 			if (pipe_queues > num_pktio_queue) {
@@ -580,6 +618,9 @@ static void print_usage(const char *progname)
 	       "  --pipe-queues <number>    Number of queues per pipeline stage\n"
 	       "  --pipe-queue-size <num>   Number of events a pipeline queue must be able to store. Default 256.\n"
 	       "  -m, --sched_mode <mode>   Scheduler synchronization mode for all queues. 1: parallel, 2: atomic, 3: ordered. Default: 2\n"
+	       "  -f, --flow_aware          Enable flow aware scheduling mode with the maximum number of flows.\n"
+	       "                            Pktin queues use packet flow hash as flow ID. Pipeline stages set\n"
+	       "                            flow ID from packet flow hash or IPv4 address and port hash.\n"
 	       "  --wait_link <sec>         Wait up to <sec> seconds for network links to be up.\n"
 	       "                            Default: 0 (don't check link status)\n"
 	       "  -s, --stat                Collect statistics.\n"
@@ -599,6 +640,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{"burst",       required_argument, NULL, 'b'},
 		{"timeout",     required_argument, NULL, 't'},
 		{"sched_mode",  required_argument, NULL, 'm'},
+		{"flow_aware",  no_argument,       NULL, 'f'},
 		{"wait_link",   required_argument, NULL, OPT_WAIT_LINK},
 		{"pipe-stages", required_argument, NULL,  0},
 		{"pipe-queues", required_argument, NULL,  1},
@@ -607,7 +649,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{"help",        no_argument,       NULL, 'h'},
 		{NULL, 0, NULL, 0}
 	};
-	const char *shortopts =  "+i:c:q:b:t:m:sh";
+	const char *shortopts =  "+i:c:q:b:t:m:fsh";
 	int ret = 0;
 
 	memset(test_options, 0, sizeof(test_options_t));
@@ -679,6 +721,9 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		case 'm':
 			test_options->sched_mode = atoi(optarg);
 			break;
+		case 'f':
+			test_options->flow_aware = 1;
+			break;
 		case OPT_WAIT_LINK:
 			test_options->wait_sec = atoi(optarg);
 			break;
@@ -700,6 +745,11 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		ret = -1;
 	}
 
+	if (test_options->timeout_us && test_options->flow_aware) {
+		printf("Error: Cannot run timeout test in flow aware mode\n");
+		ret = -1;
+	}
+
 	if (test_options->pipe_stages > MAX_PIPE_STAGES) {
 		printf("Error: Too many pipeline stages\n");
 		ret = -1;
@@ -766,7 +816,28 @@ static int config_setup(test_global_t *test_global)
 	}
 
 	odp_schedule_config_init(&test_global->schedule_config);
-	odp_schedule_config(&test_global->schedule_config);
+
+	if (test_global->opt.flow_aware) {
+		odp_schedule_capability_t sched_capa;
+
+		if (odp_schedule_capability(&sched_capa)) {
+			printf("Error: Schedule capability failed.\n");
+			return -1;
+		}
+
+		if (sched_capa.max_flow_id == 0) {
+			printf("Error: Flow aware scheduling not supported.\n");
+			return -1;
+		}
+
+		test_global->schedule_config.max_flow_id = sched_capa.max_flow_id;
+		test_global->num_flows = sched_capa.max_flow_id + 1;
+	}
+
+	if (odp_schedule_config(&test_global->schedule_config)) {
+		printf("Error: Schedule config failed.\n");
+		return -1;
+	}
 
 	if (odp_pool_capability(&pool_capa)) {
 		printf("Error: Pool capability failed.\n");
@@ -825,6 +896,8 @@ static void print_config(test_global_t *test_global)
 	printf("  burst size:            %u\n", test_global->opt.burst_size);
 	printf("  collect statistics:    %u\n", test_global->opt.collect_stat);
 	printf("  timeout usec:          %li\n", test_global->opt.timeout_us);
+	printf("  flow aware:            %u (%u flows)\n", test_global->opt.flow_aware,
+	       test_global->num_flows);
 
 	printf("\n");
 }
@@ -968,7 +1041,8 @@ static int open_pktios(test_global_t *test_global)
 		pktin_param.queue_param.sched.sync  = sched_sync;
 		pktin_param.queue_param.sched.group = ODP_SCHED_GROUP_ALL;
 
-		if (num_queue > 1) {
+		/* Flow hash is used as flow ID in flow aware mode */
+		if (num_queue > 1 || test_global->opt.flow_aware) {
 			pktin_param.hash_enable = 1;
 			pktin_param.hash_proto.proto.ipv4_udp = 1;
 		}
@@ -1006,7 +1080,8 @@ static int open_pktios(test_global_t *test_global)
 		pktout_param.num_queues  = num_queue;
 		pktout_param.op_mode     = ODP_PKTIO_OP_MT_UNSAFE;
 
-		if (test_global->opt.pipe_stages)
+		/* Flows of a pktin queue may be sent concurrently in flow aware mode */
+		if (test_global->opt.pipe_stages || test_global->opt.flow_aware)
 			pktout_param.op_mode = ODP_PKTIO_OP_MT;
 
 		if (odp_pktout_queue_config(pktio, &pktout_param)) {
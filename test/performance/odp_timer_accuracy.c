@@ -136,6 +136,7 @@ typedef struct test_global_t {
 	odp_atomic_u64_t events;
 	odp_atomic_u64_t last_events;
 	test_common_options_t common_options;
+	odp_bool_t       timer_stats;
 } test_global_t;
 
 static void print_usage(void)
@@ -674,6 +675,7 @@ static int create_timers(test_global_t *test_global)
 	}
 
 	max_timers = timer_capa.max_timers;
+	test_global->timer_stats = timer_capa.stats;
 
 	if (mode == MODE_PERIODIC) {
 		if (timer_capa.periodic.support.base_mul == 0) {
@@ -826,6 +828,12 @@ static int start_timers(test_global_t *test_global)
 	timer_pool = test_global->timer_pool;
 	idx = 0;
 
+	/* Collect timer pool statistics only from the test */
+	if (test_global->timer_stats && odp_timer_pool_stats_reset(timer_pool)) {
+		ODPH_ERR("Timer pool statistics reset failed\n");
+		return -1;
+	}
+
 	/* Record test start time and tick. Memory barriers forbid compiler and out-of-order
 	 * CPU to move samples apart. */
 	odp_mb_full();
@@ -960,6 +968,47 @@ static void print_nsec_error(const char *str, int64_t nsec, double res_ns,
 	printf("\n");
 }
 
+static void print_timer_pool_hist(const char *str, const uint64_t hist[])
+{
+	printf("  %s:\n", str);
+
+	for (int i = 0; i < ODP_TIMER_POOL_STATS_HIST_SIZE; i++) {
+		uint64_t limit = UINT64_C(2) << i;
+
+		if (hist[i] == 0)
+			continue;
+
+		if (i == ODP_TIMER_POOL_STATS_HIST_SIZE - 1)
+			printf("         >= %12" PRIu64 ": %12" PRIu64 "\n", limit / 2, hist[i]);
+		else
+			printf("         <  %12" PRIu64 ": %12" PRIu64 "\n", limit, hist[i]);
+	}
+}
+
+static void print_timer_pool_stats(test_global_t *test_global)
+{
+	odp_timer_pool_stats_t stats;
+
+	if (!test_global->timer_stats)
+		return;
+
+	if (odp_timer_pool_stats(test_global->timer_pool, &stats)) {
+		ODPH_ERR("Timer pool statistics read failed\n");
+		return;
+	}
+
+	printf("Timer pool statistics:\n");
+	printf("  scans:           %12" PRIu64 "\n", stats.scans);
+	printf("  missed scans:    %12" PRIu64 "\n", stats.missed_scans);
+	printf("  expired:         %12" PRIu64 "\n", stats.expired);
+	printf("  max scan (nsec): %12" PRIu64 "\n", stats.scan_ns_max);
+	printf("  max late (nsec): %12" PRIu64 "\n", stats.late_ns_max);
+	print_timer_pool_hist("scan duration (nsec)", stats.hist.scan_ns);
+	print_timer_pool_hist("expired per scan", stats.hist.expired);
+	print_timer_pool_hist("expiration lateness (nsec)", stats.hist.late_ns);
+	printf("\n");
+}
+
 static int print_stat(test_global_t *test_global)
 {
 	test_stat_t test_stat;
@@ -1093,6 +1142,8 @@ static int print_stat(test_global_t *test_global)
 
 	printf("\n");
 
+	print_timer_pool_stats(test_global);
+
 	if (test_global->common_options.is_export) {
 		if (test_common_write("num after,num before,num exact,num retry,"
 				      "error after min (nsec),error after min resolution,"
@@ -25,9 +25,11 @@
 #define MODE_START_CANCEL 1
 #define MODE_START_EXPIRE 2
 #define MODE_TP_CTRL      3
+#define MODE_RESTART      4
 #define MAX_TIMER_POOLS   32
 #define MAX_TIMERS        10000
 #define START_NS          (100 * ODP_TIME_MSEC_IN_NS)
+#define MAX_BURST         64
 
 typedef struct test_options_t {
 	uint32_t num_cpu;
@@ -37,6 +39,7 @@ typedef struct test_options_t {
 	uint64_t period_ns;
 	int      shared;
 	int      mode;
+	uint32_t burst;
 	uint64_t test_rounds;
 
 } test_options_t;
@@ -170,9 +173,14 @@ static void print_usage(void)
 	       "                           3: Measure timer pool create/start/destroy and timer alloc/free\n"
 	       "                              performance. Does not measure actual timer usage (start/expire).\n"
 	       "                              Requires num timer pools (-n) >= num CPUs (-c).\n"
+	       "                           4: Measure timer restart performance\n"
+	       "  -b, --burst            Number of timers per start, restart and cancel call in modes 1 and 4.\n"
+	       "                         Values larger than 1 use odp_timer_start_multi(),\n"
+	       "                         odp_timer_restart_multi() and odp_timer_cancel_multi(). Max %i.\n"
+	       "                         Default: 1\n"
 	       "  -R, --rounds           Number of test rounds. Default value is 50 for mode 3, otherwise 100000.\n"
 	       "  -h, --help             This help\n"
-	       "\n");
+	       "\n", MAX_BURST);
 }
 
 static int parse_options(int argc, char *argv[], test_options_t *test_options)
@@ -188,12 +196,13 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{"period_ns", required_argument, NULL, 'p'},
 		{"shared",    required_argument, NULL, 's'},
 		{"mode",      required_argument, NULL, 'm'},
+		{"burst",     required_argument, NULL, 'b'},
 		{"rounds",    required_argument, NULL, 'R'},
 		{"help",      no_argument,       NULL, 'h'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+c:n:t:r:p:s:m:R:h";
+	static const char *shortopts = "+c:n:t:r:p:s:m:b:R:h";
 
 	test_options->num_cpu   = 1;
 	test_options->num_tp    = 1;
@@ -202,6 +211,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 	test_options->period_ns = 100 * ODP_TIME_MSEC_IN_NS;
 	test_options->shared    = 1;
 	test_options->mode      = 0;
+	test_options->burst     = 1;
 	test_options->test_rounds = 0;
 
 	while (1) {
@@ -232,6 +242,9 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		case 'm':
 			test_options->mode = atoi(optarg);
 			break;
+		case 'b':
+			test_options->burst = atoi(optarg);
+			break;
 		case 'R':
 			test_options->test_rounds = atoll(optarg);
 			break;
@@ -249,11 +262,16 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		ret = -1;
 	}
 
-	if (test_options->mode < 0 || test_options->mode > MODE_TP_CTRL) {
+	if (test_options->mode < 0 || test_options->mode > MODE_RESTART) {
 		ODPH_ERR("Invalid mode %i\n", test_options->mode);
 		ret = -1;
 	}
 
+	if (test_options->burst < 1 || test_options->burst > MAX_BURST) {
+		ODPH_ERR("Invalid burst size %u\n", test_options->burst);
+		ret = -1;
+	}
+
 	if (test_options->test_rounds == 0) {
 		/* Set default rounds */
 		test_options->test_rounds = 100000;
@@ -365,6 +383,8 @@ static int prepare_timer_pool_param(test_global_t *global, odp_timer_pool_param_
 	printf("  private pool     %i\n", priv);
 	printf("  num timer pool   %u\n", num_tp);
 	printf("  num timer        %u\n", num_timer);
+	if (mode == MODE_START_CANCEL || mode == MODE_RESTART)
+		printf("  burst size       %u\n", test_options->burst);
 	printf("  resolution       %" PRIu64 " nsec\n", res_ns);
 	printf("  period           %" PRIu64 " nsec\n", period_ns);
 	printf("  max timeout      %" PRIu64 " nsec\n", max_tmo_ns);
@@ -781,6 +801,168 @@ static int cancel_timers(test_global_t *global, uint32_t worker_idx)
 	return ret;
 }
 
+/* Cancel worker's timers of a timer pool with odp_timer_cancel_multi(). Timeout events are
+ * stored into ev_tbl, ODP_EVENT_INVALID for timers that could not be cancelled. */
+static int cancel_multi(test_global_t *global, uint32_t tp_idx, uint32_t worker_idx,
+			odp_event_t ev_tbl[], uint64_t *num_cancel)
+{
+	odp_timer_t timer[MAX_BURST];
+	odp_event_t ev[MAX_BURST];
+	uint32_t idx[MAX_BURST];
+	uint32_t j;
+	int k, num, status;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_timer = test_options->num_timer;
+	uint32_t num_worker = test_options->num_cpu;
+	int burst = test_options->burst;
+
+	j = worker_idx;
+
+	while (j < num_timer) {
+		num = 0;
+
+		for (; j < num_timer && num < burst; j += num_worker) {
+			ev_tbl[j] = ODP_EVENT_INVALID;
+
+			if (global->timer[tp_idx][j] == ODP_TIMER_INVALID)
+				continue;
+
+			timer[num] = global->timer[tp_idx][j];
+			idx[num] = j;
+			num++;
+		}
+
+		k = 0;
+		while (k < num) {
+			status = odp_timer_cancel_multi(&timer[k], &ev[k], num - k);
+
+			if (odp_unlikely(status == ODP_TIMER_TOO_NEAR)) {
+				ev[k] = ODP_EVENT_INVALID;
+				k++;
+				continue;
+			} else if (odp_unlikely(status <= 0)) {
+				ODPH_ERR("Timer (%u/%u) cancel failed (ret %i)\n", tp_idx, idx[k],
+					 status);
+				return -1;
+			}
+
+			k += status;
+		}
+
+		for (k = 0; k < num; k++)
+			ev_tbl[idx[k]] = ev[k];
+
+		*num_cancel += num;
+	}
+
+	return 0;
+}
+
+/* Start worker's timers of a timer pool with odp_timer_start_multi() */
+static int start_multi(test_global_t *global, uint32_t tp_idx, uint32_t worker_idx, uint64_t tick,
+		       const odp_event_t ev_tbl[], uint64_t *num_start)
+{
+	odp_timer_t timer[MAX_BURST];
+	odp_timer_start_t start_param[MAX_BURST];
+	uint32_t j;
+	int num, status;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_timer = test_options->num_timer;
+	uint32_t num_worker = test_options->num_cpu;
+	uint64_t period_tick = global->timer_pool[tp_idx].period_tick;
+	int burst = test_options->burst;
+
+	j = worker_idx;
+
+	while (j < num_timer) {
+		num = 0;
+
+		for (; j < num_timer && num < burst; j += num_worker) {
+			if (ev_tbl[j] == ODP_EVENT_INVALID ||
+			    global->timer[tp_idx][j] == ODP_TIMER_INVALID)
+				continue;
+
+			timer[num] = global->timer[tp_idx][j];
+			start_param[num].tick_type = ODP_TIMER_TICK_ABS;
+			start_param[num].tick = tick + j * period_tick;
+			start_param[num].tmo_ev = ev_tbl[j];
+			num++;
+		}
+
+		if (num == 0)
+			continue;
+
+		status = odp_timer_start_multi(timer, start_param, num);
+		if (status > 0)
+			*num_start += status;
+
+		if (odp_unlikely(status != num)) {
+			ODPH_ERR("Timer start multi failed (ret %i, num %i)\n", status, num);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/* Restart worker's timers of a timer pool. Timers that have expired already are skipped, those
+ * are started again when the timeout is received. */
+static int restart_timers(test_global_t *global, uint32_t tp_idx, uint32_t worker_idx,
+			  uint64_t tick, uint64_t *num_restart)
+{
+	odp_timer_t timer[MAX_BURST];
+	odp_timer_start_t start_param[MAX_BURST];
+	uint32_t j;
+	int k, num, status;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_timer = test_options->num_timer;
+	uint32_t num_worker = test_options->num_cpu;
+	uint64_t period_tick = global->timer_pool[tp_idx].period_tick;
+	int burst = test_options->burst;
+
+	j = worker_idx;
+
+	while (j < num_timer) {
+		num = 0;
+
+		for (; j < num_timer && num < burst; j += num_worker) {
+			if (global->timer[tp_idx][j] == ODP_TIMER_INVALID)
+				continue;
+
+			timer[num] = global->timer[tp_idx][j];
+			start_param[num].tick_type = ODP_TIMER_TICK_ABS;
+			start_param[num].tick = tick + j * period_tick;
+			start_param[num].tmo_ev = ODP_EVENT_INVALID;
+			num++;
+		}
+
+		k = 0;
+		while (k < num) {
+			if (burst == 1)
+				status = odp_timer_restart(timer[k], &start_param[k]);
+			else
+				status = odp_timer_restart_multi(&timer[k], &start_param[k],
+								 num - k);
+
+			if (odp_unlikely(status == ODP_TIMER_FAIL)) {
+				/* Expired already */
+				k++;
+				continue;
+			} else if (odp_unlikely(status < 0)) {
+				ODPH_ERR("Timer (%u) restart failed (ret %i)\n", tp_idx, status);
+				return -1;
+			}
+
+			/* odp_timer_restart() returns zero on success */
+			status = burst == 1 ? 1 : status;
+			*num_restart += status;
+			k += status;
+		}
+	}
+
+	return 0;
+}
+
 static int start_cancel_mode_worker(void *arg)
 {
 	uint64_t tick, start_tick, period_tick, nsec;
@@ -807,6 +989,8 @@ static int start_cancel_mode_worker(void *arg)
 	uint64_t num_start = 0;
 	uint64_t cancel_cycles = 0, start_cycles = 0;
 	odp_event_t ev_tbl[MAX_TIMERS];
+	int restart = test_options->mode == MODE_RESTART;
+	uint32_t burst = test_options->burst;
 
 	thr = odp_thread_id();
 	worker_idx = thread_arg->worker_idx;
@@ -874,6 +1058,31 @@ static int start_cancel_mode_worker(void *arg)
 			tick = odp_timer_current_tick(tp) + start_tick;
 			c1 = odp_cpu_cycles();
 
+			if (restart) {
+				if (restart_timers(global, i, worker_idx, tick, &num_start))
+					ret = -1;
+
+				c2 = odp_cpu_cycles();
+				start_cycles += odp_cpu_cycles_diff(c2, c1);
+				continue;
+			}
+
+			if (burst > 1) {
+				if (cancel_multi(global, i, worker_idx, ev_tbl, &num_cancel))
+					ret = -1;
+
+				c2 = odp_cpu_cycles();
+				cancel_cycles += odp_cpu_cycles_diff(c2, c1);
+				c1 = c2;
+
+				if (start_multi(global, i, worker_idx, tick, ev_tbl, &num_start))
+					ret = -1;
+
+				c2 = odp_cpu_cycles();
+				start_cycles += odp_cpu_cycles_diff(c2, c1);
+				continue;
+			}
+
 			for (j = worker_idx; j < num_timer; j += num_worker) {
 				ev_tbl[j] = ODP_EVENT_INVALID;
 
@@ -925,6 +1134,9 @@ static int start_cancel_mode_worker(void *arg)
 			start_cycles += odp_cpu_cycles_diff(c2, c1);
 		}
 
+		if (odp_unlikely(ret))
+			break;
+
 		if (test_rounds) {
 			test_rounds--;
 			if (test_rounds == 0)
@@ -1254,7 +1466,8 @@ static int start_workers(test_global_t *global, odp_instance_t instance)
 
 		if (test_options->mode == MODE_SCHED_OVERH)
 			thr_param[i].start = sched_mode_worker;
-		else if (test_options->mode == MODE_START_CANCEL)
+		else if (test_options->mode == MODE_START_CANCEL ||
+			 test_options->mode == MODE_RESTART)
 			thr_param[i].start = start_cancel_mode_worker;
 		else if (test_options->mode == MODE_TP_CTRL)
 			thr_param[i].start = timer_pool_ctrl_mode_worker;
@@ -1364,31 +1577,38 @@ static void print_stat_start_cancel_mode(test_global_t *global)
 {
 	int i;
 	test_stat_sum_t *sum = &global->stat_sum;
+	test_options_t *test_options = &global->test_options;
+	int restart = test_options->mode == MODE_RESTART;
+	int multi = test_options->burst > 1;
 	double start_ave = 0.0;
 	int num = 0;
 
 	printf("\n");
 	printf("RESULTS\n");
-	printf("odp_timer_cancel() cycles per thread:\n");
-	printf("-------------------------------------------------\n");
-	printf("        1      2      3      4      5      6      7      8      9     10");
 
-	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
-		const test_stat_t *si = &global->stat[i];
+	if (!restart) {
+		printf("odp_timer_cancel%s() cycles per thread:\n", multi ? "_multi" : "");
+		printf("-------------------------------------------------\n");
+		printf("        1      2      3      4      5      6      7      8      9     10");
 
-		if (si->cancels) {
-			if ((num % 10) == 0)
-				printf("\n   ");
+		for (i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+			const test_stat_t *si = &global->stat[i];
 
-			printf("%6.1f ", (double)si->cycles_0 / si->cancels);
-			num++;
+			if (si->cancels) {
+				if ((num % 10) == 0)
+					printf("\n   ");
+
+				printf("%6.1f ", (double)si->cycles_0 / si->cancels);
+				num++;
+			}
 		}
-	}
 
-	printf("\n\n");
+		printf("\n\n");
+	}
 
 	num = 0;
-	printf("odp_timer_start() cycles per thread:\n");
+	printf("odp_timer_%s%s() cycles per thread:\n", restart ? "restart" : "start",
+	       multi ? "_multi" : "");
 	printf("-------------------------------------------------\n");
 	printf("        1      2      3      4      5      6      7      8      9     10");
 
@@ -1411,6 +1631,15 @@ static void print_stat_start_cancel_mode(test_global_t *global)
 	printf("TOTAL (%i workers)\n", sum->num);
 	printf("  rounds:              %" PRIu64 "\n", sum->rounds);
 	printf("  timeouts:            %" PRIu64 "\n", sum->events);
+	if (restart) {
+		printf("  timer restarts:      %" PRIu64 "\n", sum->starts);
+		printf("  ave time:            %.2f sec\n", sum->time_ave);
+		printf("  restarts per cpu:    %.2fM per sec\n",
+		       (start_ave / sum->time_ave) / 1000000.0);
+		printf("\n");
+		return;
+	}
+
 	printf("  timer cancels:       %" PRIu64 "\n", sum->cancels);
 	printf("  cancels failed:      %" PRIu64 "\n", sum->cancels - sum->starts);
 	printf("  timer starts:        %" PRIu64 "\n", sum->starts);
@@ -1701,7 +1930,7 @@ int main(int argc, char **argv)
 				ODPH_ERR("Sched_mode_worker failed\n");
 				return -1;
 			}
-		} else if (mode == MODE_START_CANCEL) {
+		} else if (mode == MODE_START_CANCEL || mode == MODE_RESTART) {
 			if (start_cancel_mode_worker(&global->thread_arg[0])) {
 				ODPH_ERR("Start_cancel_mode_worker failed\n");
 				return -1;
@@ -1725,7 +1954,7 @@ int main(int argc, char **argv)
 
 		if (mode == MODE_SCHED_OVERH)
 			print_stat_sched_mode(global);
-		else if (mode == MODE_START_CANCEL)
+		else if (mode == MODE_START_CANCEL || mode == MODE_RESTART)
 			print_stat_start_cancel_mode(global);
 		else
 			print_stat_expire_mode(global);
@@ -28,6 +28,28 @@ if [ $RET_VAL -ne 0 ]; then
 	exit $RET_VAL
 fi
 
+echo odp_timer_perf: timer start and cancel mode, burst
+echo ===============================================
+
+$TEST_DIR/odp_timer_perf${EXEEXT} -m 1 -c 1 -t 10 -b 4 -R 50
+
+RET_VAL=$?
+if [ $RET_VAL -ne 0 ]; then
+	echo odp_timer_perf -m 1 -b 4: FAILED
+	exit $RET_VAL
+fi
+
+echo odp_timer_perf: timer restart mode, burst
+echo ===============================================
+
+$TEST_DIR/odp_timer_perf${EXEEXT} -m 4 -c 1 -t 10 -b 4 -R 50
+
+RET_VAL=$?
+if [ $RET_VAL -ne 0 ]; then
+	echo odp_timer_perf -m 4: FAILED
+	exit $RET_VAL
+fi
+
 echo odp_timer_perf: timer start and expire mode
 echo ===============================================
 
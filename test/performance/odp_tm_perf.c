@@ -0,0 +1,655 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/**
+ * @example odp_tm_perf.c
+ *
+ * Performance test application for traffic manager scheduling. Packets are
+ * sent through a single TM node with a varying number of backlogged fan-in
+ * queues, which stresses the weighted fair queueing of the node scheduler.
+ *
+ * @cond _ODP_HIDE_FROM_DOXYGEN_
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+#include <export_results.h>
+
+#define MAX_FANIN        4096
+#define MAX_STEPS        32
+#define NUM_SCHED_PROF   4
+#define MAX_WAIT_SEC     30
+
+typedef struct test_options_t {
+	uint32_t min_fanin;
+	uint32_t max_fanin;
+	uint32_t num_pkt;
+	uint32_t pkt_len;
+	int frame_based;
+
+} test_options_t;
+
+typedef struct test_stat_t {
+	uint32_t fanin;
+	uint64_t pkts;
+	uint64_t enq_retry;
+	uint64_t nsec;
+	uint64_t cycles;
+
+} test_stat_t;
+
+typedef struct test_global_t {
+	test_options_t options;
+	odp_pool_t pool;
+	odp_tm_t tm;
+	odp_tm_node_t node;
+	odp_tm_sched_t sched[NUM_SCHED_PROF];
+	odp_tm_queue_t queue[MAX_FANIN];
+	odp_atomic_u64_t num_egress;
+	uint32_t num_steps;
+	test_stat_t stat[MAX_STEPS];
+	test_common_options_t common_options;
+
+} test_global_t;
+
+static test_global_t *test_global;
+
+static void print_usage(void)
+{
+	printf("\n"
+	       "Traffic manager scheduling performance test\n"
+	       "\n"
+	       "Sends packets through a TM node with all fan-in queues backlogged. Fan-in is\n"
+	       "doubled on every test step, starting from the minimum value until the\n"
+	       "maximum is reached.\n"
+	       "\n"
+	       "Usage: odp_tm_perf [options]\n"
+	       "\n"
+	       "  -f, --min_fanin <num>  Minimum number of fan-in queues. Default: 1\n"
+	       "  -F, --max_fanin <num>  Maximum number of fan-in queues. Default: 1024\n"
+	       "  -n, --num_pkt <num>    Number of packets per test step. Default: 100000\n"
+	       "  -l, --pkt_len <bytes>  Packet length. Default: 64\n"
+	       "  -m, --frame_based      Use frame based scheduler weights. Default: byte based\n"
+	       "  -h, --help             This help\n"
+	       "\n");
+}
+
+static int parse_options(int argc, char *argv[], test_options_t *test_options)
+{
+	int opt;
+	int ret = 0;
+
+	static const struct option longopts[] = {
+		{ "min_fanin", required_argument, NULL, 'f' },
+		{ "max_fanin", required_argument, NULL, 'F' },
+		{ "num_pkt", required_argument, NULL, 'n' },
+		{ "pkt_len", required_argument, NULL, 'l' },
+		{ "frame_based", no_argument, NULL, 'm' },
+		{ "help", no_argument, NULL, 'h' },
+		{ NULL, 0, NULL, 0 }
+	};
+
+	static const char *shortopts = "+f:F:n:l:mh";
+
+	test_options->min_fanin = 1;
+	test_options->max_fanin = 1024;
+	test_options->num_pkt = 100000;
+	test_options->pkt_len = 64;
+	test_options->frame_based = 0;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, NULL);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'f':
+			test_options->min_fanin = atoi(optarg);
+			break;
+		case 'F':
+			test_options->max_fanin = atoi(optarg);
+			break;
+		case 'n':
+			test_options->num_pkt = atoi(optarg);
+			break;
+		case 'l':
+			test_options->pkt_len = atoi(optarg);
+			break;
+		case 'm':
+			test_options->frame_based = 1;
+			break;
+		case 'h':
+			/* fall through */
+		default:
+			print_usage();
+			ret = -1;
+			break;
+		}
+	}
+
+	if (test_options->min_fanin == 0 ||
+	    test_options->min_fanin > test_options->max_fanin) {
+		ODPH_ERR("Bad fan-in range %u - %u\n", test_options->min_fanin,
+			 test_options->max_fanin);
+		return -1;
+	}
+
+	if (test_options->max_fanin > MAX_FANIN) {
+		ODPH_ERR("Too large fan-in %u. Test maximum %u.\n",
+			 test_options->max_fanin, MAX_FANIN);
+		return -1;
+	}
+
+	if (test_options->num_pkt == 0) {
+		ODPH_ERR("Number of packets must not be zero\n");
+		return -1;
+	}
+
+	return ret;
+}
+
+static void egress_fn(odp_packet_t pkt)
+{
+	odp_packet_free(pkt);
+	odp_atomic_inc_u64(&test_global->num_egress);
+}
+
+static int check_capability(test_global_t *global)
+{
+	odp_tm_capabilities_t capa;
+	odp_tm_egress_t egress;
+	odp_pool_capability_t pool_capa;
+	test_options_t *test_options = &global->options;
+
+	odp_tm_egress_init(&egress);
+	egress.egress_kind = ODP_TM_EGRESS_FN;
+	egress.egress_fcn = egress_fn;
+
+	if (odp_tm_egress_capabilities(&capa, &egress)) {
+		ODPH_ERR("TM egress capability failed\n");
+		return -1;
+	}
+
+	if (!capa.egress_fcn_supported) {
+		ODPH_ERR("TM egress function not supported\n");
+		return -1;
+	}
+
+	if (test_options->max_fanin > capa.max_tm_queues ||
+	    test_options->max_fanin > capa.per_level[0].max_fanin_per_node) {
+		ODPH_ERR("Max fan-in supported %u\n",
+			 ODPH_MIN(capa.max_tm_queues, capa.per_level[0].max_fanin_per_node));
+		return -1;
+	}
+
+	if (odp_pool_capability(&pool_capa)) {
+		ODPH_ERR("Pool capability failed\n");
+		return -1;
+	}
+
+	if (pool_capa.pkt.max_len && test_options->pkt_len > pool_capa.pkt.max_len) {
+		ODPH_ERR("Max packet length supported %u\n", pool_capa.pkt.max_len);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int create_pool(test_global_t *global)
+{
+	odp_pool_param_t pool_param;
+	odp_pool_capability_t pool_capa;
+	test_options_t *test_options = &global->options;
+	uint32_t num = 16 * test_options->max_fanin + 1024;
+
+	if (odp_pool_capability(&pool_capa)) {
+		ODPH_ERR("Pool capability failed\n");
+		return -1;
+	}
+
+	if (pool_capa.pkt.max_num && num > pool_capa.pkt.max_num)
+		num = pool_capa.pkt.max_num;
+
+	odp_pool_param_init(&pool_param);
+	pool_param.type = ODP_POOL_PACKET;
+	pool_param.pkt.num = num;
+	pool_param.pkt.len = test_options->pkt_len;
+
+	global->pool = odp_pool_create("tm_perf_pool", &pool_param);
+	if (global->pool == ODP_POOL_INVALID) {
+		ODPH_ERR("Pool create failed\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int create_sched_profiles(test_global_t *global)
+{
+	odp_tm_sched_params_t sched_param;
+	char name[ODP_TM_NAME_LEN];
+	odp_tm_sched_mode_t mode = global->options.frame_based ?
+				   ODP_TM_FRAME_BASED_WEIGHTS : ODP_TM_BYTE_BASED_WEIGHTS;
+
+	/* Profiles with different weights, so that virtual finish times of
+	 * fan-in queues advance at different rates. */
+	for (int i = 0; i < NUM_SCHED_PROF; i++) {
+		odp_tm_sched_params_init(&sched_param);
+
+		for (int prio = 0; prio < ODP_TM_MAX_PRIORITIES; prio++) {
+			sched_param.sched_modes[prio] = mode;
+			sched_param.sched_weights[prio] = 1 << (2 * i);
+		}
+
+		snprintf(name, sizeof(name), "tm_perf_sched_%i", i);
+		global->sched[i] = odp_tm_sched_create(name, &sched_param);
+		if (global->sched[i] == ODP_TM_INVALID) {
+			ODPH_ERR("Scheduler profile create failed\n");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static void destroy_sched_profiles(test_global_t *global)
+{
+	for (int i = 0; i < NUM_SCHED_PROF; i++) {
+		if (global->sched[i] != ODP_TM_INVALID &&
+		    odp_tm_sched_destroy(global->sched[i]))
+			ODPH_ERR("Scheduler profile destroy failed\n");
+	}
+}
+
+static int create_tm(test_global_t *global, uint32_t fanin)
+{
+	odp_tm_requirements_t req;
+	odp_tm_egress_t egress;
+	odp_tm_node_params_t node_param;
+	odp_tm_queue_params_t queue_param;
+	odp_tm_level_requirements_t *level;
+
+	odp_tm_requirements_init(&req);
+	req.max_tm_queues = fanin;
+	req.num_levels = 1;
+	level = &req.per_level[0];
+	level->max_num_tm_nodes = 1;
+	level->max_fanin_per_node = fanin;
+	level->max_priority = 0;
+	level->min_weight = 1;
+	level->max_weight = 1 << (2 * (NUM_SCHED_PROF - 1));
+	level->fair_queuing_needed = true;
+	level->weights_needed = true;
+
+	odp_tm_egress_init(&egress);
+	egress.egress_kind = ODP_TM_EGRESS_FN;
+	egress.egress_fcn = egress_fn;
+
+	global->tm = odp_tm_create("tm_perf", &req, &egress);
+	if (global->tm == ODP_TM_INVALID) {
+		ODPH_ERR("TM create failed (fan-in %u)\n", fanin);
+		return -1;
+	}
+
+	odp_tm_node_params_init(&node_param);
+	node_param.max_fanin = fanin;
+	node_param.level = 0;
+
+	global->node = odp_tm_node_create(global->tm, "tm_perf_node", &node_param);
+	if (global->node == ODP_TM_INVALID) {
+		ODPH_ERR("TM node create failed\n");
+		return -1;
+	}
+
+	if (odp_tm_node_connect(global->node, ODP_TM_ROOT)) {
+		ODPH_ERR("TM node connect failed\n");
+		return -1;
+	}
+
+	for (uint32_t i = 0; i < fanin; i++) {
+		odp_tm_queue_params_init(&queue_param);
+		queue_param.priority = 0;
+
+		global->queue[i] = odp_tm_queue_create(global->tm, &queue_param);
+		if (global->queue[i] == ODP_TM_INVALID) {
+			ODPH_ERR("TM queue create failed (%u)\n", i);
+			return -1;
+		}
+
+		if (odp_tm_queue_connect(global->queue[i], global->node)) {
+			ODPH_ERR("TM queue connect failed (%u)\n", i);
+			return -1;
+		}
+
+		if (odp_tm_queue_sched_config(global->node, global->queue[i],
+					      global->sched[i % NUM_SCHED_PROF])) {
+			ODPH_ERR("TM queue sched config failed (%u)\n", i);
+			return -1;
+		}
+	}
+
+	if (odp_tm_start(global->tm)) {
+		ODPH_ERR("TM start failed\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int destroy_tm(test_global_t *global, uint32_t fanin)
+{
+	int ret = 0;
+
+	if (global->tm == ODP_TM_INVALID)
+		return 0;
+
+	if (odp_tm_stop(global->tm)) {
+		ODPH_ERR("TM stop failed\n");
+		ret = -1;
+	}
+
+	for (uint32_t i = 0; i < fanin; i++) {
+		if (global->queue[i] == ODP_TM_INVALID)
+			break;
+
+		odp_tm_queue_disconnect(global->queue[i]);
+		if (odp_tm_queue_destroy(global->queue[i])) {
+			ODPH_ERR("TM queue destroy failed (%u)\n", i);
+			ret = -1;
+		}
+
+		global->queue[i] = ODP_TM_INVALID;
+	}
+
+	if (global->node != ODP_TM_INVALID) {
+		odp_tm_node_disconnect(global->node);
+		if (odp_tm_node_destroy(global->node)) {
+			ODPH_ERR("TM node destroy failed\n");
+			ret = -1;
+		}
+
+		global->node = ODP_TM_INVALID;
+	}
+
+	if (odp_tm_destroy(global->tm)) {
+		ODPH_ERR("TM destroy failed\n");
+		ret = -1;
+	}
+
+	global->tm = ODP_TM_INVALID;
+	return ret;
+}
+
+static int run_step(test_global_t *global, uint32_t fanin, test_stat_t *stat)
+{
+	odp_time_t t1, t2, wait;
+	odp_packet_t pkt;
+	uint64_t c1, c2;
+	uint32_t pkt_len = global->options.pkt_len;
+	uint64_t num_pkt = global->options.num_pkt;
+	uint64_t retry = 0;
+	uint64_t sent = 0;
+	uint32_t i = 0;
+
+	odp_atomic_init_u64(&global->num_egress, 0);
+
+	t1 = odp_time_local();
+	c1 = odp_cpu_cycles();
+
+	/* Fill fan-in queues in round-robin order. TM enqueue fails when its
+	 * internal queues are full, which keeps all fan-in queues backlogged. */
+	while (sent < num_pkt) {
+		pkt = odp_packet_alloc(global->pool, pkt_len);
+		if (pkt == ODP_PACKET_INVALID) {
+			retry++;
+			odp_cpu_pause();
+			continue;
+		}
+
+		while (odp_tm_enq(global->queue[i], pkt)) {
+			retry++;
+			odp_cpu_pause();
+		}
+
+		sent++;
+		i++;
+		if (i == fanin)
+			i = 0;
+	}
+
+	wait = odp_time_add_ns(odp_time_local(), MAX_WAIT_SEC * ODP_TIME_SEC_IN_NS);
+
+	while (odp_atomic_load_u64(&global->num_egress) < num_pkt) {
+		if (odp_time_cmp(odp_time_local(), wait) > 0) {
+			ODPH_ERR("Timeout: %" PRIu64 "/%" PRIu64 " packets received\n",
+				 odp_atomic_load_u64(&global->num_egress), num_pkt);
+			return -1;
+		}
+
+		odp_cpu_pause();
+	}
+
+	c2 = odp_cpu_cycles();
+	t2 = odp_time_local();
+
+	stat->fanin = fanin;
+	stat->pkts = num_pkt;
+	stat->enq_retry = retry;
+	stat->nsec = odp_time_diff_ns(t2, t1);
+	stat->cycles = odp_cpu_cycles_diff(c2, c1);
+
+	return 0;
+}
+
+static int run_test(test_global_t *global)
+{
+	test_options_t *test_options = &global->options;
+	uint32_t fanin = test_options->min_fanin;
+	int ret = 0;
+
+	while (global->num_steps < MAX_STEPS) {
+		global->tm = ODP_TM_INVALID;
+		global->node = ODP_TM_INVALID;
+		for (uint32_t i = 0; i < fanin; i++)
+			global->queue[i] = ODP_TM_INVALID;
+
+		printf("Fan-in %u ...\n", fanin);
+
+		if (create_tm(global, fanin) ||
+		    run_step(global, fanin, &global->stat[global->num_steps]))
+			ret = -1;
+
+		if (destroy_tm(global, fanin))
+			ret = -1;
+
+		if (ret)
+			break;
+
+		global->num_steps++;
+
+		if (fanin == test_options->max_fanin)
+			break;
+
+		fanin = ODPH_MIN(2 * fanin, test_options->max_fanin);
+	}
+
+	return ret;
+}
+
+static int output_results(test_global_t *global)
+{
+	test_stat_t *stat;
+
+	printf("\nRESULTS\n");
+	printf("-------\n");
+	printf("  fan-in    packets    Mpkt/s   nsec/pkt   cycles/pkt   enq retries\n");
+
+	for (uint32_t i = 0; i < global->num_steps; i++) {
+		stat = &global->stat[i];
+
+		printf("  %6u %10" PRIu64 " %9.3f %10.1f %12.1f %13" PRIu64 "\n",
+		       stat->fanin, stat->pkts, (1000.0 * stat->pkts) / stat->nsec,
+		       (double)stat->nsec / stat->pkts, (double)stat->cycles / stat->pkts,
+		       stat->enq_retry);
+	}
+
+	printf("\n");
+
+	if (global->common_options.is_export) {
+		if (test_common_write("fan-in,packets,packets per sec (M),nsec per packet,"
+				      "cycles per packet,enqueue retries\n")) {
+			ODPH_ERR("Export failed\n");
+			test_common_write_term();
+			return -1;
+		}
+
+		for (uint32_t i = 0; i < global->num_steps; i++) {
+			stat = &global->stat[i];
+
+			if (test_common_write("%u,%" PRIu64 ",%f,%f,%f,%" PRIu64 "\n",
+					      stat->fanin, stat->pkts,
+					      (1000.0 * stat->pkts) / stat->nsec,
+					      (double)stat->nsec / stat->pkts,
+					      (double)stat->cycles / stat->pkts,
+					      stat->enq_retry)) {
+				ODPH_ERR("Export failed\n");
+				test_common_write_term();
+				return -1;
+			}
+		}
+
+		test_common_write_term();
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	odph_helper_options_t helper_options;
+	odp_instance_t instance;
+	odp_init_t init;
+	odp_shm_t shm;
+	test_global_t *global;
+	test_common_options_t common_options;
+	int ret = 0;
+
+	/* Let helper collect its own arguments (e.g. --odph_proc) */
+	argc = odph_parse_options(argc, argv);
+	if (odph_options(&helper_options)) {
+		ODPH_ERR("Error: Reading ODP helper options failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	argc = test_common_parse_options(argc, argv);
+	if (test_common_options(&common_options)) {
+		ODPH_ERR("Error: Reading test options failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* List features not to be used */
+	odp_init_param_init(&init);
+	init.not_used.feat.cls = 1;
+	init.not_used.feat.compress = 1;
+	init.not_used.feat.crypto = 1;
+	init.not_used.feat.ipsec = 1;
+	init.not_used.feat.schedule = 1;
+	init.not_used.feat.timer = 1;
+
+	init.mem_model = helper_options.mem_model;
+
+	/* Init ODP before calling anything else */
+	if (odp_init_global(&instance, &init, NULL)) {
+		ODPH_ERR("Error: Global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* Init this thread */
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		ODPH_ERR("Error: Local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	shm = odp_shm_reserve("tm_perf_global", sizeof(test_global_t),
+			      ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		ODPH_ERR("Error: Shared mem reserve failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	global = odp_shm_addr(shm);
+	if (global == NULL) {
+		ODPH_ERR("Error: Shared mem alloc failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	memset(global, 0, sizeof(test_global_t));
+	test_global = global;
+	global->pool = ODP_POOL_INVALID;
+	for (int i = 0; i < NUM_SCHED_PROF; i++)
+		global->sched[i] = ODP_TM_INVALID;
+
+	global->common_options = common_options;
+
+	if (parse_options(argc, argv, &global->options))
+		exit(EXIT_FAILURE);
+
+	odp_sys_info_print();
+
+	printf("\nTM scheduling performance test\n");
+	printf("  fan-in               %u - %u\n", global->options.min_fanin,
+	       global->options.max_fanin);
+	printf("  packets per step     %u\n", global->options.num_pkt);
+	printf("  packet length        %u\n", global->options.pkt_len);
+	printf("  weights              %s based\n\n",
+	       global->options.frame_based ? "frame" : "byte");
+
+	if (check_capability(global) || create_pool(global) ||
+	    create_sched_profiles(global)) {
+		ret = -1;
+		goto destroy;
+	}
+
+	if (run_test(global)) {
+		ODPH_ERR("Error: Test failed.\n");
+		ret = -1;
+	}
+
+	if (output_results(global))
+		ret = -1;
+
+destroy:
+	destroy_sched_profiles(global);
+
+	if (global->pool != ODP_POOL_INVALID && odp_pool_destroy(global->pool)) {
+		ODPH_ERR("Error: Pool destroy failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_shm_free(shm)) {
+		ODPH_ERR("Error: Shared mem free failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_local()) {
+		ODPH_ERR("Error: term local failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		ODPH_ERR("Error: term global failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ret;
+}
@@ -1348,6 +1348,104 @@ static void cls_pmr_queue_set(void)
 	test_term(&ts);
 }
 
+static void cls_cos_red(void)
+{
+	const test_state_t ts = test_init(ENABLE_CLS);
+	odp_pool_capability_t pool_capa;
+	odp_pool_param_t pool_param;
+	odp_cls_cos_param_t cls_param;
+	odp_pmr_param_t pmr_param;
+	odp_cls_cos_stats_t start, stop;
+	odp_packet_t pkt;
+	odp_packet_t pkt_tbl[SHM_PKT_NUM_BUFS];
+	odp_queue_t queue, from;
+	odp_pool_t pool;
+	odp_cos_t cos;
+	odp_pmr_t pmr;
+	uint32_t seqno;
+	uint8_t val = ODPH_IPPROTO_UDP;
+	uint8_t mask = 0xff;
+	const int num_hold = (SHM_PKT_NUM_BUFS * 3) / 4;
+	int i;
+
+	CU_ASSERT_FATAL(odp_pool_capability(&pool_capa) == 0);
+
+	/* No thread local caching, so that pool usage is exact */
+	odp_pool_param_init(&pool_param);
+	pool_param.type = ODP_POOL_PACKET;
+	pool_param.pkt.seg_len = SHM_PKT_BUF_SIZE;
+	pool_param.pkt.len = SHM_PKT_BUF_SIZE;
+	pool_param.pkt.num = SHM_PKT_NUM_BUFS;
+	pool_param.pkt.cache_size = pool_capa.pkt.min_cache_size;
+	pool = odp_pool_create("red_pool", &pool_param);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	queue = queue_create("red_queue", true);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	/* Drop all packets when half of the pool is in use */
+	odp_cls_cos_param_init(&cls_param);
+	cls_param.pool = pool;
+	cls_param.queue = queue;
+	cls_param.stats_enable = cls_capa.max_cos_stats > 0;
+	cls_param.red.enable = true;
+	if (cls_capa.threshold_red.percent) {
+		cls_param.red.threshold.type = ODP_THRESHOLD_PERCENT;
+		cls_param.red.threshold.percent.min = 5000;
+		cls_param.red.threshold.percent.max = 5000;
+	} else {
+		cls_param.red.threshold.type = ODP_THRESHOLD_PACKET;
+		cls_param.red.threshold.packet.min = SHM_PKT_NUM_BUFS / 2;
+		cls_param.red.threshold.packet.max = SHM_PKT_NUM_BUFS / 2;
+	}
+
+	cos = odp_cls_cos_create("red_cos", &cls_param);
+	CU_ASSERT_FATAL(cos != ODP_COS_INVALID);
+
+	odp_cls_pmr_param_init(&pmr_param);
+	pmr_param.term = ODP_PMR_IPPROTO;
+	pmr_param.match.value = &val;
+	pmr_param.match.mask = &mask;
+	pmr_param.val_sz = sizeof(val);
+
+	pmr = odp_cls_pmr_create(&pmr_param, 1, ts.default_cos, cos);
+	CU_ASSERT_FATAL(pmr != ODP_PMR_INVALID);
+
+	/* Pool is empty, packet is delivered */
+	pkt = create_udp_packet(CLS_DEFAULT_DPORT);
+	seqno = send_packet(pkt, ts.pktio);
+	pkt = receive_and_check(seqno, queue, pool, VECTOR_MODE_DISABLED);
+	odp_packet_free(pkt);
+
+	/* Overload the pool, packet is dropped */
+	for (i = 0; i < num_hold; i++) {
+		pkt_tbl[i] = odp_packet_alloc(pool, SHM_PKT_BUF_SIZE);
+		CU_ASSERT_FATAL(pkt_tbl[i] != ODP_PACKET_INVALID);
+	}
+
+	CU_ASSERT(odp_cls_cos_stats(cos, &start) == 0);
+
+	pkt = create_udp_packet(CLS_DEFAULT_DPORT);
+	send_packet(pkt, ts.pktio);
+	pkt = receive_packet(&from, ODP_TIME_SEC_IN_NS / 10, VECTOR_MODE_DISABLED);
+	CU_ASSERT(pkt == ODP_PACKET_INVALID);
+	if (pkt != ODP_PACKET_INVALID)
+		odp_packet_free(pkt);
+
+	CU_ASSERT(odp_cls_cos_stats(cos, &stop) == 0);
+	if (cls_param.stats_enable && cls_capa.stats.cos.counter.discards)
+		CU_ASSERT((stop.discards - start.discards) == 1);
+
+	odp_packet_free_multi(pkt_tbl, num_hold);
+
+	odp_cls_pmr_destroy(pmr);
+	odp_cos_destroy(cos);
+	odp_queue_destroy(queue);
+	odp_pool_destroy(pool);
+
+	test_term(&ts);
+}
+
 static void test_pmr_term_ipv4_addr(int dst)
 {
 	odp_packet_t pkt;
@@ -2134,6 +2232,13 @@ static int check_capa_ip_proto(void)
 	return cls_capa.supported_terms.bit.ip_proto;
 }
 
+static int check_capa_red(void)
+{
+	return cls_capa.random_early_detection != ODP_SUPPORT_NO &&
+	       (cls_capa.threshold_red.percent || cls_capa.threshold_red.packet) &&
+	       cls_capa.supported_terms.bit.ip_proto;
+}
+
 static int check_capa_ip_dscp(void)
 {
 	return cls_capa.supported_terms.bit.ip_dscp;
@@ -2287,6 +2392,7 @@ odp_testinfo_t classification_suite_pmr[] = {
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_term_dmac, check_capa_dmac),
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_pool_set, check_capa_ip_proto),
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_queue_set, check_capa_ip_proto),
+	ODP_TEST_INFO_CONDITIONAL(cls_cos_red, check_capa_red),
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_term_ipv4_saddr, check_capa_ipv4_saddr),
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_term_ipv4_daddr, check_capa_ipv4_daddr),
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_term_ipv6saddr, check_capa_ipv6_saddr),
@@ -72,6 +72,9 @@ typedef struct {
 	/* Timeout pool user area support */
 	uint32_t tmo_uarea_support;
 
+	/* Timer pool statistics support */
+	odp_bool_t stats_support;
+
 	/* Default resolution / timeout parameters */
 	struct {
 		uint64_t res_ns;
@@ -249,6 +252,7 @@ static int timer_global_init(odp_instance_t *instance)
 	global_mem->param.max_tmo = max_tmo;
 	global_mem->param.queue_type_plain = capa.queue_type_plain;
 	global_mem->param.queue_type_sched = capa.queue_type_sched;
+	global_mem->stats_support = capa.stats;
 
 	return 0;
 }
@@ -278,6 +282,14 @@ check_plain_queue_support(void)
 	return ODP_TEST_INACTIVE;
 }
 
+static int check_stats_support(void)
+{
+	if (global_mem->stats_support)
+		return ODP_TEST_ACTIVE;
+
+	return ODP_TEST_INACTIVE;
+}
+
 static int check_periodic_base_mul_support(void)
 {
 	if (global_mem->periodic_base_mul_support)
@@ -2329,6 +2341,241 @@ static void timer_test_cancel(void)
 		CU_FAIL_FATAL("Failed to destroy pool");
 }
 
+#define MULTI_TIMERS 8
+
+static void timer_test_multi(void)
+{
+	odp_pool_t pool;
+	odp_pool_param_t params;
+	odp_timer_pool_param_t tparam;
+	odp_queue_param_t queue_param;
+	odp_timer_capability_t capa;
+	odp_timer_pool_t tp;
+	odp_timer_start_t start_param[MULTI_TIMERS];
+	odp_queue_t queue;
+	odp_timer_t tim[MULTI_TIMERS];
+	odp_event_t ev[MULTI_TIMERS];
+	odp_timeout_t tmo;
+	int i, ret;
+	int num = MULTI_TIMERS;
+	odp_timer_clk_src_t clk_src = test_global->clk_src;
+
+	ret = odp_timer_capability(clk_src, &capa);
+	CU_ASSERT_FATAL(ret == 0);
+
+	if (capa.max_timers && capa.max_timers < (uint32_t)num)
+		num = capa.max_timers;
+
+	odp_pool_param_init(&params);
+	params.type    = ODP_POOL_TIMEOUT;
+	params.tmo.num = num;
+
+	pool = odp_pool_create("tmo_pool_for_multi", &params);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	odp_timer_pool_param_init(&tparam);
+	tparam.res_ns	  = global_mem->param.res_ns;
+	tparam.min_tmo    = global_mem->param.min_tmo;
+	tparam.max_tmo    = global_mem->param.max_tmo;
+	tparam.num_timers = num;
+	tparam.priv       = 0;
+	tparam.clk_src    = clk_src;
+	tp = odp_timer_pool_create(NULL, &tparam);
+	CU_ASSERT_FATAL(tp != ODP_TIMER_POOL_INVALID);
+
+	CU_ASSERT_FATAL(odp_timer_pool_start_multi(&tp, 1) == 1);
+
+	odp_queue_param_init(&queue_param);
+	if (capa.queue_type_plain) {
+		queue_param.type = ODP_QUEUE_TYPE_PLAIN;
+	} else if (capa.queue_type_sched) {
+		queue_param.type = ODP_QUEUE_TYPE_SCHED;
+		queue_param.sched.sync = ODP_SCHED_SYNC_ATOMIC;
+	}
+
+	queue = odp_queue_create("timer_queue", &queue_param);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	for (i = 0; i < num; i++) {
+		tim[i] = odp_timer_alloc(tp, queue, USER_PTR);
+		CU_ASSERT_FATAL(tim[i] != ODP_TIMER_INVALID);
+
+		tmo = odp_timeout_alloc(pool);
+		CU_ASSERT_FATAL(tmo != ODP_TIMEOUT_INVALID);
+
+		start_param[i].tick_type = ODP_TIMER_TICK_REL;
+		start_param[i].tick = odp_timer_ns_to_tick(tp, tparam.max_tmo / 2);
+		start_param[i].tmo_ev = odp_timeout_to_event(tmo);
+	}
+
+	/* Expiration time of the first timer is too near */
+	start_param[0].tick = 0;
+	CU_ASSERT(odp_timer_start_multi(tim, start_param, num) == ODP_TIMER_TOO_NEAR);
+
+	start_param[0].tick = start_param[num - 1].tick;
+	CU_ASSERT_FATAL(odp_timer_start_multi(tim, start_param, num) == num);
+
+	for (i = 0; i < num; i++) {
+		start_param[i].tick = odp_timer_ns_to_tick(tp, tparam.max_tmo / 4 + i);
+		start_param[i].tmo_ev = ODP_EVENT_INVALID;
+	}
+
+	CU_ASSERT(odp_timer_restart_multi(tim, start_param, num) == num);
+
+	for (i = 0; i < num; i++)
+		ev[i] = ODP_EVENT_INVALID;
+
+	CU_ASSERT_FATAL(odp_timer_cancel_multi(tim, ev, num) == num);
+
+	for (i = 0; i < num; i++) {
+		CU_ASSERT_FATAL(ev[i] != ODP_EVENT_INVALID);
+		tmo = odp_timeout_from_event(ev[i]);
+		CU_ASSERT(odp_timeout_timer(tmo) == tim[i]);
+		CU_ASSERT(odp_timeout_user_ptr(tmo) == USER_PTR);
+		odp_timeout_free(tmo);
+	}
+
+	/* Timers are not active anymore */
+	CU_ASSERT(odp_timer_restart_multi(tim, start_param, num) == ODP_TIMER_FAIL);
+	CU_ASSERT(odp_timer_cancel_multi(tim, ev, num) == ODP_TIMER_TOO_NEAR);
+
+	for (i = 0; i < num; i++)
+		CU_ASSERT(odp_timer_free(tim[i]) == 0);
+
+	odp_timer_pool_destroy(tp);
+
+	CU_ASSERT(odp_queue_destroy(queue) == 0);
+	CU_ASSERT(odp_pool_destroy(pool) == 0);
+}
+
+static uint64_t hist_sum(const uint64_t hist[])
+{
+	uint64_t sum = 0;
+
+	for (int i = 0; i < ODP_TIMER_POOL_STATS_HIST_SIZE; i++)
+		sum += hist[i];
+
+	return sum;
+}
+
+static void timer_test_stats(void)
+{
+	odp_pool_t pool;
+	odp_pool_param_t params;
+	odp_timer_pool_param_t tparam;
+	odp_queue_param_t queue_param;
+	odp_timer_capability_t capa;
+	odp_timer_pool_t tp;
+	odp_timer_pool_stats_t stats;
+	odp_timer_start_t start_param;
+	odp_queue_t queue;
+	odp_timer_t tim[MULTI_TIMERS];
+	odp_timeout_t tmo;
+	odp_event_t ev;
+	uint64_t time_limit;
+	int i, ret;
+	int num = MULTI_TIMERS;
+	int num_recv = 0;
+	odp_timer_clk_src_t clk_src = test_global->clk_src;
+
+	ret = odp_timer_capability(clk_src, &capa);
+	CU_ASSERT_FATAL(ret == 0);
+
+	if (capa.max_timers && capa.max_timers < (uint32_t)num)
+		num = capa.max_timers;
+
+	odp_pool_param_init(&params);
+	params.type    = ODP_POOL_TIMEOUT;
+	params.tmo.num = num;
+
+	pool = odp_pool_create("tmo_pool_for_stats", &params);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	odp_timer_pool_param_init(&tparam);
+	tparam.res_ns	  = global_mem->param.res_ns;
+	tparam.min_tmo    = global_mem->param.min_tmo;
+	tparam.max_tmo    = global_mem->param.max_tmo;
+	tparam.num_timers = num;
+	tparam.priv       = 0;
+	tparam.clk_src    = clk_src;
+	tp = odp_timer_pool_create(NULL, &tparam);
+	CU_ASSERT_FATAL(tp != ODP_TIMER_POOL_INVALID);
+
+	CU_ASSERT_FATAL(odp_timer_pool_start_multi(&tp, 1) == 1);
+
+	odp_queue_param_init(&queue_param);
+	if (capa.queue_type_sched) {
+		queue_param.type = ODP_QUEUE_TYPE_SCHED;
+		queue_param.sched.sync = ODP_SCHED_SYNC_ATOMIC;
+	} else {
+		queue_param.type = ODP_QUEUE_TYPE_PLAIN;
+	}
+
+	queue = odp_queue_create("timer_queue", &queue_param);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	CU_ASSERT_FATAL(odp_timer_pool_stats_reset(tp) == 0);
+	CU_ASSERT_FATAL(odp_timer_pool_stats(tp, &stats) == 0);
+	CU_ASSERT(stats.expired == 0);
+	CU_ASSERT(stats.late_ns_max == 0);
+	CU_ASSERT(hist_sum(stats.hist.late_ns) == 0);
+
+	start_param.tick_type = ODP_TIMER_TICK_REL;
+	start_param.tick = odp_timer_ns_to_tick(tp, tparam.min_tmo);
+
+	for (i = 0; i < num; i++) {
+		tim[i] = odp_timer_alloc(tp, queue, USER_PTR);
+		CU_ASSERT_FATAL(tim[i] != ODP_TIMER_INVALID);
+
+		tmo = odp_timeout_alloc(pool);
+		CU_ASSERT_FATAL(tmo != ODP_TIMEOUT_INVALID);
+
+		start_param.tmo_ev = odp_timeout_to_event(tmo);
+		CU_ASSERT_FATAL(odp_timer_start(tim[i], &start_param) == ODP_TIMER_SUCCESS);
+	}
+
+	time_limit = odp_time_local_strict_ns() + tparam.min_tmo + ODP_TIME_SEC_IN_NS;
+
+	while (num_recv < num && odp_time_local_strict_ns() < time_limit) {
+		if (capa.queue_type_sched)
+			ev = odp_schedule(NULL, ODP_SCHED_NO_WAIT);
+		else
+			ev = odp_queue_deq(queue);
+
+		if (ev == ODP_EVENT_INVALID)
+			continue;
+
+		CU_ASSERT(odp_event_type(ev) == ODP_EVENT_TIMEOUT);
+		odp_event_free(ev);
+		num_recv++;
+	}
+
+	CU_ASSERT(num_recv == num);
+
+	/* Statistics are updated after a scan, which may still be in progress in another thread */
+	time_limit = odp_time_local_strict_ns() + ODP_TIME_SEC_IN_NS;
+
+	do {
+		CU_ASSERT_FATAL(odp_timer_pool_stats(tp, &stats) == 0);
+	} while (stats.expired < (uint64_t)num_recv && odp_time_local_strict_ns() < time_limit);
+
+	CU_ASSERT(stats.scans > 0);
+	CU_ASSERT(stats.expired == (uint64_t)num_recv);
+	CU_ASSERT(hist_sum(stats.hist.late_ns) == stats.expired);
+	CU_ASSERT(hist_sum(stats.hist.scan_ns) <= stats.scans);
+	CU_ASSERT(hist_sum(stats.hist.expired) <= stats.scans);
+
+	odp_timer_pool_print(tp);
+
+	for (i = 0; i < num; i++)
+		CU_ASSERT(odp_timer_free(tim[i]) == 0);
+
+	odp_timer_pool_destroy(tp);
+
+	CU_ASSERT(odp_queue_destroy(queue) == 0);
+	CU_ASSERT(odp_pool_destroy(pool) == 0);
+}
+
 static void timer_test_tmo_limit(odp_queue_type_t queue_type,
 				 int max_res, int min)
 {
@@ -4414,6 +4661,8 @@ odp_testinfo_t timer_suite[] = {
 	ODP_TEST_INFO_CONDITIONAL(timer_test_pkt_event_reuse,
 				  check_sched_queue_support),
 	ODP_TEST_INFO(timer_test_cancel),
+	ODP_TEST_INFO(timer_test_multi),
+	ODP_TEST_INFO_CONDITIONAL(timer_test_stats, check_stats_support),
 	ODP_TEST_INFO_CONDITIONAL(timer_test_max_res_min_tmo_plain,
 				  check_plain_queue_support),
 	ODP_TEST_INFO_CONDITIONAL(timer_test_max_res_min_tmo_sched,